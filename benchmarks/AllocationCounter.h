@@ -0,0 +1,11 @@
+#pragma once
+#include <QtGlobal>
+
+// Counts the heap allocations the process makes, so benchmarks can check
+// that steady-state queries do not allocate. With glibc every malloc,
+// calloc and realloc is counted, which covers Qt containers as well as
+// operator new; elsewhere only operator new is.
+namespace AllocationCounter {
+    // Allocations since the process started
+    qint64 count();
+}
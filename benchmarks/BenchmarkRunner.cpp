@@ -0,0 +1,68 @@
+#include "BenchmarkRunner.h"
+#include "AllocationCounter.h"
+#include <QElapsedTimer>
+#include <QJsonObject>
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+BenchmarkRunner::BenchmarkRunner(int iterations, const QString& filter)
+    : m_iterations(std::max(iterations, 1))
+    , m_filter(filter)
+{
+}
+
+void BenchmarkRunner::run(const QString& name, const std::function<void(int)>& body,
+                          const std::function<void(int)>& setup)
+{
+    if (!m_filter.isEmpty() && !name.contains(m_filter)) {
+        return;
+    }
+
+    if (setup) setup(-1);
+    body(-1);
+
+    std::vector<double> samples;
+    samples.reserve(m_iterations);
+    QElapsedTimer timer;
+    qint64 allocations = 0;
+    for (int i = 0; i < m_iterations; ++i) {
+        if (setup) setup(i);
+        const qint64 allocationsBefore = AllocationCounter::count();
+        timer.start();
+        body(i);
+        samples.push_back(timer.nsecsElapsed() / 1000.0);
+        allocations += AllocationCounter::count() - allocationsBefore;
+    }
+
+    std::sort(samples.begin(), samples.end());
+    const auto percentile = [&samples](double p) {
+        const size_t index = std::min(samples.size() - 1, static_cast<size_t>(p * samples.size()));
+        return samples[index];
+    };
+
+    QJsonObject result;
+    result["name"] = name;
+    result["iterations"] = m_iterations;
+    result["minUs"] = samples.front();
+    result["medianUs"] = percentile(0.5);
+    result["meanUs"] = std::accumulate(samples.begin(), samples.end(), 0.0) / samples.size();
+    result["p95Us"] = percentile(0.95);
+    result["maxUs"] = samples.back();
+    result["allocations"] = static_cast<double>(allocations) / m_iterations;
+    m_results.append(result);
+}
+
+void BenchmarkRunner::printSummary(QTextStream& out) const
+{
+    out << QString("%1 %2 %3 %4\n")
+               .arg("benchmark", -40).arg("median us", 12).arg("p95 us", 12).arg("max us", 12);
+    for (const QJsonValue& value : m_results) {
+        const QJsonObject result = value.toObject();
+        out << QString("%1 %2 %3 %4\n")
+                   .arg(result["name"].toString(), -40)
+                   .arg(result["medianUs"].toDouble(), 12, 'f', 1)
+                   .arg(result["p95Us"].toDouble(), 12, 'f', 1)
+                   .arg(result["maxUs"].toDouble(), 12, 'f', 1);
+    }
+}
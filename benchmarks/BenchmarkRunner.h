@@ -0,0 +1,27 @@
+#pragma once
+#include <QJsonArray>
+#include <QString>
+#include <QTextStream>
+#include <functional>
+
+// Times named benchmark bodies and collects per-iteration statistics. Each
+// body runs once untimed to warm caches, then `iterations` timed runs.
+class BenchmarkRunner {
+public:
+    BenchmarkRunner(int iterations, const QString& filter);
+
+    // The body gets the iteration index; setup runs untimed before each
+    // iteration when given
+    void run(const QString& name, const std::function<void(int)>& body,
+             const std::function<void(int)>& setup = nullptr);
+
+    // One object per benchmark: name, iterations, min/median/mean/p95/max
+    // in microseconds and the mean heap allocations per timed run
+    QJsonArray results() const { return m_results; }
+    void printSummary(QTextStream& out) const;
+
+private:
+    int m_iterations;
+    QString m_filter;
+    QJsonArray m_results;
+};
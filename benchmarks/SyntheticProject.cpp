@@ -0,0 +1,182 @@
+#include "SyntheticProject.h"
+#include "Application.h"
+#include "Project.h"
+#include "CanvasController.h"
+#include "HitTestService.h"
+#include "ElementModel.h"
+#include "ElementTypeRegistry.h"
+#include "Frame.h"
+#include "Scripts.h"
+#include "Node.h"
+#include "Edge.h"
+#include <QRandomGenerator>
+#include <cmath>
+
+namespace {
+constexpr qreal RootSize = 800.0;
+constexpr qreal RootSpacing = 200.0;
+constexpr qreal Padding = 8.0;
+}
+
+SyntheticProject::SyntheticProject(Application* application, const SyntheticProjectOptions& options)
+    : m_options(options)
+{
+    const QString projectId = application->createProject(QStringLiteral("Benchmark"));
+    m_project = application->getProject(projectId);
+    if (!m_project) {
+        qWarning() << "SyntheticProject: failed to create project";
+        return;
+    }
+
+    // Elements per root tree: 1 + c + c^2 + ... + c^depth
+    int perTree = 0;
+    for (int level = 0, width = 1; level <= m_options.depth; ++level, width *= m_options.childrenPerFrame) {
+        perTree += width;
+    }
+    const int rootCount = std::max(1, (m_options.elementCount + perTree - 1) / std::max(perTree, 1));
+    const int columns = std::max(1, static_cast<int>(std::ceil(std::sqrt(static_cast<double>(rootCount)))));
+
+    m_elements.reserve(rootCount * perTree);
+
+    HitTestService* hitTest = m_project->controller()->hitTestService();
+    hitTest->beginBatch();
+    for (int i = 0; i < rootCount && m_elements.size() < m_options.elementCount; ++i) {
+        const QRectF rect((i % columns) * (RootSize + RootSpacing),
+                          (i / columns) * (RootSize + RootSpacing),
+                          RootSize, RootSize);
+        m_bounds = m_bounds.united(rect);
+        createTree(QString(), rect, 0);
+    }
+    hitTest->endBatch();
+
+    createScriptGraph();
+}
+
+void SyntheticProject::createTree(const QString& parentId, const QRectF& rect, int level)
+{
+    if (m_elements.size() >= m_options.elementCount) {
+        return;
+    }
+
+    const bool leaf = level == m_options.depth;
+    const int index = m_elements.size();
+    const QString type = (leaf && index % 3 == 0) ? QStringLiteral("text") : QStringLiteral("frame");
+    const QString id = QString("bench%1").arg(index, 8, 10, QChar('0'));
+
+    DesignElement* element = ElementTypeRegistry::instance().createElement(type, id);
+    if (!element) {
+        qWarning() << "SyntheticProject: unknown element type" << type;
+        return;
+    }
+    element->setName(QString("%1 %2").arg(type).arg(index));
+    element->setParentElementId(parentId);
+    element->setRect(rect);
+
+    Frame* frame = qobject_cast<Frame*>(element);
+    if (frame && !parentId.isEmpty()) {
+        frame->setPosition(Frame::Relative);
+    }
+
+    // Pre-order, so parents are in the model before their children
+    m_project->elementModel()->addElement(element);
+    m_elements.append(element);
+
+    if (leaf || !frame) {
+        return;
+    }
+
+    const int children = m_options.childrenPerFrame;
+    if (level + 1 == m_options.depth) {
+        frame->setFlex(true);
+        frame->setOrientation(level % 2 == 0 ? Frame::Row : Frame::Column);
+        frame->setGap(Padding);
+        m_flexFrames.append(frame);
+    }
+
+    // Children tile the parent's inner area with a little jitter, so point
+    // queries do not all land on cell edges
+    QRandomGenerator random(m_options.seed + index);
+    const int columns = std::max(1, static_cast<int>(std::ceil(std::sqrt(static_cast<double>(children)))));
+    const int rows = (children + columns - 1) / columns;
+    const qreal cellWidth = (rect.width() - Padding * 2) / columns;
+    const qreal cellHeight = (rect.height() - Padding * 2) / rows;
+    for (int i = 0; i < children; ++i) {
+        const qreal jitter = random.bounded(Padding);
+        const QRectF childRect(rect.x() + Padding + (i % columns) * cellWidth + jitter,
+                               rect.y() + Padding + (i / columns) * cellHeight + jitter,
+                               std::max(cellWidth - Padding - jitter, 1.0),
+                               std::max(cellHeight - Padding - jitter, 1.0));
+        createTree(id, childRect, level + 1);
+    }
+}
+
+void SyntheticProject::createScriptGraph()
+{
+    Scripts* scripts = m_project->scripts();
+
+    // Projects start with an On Editor Load event node; chain the log nodes to it
+    Node* previous = nullptr;
+    for (Node* node : scripts->getAllNodes()) {
+        if (node->nodeType() == "Event" && node->nodeTitle() == "On Editor Load") {
+            previous = node;
+            break;
+        }
+    }
+    if (!previous) {
+        qWarning() << "SyntheticProject: project has no On Editor Load node";
+        return;
+    }
+
+    for (int i = 0; i < m_options.scriptNodes; ++i) {
+        const QString nodeId = QString("benchnode%1").arg(i, 8, 10, QChar('0'));
+        Node* node = new Node(nodeId, scripts);
+        node->setNodeTitle("Console Log");
+        node->setNodeType("Operation");
+        node->setScript("(params) => { console.log(params.message || ''); }");
+        node->setValue(QString("step %1").arg(i));
+        node->setX(100 + (i % 10) * 200);
+        node->setY((i / 10) * 120);
+        node->setWidth(150);
+        node->setHeight(80);
+
+        Node::RowConfig flowRow;
+        flowRow.hasTarget = true;
+        flowRow.targetLabel = "Exec";
+        flowRow.targetType = "Flow";
+        flowRow.targetPortIndex = 0;
+        flowRow.hasSource = true;
+        flowRow.sourceLabel = "Done";
+        flowRow.sourceType = "Flow";
+        flowRow.sourcePortIndex = 0;
+        node->addRow(flowRow);
+
+        Node::RowConfig messageRow;
+        messageRow.hasTarget = true;
+        messageRow.targetLabel = "Message";
+        messageRow.targetType = "String";
+        messageRow.targetPortIndex = 1;
+        node->addRow(messageRow);
+
+        node->addInputPort("exec");
+        node->setInputPortType(0, "Flow");
+        node->addInputPort("message");
+        node->setInputPortType(1, "String");
+        node->addOutputPort("done");
+        node->setOutputPortType(0, "Flow");
+        scripts->addNode(node);
+
+        Edge* edge = new Edge(QString("benchedge%1").arg(i, 8, 10, QChar('0')), scripts);
+        edge->setSourceNodeId(previous->getId());
+        edge->setTargetNodeId(nodeId);
+        edge->setSourcePortIndex(0);
+        edge->setTargetPortIndex(0);
+        edge->setSourceHandleType("right");
+        edge->setTargetHandleType("left");
+        edge->setSourcePortType("Flow");
+        edge->setTargetPortType("Flow");
+        scripts->addEdge(edge);
+
+        m_scriptNodeIds.append(nodeId);
+        previous = node;
+    }
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include <QList>
+#include <QRectF>
+#include <QStringList>
+
+class Application;
+class Project;
+class Frame;
+class Element;
+
+struct SyntheticProjectOptions {
+    int elementCount = 2000;     // Design elements, across all trees
+    int depth = 3;               // Levels below each root frame
+    int childrenPerFrame = 4;    // Children of every non-leaf frame
+    int scriptNodes = 100;       // Console Log nodes chained after On Editor Load
+    quint32 seed = 1;
+};
+
+// Fills a new project with a grid of nested frame trees and a linear script
+// graph. The parents of leaf frames are flex containers, so layout passes
+// have work to do; every third leaf is a text element.
+class SyntheticProject {
+public:
+    SyntheticProject(Application* application, const SyntheticProjectOptions& options);
+
+    Project* project() const { return m_project; }
+    const QList<Element*>& elements() const { return m_elements; }
+    const QList<Frame*>& flexFrames() const { return m_flexFrames; }
+    const QStringList& scriptNodeIds() const { return m_scriptNodeIds; }
+    QRectF bounds() const { return m_bounds; }
+
+private:
+    void createTree(const QString& parentId, const QRectF& rect, int level);
+    void createScriptGraph();
+
+    SyntheticProjectOptions m_options;
+    Project* m_project = nullptr;
+    QList<Element*> m_elements;
+    QList<Frame*> m_flexFrames;
+    QStringList m_scriptNodeIds;
+    QRectF m_bounds;
+};
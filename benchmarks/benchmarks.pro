@@ -0,0 +1,33 @@
+# Headless performance benchmarks for the real application classes.
+# Built with the application by the top-level cubit.pro, or on its own:
+#
+#   qmake benchmarks/benchmarks.pro && make
+#   ./cubit-benchmarks --elements 5000 --depth 3 --output results.json
+#
+# Runs on the offscreen platform, so no display is needed.
+
+TEMPLATE = app
+TARGET = cubit-benchmarks
+
+QT += core gui widgets qml quick quickcontrols2 quicktemplates2 network websockets
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+# Benchmarks are only meaningful with optimizations on
+CONFIG += release
+CONFIG -= debug
+
+include(../src/src.pri)
+
+SOURCES += \
+    main.cpp \
+    AllocationCounter.cpp \
+    BenchmarkRunner.cpp \
+    SyntheticProject.cpp
+
+HEADERS += \
+    AllocationCounter.h \
+    BenchmarkRunner.h \
+    SyntheticProject.h
+
+RESOURCES += ../data.qrc
@@ -0,0 +1,528 @@
+// Headless benchmarks for the editor's hot paths, run against the real
+// application classes on a generated project. See docs/BENCHMARKS.md.
+
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QRandomGenerator>
+#include <QStringList>
+#include <QTextStream>
+#include <memory>
+#include <vector>
+#include "BenchmarkRunner.h"
+#include "SyntheticProject.h"
+#include "Application.h"
+#include "Project.h"
+#include "CanvasController.h"
+#include "HitTestService.h"
+#include "SnappingService.h"
+#include "QuadTree.h"
+#include "ElementModel.h"
+#include "ElementTypeRegistry.h"
+#include "PropertyTypeMapper.h"
+#include "FlexLayoutEngine.h"
+#include "Frame.h"
+#include "Scripts.h"
+#include "ScriptCompiler.h"
+#include "ScriptExecutor.h"
+#include "PerformanceTrace.h"
+#include "InputRecording.h"
+#include "InputReplayer.h"
+#include "AICommandStreamParser.h"
+
+namespace {
+
+bool s_verbose = false;
+
+// The editor logs freely at debug level; keep the benchmark output readable
+void messageHandler(QtMsgType type, const QMessageLogContext& context, const QString& message)
+{
+    if (!s_verbose && (type == QtDebugMsg || type == QtInfoMsg)) {
+        return;
+    }
+    Q_UNUSED(context);
+    QTextStream(stderr) << message << '\n';
+}
+
+bool writeReport(const QJsonObject& report, const QString& outputPath)
+{
+    const QByteArray json = QJsonDocument(report).toJson();
+    if (outputPath.isEmpty()) {
+        QTextStream(stdout) << json;
+        return true;
+    }
+
+    QFile file(outputPath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "Cannot write" << file.fileName();
+        return false;
+    }
+    file.write(json);
+    return true;
+}
+
+// Replays a recorded input session against the project snapshot it carries
+int replaySession(Application* application, const QString& sessionPath, bool maximumSpeed,
+                  const QString& outputPath)
+{
+    InputRecording recording;
+    if (!recording.load(sessionPath)) {
+        return 1;
+    }
+
+    const QJsonObject projectData = QJsonDocument::fromJson(recording.projectData).object();
+    if (projectData.isEmpty()) {
+        qWarning() << sessionPath << "has no project snapshot to replay against";
+        return 1;
+    }
+    std::unique_ptr<Project> project(application->deserializeProjectFromData(projectData));
+    if (!project) {
+        return 1;
+    }
+
+    InputReplayer replayer(project->controller());
+    QJsonObject report = replayer.replay(recording, maximumSpeed ? InputReplayer::MaximumSpeed
+                                                                 : InputReplayer::OriginalSpeed);
+    report["session"] = sessionPath;
+
+    QTextStream summary(stderr);
+    summary << QString("%1 %2 %3 %4 %5\n")
+                   .arg("event", -12).arg("count", 8).arg("p50 us", 10).arg("p95 us", 10).arg("max us", 10);
+    const QJsonObject latency = report["latency"].toObject();
+    for (auto it = latency.begin(); it != latency.end(); ++it) {
+        const QJsonObject stats = it.value().toObject();
+        summary << QString("%1 %2 %3 %4 %5\n")
+                       .arg(it.key(), -12)
+                       .arg(stats["count"].toInteger(), 8)
+                       .arg(stats["p50Us"].toInteger(), 10)
+                       .arg(stats["p95Us"].toInteger(), 10)
+                       .arg(stats["maxUs"].toInteger(), 10);
+    }
+    summary << "input work " << report["inputWorkUs"].toInteger() << " us, frame work "
+            << report["frameWorkUs"].toInteger() << " us, wall time " << report["wallTimeUs"].toInteger() << " us\n";
+
+    return writeReport(report, outputPath) ? 0 : 1;
+}
+
+// Replays a captured AI response through AICommandStreamParser and checks
+// that each command comes out of the chunk in which it completes. The file is
+// either a JSON array of the chunks as they arrived, or the raw response text,
+// which is then cut into chunkSize pieces
+int replayStream(const QString& streamPath, int chunkSize, const QString& outputPath)
+{
+    QFile file(streamPath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "Cannot read" << file.fileName();
+        return 1;
+    }
+    const QByteArray data = file.readAll();
+
+    QStringList chunks;
+    const QJsonDocument captured = QJsonDocument::fromJson(data);
+    if (captured.isArray()) {
+        for (const QJsonValue& chunk : captured.array()) {
+            chunks.append(chunk.toString());
+        }
+    } else {
+        const QString text = QString::fromUtf8(data);
+        for (qsizetype i = 0; i < text.size(); i += chunkSize) {
+            chunks.append(text.mid(i, chunkSize));
+        }
+    }
+    const QString response = chunks.join(QString());
+
+    // The commands the finished response holds, parsed the way finalizeResponse does
+    const QJsonObject responseObject = QJsonDocument::fromJson(response.trimmed().toUtf8()).object();
+    QJsonValue commandsValue = responseObject["commands"];
+    if (commandsValue.isString()) {
+        commandsValue = QJsonDocument::fromJson(commandsValue.toString().toUtf8()).array();
+    }
+    if (!commandsValue.isArray()) {
+        qWarning() << streamPath << "is not a response with a commands array";
+        return 1;
+    }
+    const QJsonArray expected = commandsValue.toArray();
+
+    // Feeding one character at a time gives the offset at which each command
+    // completes, and so the earliest it could be emitted
+    AICommandStreamParser parser;
+    QList<qsizetype> completedAt;
+    for (qsizetype i = 0; i < response.size(); ++i) {
+        for (qsizetype n = parser.feed(response.mid(i, 1)).size(); n > 0; --n) {
+            completedAt.append(i + 1);
+        }
+    }
+
+    parser.reset();
+    QJsonArray commandReports;
+    QStringList failures;
+    qsizetype offset = 0;
+    qint64 parseNs = 0;
+    QElapsedTimer timer;
+    for (int chunkIndex = 0; chunkIndex < chunks.size(); ++chunkIndex) {
+        const qsizetype chunkStart = offset;
+        offset += chunks[chunkIndex].size();
+
+        timer.start();
+        const QList<QJsonObject> commands = parser.feed(chunks[chunkIndex]);
+        parseNs += timer.nsecsElapsed();
+
+        for (const QJsonObject& command : commands) {
+            const int index = commandReports.size();
+            const qsizetype earliest = index < completedAt.size() ? completedAt[index] : -1;
+            if (index >= expected.size() || command != expected[index].toObject()) {
+                failures.append(QString("command %1 does not match the response").arg(index));
+            } else if (earliest <= chunkStart || earliest > offset) {
+                failures.append(QString("command %1 completed at offset %2 but came out of chunk %3 (%4-%5)")
+                                    .arg(index).arg(earliest).arg(chunkIndex).arg(chunkStart).arg(offset));
+            }
+
+            QJsonObject entry;
+            entry["index"] = index;
+            entry["type"] = command["type"].toString();
+            entry["chunk"] = chunkIndex;
+            entry["offset"] = offset;
+            entry["completedAt"] = earliest;
+            commandReports.append(entry);
+        }
+    }
+    if (commandReports.size() != expected.size()) {
+        failures.append(QString("%1 of %2 commands were emitted").arg(commandReports.size()).arg(expected.size()));
+    }
+
+    QJsonObject report;
+    report["stream"] = streamPath;
+    report["chunks"] = chunks.size();
+    report["characters"] = response.size();
+    report["parseUs"] = parseNs / 1000;
+    report["commands"] = commandReports;
+    if (!commandReports.isEmpty() && !response.isEmpty()) {
+        // Share of the response that had to arrive before the first command could run
+        report["firstCommandFraction"] = commandReports.first()["offset"].toDouble() / response.size();
+    }
+    report["failures"] = QJsonArray::fromStringList(failures);
+
+    QTextStream summary(stderr);
+    summary << commandReports.size() << " commands from " << chunks.size() << " chunks, parse time "
+            << parseNs / 1000 << " us\n";
+    for (const QString& failure : failures) {
+        summary << "FAIL " << failure << '\n';
+    }
+
+    return writeReport(report, outputPath) && failures.isEmpty() ? 0 : 1;
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    // QApplication rather than QGuiApplication: parts of the editor look up
+    // the application object as a QApplication
+    QApplication app(argc, argv);
+    app.setApplicationName("cubit-benchmarks");
+    app.setOrganizationName("Cubit");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Headless performance benchmarks for Cubit");
+    parser.addHelpOption();
+    const QCommandLineOption elementsOption("elements", "Design elements to generate.", "count", "2000");
+    const QCommandLineOption depthOption("depth", "Frame nesting depth below each root.", "levels", "3");
+    const QCommandLineOption childrenOption("children", "Children per frame.", "count", "4");
+    const QCommandLineOption scriptNodesOption("script-nodes", "Script nodes to chain.", "count", "100");
+    const QCommandLineOption iterationsOption("iterations", "Timed iterations per benchmark.", "count", "20");
+    const QCommandLineOption filterOption("filter", "Only run benchmarks whose name contains this.", "text");
+    const QCommandLineOption outputOption("output", "Write JSON results to this file instead of stdout.", "file");
+    const QCommandLineOption seedOption("seed", "Seed for the generated layout.", "seed", "1");
+    const QCommandLineOption verboseOption("verbose", "Show the application's debug output.");
+    const QCommandLineOption traceOption("trace", "Record a Chrome trace of the run into this file.", "file");
+    const QCommandLineOption replayOption("replay", "Replay a recorded input session instead of benchmarking.", "file");
+    const QCommandLineOption maxSpeedOption("max-speed", "Replay without the recorded gaps between events.");
+    const QCommandLineOption replayStreamOption("replay-stream", "Replay a captured AI response through the command stream parser.", "file");
+    const QCommandLineOption chunkSizeOption("chunk-size", "Characters per chunk when the captured response is plain text.", "count", "16");
+    parser.addOptions({elementsOption, depthOption, childrenOption, scriptNodesOption,
+                       iterationsOption, filterOption, outputOption, seedOption, verboseOption,
+                       traceOption, replayOption, maxSpeedOption, replayStreamOption, chunkSizeOption});
+    parser.process(app);
+
+    s_verbose = parser.isSet(verboseOption);
+    qInstallMessageHandler(messageHandler);
+
+    ElementTypeRegistry::instance().initializeDefaultTypes();
+    PropertyTypeMapper::instance()->loadMappings(":/data/src/property-types.json");
+
+    // Trace points add a little time to every traced call, so timings taken
+    // with --trace are not comparable to those without
+    if (parser.isSet(traceOption)) {
+        PerformanceTrace::setEnabled(true);
+    }
+
+    if (parser.isSet(replayStreamOption)) {
+        return replayStream(parser.value(replayStreamOption), std::max(1, parser.value(chunkSizeOption).toInt()),
+                            parser.value(outputOption));
+    }
+
+    if (parser.isSet(replayOption)) {
+        Application application;
+        const int result = replaySession(&application, parser.value(replayOption),
+                                         parser.isSet(maxSpeedOption), parser.value(outputOption));
+        if (parser.isSet(traceOption)) {
+            PerformanceTrace::writeChromeTrace(parser.value(traceOption));
+        }
+        return result;
+    }
+
+    SyntheticProjectOptions options;
+    options.elementCount = std::max(1, parser.value(elementsOption).toInt());
+    options.depth = std::max(0, parser.value(depthOption).toInt());
+    options.childrenPerFrame = std::max(1, parser.value(childrenOption).toInt());
+    options.scriptNodes = std::max(0, parser.value(scriptNodesOption).toInt());
+    options.seed = parser.value(seedOption).toUInt();
+
+    Application application;
+    SyntheticProject synthetic(&application, options);
+    Project* project = synthetic.project();
+    if (!project) {
+        return 1;
+    }
+
+    ElementModel* model = project->elementModel();
+    HitTestService* hitTest = project->controller()->hitTestService();
+    const QList<Element*>& elements = synthetic.elements();
+    const QRectF bounds = synthetic.bounds();
+
+    // Query positions are drawn from a fixed sequence so runs are comparable
+    QRandomGenerator random(options.seed);
+    std::vector<QPointF> points(1000);
+    for (QPointF& point : points) {
+        point = QPointF(bounds.x() + random.bounded(bounds.width()),
+                        bounds.y() + random.bounded(bounds.height()));
+    }
+    std::vector<QRectF> rects(100);
+    for (QRectF& rect : rects) {
+        rect = QRectF(bounds.x() + random.bounded(bounds.width()),
+                      bounds.y() + random.bounded(bounds.height()),
+                      50 + random.bounded(400.0), 50 + random.bounded(400.0));
+    }
+
+    BenchmarkRunner runner(parser.value(iterationsOption).toInt(), parser.value(filterOption));
+    volatile qsizetype sink = 0;
+
+    // Element model
+
+    runner.run("elementModel/getElementById", [&](int) {
+        for (Element* element : elements) {
+            sink = sink + (model->getElementById(element->getId()) != nullptr);
+        }
+    });
+
+    runner.run("elementModel/getDirectChildren", [&](int) {
+        for (Element* element : elements) {
+            sink = sink + model->getDirectChildren(element->getId()).size();
+        }
+    });
+
+    runner.run("elementModel/isDescendantOf", [&](int) {
+        const Element* ancestor = elements.first();
+        for (Element* element : elements) {
+            sink = sink + model->isDescendantOf(element, ancestor);
+        }
+    });
+
+    // Moves a leaf between two roots, then asks an ancestry question, so each
+    // iteration pays for renumbering the tree once. The leaf goes back to its
+    // own parent afterwards, so the later benchmarks see the generated tree
+    Element* reparentedLeaf = elements.last();
+    const QString leafParentId = reparentedLeaf->getParentElementId();
+    runner.run("elementModel/reparentAndQuery", [&](int iteration) {
+        const QString target = iteration % 2 == 0 ? elements.first()->getId() : QString();
+        reparentedLeaf->setParentElementId(target);
+        sink = sink + model->isDescendantOf(reparentedLeaf, elements.first());
+    });
+    reparentedLeaf->setParentElementId(leafParentId);
+
+    // Spatial index
+
+    const std::vector<Element*> elementVector(elements.begin(), elements.end());
+
+    runner.run("quadTree/insertEach", [&](int) {
+        QuadTree tree(bounds.adjusted(-100, -100, 100, 100));
+        for (Element* element : elements) {
+            sink = sink + tree.insert(element);
+        }
+    });
+
+    runner.run("quadTree/rebuild", [&](int) {
+        QuadTree tree(bounds.adjusted(-100, -100, 100, 100));
+        tree.rebuild(elementVector);
+        sink = sink + tree.getBounds().isValid();
+    });
+
+    QuadTree quadTree(bounds.adjusted(-100, -100, 100, 100));
+    for (Element* element : elements) {
+        quadTree.insert(element);
+    }
+    std::vector<Element*> buffer;
+
+    runner.run("quadTree/queryPoint", [&](int) {
+        for (const QPointF& point : points) {
+            quadTree.query(point, buffer);
+            sink = sink + buffer.size();
+        }
+    });
+
+    runner.run("quadTree/queryRect", [&](int) {
+        for (const QRectF& rect : rects) {
+            quadTree.query(rect, buffer);
+            sink = sink + buffer.size();
+        }
+    });
+
+    // Hit testing
+
+    runner.run("hitTest/rebuildSpatialIndex", [&](int) {
+        hitTest->rebuildSpatialIndex();
+    });
+
+    runner.run("hitTest/hitTest", [&](int) {
+        for (const QPointF& point : points) {
+            sink = sink + (hitTest->hitTest(point) != nullptr);
+        }
+    });
+
+    runner.run("hitTest/hitTestForHover", [&](int) {
+        for (const QPointF& point : points) {
+            sink = sink + (hitTest->hitTestForHover(point) != nullptr);
+        }
+    });
+
+    runner.run("hitTest/elementsInRect", [&](int) {
+        for (const QRectF& rect : rects) {
+            hitTest->elementsInRect(rect, buffer);
+            sink = sink + buffer.size();
+        }
+    });
+
+    // Snapping, with the whole project in view
+
+    SnappingService snapping;
+    snapping.setHitTestService(hitTest);
+
+    runner.run("snapping/buildIndex", [&](int) {
+        snapping.beginSession({elements.last()});
+        sink = sink + snapping.snap(rects.front(), SnappingService::AllEdges, bounds, 1.0).guides.size();
+    });
+
+    runner.run("snapping/snapMove", [&](int) {
+        for (const QRectF& rect : rects) {
+            sink = sink + snapping.snap(rect, SnappingService::AllEdges, bounds, 1.0).guides.size();
+        }
+    });
+
+    runner.run("snapping/snapResize", [&](int) {
+        for (const QRectF& rect : rects) {
+            sink = sink + snapping.snap(rect, SnappingService::RightEdge | SnappingService::BottomEdge,
+                                        bounds, 1.0).guides.size();
+        }
+    });
+    snapping.endSession();
+
+    // Layout
+
+    FlexLayoutEngine layoutEngine;
+    runner.run("flexLayout/layoutChildren", [&](int) {
+        for (Frame* frame : synthetic.flexFrames()) {
+            layoutEngine.layoutChildren(frame, model);
+        }
+    });
+
+    // Serialization
+
+    runner.run("serializer/serializeProject", [&](int) {
+        sink = sink + application.serializeProjectData(project).size();
+    });
+
+    const QJsonObject projectData = application.serializeProjectData(project);
+    runner.run("serializer/roundTrip", [&](int) {
+        std::unique_ptr<Project> copy(application.deserializeProjectFromData(projectData));
+        sink = sink + (copy != nullptr);
+    });
+
+    // Scripts
+
+    Scripts* scripts = project->scripts();
+    ScriptCompiler compiler;
+    runner.run("scriptCompiler/compile", [&](int) {
+        compiler.clearCache();
+        sink = sink + compiler.compile(scripts, model).size();
+    });
+
+    // An edit to the last node of the chain; only its event is recompiled
+    const QSet<QString> changedNodes = synthetic.scriptNodeIds().isEmpty()
+        ? QSet<QString>() : QSet<QString>{synthetic.scriptNodeIds().last()};
+    runner.run("scriptCompiler/compileChanged", [&](int) {
+        sink = sink + compiler.compileChanged(scripts, changedNodes, model).size();
+    }, [&](int) {
+        compiler.compile(scripts, model);
+    });
+
+    // executeEvent compiles on first use; do it before timing starts
+    scripts->compile(model, project->console());
+    ScriptExecutor executor(project);
+    executor.setScripts(scripts);
+    executor.setElementModel(model);
+    executor.setCanvasController(project->controller());
+    runner.run("scriptExecutor/executeEvent", [&](int) {
+        executor.executeEvent("onEditorLoad");
+    }, [&](int) {
+        project->console()->clearMessages();
+    });
+
+    QJsonObject config;
+    config["elements"] = elements.size();
+    config["depth"] = options.depth;
+    config["children"] = options.childrenPerFrame;
+    config["scriptNodes"] = options.scriptNodes;
+    config["iterations"] = parser.value(iterationsOption).toInt();
+    config["seed"] = static_cast<qint64>(options.seed);
+
+    QJsonObject report;
+    report["config"] = config;
+    report["results"] = runner.results();
+    if (!writeReport(report, parser.value(outputOption))) {
+        return 1;
+    }
+
+    if (parser.isSet(traceOption)) {
+        PerformanceTrace::writeChromeTrace(parser.value(traceOption));
+    }
+
+    QTextStream summary(stderr);
+    runner.printSummary(summary);
+
+    // Hover and marquee queries reuse their buffers once warm and must not
+    // allocate. Trace points allocate while tracing, so skip the check then
+    const QStringList allocationFree = {
+        "quadTree/queryPoint", "quadTree/queryRect",
+        "hitTest/hitTest", "hitTest/hitTestForHover", "hitTest/elementsInRect"
+    };
+    int allocating = 0;
+    if (!parser.isSet(traceOption)) {
+        for (const QJsonValue& value : report["results"].toArray()) {
+            const QJsonObject result = value.toObject();
+            if (allocationFree.contains(result["name"].toString()) && result["allocations"].toDouble() > 0) {
+                summary << result["name"].toString() << " allocates " << result["allocations"].toDouble()
+                        << " times per run; it should not allocate\n";
+                ++allocating;
+            }
+        }
+    }
+    return allocating > 0 ? 1 : 0;
+}
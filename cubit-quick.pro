@@ -34,190 +34,14 @@ CONFIG(debug, debug|release) {
     }
 }
 
-SOURCES += \
-    src/main.cpp \
-    src/Element.cpp \
-    src/CanvasElement.cpp \
-    src/Component.cpp \
-    src/DesignElement.cpp \
-    src/ScriptElement.cpp \
-    src/Frame.cpp \
-    src/Text.cpp \
-    src/platforms/web/WebTextInput.cpp \
-    src/Shape.cpp \
-    src/Variable.cpp \
-    src/Node.cpp \
-    src/Edge.cpp \
-    src/CanvasController.cpp \
-    src/DesignCanvas.cpp \
-    src/ElementModel.cpp \
-    src/SelectionManager.cpp \
-    src/ViewportCache.cpp \
-    src/ConsoleMessageRepository.cpp \
-    src/Application.cpp \
-    src/Project.cpp \
-    src/Panels.cpp \
-    src/Scripts.cpp \
-    src/CreationManager.cpp \
-    src/HitTestService.cpp \
-    src/JsonImporter.cpp \
-    src/ElementTypeRegistry.cpp \
-    src/QuadTree.cpp \
-    src/Command.cpp \
-    src/CommandHistory.cpp \
-    src/commands/CreateDesignElementCommand.cpp \
-    src/commands/CreateScriptElementCommand.cpp \
-    src/commands/CreateVariableCommand.cpp \
-    src/commands/CompileScriptsCommand.cpp \
-    src/commands/CreateProjectCommand.cpp \
-    src/commands/OpenProjectCommand.cpp \
-    src/commands/DeleteElementsCommand.cpp \
-    src/commands/DeleteProjectCommand.cpp \
-    src/commands/MoveElementsCommand.cpp \
-    src/commands/ResizeElementCommand.cpp \
-    src/commands/SetPropertyCommand.cpp \
-    src/commands/ChangeParentCommand.cpp \
-    src/commands/CloseProjectCommand.cpp \
-    src/commands/CreateComponentCommand.cpp \
-    src/commands/CreateInstanceCommand.cpp \
-    src/commands/DetachComponentCommand.cpp \
-    src/commands/AssignVariableCommand.cpp \
-    src/commands/AddPlatformCommand.cpp \
-    src/ScriptCompiler.cpp \
-    src/ScriptExecutor.cpp \
-    src/ScriptGraphValidator.cpp \
-    src/ScriptInvokeBuilder.cpp \
-    src/ScriptFunctionRegistry.cpp \
-    src/ScriptSerializer.cpp \
-    src/SelectModeHandler.cpp \
-    src/CreationModeHandler.cpp \
-    src/PenModeHandler.cpp \
-    src/ElementFilterProxy.cpp \
-    src/FlexLayoutEngine.cpp \
-    src/PrototypeController.cpp \
-    src/GoogleFonts.cpp \
-    src/DesignControlsController.cpp \
-    src/ShapeControlsController.cpp \
-    src/AuthenticationManager.cpp \
-    src/UrlSchemeHandler.cpp \
-    src/StreamingAIClient.cpp \
-    src/AICommandDispatcher.cpp \
-    src/ProjectApiClient.cpp \
-    src/FileManager.cpp \
-    src/Serializer.cpp \
-    src/PlatformConfig.cpp \
-    src/CanvasContext.cpp \
-    src/contexts/MainCanvasContext.cpp \
-    src/contexts/ScriptCanvasContext.cpp \
-    src/PropertyRegistry.cpp \
-    src/PropertyTypeMapper.cpp \
-    src/ThrottledUpdate.cpp \
-    src/AdaptiveThrottler.cpp \
-    src/AIService.cpp \
-    src/VariableBinding.cpp
+include(src/src.pri)
 
-HEADERS += \
-    src/Element.h \
-    src/FlexLayoutEngine.h \
-    src/CanvasElement.h \
-    src/Component.h \
-    src/DesignElement.h \
-    src/ScriptElement.h \
-    src/Frame.h \
-    src/Text.h \
-    src/platforms/web/WebTextInput.h \
-    src/Shape.h \
-    src/Variable.h \
-    src/BoxShadow.h \
-    src/ComponentTemplates.h \
-    src/ConnectionManager.h \
-    src/PropertySyncer.h \
-    src/PropertyCopier.h \
-    src/Node.h \
-    src/Edge.h \
-    src/CanvasController.h \
-    src/DesignCanvas.h \
-    src/ElementModel.h \
-    src/SelectionManager.h \
-    src/Config.h \
-    src/UniqueIdGenerator.h \
-    src/HandleType.h \
-    src/ViewportCache.h \
-    src/ConsoleMessageRepository.h \
-    src/Application.h \
-    src/Project.h \
-    src/Panels.h \
-    src/Scripts.h \
-    src/CreationManager.h \
-    src/HitTestService.h \
-    src/JsonImporter.h \
-    src/PropertyDefinition.h \
-    src/ElementTypeRegistry.h \
-    src/ElementTemplates.h \
-    src/QuadTree.h \
-    src/Command.h \
-    src/CommandHistory.h \
-    src/commands/CreateDesignElementCommand.h \
-    src/commands/CreateScriptElementCommand.h \
-    src/commands/CreateVariableCommand.h \
-    src/commands/CompileScriptsCommand.h \
-    src/commands/CreateProjectCommand.h \
-    src/commands/OpenProjectCommand.h \
-    src/commands/DeleteElementsCommand.h \
-    src/commands/DeleteProjectCommand.h \
-    src/commands/MoveElementsCommand.h \
-    src/commands/ResizeElementCommand.h \
-    src/commands/SetPropertyCommand.h \
-    src/commands/ChangeParentCommand.h \
-    src/commands/CloseProjectCommand.h \
-    src/commands/CreateComponentCommand.h \
-    src/commands/CreateInstanceCommand.h \
-    src/commands/DetachComponentCommand.h \
-    src/commands/AssignVariableCommand.h \
-    src/commands/AddPlatformCommand.h \
-    src/ScriptCompiler.h \
-    src/ScriptExecutor.h \
-    src/ScriptGraphValidator.h \
-    src/ScriptInvokeBuilder.h \
-    src/ScriptFunctionRegistry.h \
-    src/ScriptSerializer.h \
-    src/IModeHandler.h \
-    src/SelectModeHandler.h \
-    src/CreationModeHandler.h \
-    src/PenModeHandler.h \
-    src/ElementFilterProxy.h \
-    src/PrototypeController.h \
-    src/GoogleFonts.h \
-    src/DesignControlsController.h \
-    src/ShapeControlsController.h \
-    src/AuthenticationManager.h \
-    src/UrlSchemeHandler.h \
-    src/StreamingAIClient.h \
-    src/AICommandDispatcher.h \
-    src/ProjectApiClient.h \
-    src/FileManager.h \
-    src/Serializer.h \
-    src/PlatformConfig.h \
-    src/CanvasContext.h \
-    src/contexts/MainCanvasContext.h \
-    src/contexts/ScriptCanvasContext.h \
-    src/PropertyRegistry.h \
-    src/PropertyTypeMapper.h \
-    src/PropertyMetadata.h \
-    src/ThrottledUpdate.h \
-    src/AdaptiveThrottler.h \
-    src/ConfigObject.h \
-    src/AIService.h \
-    src/VariableBinding.h
+SOURCES += \
+    src/main.cpp
 
 RESOURCES += qml.qrc \
              data.qrc
 
-# Add include paths for better organization
-INCLUDEPATH += src
-INCLUDEPATH += src/platforms/web
-INCLUDEPATH += src/contexts
-
 # Additional import path used to resolve QML modules in Qt Creator's code model
 QML_IMPORT_PATH =
 
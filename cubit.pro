@@ -0,0 +1,14 @@
+# Top-level project: the application and the headless benchmarks, which
+# compile the same sources (src/src.pri), so a change that breaks one shows
+# up in the other.
+#
+#   qmake cubit.pro && make
+#
+# cubit-quick.pro on its own still builds just the application.
+
+TEMPLATE = subdirs
+
+SUBDIRS = app benchmarks
+
+app.file = cubit-quick.pro
+benchmarks.file = benchmarks/benchmarks.pro
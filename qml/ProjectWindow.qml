@@ -2,6 +2,7 @@ import QtQuick
 import QtQuick.Window
 import QtQuick.Controls
 import QtQuick.Layouts
+import QtQuick.Dialogs
 import Cubit
 
 ApplicationWindow {
@@ -27,6 +28,27 @@ ApplicationWindow {
                     Application.saveAs()
                 }
             }
+            MenuSeparator { }
+            MenuItem {
+                text: qsTr("Record Input Session")
+                checkable: true
+                enabled: canvas && canvas.controller
+                checked: canvas && canvas.controller ? canvas.controller.inputRecorder.recording : false
+                onTriggered: {
+                    if (checked) {
+                        canvas.controller.inputRecorder.start()
+                    } else {
+                        canvas.controller.inputRecorder.stop()
+                    }
+                }
+            }
+            MenuItem {
+                text: qsTr("Save Input Session...")
+                enabled: canvas && canvas.controller && !canvas.controller.inputRecorder.recording
+                onTriggered: {
+                    saveInputSessionDialog.open()
+                }
+            }
         }
         Menu {
             title: qsTr("Edit")
@@ -476,6 +498,20 @@ ApplicationWindow {
         }
     }
     
+    FileDialog {
+        id: saveInputSessionDialog
+        title: "Save Input Session"
+        nameFilters: ["Cubit Input Sessions (*.cbir)"]
+        fileMode: FileDialog.SaveFile
+        defaultSuffix: "cbir"
+        
+        onAccepted: {
+            if (canvas && canvas.controller) {
+                canvas.controller.inputRecorder.save(selectedFile)
+            }
+        }
+    }
+    
     // Handle window closing
     onClosing: {
         // Future: Handle unsaved changes, cleanup, etc.
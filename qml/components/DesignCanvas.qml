@@ -154,6 +154,10 @@ BaseCanvas {
             canvasMinX: root.canvasMinX
             canvasMinY: root.canvasMinY
             canvas: root.canvas
+            viewportRect: Qt.rect(root.flickable.contentX / root.zoom + root.canvasMinX,
+                                  root.flickable.contentY / root.zoom + root.canvasMinY,
+                                  root.flickable.width / root.zoom,
+                                  root.flickable.height / root.zoom)
         },
         
         // Hover highlight overlay
@@ -288,6 +292,28 @@ BaseCanvas {
         }
     }
     
+    // Report scrolling and zoom to an active input recording; the controller
+    // only sees canvas coordinates
+    Connections {
+        target: root.flickable
+        enabled: root.controller !== null && root.controller.inputRecorder.recording
+        function onContentXChanged() { root.recordViewport() }
+        function onContentYChanged() { root.recordViewport() }
+    }
+    
+    Connections {
+        target: root.controller ? root.controller.inputRecorder : null
+        function onRecordingChanged() { root.recordViewport() }
+    }
+    
+    onZoomChanged: recordViewport()
+    
+    function recordViewport() {
+        if (root.controller && root.controller.inputRecorder.recording) {
+            root.controller.inputRecorder.recordViewport(root.flickable.contentX, root.flickable.contentY, root.zoom)
+        }
+    }
+    
     // Watch for mode changes to clear preview
     Connections {
         target: root.controller
@@ -13,6 +13,8 @@ Item {
     required property real canvasMinX
     required property real canvasMinY
     property var canvas: null  // Will be set by parent
+    // Visible canvas area in canvas coordinates; only elements near it get delegates
+    property rect viewportRect: Qt.rect(0, 0, 0, 0)
     
     onCanvasChanged: {
         // Connect the HitTestService when canvas is set
@@ -50,18 +52,25 @@ Item {
         }
     }
     
-    // Element rendering - only render root elements (no parent)
+    // Root elements near the viewport, in z-order - children are handled by their parents
+    VisibleElementsModel {
+        id: visibleModel
+        elementModel: root.elementModel || null
+        hitTestService: root.canvas && root.canvas.controller ? root.canvas.controller.hitTestService : null
+        filterProxy: filteredModel
+        viewport: root.viewportRect
+    }
+    
+    // Element rendering - only on-screen root elements hold live items
     Repeater {
         id: elementRepeater
-        model: filteredModel
+        model: visibleModel
         
         delegate: Loader {
             property var element: model.element
             property string elementType: model.elementType
-            property string elementParentId: element ? element.parentId : ""
             
-            // Only render root elements - children are handled by their parents
-            active: elementParentId === ""
+            active: element !== null && element !== undefined
             
             // Position elements relative to canvas origin
             x: element && active ? element.x - root.canvasMinX : 0
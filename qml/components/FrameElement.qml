@@ -112,15 +112,17 @@ Item {
             
             // Render child elements
             Repeater {
-                model: root.elementModel
+                // Only this frame's direct children, in z-order
+                model: ChildrenProxyModel {
+                    elementModel: root.elementModel
+                    parentId: root.element ? root.element.elementId : ""
+                }
                 
                 delegate: Loader {
                     property var childElement: model.element
                     property string childElementType: model.elementType
-                    property string childParentId: childElement ? childElement.parentId : ""
                     
-                    // Only render elements that are children of this frame
-                    active: childParentId === root.element.elementId
+                    active: childElement !== null && childElement !== undefined
                     
                     // Position child elements relative to parent
                     x: childElement && active ? childElement.x - root.element.x : 0
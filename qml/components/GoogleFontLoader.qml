@@ -6,6 +6,7 @@ Item {
     
     property string fontFamily: ""
     property string fontWeight: "regular"
+    property int priority: GoogleFonts.NormalPriority
     property bool isLoaded: false
     
     signal loaded()
@@ -37,7 +38,7 @@ Item {
         }
         
         // Load the font with specific weight
-        GoogleFonts.loadFont(fontFamily, fontWeight)
+        GoogleFonts.loadFont(fontFamily, fontWeight, priority)
     }
     
     Connections {
@@ -50,27 +50,10 @@ BaseCanvas {
         }
     }
     
-    // Timer to update edges during node dragging
-    Timer {
-        id: edgeUpdateTimer
-        interval: ConfigObject.throttleInterval  // Use global throttle interval
-        repeat: true
-        running: isNodeDragging
-        onTriggered: {
-            // Force re-evaluation of all edge bindings
-            edgesLayer.visible = false
-            edgesLayer.visible = true
-        }
-    }
-    
     // Function to force update all edges
     function updateAllEdges() {
-        // Force all edge delegates to update by triggering a model refresh
-        if (elementModel) {
-            // This will cause all delegates to re-evaluate their bindings
-            elementModel.dataChanged(elementModel.index(0, 0), 
-                                   elementModel.index(elementModel.rowCount() - 1, 0))
-        }
+        // Recompute every edge's port positions; node moves already update their own edges
+        edgesModel.updateAllEndpoints()
     }
     
     
@@ -191,190 +174,17 @@ BaseCanvas {
             
             Repeater {
                 id: edgesRepeater
-                model: root.elementModel
+                model: EdgesModel {
+                    id: edgesModel
+                    scripts: root.canvas ? root.canvas.activeScripts : null
+                }
                 
                 delegate: Item {
                     id: edgeDelegate
-                    visible: model.elementType === "Edge"
-                    property var edge: model.element
-                    property var edgeObj: edge as Edge
-                    
-                    // Get source and target nodes - dynamically look them up
-                    property var sourceNode: {
-                        if (model.elementType !== "Edge" || !edgeObj || !root.elementModel) return null
-                        // Force re-evaluation when dragging
-                        var dummy = root.isNodeDragging
-                        return root.elementModel.getElementById(edgeObj.sourceNodeId)
-                    }
-                    property var targetNode: {
-                        if (model.elementType !== "Edge" || !edgeObj || !root.elementModel) return null
-                        // Force re-evaluation when dragging
-                        var dummy = root.isNodeDragging
-                        return root.elementModel.getElementById(edgeObj.targetNodeId)
-                    }
-                    
-                    // Watch for source/target node changes and update positions
-                    onSourceNodeChanged: {
-                        if (sourceNode) {
-                            Qt.callLater(updateEdgePositions)
-                        } else {
-                        }
-                    }
-                    
-                    onTargetNodeChanged: {
-                        if (targetNode) {
-                            Qt.callLater(updateEdgePositions)
-                        } else {
-                        }
-                    }
-                    
-                    // Connect to node position changes
-                    Connections {
-                        target: sourceNode
-                        enabled: sourceNode !== null && model.elementType === "Edge"
-                        function onXChanged() {
-                            updateEdgePositions()
-                        }
-                        function onYChanged() {
-                            updateEdgePositions()
-                        }
-                        function onWidthChanged() {
-                            updateEdgePositions()
-                        }
-                        function onHeightChanged() {
-                            updateEdgePositions()
-                        }
-                    }
-                    
-                    Connections {
-                        target: targetNode
-                        enabled: targetNode !== null && model.elementType === "Edge"
-                        function onXChanged() {
-                            updateEdgePositions()
-                        }
-                        function onYChanged() {
-                            updateEdgePositions()
-                        }
-                        function onWidthChanged() {
-                            updateEdgePositions()
-                        }
-                        function onHeightChanged() {
-                            updateEdgePositions()
-                        }
-                    }
-                    
-                    function updateEdgePositions() {
-                        // Always refresh node references when updating
-                        var currentSourceNode = sourceNode
-                        var currentTargetNode = targetNode
-                        
-                        if (!edgeObj) {
-                            console.log("updateEdgePositions: edgeObj is null!")
-                            return
-                        }
-                        
-                        if (!currentSourceNode) {
-                            console.log("updateEdgePositions: sourceNode is null for edge", edgeObj.elementId, 
-                                       "sourceNodeId:", edgeObj.sourceNodeId)
-                            return
-                        }
-                        
-                        if (!currentTargetNode) {
-                            console.log("updateEdgePositions: targetNode is null for edge", edgeObj.elementId,
-                                       "targetNodeId:", edgeObj.targetNodeId)
-                            return
-                        }
-                        
-                        
-                        var sourceX, sourceY
-                        
-                        // Special handling for Variable nodes as source
-                        if (currentSourceNode.nodeType === "Variable") {
-                            sourceX = currentSourceNode.x + currentSourceNode.width - 15  // 5px margin + 10px to center
-                            sourceY = currentSourceNode.y + 15  // Center of 30px header
-                        } else {
-                            var titleAndMargins = 30 + 15  // Title height + margins
-                            var columnsMargin = 10  // Left/right margin of columns container
-                            var columnSpacing = 20  // Spacing between columns
-                            
-                            // Check if this is a flow port (index -1)
-                            if (edgeObj.sourcePortIndex === -1) {
-                                // Flow ports are positioned at the top right, in the first row of the sources column
-                                // Handle is 20x20, anchored to right edge, vertically centered in 30px row
-                                sourceX = currentSourceNode.x + currentSourceNode.width - 10 - 10  // right edge - right margin - half handle width
-                                sourceY = currentSourceNode.y + 30 + 15 + 15  // header + top margin + half row height
-                            } else {
-                                // Find the source port index in the sources column
-                                var sourceIndex = 0
-                                var foundSource = false
-                                for (var i = 0; i < currentSourceNode.rowConfigurations.length; i++) {
-                                    var config = currentSourceNode.rowConfigurations[i]
-                                    if (config.hasSource) {
-                                        if (config.sourcePortIndex === edgeObj.sourcePortIndex) {
-                                            foundSource = true
-                                            break
-                                        }
-                                        sourceIndex++
-                                    }
-                                }
-                                
-                                if (!foundSource) {
-                                    console.log("updateEdgePositions: Could not find source port", edgeObj.sourcePortIndex, "in node", currentSourceNode.nodeTitle)
-                                    return
-                                }
-                                
-                                // Calculate source point (right column, right side)
-                                var columnWidth = (currentSourceNode.width - 2 * columnsMargin - columnSpacing) / 2
-                                var rightColumnX = currentSourceNode.x + columnsMargin + columnWidth + columnSpacing
-                                sourceX = rightColumnX + columnWidth - 10  // 10px from right edge to center
-                                sourceY = currentSourceNode.y + titleAndMargins + sourceIndex * 40 + 15  // center of 30px item
-                            }
-                        }
-                        
-                        // Find the target port index in the targets column
-                        var titleAndMargins = 30 + 15  // Title height + margins
-                        var columnsMargin = 10  // Left/right margin of columns container
-                        
-                        // Check if this is a flow port (index -1)
-                        if (edgeObj.targetPortIndex === -1) {
-                            // Flow ports are positioned at the top left, in the first row of the targets column
-                            // Handle is 20x20, anchored to left edge, vertically centered in 30px row
-                            var targetX = currentTargetNode.x + 10 + 10  // left edge + left margin + half handle width
-                            var targetY = currentTargetNode.y + 30 + 15 + 15  // header + top margin + half row height
-                        } else {
-                            var targetIndex = 0
-                            var foundTarget = false
-                            for (var j = 0; j < currentTargetNode.rowConfigurations.length; j++) {
-                                var targetConfig = currentTargetNode.rowConfigurations[j]
-                                if (targetConfig.hasTarget) {
-                                    if (targetConfig.targetPortIndex === edgeObj.targetPortIndex) {
-                                        foundTarget = true
-                                        break
-                                    }
-                                    targetIndex++
-                                }
-                            }
-                            
-                            if (!foundTarget) {
-                                console.log("updateEdgePositions: Could not find target port", edgeObj.targetPortIndex, "in node", currentTargetNode.nodeTitle)
-                                return
-                            }
-                            
-                            // Calculate target point (left column, left side)
-                            var targetX = currentTargetNode.x + columnsMargin + 10  // 10px to center of 20px handle
-                            var targetY = currentTargetNode.y + titleAndMargins + targetIndex * 40 + 15
-                        }
-                        
-                        // Update the edge points
-                        edgeObj.sourcePoint = Qt.point(sourceX, sourceY)
-                        edgeObj.targetPoint = Qt.point(targetX, targetY)
-                    }
-                    
-                    Component.onCompleted: {
-                        if (model.elementType === "Edge") {
-                            updateEdgePositions()
-                        }
-                    }
+                    property var edgeObj: model.element as Edge
+                    // Endpoint nodes and port positions are resolved by EdgesModel
+                    property var sourceNode: model.sourceNode
+                    property var targetNode: model.targetNode
                     
                     // Bezier curve using BezierEdge component
                     BezierEdge {
@@ -415,7 +225,10 @@ BaseCanvas {
         // Nodes layer
         Repeater {
             id: nodeRepeater
-            model: root.elementModel
+            model: NodesModel {
+                id: nodesModel
+                scripts: root.canvas ? root.canvas.activeScripts : null
+            }
             
             delegate: Loader {
                 property var element: model.element
@@ -426,14 +239,7 @@ BaseCanvas {
                 y: element ? element.y - root.canvasMinY : 0
                 z: 1
                 
-                sourceComponent: {
-                    if (!element || !elementType) return null
-                    switch(elementType) {
-                        case "Node": return nodeComponent
-                        case "Edge": return null  // Edges are handled separately
-                        default: return null
-                    }
-                }
+                sourceComponent: element ? nodeComponent : null
                 
                 onLoaded: {
                     if (item && element) {
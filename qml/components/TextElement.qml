@@ -33,6 +33,7 @@ Item {
     GoogleFontLoader {
         id: fontLoader
         fontFamily: textElement ? textElement.font.family : ""
+        priority: GoogleFonts.ViewportPriority
         fontWeight: {
             if (!textElement || !textElement.font) return "regular"
             
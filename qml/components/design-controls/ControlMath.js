@@ -37,4 +37,25 @@ function mapToCanvas(parent, point, zoom, flickable, canvasMin) {
         (flickable.contentX + globalPoint.x) / zoom + canvasMin.x,
         (flickable.contentY + globalPoint.y) / zoom + canvasMin.y
     );
-}
\ No newline at end of file
+}
+
+// SnappingService edge flags for the sides a drag moves
+const SNAP_LEFT = 0x1;
+const SNAP_TOP = 0x2;
+const SNAP_RIGHT = 0x4;
+const SNAP_BOTTOM = 0x8;
+
+function snapEdgesFor(dragMode) {
+    switch (dragMode) {
+        case "move": return SNAP_LEFT | SNAP_TOP | SNAP_RIGHT | SNAP_BOTTOM;
+        case "resize-edge-0": return SNAP_TOP;
+        case "resize-edge-1": return SNAP_RIGHT;
+        case "resize-edge-2": return SNAP_BOTTOM;
+        case "resize-edge-3": return SNAP_LEFT;
+        case "resize-corner-0": return SNAP_LEFT | SNAP_TOP;
+        case "resize-corner-1": return SNAP_RIGHT | SNAP_TOP;
+        case "resize-corner-2": return SNAP_RIGHT | SNAP_BOTTOM;
+        case "resize-corner-3": return SNAP_LEFT | SNAP_BOTTOM;
+        default: return 0;
+    }
+}
@@ -70,6 +70,11 @@ Item {
     property real dragStartRotation: 0
     property point lastMousePosition: Qt.point(0, 0)
     
+    // Snap guides for the drag in progress, as {x1, y1, x2, y2} lines in
+    // canvas coordinates
+    property var snapGuides: []
+    property var snapSpacings: []
+    
     
     // Signal to notify about mouse position during drag
     signal mouseDragged(point viewportPos)
@@ -105,6 +110,43 @@ Item {
         }
     }
     
+    // Canvas area currently shown in the viewport
+    function visibleCanvasRect() {
+        var viewport = root.parent
+        var flickable = viewport ? viewport.flickable : null
+        if (!flickable || !viewport.zoomLevel) {
+            return Qt.rect(0, 0, 0, 0)
+        }
+        return Qt.rect(flickable.contentX / viewport.zoomLevel + viewport.canvasMinX,
+                       flickable.contentY / viewport.zoomLevel + viewport.canvasMinY,
+                       flickable.width / viewport.zoomLevel,
+                       flickable.height / viewport.zoomLevel)
+    }
+    
+    // Snap a proposed control rect to the elements around it for the current
+    // drag mode; rotated and flipped controls are left as they are
+    function snapControlRect(rect) {
+        var edges = CM.snapEdgesFor(root.dragMode)
+        if (!root.designControlsController || edges === 0 || root.controlRotation !== 0 ||
+            rect.width <= 0 || rect.height <= 0) {
+            root.snapGuides = []
+            root.snapSpacings = []
+            return rect
+        }
+        
+        var result = root.designControlsController.snapRect(rect, edges, visibleCanvasRect(), root.parent.zoomLevel)
+        root.snapGuides = result.guides
+        root.snapSpacings = result.spacings
+        return result.rect
+    }
+    
+    onDraggingChanged: {
+        if (!dragging) {
+            snapGuides = []
+            snapSpacings = []
+        }
+    }
+    
     // Throttled update component for move operations
     ThrottledUpdate {
         id: moveThrottle
@@ -112,9 +154,11 @@ Item {
         active: root.dragging && root.dragMode === "move"
         
         onUpdate: (data) => {
-            // Update control position in canvas coordinates
-            root.controlX = data.x
-            root.controlY = data.y
+            // Update control position in canvas coordinates, snapped to the
+            // elements around it
+            var snapped = root.snapControlRect(Qt.rect(data.x, data.y, root.controlWidth, root.controlHeight))
+            root.controlX = snapped.x
+            root.controlY = snapped.y
             
             // Check for reordering if dragging a position relative child in a flex parent
             checkForReordering(data.mousePos)
@@ -131,11 +175,12 @@ Item {
         active: root.dragging && root.dragMode.startsWith("resize-edge-")
         
         onUpdate: (data) => {
-            // Update control dimensions and position
-            root.controlWidth = data.width
-            root.controlHeight = data.height
-            root.controlX = data.x
-            root.controlY = data.y
+            // Update control dimensions and position, snapping the dragged sides
+            var snapped = root.snapControlRect(Qt.rect(data.x, data.y, data.width, data.height))
+            root.controlWidth = snapped.width
+            root.controlHeight = snapped.height
+            root.controlX = snapped.x
+            root.controlY = snapped.y
         }
     }
     
@@ -146,11 +191,12 @@ Item {
         active: root.dragging && root.dragMode.startsWith("resize-corner-")
         
         onUpdate: (data) => {
-            // Update control dimensions and position
-            root.controlWidth = data.width
-            root.controlHeight = data.height
-            root.controlX = data.x
-            root.controlY = data.y
+            // Update control dimensions and position, snapping the dragged sides
+            var snapped = root.snapControlRect(Qt.rect(data.x, data.y, data.width, data.height))
+            root.controlWidth = snapped.width
+            root.controlHeight = snapped.height
+            root.controlX = snapped.x
+            root.controlY = snapped.y
         }
     }
     
@@ -172,7 +218,7 @@ Item {
             
             // Store initial state for command creation via DesignControlsController
             if (root.designControlsController) {
-                root.designControlsController.startDragOperation()
+                root.designControlsController.startDragOperation(Qt.rect(root.controlX, root.controlY, root.controlWidth, root.controlHeight))
             }
             
             // Reset the drag threshold exceeded flag
@@ -395,7 +441,7 @@ Item {
                 
                 // Store initial state for command creation via DesignControlsController
                 if (root.designControlsController) {
-                    root.designControlsController.startDragOperation()
+                    root.designControlsController.startDragOperation(Qt.rect(root.controlX, root.controlY, root.controlWidth, root.controlHeight))
                 }
                 
                 // Initialize mouse position
@@ -721,7 +767,7 @@ Item {
                 
                 // Store initial state for command creation via DesignControlsController
                 if (root.designControlsController) {
-                    root.designControlsController.startDragOperation()
+                    root.designControlsController.startDragOperation(Qt.rect(root.controlX, root.controlY, root.controlWidth, root.controlHeight))
                 }
                 
                 // Initialize mouse position
@@ -1174,92 +1220,17 @@ Item {
             return // Only handle single selection for now
         }
         
-        var draggedElement = parent.selectedElements[0]
-        if (!draggedElement || draggedElement.elementType !== "Frame" || draggedElement.position !== 0) {
-            return // Only reorder position relative frames
-        }
-        
-        // Check if parent has flex enabled
-        if (!parent.canvasView || !parent.canvasView.elementModel) {
+        if (!root.designControlsController) {
             return
         }
         
-        var parentElement = parent.canvasView.elementModel.getElementById(draggedElement.parentId)
-        if (!parentElement || parentElement.elementType !== "Frame" || !parentElement.flex) {
-            return // Parent must be a flex container
-        }
-        
         // Convert mouse position to canvas coordinates
         var canvasX = (mouseInParent.x + (parent.flickable?.contentX ?? 0)) / parent.zoomLevel + parent.canvasMinX
         var canvasY = (mouseInParent.y + (parent.flickable?.contentY ?? 0)) / parent.zoomLevel + parent.canvasMinY
         
-        // Get all siblings (children of the same parent)
-        var siblings = []
-        var allElements = parent.canvasView.elementModel.getAllElements()
-        for (var i = 0; i < allElements.length; i++) {
-            var element = allElements[i]
-            if (element.parentId === draggedElement.parentId && 
-                element.elementId !== draggedElement.elementId &&
-                element.elementType === "Frame" &&
-                element.position === 0) { // Only position relative siblings
-                siblings.push(element)
-            }
-        }
-        
-        if (siblings.length === 0) {
-            return // No siblings to reorder with
-        }
-        
-        // Find which sibling we're hovering over
-        var hoveredSibling = null
-        var hoveredIndex = -1
-        var draggedIndex = allElements.indexOf(draggedElement)
-        
-        for (var j = 0; j < siblings.length; j++) {
-            var sibling = siblings[j]
-            if (canvasX >= sibling.x && canvasX <= sibling.x + sibling.width &&
-                canvasY >= sibling.y && canvasY <= sibling.y + sibling.height) {
-                hoveredSibling = sibling
-                hoveredIndex = allElements.indexOf(sibling)
-                break
-            }
-        }
-        
-        if (!hoveredSibling || hoveredIndex === -1) {
-            return // Not hovering over a sibling
-        }
-        
-        // Determine the new index based on the layout direction and mouse position
-        var newIndex = hoveredIndex
-        
-        if (parentElement.orientation === 0) { // Row layout
-            // Check if mouse is in the right half of the hovered sibling
-            if (canvasX > hoveredSibling.x + hoveredSibling.width / 2) {
-                // Insert after the hovered sibling
-                newIndex = hoveredIndex > draggedIndex ? hoveredIndex : hoveredIndex + 1
-            } else {
-                // Insert before the hovered sibling
-                newIndex = hoveredIndex < draggedIndex ? hoveredIndex : hoveredIndex - 1
-            }
-        } else { // Column layout
-            // Check if mouse is in the bottom half of the hovered sibling
-            if (canvasY > hoveredSibling.y + hoveredSibling.height / 2) {
-                // Insert after the hovered sibling
-                newIndex = hoveredIndex > draggedIndex ? hoveredIndex : hoveredIndex + 1
-            } else {
-                // Insert before the hovered sibling
-                newIndex = hoveredIndex < draggedIndex ? hoveredIndex : hoveredIndex - 1
-            }
-        }
-        
-        // Perform the reorder if the index changed
-        if (newIndex !== draggedIndex && newIndex >= 0 && newIndex < allElements.length) {
-            parent.canvasView.elementModel.reorderElement(draggedElement, newIndex)
-            
-            // Trigger layout update on the parent frame
-            // The Frame's own layout engine will handle the update
-            parentElement.triggerLayout()
-        }
+        // The controller finds the slot among the flex siblings, moves the
+        // element there and relayouts the parent frame
+        root.designControlsController.reorderInFlexParent(parent.selectedElements[0], Qt.point(canvasX, canvasY))
     }
     
     // Add Variant Button - shown when a single element with isVariant=true is selected
@@ -58,7 +58,7 @@ FocusScope {
             
             ListView {
                 id: listView
-                model: root.repository ? root.repository.messages : []
+                model: root.repository
                 clip: true
                 
                 // Remove focus when clicking on the list
@@ -91,8 +91,8 @@ FocusScope {
                 delegate: Rectangle {
                     width: listView.width
                     height: messageText.implicitHeight + 16
-                    color: modelData.type === "error" ? "#fff0f0" : 
-                           modelData.type === "input" ? "#f0f8ff" : 
+                    color: model.type === "error" ? "#fff0f0" : 
+                           model.type === "input" ? "#f0f8ff" : 
                            "#ffffff"
                     
                     RowLayout {
@@ -101,7 +101,7 @@ FocusScope {
                         spacing: 8
                         
                         Label {
-                            text: modelData.timestamp
+                            text: model.timestamp
                             font.pixelSize: 11
                             color: "#888888"
                             Layout.preferredWidth: 60
@@ -109,11 +109,11 @@ FocusScope {
                         
                         Label {
                             id: messageText
-                            text: modelData.text
+                            text: model.text
                             font.pixelSize: 13
                             font.family: Qt.platform.os === "osx" ? "Menlo" : (Qt.platform.os === "windows" ? "Consolas" : "DejaVu Sans Mono")
-                            color: modelData.type === "error" ? "#cc0000" : 
-                                   modelData.type === "input" ? "#0066cc" : 
+                            color: model.type === "error" ? "#cc0000" : 
+                                   model.type === "input" ? "#0066cc" : 
                                    "#333333"
                             wrapMode: Text.Wrap
                             Layout.fillWidth: true
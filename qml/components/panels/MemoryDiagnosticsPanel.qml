@@ -0,0 +1,143 @@
+import QtQuick
+import QtQuick.Controls
+import QtQuick.Layouts
+import QtQuick.Dialogs
+import Cubit
+
+// Per-subsystem memory estimates from MemoryDiagnostics, largest first
+ApplicationWindow {
+    id: root
+    title: qsTr("Memory Diagnostics")
+    width: 560
+    height: 420
+    minimumWidth: 420
+    minimumHeight: 240
+
+    property var rows: []
+    property real totalBytes: 0
+
+    function refresh() {
+        var sample = MemoryDiagnostics.sample()
+        sample.sort(function(a, b) { return b.bytes - a.bytes })
+        var total = 0
+        for (var i = 0; i < sample.length; i++) {
+            total += sample[i].bytes
+        }
+        rows = sample
+        totalBytes = total
+    }
+
+    function formatBytes(bytes) {
+        if (bytes >= 1048576) return (bytes / 1048576).toFixed(1) + " MB"
+        if (bytes >= 1024) return (bytes / 1024).toFixed(1) + " KB"
+        return bytes + " B"
+    }
+
+    onVisibleChanged: {
+        if (visible) refresh()
+    }
+
+    // Sampling walks every element, so only refresh while the panel is shown
+    Timer {
+        interval: 2000
+        repeat: true
+        running: root.visible && autoRefreshBox.checked
+        onTriggered: root.refresh()
+    }
+
+    ColumnLayout {
+        anchors.fill: parent
+        anchors.margins: 12
+        spacing: 8
+
+        RowLayout {
+            Layout.fillWidth: true
+            spacing: 8
+
+            Button {
+                text: qsTr("Refresh")
+                onClicked: root.refresh()
+            }
+
+            CheckBox {
+                id: autoRefreshBox
+                text: qsTr("Auto refresh")
+            }
+
+            CheckBox {
+                text: qsTr("Log every 10 s")
+                checked: MemoryDiagnostics.logInterval > 0
+                onToggled: MemoryDiagnostics.logInterval = checked ? 10000 : 0
+            }
+
+            Item { Layout.fillWidth: true }
+
+            Button {
+                text: qsTr("Save JSON...")
+                onClicked: saveDialog.open()
+            }
+        }
+
+        // Column headers
+        RowLayout {
+            Layout.fillWidth: true
+            spacing: 8
+
+            Label { text: qsTr("Project"); font.bold: true; Layout.preferredWidth: 160 }
+            Label { text: qsTr("Subsystem"); font.bold: true; Layout.fillWidth: true }
+            Label { text: qsTr("Size"); font.bold: true; Layout.preferredWidth: 90; horizontalAlignment: Text.AlignRight }
+            Label { text: qsTr("Objects"); font.bold: true; Layout.preferredWidth: 80; horizontalAlignment: Text.AlignRight }
+        }
+
+        ListView {
+            Layout.fillWidth: true
+            Layout.fillHeight: true
+            clip: true
+            model: root.rows
+
+            delegate: RowLayout {
+                width: ListView.view.width
+                spacing: 8
+
+                Label {
+                    text: modelData.projectId === "" ? qsTr("(application)") : modelData.project
+                    elide: Text.ElideRight
+                    Layout.preferredWidth: 160
+                }
+                Label {
+                    text: modelData.hitRate === undefined
+                          ? modelData.subsystem
+                          : qsTr("%1 (%2% hits)").arg(modelData.subsystem).arg((modelData.hitRate * 100).toFixed(1))
+                    Layout.fillWidth: true
+                }
+                Label {
+                    text: root.formatBytes(modelData.bytes)
+                    Layout.preferredWidth: 90
+                    horizontalAlignment: Text.AlignRight
+                }
+                Label {
+                    text: modelData.objects
+                    Layout.preferredWidth: 80
+                    horizontalAlignment: Text.AlignRight
+                }
+            }
+        }
+
+        Label {
+            text: qsTr("Total (estimated): %1").arg(root.formatBytes(root.totalBytes))
+            font.bold: true
+        }
+    }
+
+    FileDialog {
+        id: saveDialog
+        title: qsTr("Save Memory Report")
+        nameFilters: ["JSON Files (*.json)"]
+        fileMode: FileDialog.SaveFile
+        defaultSuffix: "json"
+
+        onAccepted: {
+            MemoryDiagnostics.writeJson(selectedFile)
+        }
+    }
+}
@@ -193,6 +193,27 @@ PropertyGroup {
                 return uniqueWeights.length > 0 ? uniqueWeights : ["Normal"]
             }
         },
+        {
+            name: "Resizing",
+            type: "combobox",
+            getter: () => {
+                if (selectedElement && selectedElement.autoSize !== undefined) {
+                    switch (selectedElement.autoSize) {
+                        case 1: return "Auto Width"
+                        case 2: return "Auto Height"
+                        default: return "Fixed"
+                    }
+                }
+                return "Fixed"
+            },
+            setter: v => {
+                if (selectedElement && selectedElement.autoSize !== undefined) {
+                    const index = ["Fixed", "Auto Width", "Auto Height"].indexOf(v)
+                    selectedElement.autoSize = index >= 0 ? index : 0
+                }
+            },
+            model: () => ["Fixed", "Auto Width", "Auto Height"]
+        },
         {
             name: "Box Shadow",
             type: "property_popover",
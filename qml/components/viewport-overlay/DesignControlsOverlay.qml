@@ -234,13 +234,6 @@ Item {
             height = Math.abs(controlHeight) * zoomLevel
         }
         
-        // Track initial states when drag starts
-        property var initialElementStates: []
-        property real initialControlX: 0
-        property real initialControlY: 0
-        property real initialControlWidth: 0
-        property real initialControlHeight: 0
-        
         // Watch for dragMode changes
         onDragModeChanged: {
             // Update isResizing when dragMode changes during active drag
@@ -271,7 +264,6 @@ Item {
         
         onDraggingChanged: {
             if (dragging) {
-                captureInitialStates()
                 // Set isResizing on the canvas when starting resize drag
                 if (canvasView && (dragMode.startsWith("resize-") || dragMode === "resize")) {
                     canvasView.isResizing = true
@@ -285,7 +277,6 @@ Item {
                     controlHeight = selectionBoundingHeight
                 }
                 
-                initialElementStates = []
                 updateViewportPosition() // Ensure position is correct after drag
                 // Clear isResizing on the canvas when ending drag
                 if (canvasView) {
@@ -301,244 +292,15 @@ Item {
         onControlHeightChanged: if (dragging) updateElements()
         onControlRotationChanged: if (dragging) updateElements()
         
-        function captureInitialStates() {
-            // Store initial control bounds
-            initialControlX = controlX
-            initialControlY = controlY
-            initialControlWidth = controlWidth
-            initialControlHeight = controlHeight
-            
-            var states = []
-            var parentElementsToCapture = {} // Track parent elements we need to capture
-            
-            for (var i = 0; i < selectedElements.length; i++) {
-                var element = selectedElements[i]
-                states.push({
-                    element: element,
-                    x: element.x,
-                    y: element.y,
-                    width: element.width,
-                    height: element.height
-                })
-                
-                // Check if this is a relatively positioned child in a flex parent
-                // Only capture parent state during resize operations, not move operations
-                if (dragMode.startsWith("resize") && element.elementType === "Frame" && element.position === 0 && element.parentId) { // 0 = Relative
-                    // We'll need to capture the parent's state too for resize operations
-                    parentElementsToCapture[element.parentId] = true
-                }
-                
-                // Also capture children of this element
-                if (canvasView && canvasView.elementModel) {
-                    var children = canvasView.elementModel.getChildrenRecursive(element.elementId)
-                    for (var j = 0; j < children.length; j++) {
-                        var child = children[j]
-                        if (child && child.x !== undefined) {
-                            states.push({
-                                element: child,
-                                x: child.x,
-                                y: child.y,
-                                width: child.width,
-                                height: child.height
-                            })
-                        }
-                    }
-                }
-            }
-            
-            // Now capture parent elements that we identified
-            if (canvasView && canvasView.elementModel) {
-                for (var parentId in parentElementsToCapture) {
-                    var parentElement = canvasView.elementModel.getElementById(parentId)
-                    if (parentElement && parentElement.elementType === "Frame" && parentElement.flex) {
-                        // Check if we haven't already captured this parent
-                        var alreadyCaptured = false
-                        for (var k = 0; k < states.length; k++) {
-                            if (states[k].element.elementId === parentId) {
-                                alreadyCaptured = true
-                                break
-                            }
-                        }
-                        
-                        if (!alreadyCaptured) {
-                            states.push({
-                                element: parentElement,
-                                x: parentElement.x,
-                                y: parentElement.y,
-                                width: parentElement.width,
-                                height: parentElement.height
-                            })
-                        }
-                    }
-                }
-            }
-            initialElementStates = states
-        }
-        
+        // The dragged elements follow the controls through the controller,
+        // which captured their starting geometry in startDragOperation
         function updateElements() {
-            if (initialElementStates.length === 0) return
+            if (!designControlsController) return
             
             if (dragMode === "move") {
-                // Simple translation
-                var deltaX = controlX - initialControlX
-                var deltaY = controlY - initialControlY
-                
-                for (var i = 0; i < initialElementStates.length; i++) {
-                    var state = initialElementStates[i]
-                    // Check if element is controlled
-                    if (state.element.elementType === "Frame" && !state.element.controlled) {
-                        continue // Skip uncontrolled frames
-                    }
-                    
-                    // Check if element is a relatively positioned child in a flex parent
-                    var isRelativeChildInFlexParent = false
-                    if (state.element.elementType === "Frame" && state.element.position === 0) { // 0 = Relative
-                        // Check if parent has flex enabled
-                        if (canvasView && canvasView.elementModel) {
-                            var parentElement = canvasView.elementModel.getElementById(state.element.parentId)
-                            if (parentElement && parentElement.elementType === "Frame" && parentElement.flex) {
-                                isRelativeChildInFlexParent = true
-                            }
-                        }
-                    }
-                    
-                    // Skip moving relatively positioned children in flex parents
-                    if (isRelativeChildInFlexParent) {
-                        continue
-                    }
-                    
-                    state.element.x = state.x + deltaX
-                    state.element.y = state.y + deltaY
-                }
+                designControlsController.updateMoveOperation(Qt.point(controlX, controlY))
             } else if (dragMode.startsWith("resize")) {
-                // Calculate scale factors from initial control size
-                var scaleX = controlWidth / initialControlWidth
-                var scaleY = controlHeight / initialControlHeight
-                
-                // Use absolute values for scaling calculations
-                var absScaleX = Math.abs(scaleX)
-                var absScaleY = Math.abs(scaleY)
-                
-                // Determine if we need to flip
-                var flipX = scaleX < 0
-                var flipY = scaleY < 0
-                
-                // Create a set of selected element IDs for quick lookup
-                var selectedIds = {}
-                for (var j = 0; j < selectedElements.length; j++) {
-                    selectedIds[selectedElements[j].elementId] = true
-                }
-                
-                for (var i = 0; i < initialElementStates.length; i++) {
-                    var state = initialElementStates[i]
-                    var isDirectlySelected = selectedIds[state.element.elementId] === true
-                    
-                    // Check if element is a Frame with controlled=false
-                    var isFrame = state.element.elementType === "Frame"
-                    if (isFrame && !state.element.controlled) {
-                        continue // Skip uncontrolled frames
-                    }
-                    
-                    // Check if element is a relatively positioned child in a flex parent
-                    var isRelativeChildInFlexParent = false
-                    var parentElement = null
-                    if (isFrame && state.element.position === 0) { // 0 = Relative
-                        // Check if parent has flex enabled
-                        if (canvasView && canvasView.elementModel) {
-                            parentElement = canvasView.elementModel.getElementById(state.element.parentId)
-                        }
-                        if (parentElement && parentElement.elementType === "Frame" && parentElement.flex) {
-                            isRelativeChildInFlexParent = true
-                        }
-                    }
-                    
-                    // Calculate relative position within initial control bounds
-                    var relX = state.x - initialControlX
-                    var relY = state.y - initialControlY
-                    
-                    if (isDirectlySelected && !isRelativeChildInFlexParent) {
-                        // For directly selected elements, apply scaling
-                        var newWidth = Math.max(1, state.width * absScaleX)
-                        var newHeight = Math.max(1, state.height * absScaleY)
-                        
-                        // Calculate new position
-                        var newX, newY
-                        
-                        if (flipX) {
-                            // Flip horizontally: mirror around the center
-                            newX = controlX + Math.abs(controlWidth) - (relX + state.width) * absScaleX
-                        } else {
-                            // Normal positioning
-                            newX = controlX + relX * absScaleX
-                        }
-                        
-                        if (flipY) {
-                            // Flip vertically: mirror around the center
-                            newY = controlY + Math.abs(controlHeight) - (relY + state.height) * absScaleY
-                        } else {
-                            // Normal positioning
-                            newY = controlY + relY * absScaleY
-                        }
-                        
-                        // Update element
-                        state.element.x = newX
-                        state.element.y = newY
-                        state.element.width = newWidth
-                        state.element.height = newHeight
-                    } else if (isDirectlySelected && isRelativeChildInFlexParent && parentElement) {
-                        // For relatively positioned children in flex parents, resize the child
-                        // Only resize the parent if its width/height type is set to "fit content"
-                        
-                        // Calculate the drag distance (difference between new and old control size)
-                        var widthDelta = controlWidth - initialControlWidth
-                        var heightDelta = controlHeight - initialControlHeight
-                        
-                        // First, resize the child by the drag distance
-                        var newChildWidth = Math.max(1, state.width + widthDelta)
-                        var newChildHeight = Math.max(1, state.height + heightDelta)
-                        state.element.width = newChildWidth
-                        state.element.height = newChildHeight
-                        
-                        // Find the parent's initial state
-                        var parentInitialState = null
-                        for (var k = 0; k < initialElementStates.length; k++) {
-                            if (initialElementStates[k].element.elementId === parentElement.elementId) {
-                                parentInitialState = initialElementStates[k]
-                                break
-                            }
-                        }
-                        
-                        if (parentInitialState) {
-                            // Only resize parent dimensions that are set to "fit content" (SizeFitContent = 3)
-                            var shouldResizeWidth = parentElement.widthType === 3 // SizeFitContent
-                            var shouldResizeHeight = parentElement.heightType === 3 // SizeFitContent
-                            
-                            if (shouldResizeWidth) {
-                                var newParentWidth = Math.max(1, parentInitialState.width + widthDelta)
-                                parentElement.width = newParentWidth
-                            }
-                            
-                            if (shouldResizeHeight) {
-                                var newParentHeight = Math.max(1, parentInitialState.height + heightDelta)
-                                parentElement.height = newParentHeight
-                            }
-                        }
-                        
-                        // The flex layout engine will handle repositioning
-                    } else {
-                        // For child elements, maintain size and adjust position to stay relative to parent's left edge
-                        // Only update position if parent moved (due to resize from left/top)
-                        var deltaX = controlX - initialControlX
-                        var deltaY = controlY - initialControlY
-                        
-                        // Don't move elements with controlled=false
-                        if (!isRelativeChildInFlexParent) {
-                            state.element.x = state.x + deltaX
-                            state.element.y = state.y + deltaY
-                        }
-                        // Don't change width/height for children
-                    }
-                }
+                designControlsController.updateResizeOperation(Qt.rect(controlX, controlY, controlWidth, controlHeight))
             }
             
             // Update viewport position during drag
@@ -546,6 +308,19 @@ Item {
         }
     }
     
+    // Alignment guides for the controls being dragged
+    SnapGuides {
+        anchors.fill: parent
+        visible: selectionControls.visible && selectionControls.dragging
+        guides: selectionControls.snapGuides
+        spacings: selectionControls.snapSpacings
+        flickable: root.flickable
+        zoomLevel: root.zoomLevel
+        canvasMinX: root.canvasMinX
+        canvasMinY: root.canvasMinY
+        z: ConfigObject.zHoverBadge - 1
+    }
+    
     // Hover badge that shows dimensions during resize or rotation angle during rotate (for design and variant canvases)
     Loader {
         id: hoverBadgeLoader
@@ -0,0 +1,79 @@
+import QtQuick
+import Cubit 1.0
+
+// SnapGuides.qml - Alignment and equal spacing guides shown while controls are dragged
+Item {
+    id: root
+
+    // Lines as {x1, y1, x2, y2} in canvas coordinates, from DesignControls
+    property var guides: []
+    property var spacings: []
+
+    // Viewport mapping, passed from DesignControlsOverlay
+    property var flickable
+    property real zoomLevel: 1.0
+    property real canvasMinX: 0
+    property real canvasMinY: 0
+
+    // Length of the end caps on spacing markers
+    property real capSize: 6
+
+    function toViewportX(x) {
+        return (x - canvasMinX) * zoomLevel - (flickable?.contentX ?? 0)
+    }
+
+    function toViewportY(y) {
+        return (y - canvasMinY) * zoomLevel - (flickable?.contentY ?? 0)
+    }
+
+    // Alignment lines
+    Repeater {
+        model: root.guides
+
+        Rectangle {
+            readonly property bool vertical: modelData.x1 === modelData.x2
+
+            x: root.toViewportX(Math.min(modelData.x1, modelData.x2)) - (vertical ? 0.5 : 0)
+            y: root.toViewportY(Math.min(modelData.y1, modelData.y2)) - (vertical ? 0 : 0.5)
+            width: vertical ? 1 : Math.abs(modelData.x2 - modelData.x1) * root.zoomLevel
+            height: vertical ? Math.abs(modelData.y2 - modelData.y1) * root.zoomLevel : 1
+            color: ConfigObject.snapGuideColor
+        }
+    }
+
+    // Equal gaps, each a line with a cap at either end
+    Repeater {
+        model: root.spacings
+
+        Item {
+            readonly property bool vertical: modelData.x1 === modelData.x2
+
+            x: root.toViewportX(Math.min(modelData.x1, modelData.x2)) - (vertical ? root.capSize / 2 : 0)
+            y: root.toViewportY(Math.min(modelData.y1, modelData.y2)) - (vertical ? 0 : root.capSize / 2)
+            width: vertical ? root.capSize : Math.abs(modelData.x2 - modelData.x1) * root.zoomLevel
+            height: vertical ? Math.abs(modelData.y2 - modelData.y1) * root.zoomLevel : root.capSize
+
+            Rectangle {
+                x: parent.vertical ? (parent.width - width) / 2 : 0
+                y: parent.vertical ? 0 : (parent.height - height) / 2
+                width: parent.vertical ? 1 : parent.width
+                height: parent.vertical ? parent.height : 1
+                color: ConfigObject.snapGuideColor
+            }
+
+            Rectangle {
+                width: parent.vertical ? parent.width : 1
+                height: parent.vertical ? 1 : parent.height
+                color: ConfigObject.snapGuideColor
+            }
+
+            Rectangle {
+                x: parent.vertical ? 0 : parent.width - width
+                y: parent.vertical ? parent.height - height : 0
+                width: parent.vertical ? parent.width : 1
+                height: parent.vertical ? 1 : parent.height
+                color: ConfigObject.snapGuideColor
+            }
+        }
+    }
+}
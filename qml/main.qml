@@ -34,6 +34,28 @@ ApplicationWindow {
                     Application.saveAs()
                 }
             }
+            MenuSeparator { }
+            MenuItem {
+                text: qsTr("Record Performance Trace")
+                checkable: true
+                checked: ConfigObject.tracingEnabled
+                onTriggered: {
+                    ConfigObject.tracingEnabled = checked
+                }
+            }
+            MenuItem {
+                text: qsTr("Save Performance Trace...")
+                onTriggered: {
+                    saveTraceDialog.open()
+                }
+            }
+            MenuItem {
+                text: qsTr("Memory Diagnostics...")
+                onTriggered: {
+                    memoryDiagnosticsPanel.show()
+                    memoryDiagnosticsPanel.raise()
+                }
+            }
         }
     }
     
@@ -49,6 +71,11 @@ ApplicationWindow {
     ProjectList {
         anchors.fill: parent
     }
+    
+    MemoryDiagnosticsPanel {
+        id: memoryDiagnosticsPanel
+        visible: false
+    }
     // Note: PropertyPopoverPanel and its components have been moved to CanvasScreen
     
     // Authentication overlay - covers entire window when not authenticated
@@ -254,6 +281,18 @@ ApplicationWindow {
         }
     }
     
+    FileDialog {
+        id: saveTraceDialog
+        title: "Save Performance Trace"
+        nameFilters: ["Chrome Trace Files (*.json)"]
+        fileMode: FileDialog.SaveFile
+        defaultSuffix: "json"
+        
+        onAccepted: {
+            ConfigObject.saveTrace(selectedFile)
+        }
+    }
+    
     FileDialog {
         id: openFileDialog
         title: "Open Project"
@@ -1,6 +1,7 @@
 #include "AICommandDispatcher.h"
 #include "Application.h"
 #include "CanvasController.h"
+#include "CommandHistory.h"
 #include "HitTestService.h"
 #include "ElementModel.h"
 #include "SelectionManager.h"
@@ -15,16 +16,22 @@
 #include "commands/SetPropertyCommand.h"
 #include "Project.h"
 #include "UniqueIdGenerator.h"
+#include "ProjectSyncQueue.h"
 #include <QJsonDocument>
 #include <QJsonValue>
 #include <QDebug>
 #include <QUuid>
-#include <QCoreApplication>
 #include <QColor>
+#include <QTimer>
+#include <utility>
 
 AICommandDispatcher::AICommandDispatcher(Application *app, QObject *parent)
     : QObject(parent), m_application(app)
 {
+    m_drainTimer = new QTimer(this);
+    m_drainTimer->setSingleShot(true);
+    m_drainTimer->setInterval(0);
+    connect(m_drainTimer, &QTimer::timeout, this, &AICommandDispatcher::drainStream);
 }
 
 void AICommandDispatcher::setTargetProject(Project* project)
@@ -88,85 +95,150 @@ void AICommandDispatcher::executeCommands(const QJsonArray &commands)
 {
     // Keep track of newly created elements in this batch
     QMap<QString, QString> tempIdMapping; // temp ID -> actual ID
-    bool hasCreatedElements = false;
 
+    beginBatch(commands.size());
     for (int i = 0; i < commands.size(); ++i)
     {
         const QJsonValue &value = commands[i];
         if (!value.isObject())
             continue;
 
-        QJsonObject command = value.toObject();
-        
-        // Track if we're creating elements
-        QString type = command["type"].toString();
-        if (type == "createElement") {
-            hasCreatedElements = true;
-        }
+        executeWithTempIds(value.toObject(), tempIdMapping);
+    }
+    endBatch();
+}
+
+void AICommandDispatcher::beginStream()
+{
+    // Finish anything still queued from the previous stream under its own mapping
+    if (!m_streamQueue.isEmpty()) {
+        drainStream();
+    }
+    m_streamTempIds.clear();
+    m_streamKey = QUuid::createUuid().toString(QUuid::WithoutBraces);
+    m_streamEnding = false;
+}
 
-        // Replace any temp IDs in the command with actual IDs
-        if (command.contains("elementId"))
+void AICommandDispatcher::enqueueCommand(const QJsonObject &command)
+{
+    m_streamQueue.append(command);
+    if (!m_drainTimer->isActive()) {
+        m_drainTimer->start();
+    }
+}
+
+void AICommandDispatcher::endStream()
+{
+    m_streamEnding = true;
+    if (!m_drainTimer->isActive()) {
+        m_drainTimer->start();
+    }
+}
+
+void AICommandDispatcher::drainStream()
+{
+    m_drainTimer->stop();
+
+    if (!m_streamQueue.isEmpty())
+    {
+        // Everything that arrived since the last pass runs as one batch; batches
+        // of the same stream fold into a single undo step
+        const QList<QJsonObject> commands = std::exchange(m_streamQueue, {});
+        beginBatch(commands.size(), m_streamKey);
+        for (const QJsonObject &command : commands)
         {
-            QString elementId = command["elementId"].toString();
-            if (tempIdMapping.contains(elementId))
-            {
-                qDebug() << "Replacing tempId" << elementId << "with actual ID" << tempIdMapping[elementId];
-                command["elementId"] = tempIdMapping[elementId];
-            }
-            else
-            {
-                qDebug() << "ElementId" << elementId << "not found in tempIdMapping. Available mappings:" << tempIdMapping.keys();
-            }
+            executeWithTempIds(command, m_streamTempIds);
         }
+        endBatch();
+    }
 
-        if (command.contains("params"))
-        {
-            QJsonObject params = command["params"].toObject();
-            if (params.contains("parentId"))
-            {
-                QString parentId = params["parentId"].toString();
-                if (tempIdMapping.contains(parentId))
-                {
-                    params["parentId"] = tempIdMapping[parentId];
-                }
-            }
-            command["params"] = params;
+    if (m_streamEnding) {
+        m_streamKey.clear();
+        m_streamEnding = false;
+    }
+}
+
+void AICommandDispatcher::beginBatch(int commandCount, const QString &mergeKey)
+{
+    m_batchController = activeController();
+    if (m_batchController) {
+        m_batchController->commandHistory()->beginMacro(
+            QString("AI: %1 commands").arg(commandCount), mergeKey);
+        if (m_batchController->hitTestService()) {
+            m_batchController->hitTestService()->beginBatch();
+        }
+    }
+
+    m_batchSyncQueue = m_targetProject ? m_targetProject->syncQueue() : nullptr;
+    if (m_batchSyncQueue) {
+        m_batchSyncQueue->beginBatch();
+    }
+}
+
+void AICommandDispatcher::endBatch()
+{
+    if (m_batchController) {
+        m_batchController->commandHistory()->endMacro();
+        // One index rebuild makes every created element clickable at once
+        if (m_batchController->hitTestService()) {
+            m_batchController->hitTestService()->endBatch();
         }
+    }
+    m_batchController.clear();
 
-        // Execute the command
-        executeCommand(command);
+    if (m_batchSyncQueue) {
+        m_batchSyncQueue->endBatch();
+    }
+    m_batchSyncQueue.clear();
+}
 
-        // If this was a createElement command, capture the created element's ID
-        if (command["type"].toString() == "createElement")
+void AICommandDispatcher::executeWithTempIds(QJsonObject command, QMap<QString, QString> &tempIdMapping)
+{
+    // Replace any temp IDs in the command with actual IDs
+    if (command.contains("elementId"))
+    {
+        QString elementId = command["elementId"].toString();
+        if (tempIdMapping.contains(elementId))
         {
-            // Get the most recently selected element (which should be the one we just created)
-            auto selected = activeSelectionManager()->selectedElements();
-            if (!selected.isEmpty())
-            {
-                Element *createdElement = selected.first();
+            qDebug() << "Replacing tempId" << elementId << "with actual ID" << tempIdMapping[elementId];
+            command["elementId"] = tempIdMapping[elementId];
+        }
+        else
+        {
+            qDebug() << "ElementId" << elementId << "not found in tempIdMapping. Available mappings:" << tempIdMapping.keys();
+        }
+    }
 
-                // If the command had a tempId, map it to the actual ID
-                QJsonObject params = command["params"].toObject();
-                if (params.contains("tempId"))
-                {
-                    QString tempId = params["tempId"].toString();
-                    tempIdMapping[tempId] = createdElement->getId();
-                    qDebug() << "Mapped tempId" << tempId << "to actual ID" << createdElement->getId();
-                }
+    if (command.contains("params"))
+    {
+        QJsonObject params = command["params"].toObject();
+        if (params.contains("parentId"))
+        {
+            QString parentId = params["parentId"].toString();
+            if (tempIdMapping.contains(parentId))
+            {
+                params["parentId"] = tempIdMapping[parentId];
             }
         }
-
-        // Process events to ensure the element is fully registered
-        QCoreApplication::processEvents();
+        command["params"] = params;
     }
-    
-    // If we created any elements, force a spatial index rebuild
-    // This ensures all programmatically created frames are immediately clickable
-    if (hasCreatedElements) {
-        auto controller = activeController();
-        if (controller && controller->hitTestService()) {
-            controller->hitTestService()->rebuildSpatialIndex();
-            qDebug() << "AICommandDispatcher: Forced spatial index rebuild after batch element creation";
+
+    // Execute the command
+    m_lastCreatedId.clear();
+    executeCommand(command);
+
+    // If this was a createElement command, capture the created element's ID
+    if (command["type"].toString() == "createElement")
+    {
+        QString createdId = m_lastCreatedId;
+
+        // If the command had a tempId, map it to the actual ID
+        QJsonObject params = command["params"].toObject();
+        if (!createdId.isEmpty() && params.contains("tempId"))
+        {
+            QString tempId = params["tempId"].toString();
+            tempIdMapping[tempId] = createdId;
+            qDebug() << "Mapped tempId" << tempId << "to actual ID" << createdId;
         }
     }
 }
@@ -190,14 +262,14 @@ void AICommandDispatcher::executeCreateElement(const QJsonObject &command)
 
     if (elementType == "frame")
     {
-        controller->createFrame(QRectF(x, y, width, height));
+        auto command = std::make_unique<CreateDesignElementCommand>(
+            activeElementModel(), activeSelectionManager(), "frame", QRectF(x, y, width, height));
+        CreateDesignElementCommand *create = command.get();
+        controller->commandHistory()->execute(std::move(command));
 
         // Apply additional properties directly from params
-        auto elements = activeSelectionManager()->selectedElements();
-        if (!elements.isEmpty())
+        if (Element *frame = create->element())
         {
-            Element *frame = elements.first();
-
             // Apply properties like fill, backgroundColor, borderColor, etc.
             if (params.contains("fill"))
             {
@@ -219,12 +291,9 @@ void AICommandDispatcher::executeCreateElement(const QJsonObject &command)
             {
                 frame->setProperty("overflow", params["overflow"].toVariant());
             }
-        }
-        
-        // Force spatial index update for single frame creation
-        // This ensures the frame is immediately clickable
-        if (controller->hitTestService()) {
-            controller->hitTestService()->rebuildSpatialIndex();
+
+            m_lastCreatedId = create->elementId();
+            create->creationCompleted();
         }
     }
     else if (elementType == "text")
@@ -257,40 +326,33 @@ void AICommandDispatcher::executeCreateElement(const QJsonObject &command)
                     text = params["text"].toString("New Text");
                 }
 
-                // Create text element with absolute positioning
-                QString textId = UniqueIdGenerator::generate16DigitId();
-                Text *textElement = new Text(textId, activeElementModel());
-                textElement->setContent(text);
-                textElement->setParentElementId(frame->getId());
-
                 // Use absolute coordinates from params
-                double textX = params["x"].toDouble(frame->x());
-                double textY = params["y"].toDouble(frame->y());
-                double textWidth = params["width"].toDouble(frame->width());
-                double textHeight = params["height"].toDouble(30);
-
-                textElement->setX(textX);
-                textElement->setY(textY);
-                textElement->setWidth(textWidth);
-                textElement->setHeight(textHeight);
-
-                qDebug() << "AI creating text element:" << textId
-                         << "at absolute position" << textX << "," << textY
-                         << "inside frame" << frame->getId()
-                         << "which is at" << frame->x() << "," << frame->y();
-
-                // Apply text properties
-                if (params.contains("textSize"))
+                QRectF textRect(params["x"].toDouble(frame->x()),
+                                params["y"].toDouble(frame->y()),
+                                params["width"].toDouble(frame->width()),
+                                params["height"].toDouble(30));
+
+                auto command = std::make_unique<CreateDesignElementCommand>(
+                    activeElementModel(), activeSelectionManager(), "text", textRect, text, frame->getId());
+                CreateDesignElementCommand *create = command.get();
+                controller->commandHistory()->execute(std::move(command));
+
+                if (Element *textElement = create->element())
                 {
-                    textElement->setProperty("textSize", params["textSize"].toVariant());
-                }
+                    qDebug() << "AI creating text element:" << create->elementId()
+                             << "at absolute position" << textRect.x() << "," << textRect.y()
+                             << "inside frame" << frame->getId()
+                             << "which is at" << frame->x() << "," << frame->y();
 
-                activeElementModel()->addElement(textElement);
+                    // Apply text properties
+                    if (params.contains("textSize"))
+                    {
+                        textElement->setProperty("textSize", params["textSize"].toVariant());
+                    }
 
-                // Select the text element temporarily for tempId mapping
-                // This allows executeCommands() to map the text element's tempId to its actual ID
-                activeSelectionManager()->clearSelection();
-                activeSelectionManager()->selectElement(textElement);
+                    m_lastCreatedId = create->elementId();
+                    create->creationCompleted();
+                }
             }
             else
             {
@@ -307,7 +369,7 @@ void AICommandDispatcher::executeCreateElement(const QJsonObject &command)
         // For script canvas elements
         QString nodeType = params["nodeType"].toString("Operation");
         QString nodeTitle = params["nodeTitle"].toString("New Node");
-        controller->createNode(QPointF(x, y), nodeType, nodeTitle);
+        m_lastCreatedId = controller->createNode(QPointF(x, y), nodeType, nodeTitle);
     }
     else if (elementType == "edge")
     {
@@ -316,7 +378,7 @@ void AICommandDispatcher::executeCreateElement(const QJsonObject &command)
         QString targetId = params["targetNodeId"].toString();
         if (!sourceId.isEmpty() && !targetId.isEmpty())
         {
-            controller->createEdge(sourceId, targetId);
+            m_lastCreatedId = controller->createEdge(sourceId, targetId);
         }
         else
         {
@@ -4,6 +4,9 @@
 #include <QObject>
 #include <QJsonObject>
 #include <QJsonArray>
+#include <QList>
+#include <QMap>
+#include <QPointer>
 #include <memory>
 
 class CanvasController;
@@ -11,6 +14,8 @@ class ElementModel;
 class SelectionManager;
 class Application;
 class Project;
+class ProjectSyncQueue;
+class QTimer;
 
 class AICommandDispatcher : public QObject
 {
@@ -28,6 +33,12 @@ public:
     // Execute multiple commands in sequence
     void executeCommands(const QJsonArray& commands);
 
+    // Streamed execution: commands are queued as they arrive and run on the
+    // next event loop pass. Temp IDs resolve across the whole stream.
+    void beginStream();
+    void enqueueCommand(const QJsonObject& command);
+    void endStream();
+
 signals:
     void commandExecuted(const QString& commandType, bool success);
     void commandError(const QString& error);
@@ -44,6 +55,26 @@ private:
     void executeSetProperty(const QJsonObject& params);
     void executeSelectElement(const QJsonObject& params);
     
+    // Streamed execution state
+    QList<QJsonObject> m_streamQueue;
+    QMap<QString, QString> m_streamTempIds;   // temp ID -> actual ID
+    QString m_streamKey;                      // Merges a stream's batches into one undo step
+    bool m_streamEnding = false;
+    QTimer* m_drainTimer = nullptr;
+    void drainStream();
+
+    // Batch mode: one undo step, one spatial index rebuild and one API sync
+    void beginBatch(int commandCount, const QString& mergeKey = QString());
+    void endBatch();
+    QPointer<CanvasController> m_batchController;
+    QPointer<ProjectSyncQueue> m_batchSyncQueue;
+
+    // ID of the element made by the last createElement, for temp ID mapping
+    QString m_lastCreatedId;
+
+    // Execute one command of a batch, resolving and recording temp IDs
+    void executeWithTempIds(QJsonObject command, QMap<QString, QString>& tempIdMapping);
+
     // Helper methods
     CanvasController* activeController() const;
     ElementModel* activeElementModel() const;
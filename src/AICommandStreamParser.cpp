@@ -0,0 +1,192 @@
+#include "AICommandStreamParser.h"
+#include <QJsonDocument>
+#include <QJsonParseError>
+#include <QDebug>
+
+void AICommandStreamParser::reset()
+{
+    *this = AICommandStreamParser();
+}
+
+QList<QJsonObject> AICommandStreamParser::feed(const QString &chunk)
+{
+    QList<QJsonObject> commands;
+
+    for (QChar c : chunk) {
+        switch (m_mode) {
+        case Mode::Outer:
+            feedOuter(c);
+            break;
+        case Mode::CommandsString:
+            feedEscapedString(c, commands);
+            break;
+        case Mode::CommandsArray:
+            feedCommand(c, commands);
+            break;
+        case Mode::Done:
+            return commands;
+        }
+    }
+
+    return commands;
+}
+
+void AICommandStreamParser::feedOuter(QChar c)
+{
+    if (m_outerInString) {
+        if (m_outerEscape) {
+            m_outerEscape = false;
+            m_outerToken += c;
+        } else if (c == '\\') {
+            m_outerEscape = true;
+        } else if (c == '"') {
+            m_outerInString = false;
+            if (m_outerDepth == 1) {
+                m_lastKey = m_outerToken;
+            }
+        } else {
+            m_outerToken += c;
+        }
+        return;
+    }
+
+    switch (c.unicode()) {
+    case '"':
+        if (m_expectValue && m_outerDepth == 1) {
+            m_mode = Mode::CommandsString;
+            return;
+        }
+        m_outerInString = true;
+        m_outerToken.clear();
+        break;
+    case '[':
+        if (m_expectValue && m_outerDepth == 1) {
+            m_mode = Mode::CommandsArray;
+            return;
+        }
+        ++m_outerDepth;
+        break;
+    case '{':
+        ++m_outerDepth;
+        break;
+    case '}':
+    case ']':
+        --m_outerDepth;
+        break;
+    case ':':
+        if (m_outerDepth == 1 && m_lastKey == QLatin1String("commands")) {
+            m_expectValue = true;
+        }
+        break;
+    case ',':
+        m_expectValue = false;
+        m_lastKey.clear();
+        break;
+    default:
+        // Whitespace, prose before the object, or scalar values
+        break;
+    }
+}
+
+void AICommandStreamParser::feedEscapedString(QChar c, QList<QJsonObject> &out)
+{
+    if (m_unicodeActive) {
+        m_unicodeEscape += c;
+        if (m_unicodeEscape.size() == 4) {
+            m_unicodeActive = false;
+            bool ok = false;
+            const ushort code = m_unicodeEscape.toUShort(&ok, 16);
+            if (ok) {
+                feedCommand(QChar(code), out);
+            }
+        }
+        return;
+    }
+
+    if (m_stringEscape) {
+        m_stringEscape = false;
+        switch (c.unicode()) {
+        case 'n': feedCommand(QChar('\n'), out); break;
+        case 't': feedCommand(QChar('\t'), out); break;
+        case 'r': feedCommand(QChar('\r'), out); break;
+        case 'b': feedCommand(QChar('\b'), out); break;
+        case 'f': feedCommand(QChar('\f'), out); break;
+        case 'u':
+            m_unicodeActive = true;
+            m_unicodeEscape.clear();
+            break;
+        default:
+            // \" \\ \/
+            feedCommand(c, out);
+            break;
+        }
+        return;
+    }
+
+    if (c == '\\') {
+        m_stringEscape = true;
+    } else if (c == '"') {
+        // End of the "commands" string
+        m_mode = Mode::Done;
+    } else {
+        feedCommand(c, out);
+    }
+}
+
+void AICommandStreamParser::feedCommand(QChar c, QList<QJsonObject> &out)
+{
+    if (m_depth == 0) {
+        // Between commands: only the start of the next object or the end of the array matter
+        if (c == '{') {
+            m_depth = 1;
+            m_inString = false;
+            m_escape = false;
+            m_current = c;
+        } else if (c == ']' && m_mode == Mode::CommandsArray) {
+            m_mode = Mode::Done;
+        }
+        return;
+    }
+
+    m_current += c;
+
+    if (m_inString) {
+        if (m_escape) {
+            m_escape = false;
+        } else if (c == '\\') {
+            m_escape = true;
+        } else if (c == '"') {
+            m_inString = false;
+        }
+        return;
+    }
+
+    switch (c.unicode()) {
+    case '"':
+        m_inString = true;
+        break;
+    case '{':
+    case '[':
+        ++m_depth;
+        break;
+    case '}':
+    case ']':
+        if (--m_depth == 0) {
+            QJsonParseError error;
+            const QJsonDocument doc = QJsonDocument::fromJson(m_current.toUtf8(), &error);
+            if (error.error == QJsonParseError::NoError && doc.isObject()) {
+                out.append(doc.object());
+                ++m_commandCount;
+            } else {
+                // Stop here so streamed commands stay a prefix of the array; the
+                // full-response parse handles the rest and can request a repair
+                qWarning() << "AICommandStreamParser: malformed command, stopping stream:" << error.errorString();
+                m_mode = Mode::Done;
+            }
+            m_current.clear();
+        }
+        break;
+    default:
+        break;
+    }
+}
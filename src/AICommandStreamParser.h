@@ -0,0 +1,67 @@
+#pragma once
+
+#include <QJsonObject>
+#include <QList>
+#include <QString>
+
+/**
+ * AICommandStreamParser pulls command objects out of an AI response while it
+ * is still streaming in.
+ *
+ * The response has the shape {"message": ..., "commands": "[{...}, ...]", ...}
+ * where "commands" is usually a JSON-encoded string (a plain array is accepted
+ * too). The parser tracks the outer object just far enough to find the
+ * "commands" value, unescapes it on the fly and returns each command object as
+ * soon as its closing brace arrives. Chunks may split anywhere, including in
+ * the middle of an escape sequence.
+ *
+ * It has no I/O of its own, so a recorded stream can be replayed through feed()
+ * chunk by chunk; cubit-benchmarks --replay-stream does this (docs/BENCHMARKS.md).
+ */
+class AICommandStreamParser
+{
+public:
+    /** Forget all state; call before the first chunk of a new response */
+    void reset();
+
+    /** Consume the next chunk and return the commands it completed, in order */
+    QList<QJsonObject> feed(const QString &chunk);
+
+    /** Number of commands returned since the last reset() */
+    int commandCount() const { return m_commandCount; }
+
+private:
+    enum class Mode {
+        Outer,          // Scanning the top-level response object
+        CommandsString, // Inside the "commands" string value
+        CommandsArray,  // Inside a raw "commands" array value
+        Done            // "commands" fully consumed
+    };
+
+    void feedOuter(QChar c);
+    void feedEscapedString(QChar c, QList<QJsonObject> &out);
+    void feedCommand(QChar c, QList<QJsonObject> &out);
+
+    Mode m_mode = Mode::Outer;
+
+    // Outer object scan
+    int m_outerDepth = 0;
+    bool m_outerInString = false;
+    bool m_outerEscape = false;
+    QString m_outerToken;         // Current top-level string
+    QString m_lastKey;            // Last completed top-level string
+    bool m_expectValue = false;   // Saw ':' after the "commands" key
+
+    // JSON string decoding for "commands": "..."
+    bool m_stringEscape = false;
+    QString m_unicodeEscape;      // Hex digits of a pending \uXXXX
+    bool m_unicodeActive = false;
+
+    // Command array scan (on decoded text)
+    int m_depth = 0;
+    bool m_inString = false;
+    bool m_escape = false;
+    QString m_current;            // Text of the command object being read
+
+    int m_commandCount = 0;
+};
@@ -1,4 +1,5 @@
 #include "AIService.h"
+#include "NetworkTransport.h"
 #include <QNetworkRequest>
 #include <QJsonDocument>
 #include <QJsonObject>
@@ -9,7 +10,6 @@ const QString AIService::GRAPHQL_ENDPOINT = "https://enrxjqdgdvc7pkragdib6abhyy.
 
 AIService::AIService(QObject *parent)
     : QObject(parent)
-    , m_networkManager(new QNetworkAccessManager(this))
 {
 }
 
@@ -46,20 +46,13 @@ void AIService::callCubitAI(const QString &prompt, const QString &accessToken)
     request.setRawHeader("Authorization", accessToken.toUtf8());
     
     // Send the request
-    QNetworkReply *reply = m_networkManager->post(request, jsonData);
-    connect(reply, &QNetworkReply::finished, this, &AIService::handleNetworkReply);
-    
+    NetworkTransport::instance()->post(request, jsonData, this,
+                                       [this](QNetworkReply *reply) { handleNetworkReply(reply); },
+                                       NetworkTransport::InteractivePriority);
 }
 
-void AIService::handleNetworkReply()
+void AIService::handleNetworkReply(QNetworkReply *reply)
 {
-    QNetworkReply *reply = qobject_cast<QNetworkReply*>(sender());
-    if (!reply) {
-        return;
-    }
-    
-    reply->deleteLater();
-    
     if (reply->error() != QNetworkReply::NoError) {
         QString errorStr = QString("HTTP Error: %1").arg(reply->errorString());
         qWarning() << "AIService network error:" << errorStr;
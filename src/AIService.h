@@ -2,7 +2,6 @@
 #define AISERVICE_H
 
 #include <QObject>
-#include <QNetworkAccessManager>
 #include <QNetworkReply>
 #include <QJsonObject>
 
@@ -24,11 +23,8 @@ signals:
     // Emitted when an error occurs
     void errorOccurred(const QString &error);
     
-private slots:
-    void handleNetworkReply();
-    
 private:
-    QNetworkAccessManager *m_networkManager;
+    void handleNetworkReply(QNetworkReply *reply);
     
     // GraphQL endpoint
     static const QString GRAPHQL_ENDPOINT;
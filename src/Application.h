@@ -69,6 +69,7 @@ public:
     ProjectApiClient* projectApiClient() const;
     FileManager* fileManager() const;
     Serializer* serializer() const;
+    CommandHistory* commandHistory() const { return m_commandHistory.get(); }
     QQmlApplicationEngine* qmlEngine() const { return m_engine; }
     const std::vector<std::unique_ptr<Project>>& canvases() const { return m_canvases; }
     void addCanvas(Project* project); // For use by Serializer
@@ -1,5 +1,6 @@
 #include "AuthenticationManager.h"
 #include "Config.h"
+#include "NetworkTransport.h"
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QUrlQuery>
@@ -15,7 +16,6 @@
 
 AuthenticationManager::AuthenticationManager(QObject *parent)
     : QObject(parent)
-    , m_networkManager(std::make_unique<QNetworkAccessManager>())
     , m_callbackTimer(new QTimer(this))
 {
     // Configure default values from Config
@@ -172,19 +172,13 @@ void AuthenticationManager::exchangeCodeForToken(const QString& code)
     QNetworkRequest request(tokenUrl);
     request.setHeader(QNetworkRequest::ContentTypeHeader, "application/x-www-form-urlencoded");
     
-    QNetworkReply* reply = m_networkManager->post(request, postData.toString(QUrl::FullyEncoded).toUtf8());
-    connect(reply, &QNetworkReply::finished, this, &AuthenticationManager::handleTokenResponse);
+    NetworkTransport::instance()->post(request, postData.toString(QUrl::FullyEncoded).toUtf8(), this,
+                                       [this](QNetworkReply* reply) { handleTokenResponse(reply); },
+                                       NetworkTransport::InteractivePriority);
 }
 
-void AuthenticationManager::handleTokenResponse()
+void AuthenticationManager::handleTokenResponse(QNetworkReply* reply)
 {
-    QNetworkReply* reply = qobject_cast<QNetworkReply*>(sender());
-    if (!reply) {
-        return;
-    }
-    
-    reply->deleteLater();
-    
     if (reply->error() != QNetworkReply::NoError) {
         setIsLoading(false);
         emit authenticationError(reply->errorString());
@@ -223,19 +217,13 @@ void AuthenticationManager::fetchUserInfo()
     QNetworkRequest request(userInfoUrl);
     request.setRawHeader("Authorization", ("Bearer " + m_accessToken).toUtf8());
     
-    QNetworkReply* reply = m_networkManager->get(request);
-    connect(reply, &QNetworkReply::finished, this, &AuthenticationManager::handleUserInfoResponse);
+    NetworkTransport::instance()->get(request, this,
+                                      [this](QNetworkReply* reply) { handleUserInfoResponse(reply); },
+                                      NetworkTransport::InteractivePriority);
 }
 
-void AuthenticationManager::handleUserInfoResponse()
+void AuthenticationManager::handleUserInfoResponse(QNetworkReply* reply)
 {
-    QNetworkReply* reply = qobject_cast<QNetworkReply*>(sender());
-    if (!reply) {
-        return;
-    }
-    
-    reply->deleteLater();
-    
     if (reply->error() != QNetworkReply::NoError) {
         setIsLoading(false);
         emit authenticationError(reply->errorString());
@@ -394,11 +382,8 @@ void AuthenticationManager::refreshAccessToken() {
     params.addQueryItem("client_id", m_clientId);
     params.addQueryItem("refresh_token", m_refreshToken);
     
-    QNetworkReply* reply = m_networkManager->post(request, params.toString(QUrl::FullyEncoded).toUtf8());
-    
-    connect(reply, &QNetworkReply::finished, this, [this, reply]() {
-        reply->deleteLater();
-        
+    NetworkTransport::instance()->post(request, params.toString(QUrl::FullyEncoded).toUtf8(), this,
+                                       [this](QNetworkReply* reply) {
         if (reply->error() != QNetworkReply::NoError) {
             QString errorString = reply->errorString();
             
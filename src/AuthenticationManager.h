@@ -2,13 +2,11 @@
 #define AUTHENTICATIONMANAGER_H
 
 #include <QObject>
-#include <QNetworkAccessManager>
 #include <QNetworkReply>
 #include <QString>
 #include <QUrl>
 #include <QDesktopServices>
 #include <QTimer>
-#include <memory>
 
 class AuthenticationManager : public QObject
 {
@@ -70,8 +68,6 @@ signals:
     void tokensRefreshed();
 
 private slots:
-    void handleTokenResponse();
-    void handleUserInfoResponse();
     void checkForCallback();
 
 private:
@@ -83,6 +79,8 @@ private:
     // OAuth flow methods
     void exchangeCodeForToken(const QString& code);
     void fetchUserInfo();
+    void handleTokenResponse(QNetworkReply* reply);
+    void handleUserInfoResponse(QNetworkReply* reply);
     void clearAuthData();
     QString generateRandomState();
     
@@ -90,9 +88,6 @@ private:
     void saveTokens();
     void loadTokens();
     
-    // Network manager
-    std::unique_ptr<QNetworkAccessManager> m_networkManager;
-    
     // OAuth configuration
     QString m_clientId;
     QString m_cognitoDomain;
@@ -55,6 +55,7 @@ CanvasController::CanvasController(ElementModel& model,
     m_hitTestService = std::make_unique<HitTestService>(this);
     m_jsonImporter = std::make_unique<JsonImporter>(this);
     m_commandHistory = std::make_unique<CommandHistory>(this);
+    m_inputRecorder = std::make_unique<InputRecorder>(this);
     
     // Set element model and selection manager on subcontrollers
     m_creationManager->setElementModel(&m_elementModel);
@@ -189,6 +190,7 @@ void CanvasController::setMode(Mode mode)
             qWarning() << "No handler found for mode:" << static_cast<int>(mode);
         }
         
+        m_inputRecorder->recordMode(static_cast<int>(mode));
         emit modeChanged();
     }
 }
@@ -223,6 +225,8 @@ Element* CanvasController::hitTestForHover(qreal x, qreal y)
 
 void CanvasController::handleMousePress(qreal x, qreal y)
 {
+    m_inputRecorder->record(InputEvent::Press, x, y);
+    
     // Handle mouse press
     if (m_currentHandler) {
         m_currentHandler->onPress(x, y);
@@ -233,6 +237,7 @@ void CanvasController::handleMousePress(qreal x, qreal y)
 
 void CanvasController::handleMouseMove(qreal x, qreal y)
 {
+    m_inputRecorder->record(InputEvent::Move, x, y);
     if (m_currentHandler) {
         m_currentHandler->onMove(x, y);
     }
@@ -240,6 +245,7 @@ void CanvasController::handleMouseMove(qreal x, qreal y)
 
 void CanvasController::handleMouseRelease(qreal x, qreal y)
 {
+    m_inputRecorder->record(InputEvent::Release, x, y);
     if (m_currentHandler) {
         m_currentHandler->onRelease(x, y);
     }
@@ -247,12 +253,16 @@ void CanvasController::handleMouseRelease(qreal x, qreal y)
 
 void CanvasController::handleEscapeKey()
 {
+    m_inputRecorder->record(InputEvent::EscapeKey);
+    
     // Handle escape key - no longer used for line creation mode
     // Left for other escape functionality if needed
 }
 
 void CanvasController::handleEnterKey()
 {
+    m_inputRecorder->record(InputEvent::EnterKey);
+    
     // Handle enter key - currently only used for pen creation mode
     if (m_mode == Mode::ShapePen) {
         PenModeHandler* penHandler = static_cast<PenModeHandler*>(m_currentHandler);
@@ -274,19 +284,19 @@ void CanvasController::createVariable()
     m_commandHistory->execute(std::move(command));
 }
 
-void CanvasController::createNode(qreal x, qreal y, const QString &title, const QString &color)
+QString CanvasController::createNode(qreal x, qreal y, const QString &title, const QString &color)
 {
     // Get the Project from the ElementModel's parent
     Project* project = qobject_cast<Project*>(m_elementModel.parent());
     if (!project) {
         qWarning() << "CanvasController::createNode - ElementModel has no Project parent";
-        return;
+        return QString();
     }
     
     Scripts* scripts = project->activeScripts();
     if (!scripts) {
         qWarning() << "CanvasController::createNode - No active scripts";
-        return;
+        return QString();
     }
     
     // Create the node using command pattern
@@ -300,11 +310,13 @@ void CanvasController::createNode(qreal x, qreal y, const QString &title, const
     auto command = std::make_unique<CreateScriptElementCommand>(
         &m_elementModel, &m_selectionManager, scripts, "node",
         QRectF(x, y, 200, 100), payload);
+    CreateScriptElementCommand* create = command.get();
     
     m_commandHistory->execute(std::move(command));
+    return create->element() ? create->element()->getId() : QString();
 }
 
-void CanvasController::createEdge(const QString &sourceNodeId, const QString &targetNodeId, 
+QString CanvasController::createEdge(const QString &sourceNodeId, const QString &targetNodeId, 
                                   const QString &sourceHandleType, const QString &targetHandleType,
                                   int sourcePortIndex, int targetPortIndex)
 {
@@ -314,13 +326,13 @@ void CanvasController::createEdge(const QString &sourceNodeId, const QString &ta
     Project* project = qobject_cast<Project*>(m_elementModel.parent());
     if (!project) {
         qWarning() << "CanvasController::createEdge - ElementModel has no Project parent";
-        return;
+        return QString();
     }
     
     Scripts* scripts = project->activeScripts();
     if (!scripts) {
         qWarning() << "CanvasController::createEdge - No active scripts";
-        return;
+        return QString();
     }
     
     // Validate that nodes exist and ports are compatible
@@ -328,7 +340,7 @@ void CanvasController::createEdge(const QString &sourceNodeId, const QString &ta
     Element *targetElement = m_elementModel.getElementById(targetNodeId);
     
     if (!sourceElement || !targetElement) {
-        return;
+        return QString();
     }
     
     // Check if nodes are the correct type and get port types
@@ -336,7 +348,7 @@ void CanvasController::createEdge(const QString &sourceNodeId, const QString &ta
     Node *tgtNode = qobject_cast<Node*>(targetElement);
     
     if (!srcNode || !tgtNode) {
-        return;
+        return QString();
     }
     
     // Get port types
@@ -348,7 +360,7 @@ void CanvasController::createEdge(const QString &sourceNodeId, const QString &ta
         qWarning() << "Port types cannot connect"
                    << "source:" << sourcePortType 
                    << "target:" << targetPortType;
-        return;
+        return QString();
     }
     
     // Create the edge using command pattern
@@ -363,8 +375,10 @@ void CanvasController::createEdge(const QString &sourceNodeId, const QString &ta
     auto command = std::make_unique<CreateScriptElementCommand>(
         &m_elementModel, &m_selectionManager, scripts, "edge",
         QRectF(), payload);
+    CreateScriptElementCommand* create = command.get();
     
     m_commandHistory->execute(std::move(command));
+    return create->element() ? create->element()->getId() : QString();
 }
 
 void CanvasController::createEdgeByPortId(const QString &sourceNodeId, const QString &targetNodeId,
@@ -466,11 +480,11 @@ void CanvasController::detachComponent(DesignElement* instanceElement)
 
 void CanvasController::selectElementsInRect(const QRectF &rect)
 {
+    m_inputRecorder->recordRect(InputEvent::SelectRect, rect);
+    m_hitTestService->elementsInRect(rect, m_marqueeHits);
     
-    std::vector<Element*> elementsInRect = m_hitTestService->elementsInRect(rect);
-    
-    if (!elementsInRect.empty()) {
-        m_selectionManager.selectAll(elementsInRect);
+    if (!m_marqueeHits.empty()) {
+        m_selectionManager.selectAll(m_marqueeHits);
     } else {
         // Clear selection if no elements are in the rect
         m_selectionManager.clearSelection();
@@ -635,13 +649,13 @@ void CanvasController::setElementProperty(Element* element, const QString& prope
     m_commandHistory->execute(std::move(command));
 }
 
-void CanvasController::createNode(const QPointF& position, const QString& nodeType, const QString& nodeTitle)
+QString CanvasController::createNode(const QPointF& position, const QString& nodeType, const QString& nodeTitle)
 {
     // Use existing createNode method with appropriate parameters
-    createNode(position.x(), position.y(), nodeTitle, nodeType);
+    return createNode(position.x(), position.y(), nodeTitle, nodeType);
 }
 
-void CanvasController::createEdge(const QString& sourceNodeId, const QString& targetNodeId)
+QString CanvasController::createEdge(const QString& sourceNodeId, const QString& targetNodeId)
 {
     // Find nodes
     Element* sourceElement = m_elementModel.getElementById(sourceNodeId);
@@ -650,13 +664,14 @@ void CanvasController::createEdge(const QString& sourceNodeId, const QString& ta
     Node* sourceNode = qobject_cast<Node*>(sourceElement);
     Node* targetNode = qobject_cast<Node*>(targetElement);
     
-    if (!sourceNode || !targetNode) return;
+    if (!sourceNode || !targetNode) return QString();
     
     // Create edge between first output port of source and first input port of target
     if (!sourceNode->outputPorts().isEmpty() && !targetNode->inputPorts().isEmpty()) {
         // Create edge using port indices (0 for first port)
-        createEdge(sourceNodeId, targetNodeId, "output", "input", 0, 0);
+        return createEdge(sourceNodeId, targetNodeId, "output", "input", 0, 0);
     }
+    return QString();
 }
 
 void CanvasController::setElementParent(Element* element, const QString& newParentId)
@@ -6,6 +6,7 @@
 #include "Element.h"
 #include "HitTestService.h"
 #include "ShapeControlsController.h"
+#include "InputRecording.h"
 
 class ElementModel;
 class SelectionManager;
@@ -30,6 +31,7 @@ class CanvasController : public QObject {
     Q_PROPERTY(qreal savedContentY READ savedContentY WRITE setSavedContentY NOTIFY savedContentYChanged)
     Q_PROPERTY(qreal savedZoom READ savedZoom WRITE setSavedZoom NOTIFY savedZoomChanged)
     Q_PROPERTY(HitTestService* hitTestService READ hitTestService CONSTANT)
+    Q_PROPERTY(InputRecorder* inputRecorder READ inputRecorder CONSTANT)
     Q_PROPERTY(QObject* shapeControlsController READ shapeControlsController WRITE setShapeControlsController NOTIFY shapeControlsControllerChanged)
     
 public:
@@ -111,8 +113,9 @@ public slots:
     // Element creation (delegated to CreationManager)
     void createElement(const QString &type, qreal x, qreal y, qreal width = 200, qreal height = 150);
     Q_INVOKABLE void createVariable();
-    Q_INVOKABLE void createNode(qreal x, qreal y, const QString &title = "Node", const QString &color = "");
-    Q_INVOKABLE void createEdge(const QString &sourceNodeId, const QString &targetNodeId, 
+    // Node and edge creation return the new element's ID, or an empty string
+    Q_INVOKABLE QString createNode(qreal x, qreal y, const QString &title = "Node", const QString &color = "");
+    Q_INVOKABLE QString createEdge(const QString &sourceNodeId, const QString &targetNodeId, 
                                 const QString &sourceHandleType, const QString &targetHandleType,
                                 int sourcePortIndex, int targetPortIndex);
     Q_INVOKABLE void createEdgeByPortId(const QString &sourceNodeId, const QString &targetNodeId,
@@ -142,8 +145,8 @@ public slots:
     void moveElementsWithOriginalPositions(const QList<Element*>& elements, const QPointF& delta, const QHash<QString, QPointF>& originalPositions);
     Q_INVOKABLE void resizeElement(CanvasElement* element, const QRectF& oldRect, const QRectF& newRect);
     Q_INVOKABLE void setElementProperty(Element* element, const QString& property, const QVariant& value);
-    Q_INVOKABLE void createNode(const QPointF& position, const QString& nodeType, const QString& nodeTitle);
-    Q_INVOKABLE void createEdge(const QString& sourceNodeId, const QString& targetNodeId);
+    Q_INVOKABLE QString createNode(const QPointF& position, const QString& nodeType, const QString& nodeTitle);
+    Q_INVOKABLE QString createEdge(const QString& sourceNodeId, const QString& targetNodeId);
     
     // Element parenting
     Q_INVOKABLE void setElementParent(Element* element, const QString& newParentId);
@@ -159,6 +162,9 @@ public slots:
     // Access to CreationManager
     CreationManager* creationManager() const { return m_creationManager.get(); }
     
+    // Records the input this controller receives, for replay
+    InputRecorder* inputRecorder() const { return m_inputRecorder.get(); }
+    
 signals:
     void modeChanged();
     void canvasTypeChanged();
@@ -184,6 +190,7 @@ private:
     std::unique_ptr<HitTestService> m_hitTestService;
     std::unique_ptr<JsonImporter> m_jsonImporter;
     std::unique_ptr<CommandHistory> m_commandHistory;
+    std::unique_ptr<InputRecorder> m_inputRecorder;
     
     // Mode handlers
     std::unordered_map<Mode, std::unique_ptr<IModeHandler>> m_modeHandlers;
@@ -196,6 +203,8 @@ private:
     
     ShapeControlsController* m_shapeControlsController = nullptr;
     
+    // Reused by marquee selection so dragging the marquee does not allocate
+    std::vector<Element*> m_marqueeHits;
     
     // Initialize subcontrollers
     void initializeModeHandlers();
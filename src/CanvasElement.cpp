@@ -5,6 +5,8 @@
 #include <QMetaProperty>
 #include <QDebug>
 
+QList<CanvasElementChangeObserver*> CanvasElement::s_changeObservers;
+
 CanvasElement::CanvasElement(ElementType type, const QString &id, QObject *parent)
     : Element(type, id, parent), canvasPosition(0, 0), canvasSize(200, 150) // Default size
 {
@@ -16,6 +18,7 @@ void CanvasElement::setX(qreal x)
     qreal roundedX = qRound(x);
     if (!qFuzzyCompare(canvasPosition.x(), roundedX))
     {
+        notifyAboutToChange();
         canvasPosition.setX(roundedX);
         m_boundsValid = false;
         updateCachedBounds();
@@ -30,6 +33,7 @@ void CanvasElement::setY(qreal y)
     qreal roundedY = qRound(y);
     if (!qFuzzyCompare(canvasPosition.y(), roundedY))
     {
+        notifyAboutToChange();
         canvasPosition.setY(roundedY);
         m_boundsValid = false;
         updateCachedBounds();
@@ -44,6 +48,7 @@ void CanvasElement::setWidth(qreal w)
     qreal roundedW = qRound(w);
     if (!qFuzzyCompare(canvasSize.width(), roundedW))
     {
+        notifyAboutToChange();
         canvasSize.setWidth(roundedW);
         m_boundsValid = false;
         updateCachedBounds();
@@ -58,6 +63,7 @@ void CanvasElement::setHeight(qreal h)
     qreal roundedH = qRound(h);
     if (!qFuzzyCompare(canvasSize.height(), roundedH))
     {
+        notifyAboutToChange();
         canvasSize.setHeight(roundedH);
         m_boundsValid = false;
         updateCachedBounds();
@@ -75,6 +81,7 @@ void CanvasElement::setRect(const QRectF &rect)
 
     if (posChanged || sizeChanged)
     {
+        notifyAboutToChange();
         canvasPosition = roundedPos;
         canvasSize = QSizeF(qRound(rect.width()), qRound(rect.height()));
         m_boundsValid = false;
@@ -95,6 +102,19 @@ void CanvasElement::setRect(const QRectF &rect)
     }
 }
 
+void CanvasElement::addChangeObserver(CanvasElementChangeObserver *observer)
+{
+    if (observer && !s_changeObservers.contains(observer))
+    {
+        s_changeObservers.append(observer);
+    }
+}
+
+void CanvasElement::removeChangeObserver(CanvasElementChangeObserver *observer)
+{
+    s_changeObservers.removeAll(observer);
+}
+
 bool CanvasElement::containsPoint(const QPointF &point) const
 {
     // Default implementation uses bounding box
@@ -7,6 +7,17 @@
 #include <QStringList>
 #include "ConnectionManager.h"
 
+class CanvasElement;
+
+// Notified right before a canvas element's geometry, constraints or value change,
+// while the old state can still be read. Observers are process-wide and the
+// notification is a single isEmpty() check when none are registered.
+class CanvasElementChangeObserver {
+public:
+    virtual ~CanvasElementChangeObserver() = default;
+    virtual void elementAboutToChange(CanvasElement* element) = 0;
+};
+
 class CanvasElement : public Element {
     Q_OBJECT
     Q_PROPERTY(qreal x READ x WRITE setX NOTIFY xChanged)
@@ -76,6 +87,10 @@ public:
     // Register CanvasElement properties
     void registerProperties() override;
     
+    // Change observers
+    static void addChangeObserver(CanvasElementChangeObserver* observer);
+    static void removeChangeObserver(CanvasElementChangeObserver* observer);
+    
 signals:
     void xChanged();
     void yChanged();
@@ -90,6 +105,15 @@ protected:
     QPointF canvasPosition;
     QSizeF canvasSize;
     
+    // Call before mutating state that change observers may need to capture
+    void notifyAboutToChange() {
+        if (!s_changeObservers.isEmpty()) {
+            for (CanvasElementChangeObserver* observer : s_changeObservers) {
+                observer->elementAboutToChange(this);
+            }
+        }
+    }
+    
 private slots:
     void onParentPropertyChanged();
     
@@ -112,4 +136,6 @@ private:
     
     // Mouse events control
     bool m_mouseEventsEnabled = true;
+    
+    static QList<CanvasElementChangeObserver*> s_changeObservers;
 };
\ No newline at end of file
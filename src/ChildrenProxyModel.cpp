@@ -0,0 +1,158 @@
+#include "ChildrenProxyModel.h"
+#include "ElementModel.h"
+#include "Element.h"
+
+ChildrenProxyModel::ChildrenProxyModel(QObject *parent)
+    : QAbstractListModel(parent)
+{
+}
+
+ChildrenProxyModel::~ChildrenProxyModel()
+{
+    for (Element *child : std::as_const(m_children)) {
+        unwatchChild(child);
+    }
+}
+
+int ChildrenProxyModel::rowCount(const QModelIndex &parent) const
+{
+    if (parent.isValid())
+        return 0;
+    return m_children.size();
+}
+
+QVariant ChildrenProxyModel::data(const QModelIndex &index, int role) const
+{
+    if (!m_elementModel || !index.isValid() || index.row() >= m_children.size())
+        return QVariant();
+
+    return m_elementModel->elementData(m_children.at(index.row()), role);
+}
+
+QHash<int, QByteArray> ChildrenProxyModel::roleNames() const
+{
+    if (m_elementModel) {
+        return m_elementModel->roleNames();
+    }
+    return QAbstractListModel::roleNames();
+}
+
+void ChildrenProxyModel::setElementModel(ElementModel *model)
+{
+    if (m_elementModel == model) return;
+
+    if (m_elementModel) {
+        disconnect(m_elementModel, nullptr, this, nullptr);
+    }
+
+    m_elementModel = model;
+
+    if (m_elementModel) {
+        connect(m_elementModel, &ElementModel::childInserted, this, &ChildrenProxyModel::onChildInserted);
+        connect(m_elementModel, &ElementModel::childRemoved, this, &ChildrenProxyModel::onChildRemoved);
+        connect(m_elementModel, &ElementModel::childMoved, this, &ChildrenProxyModel::onChildMoved);
+        connect(m_elementModel, &ElementModel::childIndexReset, this, &ChildrenProxyModel::rebuild);
+        connect(m_elementModel, &QObject::destroyed, this, &ChildrenProxyModel::rebuild);
+    }
+
+    rebuild();
+    emit elementModelChanged();
+}
+
+void ChildrenProxyModel::setParentId(const QString &parentId)
+{
+    if (m_parentId == parentId) return;
+
+    m_parentId = parentId;
+    rebuild();
+    emit parentIdChanged();
+}
+
+Element* ChildrenProxyModel::elementAt(int row) const
+{
+    if (row >= 0 && row < m_children.size()) {
+        return m_children.at(row);
+    }
+    return nullptr;
+}
+
+void ChildrenProxyModel::rebuild()
+{
+    const int oldCount = m_children.size();
+
+    beginResetModel();
+    for (Element *child : std::as_const(m_children)) {
+        unwatchChild(child);
+    }
+    m_children.clear();
+
+    // An empty parentId would list every root element; frames always have an id
+    if (m_elementModel && !m_parentId.isEmpty()) {
+        m_children = m_elementModel->getDirectChildren(m_parentId);
+        for (Element *child : std::as_const(m_children)) {
+            watchChild(child);
+        }
+    }
+    endResetModel();
+
+    if (m_children.size() != oldCount) {
+        emit countChanged();
+    }
+}
+
+void ChildrenProxyModel::onChildInserted(const QString &parentId, int row, Element *child)
+{
+    if (parentId != m_parentId || m_parentId.isEmpty() || !child) return;
+
+    row = qBound(0, row, m_children.size());
+    beginInsertRows(QModelIndex(), row, row);
+    m_children.insert(row, child);
+    watchChild(child);
+    endInsertRows();
+    emit countChanged();
+}
+
+void ChildrenProxyModel::onChildRemoved(const QString &parentId, int row)
+{
+    if (parentId != m_parentId || row < 0 || row >= m_children.size()) return;
+
+    beginRemoveRows(QModelIndex(), row, row);
+    unwatchChild(m_children.takeAt(row));
+    endRemoveRows();
+    emit countChanged();
+}
+
+void ChildrenProxyModel::onChildMoved(const QString &parentId, int fromRow, int toRow)
+{
+    if (parentId != m_parentId || fromRow == toRow) return;
+    if (fromRow < 0 || fromRow >= m_children.size() || toRow < 0 || toRow >= m_children.size()) return;
+
+    // beginMoveRows takes the destination as the row the item is inserted before
+    const int destination = toRow > fromRow ? toRow + 1 : toRow;
+    beginMoveRows(QModelIndex(), fromRow, fromRow, QModelIndex(), destination);
+    m_children.move(fromRow, toRow);
+    endMoveRows();
+}
+
+void ChildrenProxyModel::onChildDataChanged()
+{
+    Element *child = qobject_cast<Element*>(sender());
+    const int row = m_children.indexOf(child);
+    if (row >= 0) {
+        QModelIndex modelIndex = index(row, 0);
+        emit dataChanged(modelIndex, modelIndex);
+    }
+}
+
+void ChildrenProxyModel::watchChild(Element *child)
+{
+    connect(child, &Element::elementChanged, this, &ChildrenProxyModel::onChildDataChanged);
+    connect(child, &Element::selectedChanged, this, &ChildrenProxyModel::onChildDataChanged);
+}
+
+void ChildrenProxyModel::unwatchChild(Element *child)
+{
+    if (child) {
+        disconnect(child, nullptr, this, nullptr);
+    }
+}
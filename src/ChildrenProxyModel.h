@@ -0,0 +1,61 @@
+#pragma once
+#include <QAbstractListModel>
+#include <QList>
+#include <QPointer>
+#include <QString>
+
+class Element;
+class ElementModel;
+
+/**
+ * ChildrenProxyModel exposes the direct children of one element in z-order
+ * (back to front), using the ElementModel's parent->children index.
+ *
+ * It mirrors the source's roles, so a delegate written against ElementModel
+ * works unchanged. Inserts, removals, reparents and reorders arrive as row-level
+ * signals from ElementModel, so frames only instantiate delegates for their own
+ * children and only hear about changes to them.
+ */
+class ChildrenProxyModel : public QAbstractListModel {
+    Q_OBJECT
+    Q_PROPERTY(ElementModel* elementModel READ elementModel WRITE setElementModel NOTIFY elementModelChanged)
+    Q_PROPERTY(QString parentId READ parentId WRITE setParentId NOTIFY parentIdChanged)
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+
+public:
+    explicit ChildrenProxyModel(QObject *parent = nullptr);
+    ~ChildrenProxyModel();
+
+    // QAbstractListModel interface
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    ElementModel* elementModel() const { return m_elementModel; }
+    void setElementModel(ElementModel *model);
+    QString parentId() const { return m_parentId; }
+    void setParentId(const QString &parentId);
+    int count() const { return m_children.size(); }
+
+    Q_INVOKABLE Element* elementAt(int row) const;
+
+signals:
+    void elementModelChanged();
+    void parentIdChanged();
+    void countChanged();
+
+private slots:
+    void onChildInserted(const QString &parentId, int row, Element *child);
+    void onChildRemoved(const QString &parentId, int row);
+    void onChildMoved(const QString &parentId, int fromRow, int toRow);
+    void onChildDataChanged();
+
+private:
+    void rebuild();
+    void watchChild(Element *child);
+    void unwatchChild(Element *child);
+
+    QPointer<ElementModel> m_elementModel;
+    QString m_parentId;
+    QList<Element*> m_children;
+};
@@ -25,6 +25,14 @@ bool Command::isExecuted() const
     return m_executed;
 }
 
+MemoryUsage Command::memoryUsage() const
+{
+    MemoryUsage usage;
+    usage.objects = 1;
+    usage.bytes = sizeof(Command) + MemoryEstimate::QOBJECT_OVERHEAD + MemoryEstimate::of(m_description);
+    return usage;
+}
+
 void Command::setDescription(const QString& desc)
 {
     m_description = desc;
@@ -3,6 +3,7 @@
 
 #include <QObject>
 #include <QString>
+#include "MemoryUsage.h"
 
 class Command : public QObject
 {
@@ -19,6 +20,10 @@ public:
     QString description() const;
     bool isExecuted() const;
 
+    // Estimated footprint of the command and the state it keeps for undo and
+    // redo; commands holding more than a few ids override this
+    virtual MemoryUsage memoryUsage() const;
+
 protected:
     void setDescription(const QString& desc);
 
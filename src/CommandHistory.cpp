@@ -1,5 +1,6 @@
 #include "CommandHistory.h"
 #include "Command.h"
+#include "commands/CompoundCommand.h"
 #include <QDebug>
 
 CommandHistory::CommandHistory(QObject *parent)
@@ -23,6 +24,13 @@ void CommandHistory::execute(std::unique_ptr<Command> command)
     command->execute();
     command->setExecuted(true);
 
+    if (m_macro) {
+        // Recorded into the open macro; it reaches the undo stack in endMacro()
+        m_macro->append(std::move(command));
+        emit commandExecuted(description);
+        return;
+    }
+
     m_undoStack.push(std::move(command));
     
     // Clear redo stack
@@ -36,10 +44,53 @@ void CommandHistory::execute(std::unique_ptr<Command> command)
     emit commandExecuted(description);
 }
 
+void CommandHistory::beginMacro(const QString& description, const QString& mergeKey)
+{
+    if (m_macroDepth++ == 0) {
+        m_macro = std::make_unique<CompoundCommand>(description, mergeKey);
+    }
+}
+
+void CommandHistory::endMacro()
+{
+    if (m_macroDepth == 0) {
+        qWarning() << "CommandHistory::endMacro called without beginMacro";
+        return;
+    }
+    if (--m_macroDepth > 0) {
+        return;
+    }
+
+    std::unique_ptr<CompoundCommand> macro = std::move(m_macro);
+    if (macro->isEmpty()) {
+        return;
+    }
+
+    while (!m_redoStack.empty()) {
+        m_redoStack.pop();
+    }
+
+    // Fold into the previous macro of the same key, e.g. successive passes of one AI response
+    if (!m_undoStack.empty()) {
+        if (auto top = qobject_cast<CompoundCommand*>(m_undoStack.top().get())) {
+            if (top->mergeWith(macro.get())) {
+                updateCanUndoRedo();
+                return;
+            }
+        }
+    }
+
+    macro->setExecuted(true);
+    m_undoStack.push(std::move(macro));
+
+    limitUndoStack();
+    updateCanUndoRedo();
+}
+
 void CommandHistory::undo()
 {
     
-    if (!canUndo()) {
+    if (!canUndo() || m_macro) {
         return;
     }
 
@@ -55,7 +106,7 @@ void CommandHistory::undo()
 
 void CommandHistory::redo()
 {
-    if (!canRedo()) {
+    if (!canRedo() || m_macro) {
         return;
     }
 
@@ -158,4 +209,18 @@ void CommandHistory::limitUndoStack()
             temp.pop();
         }
     }
-}
\ No newline at end of file
+}
+
+MemoryUsage CommandHistory::memoryUsage() const
+{
+    MemoryUsage usage;
+    for (const auto* stack : {&m_undoStack, &m_redoStack}) {
+        for (const auto& command : stack->commands()) {
+            usage += command->memoryUsage();
+        }
+    }
+    if (m_macro) {
+        usage += m_macro->memoryUsage();
+    }
+    return usage;
+}
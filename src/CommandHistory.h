@@ -4,8 +4,10 @@
 #include <QObject>
 #include <memory>
 #include <stack>
+#include "MemoryUsage.h"
 
 class Command;
+class CompoundCommand;
 
 class CommandHistory : public QObject
 {
@@ -16,6 +18,13 @@ public:
     ~CommandHistory();
 
     void execute(std::unique_ptr<Command> command);
+
+    // Commands executed between beginMacro() and endMacro() become one undo step.
+    // Macros nest; a non-empty mergeKey folds the macro into the top undo entry
+    // when that entry is a macro with the same key.
+    void beginMacro(const QString& description, const QString& mergeKey = QString());
+    void endMacro();
+    bool isMacroActive() const { return m_macroDepth > 0; }
     void undo();
     void redo();
 
@@ -32,6 +41,9 @@ public:
     void setMaxUndoCount(int count);
     int maxUndoCount() const;
 
+    // Estimated footprint of both stacks and an open macro
+    MemoryUsage memoryUsage() const;
+
 signals:
     void canUndoChanged(bool canUndo);
     void canRedoChanged(bool canRedo);
@@ -41,9 +53,18 @@ private:
     void updateCanUndoRedo();
     void limitUndoStack();
 
-    std::stack<std::unique_ptr<Command>> m_undoStack;
-    std::stack<std::unique_ptr<Command>> m_redoStack;
+    // A std::stack whose commands can be walked, for memoryUsage()
+    class CommandStack : public std::stack<std::unique_ptr<Command>> {
+    public:
+        const container_type& commands() const { return c; }
+    };
+
+    CommandStack m_undoStack;
+    CommandStack m_redoStack;
     int m_maxUndoCount;
+
+    std::unique_ptr<CompoundCommand> m_macro;
+    int m_macroDepth = 0;
 };
 
 #endif // COMMANDHISTORY_H
\ No newline at end of file
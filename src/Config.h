@@ -145,6 +145,9 @@ namespace Config {
     constexpr const char* COMPONENT_HOVER_BADGE_BACKGROUND_COLOR = "#7B1FA2";  // Purple
     constexpr const char* COMPONENT_HOVER_BADGE_BORDER_COLOR = "#6A1B9A";      // Darker purple
     
+    // Snap guide color
+    constexpr const char* SNAP_GUIDE_COLOR = "#FF3D7F";  // Pink alignment and spacing guides
+    
     // Sizes
     constexpr int DEFAULT_ELEMENT_WIDTH = 200;
     constexpr int DEFAULT_ELEMENT_HEIGHT = 150;
@@ -198,8 +201,57 @@ namespace Config {
     constexpr int MAX_FPS = 120;           // Maximum FPS cap
     constexpr bool ADAPTIVE_THROTTLING_DEFAULT = true;  // Enable adaptive throttling by default
     
+    // Viewport virtualization (fractions of the viewport size added on each side)
+    constexpr qreal VIEWPORT_PRELOAD_FACTOR = 0.5;  // Elements this close to the viewport get delegates
+    constexpr qreal VIEWPORT_RETAIN_FACTOR = 1.0;   // Live delegates are kept until they are this far out
+    
+    // Google Fonts cache
+    constexpr int FONT_CATALOG_MAX_AGE = 7 * 24 * 60 * 60;  // Seconds before the cached catalog is revalidated
+    constexpr int FONT_MAX_CONCURRENT_DOWNLOADS = 4;        // Font file downloads in flight at once
+    
+    // Network transport
+    constexpr int NETWORK_MAX_IN_FLIGHT = 8;          // Requests running at once across all clients
+    constexpr int NETWORK_INTERACTIVE_RESERVE = 2;    // Slots only interactive requests may use
+    constexpr int NETWORK_MAX_RETRIES = 3;            // Retries after the first attempt
+    constexpr int NETWORK_RETRY_BASE_DELAY = 250;     // Backoff before the first retry (ms), doubled each time
+    constexpr int NETWORK_RETRY_MAX_DELAY = 8000;     // Backoff ceiling (ms)
+    
+    // Project sync queue
+    constexpr int SYNC_IDLE_DELAY = 500;          // Quiet time after the last edit before a flush (ms)
+    constexpr int SYNC_FLUSH_INTERVAL = 3000;     // Longest an edit waits while editing continues (ms)
+    
+    // Script runtime
+    constexpr int SCRIPT_EVENT_TIME_LIMIT = 0;            // Stop worker events running longer than this (ms); 0 for no limit
+    constexpr int SCRIPT_COMMAND_BATCH_INTERVAL = 16;     // Worker output is batched and applied once per frame (ms)
+    
+    // Text measurement
+    constexpr int TEXT_MEASURE_CACHE_SIZE = 4096;   // Cached (font, content, width) measurements
+    constexpr qreal TEXT_ELEMENT_PADDING = 4.0;     // Matches the 4px margins in TextElement.qml
+    constexpr qreal TEXT_ELEMENT_LINE_HEIGHT = 1.2; // Matches TextElement.qml lineHeight
+    
+    // Console
+    constexpr int CONSOLE_MAX_MESSAGES = 5000;     // Ring buffer capacity; oldest messages are evicted
+    constexpr int CONSOLE_FLUSH_INTERVAL = 50;     // Batch console appends at most every 50ms
+    
+    // Performance tracing
+    constexpr int TRACE_BUFFER_EVENTS = 65536;     // Ring buffer capacity per thread; oldest events are overwritten
+    
+    // Snapping
+    constexpr qreal SNAP_TOLERANCE = 6.0;      // Screen pixels within which a dragged edge snaps
+    constexpr qreal SNAP_INDEX_MARGIN = 0.5;   // Fraction of the viewport indexed on each side, so pans reuse the index
+    
+    // Spatial index
+    constexpr int QUADTREE_PARALLEL_BUILD_MIN = 8192;  // Subtrees with this many elements build their quadrants in parallel
+    
+    // Project loading
+    constexpr int DESERIALIZE_CHUNK_SIZE = 128;    // Elements decoded per worker task when loading a project
+    
+    // Memory diagnostics
+    constexpr int MEMORY_LOG_MIN_INTERVAL = 1000;  // A sample walks every element; periodic logging is clamped to this
+    
     // API URLs
     constexpr const char* TOOL_REGISTRY_URL = "https://k72mo3oun7sefawjhvilq2ne5a0ybfgr.lambda-url.us-west-2.on.aws/";
+    constexpr const char* GOOGLE_FONTS_API_URL = "https://www.googleapis.com/webfonts/v1/webfonts";
     constexpr const char* GRAPHQL_ENDPOINT = "https://enrxjqdgdvc7pkragdib6abhyy.appsync-api.us-west-2.amazonaws.com/graphql";
     
     // Authentication
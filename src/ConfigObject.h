@@ -5,9 +5,11 @@
 #include <QColor>
 #include <QQmlEngine>
 #include <QVariantList>
+#include <QUrl>
 #include <QGuiApplication>
 #include <QStyleHints>
 #include "Config.h"
+#include "PerformanceTrace.h"
 
 // Singleton to expose Config values to QML
 class ConfigObject : public QObject
@@ -118,6 +120,9 @@ class ConfigObject : public QObject
     Q_PROPERTY(QColor componentHoverBadgeBackgroundColor READ componentHoverBadgeBackgroundColor CONSTANT)
     Q_PROPERTY(QColor componentHoverBadgeBorderColor READ componentHoverBadgeBorderColor CONSTANT)
     
+    // Snap guide color
+    Q_PROPERTY(QColor snapGuideColor READ snapGuideColor CONSTANT)
+    
     // Sizes
     Q_PROPERTY(int defaultElementWidth READ defaultElementWidth CONSTANT)
     Q_PROPERTY(int defaultElementHeight READ defaultElementHeight CONSTANT)
@@ -171,6 +176,7 @@ class ConfigObject : public QObject
     Q_PROPERTY(int maxFps READ maxFps CONSTANT)
     Q_PROPERTY(bool adaptiveThrottlingDefault READ adaptiveThrottlingDefault CONSTANT)
     Q_PROPERTY(int zoomThrottleInterval READ zoomThrottleInterval CONSTANT)
+    Q_PROPERTY(bool tracingEnabled READ tracingEnabled WRITE setTracingEnabled NOTIFY tracingEnabledChanged)
     
     // Platform options
     Q_PROPERTY(QVariantList platformOptions READ platformOptions CONSTANT)
@@ -359,6 +365,9 @@ public:
     QColor componentHoverBadgeBackgroundColor() const { return QColor(128, 0, 128, 204); }  // 80% opacity = 204/255
     QColor componentHoverBadgeBorderColor() const { return QColor(255, 255, 255, 51); }  // 20% opacity = 51/255
     
+    // Snap guide color
+    QColor snapGuideColor() const { return QColor(Config::SNAP_GUIDE_COLOR); }
+    
     // Sizes
     int defaultElementWidth() const { return Config::DEFAULT_ELEMENT_WIDTH; }
     int defaultElementHeight() const { return Config::DEFAULT_ELEMENT_HEIGHT; }
@@ -413,6 +422,19 @@ public:
     bool adaptiveThrottlingDefault() const { return Config::ADAPTIVE_THROTTLING_DEFAULT; }
     int zoomThrottleInterval() const { return Config::ZOOM_THROTTLE_INTERVAL; }
     
+    // Performance tracing; each recording starts from an empty trace
+    bool tracingEnabled() const { return PerformanceTrace::isEnabled(); }
+    void setTracingEnabled(bool enabled) {
+        if (enabled == PerformanceTrace::isEnabled()) return;
+        if (enabled) PerformanceTrace::clear();
+        PerformanceTrace::setEnabled(enabled);
+        emit tracingEnabledChanged();
+    }
+    // Write the recorded trace as Chrome trace JSON (opens in Perfetto)
+    Q_INVOKABLE bool saveTrace(const QUrl& fileUrl) const {
+        return PerformanceTrace::writeChromeTrace(fileUrl.isLocalFile() ? fileUrl.toLocalFile() : fileUrl.toString());
+    }
+    
     // Platform options
     QVariantList platformOptions() const {
         QVariantList options;
@@ -424,6 +446,7 @@ public:
 
 signals:
     void darkModeChanged();
+    void tracingEnabledChanged();
 };
 
 #endif // CONFIGOBJECT_H
\ No newline at end of file
@@ -1,59 +1,185 @@
 #include "ConsoleMessageRepository.h"
+#include "Config.h"
 #include <QDebug>
-#include <QUuid>
+#include <QTimer>
+
+bool ConsoleMessageRepository::s_echoToLog = false;
 
 ConsoleMessageRepository::ConsoleMessageRepository(QObject *parent)
-    : QObject(parent), m_isUsingAI(false), m_selectedOption(1), m_showAIPrompt(false)
+    : QAbstractListModel(parent), m_isUsingAI(false), m_selectedOption(1), m_showAIPrompt(false)
+{
+    m_ring.resize(Config::CONSOLE_MAX_MESSAGES);
+    
+    m_flushTimer = new QTimer(this);
+    m_flushTimer->setSingleShot(true);
+    m_flushTimer->setInterval(Config::CONSOLE_FLUSH_INTERVAL);
+    connect(m_flushTimer, &QTimer::timeout, this, &ConsoleMessageRepository::flushPendingMessages);
+}
+
+int ConsoleMessageRepository::rowCount(const QModelIndex &parent) const
 {
+    if (parent.isValid())
+        return 0;
+    return m_count;
 }
 
-QVariantList ConsoleMessageRepository::messages() const
+QVariant ConsoleMessageRepository::data(const QModelIndex &index, int role) const
 {
-    QVariantList result;
-    for (const auto &msg : m_messages) {
-        QVariantMap messageMap;
-        messageMap["id"] = msg.id;
-        messageMap["text"] = msg.text;
-        messageMap["type"] = messageTypeToString(msg.type);
-        messageMap["timestamp"] = msg.timestamp.toString("hh:mm:ss");
-        result.append(messageMap);
+    if (!index.isValid() || index.row() < 0 || index.row() >= m_count)
+        return QVariant();
+    
+    const Message &msg = messageAt(index.row());
+    
+    switch (role) {
+    case IdRole:
+        return QString::number(msg.id);
+    case Qt::DisplayRole:
+    case TextRole:
+        return msg.text;
+    case TypeRole:
+        return messageTypeToString(msg.type);
+    case TimestampRole:
+        // Formatted on demand so only visible delegates pay for it
+        return msg.timestamp.toString("hh:mm:ss");
+    default:
+        return QVariant();
     }
-    return result;
+}
+
+QHash<int, QByteArray> ConsoleMessageRepository::roleNames() const
+{
+    QHash<int, QByteArray> roles;
+    roles[IdRole] = "messageId";
+    roles[TextRole] = "text";
+    roles[TypeRole] = "type";
+    roles[TimestampRole] = "timestamp";
+    return roles;
 }
 
 void ConsoleMessageRepository::addMessage(const QString &text, MessageType type)
+{
+    enqueueMessage(text, type);
+}
+
+quint64 ConsoleMessageRepository::enqueueMessage(const QString &text, MessageType type)
 {
     Message msg;
-    msg.id = QUuid::createUuid().toString(QUuid::WithoutBraces);
+    msg.id = m_nextId++;
     msg.text = text;
     msg.type = type;
     msg.timestamp = QDateTime::currentDateTime();
     
-    m_messages.append(msg);
+    m_pending.append(msg);
     
-    // Log to debug console as well
-    switch (type) {
-    case Error:
-        qCritical() << "[Console]" << text;
-        break;
-    case Warning:
-        qWarning() << "[Console]" << text;
-        break;
-    default:
-        qDebug() << "[Console]" << text;
-        break;
+    // Anything beyond the ring capacity would be evicted by the flush anyway
+    if (m_pending.size() > m_ring.size()) {
+        m_pending.removeFirst();
+    }
+    
+    // Log to debug console as well when asked to
+    if (s_echoToLog) {
+        switch (type) {
+        case Error:
+            qCritical() << "[Console]" << text;
+            break;
+        case Warning:
+            qWarning() << "[Console]" << text;
+            break;
+        default:
+            qDebug() << "[Console]" << text;
+            break;
+        }
     }
     
     emit messageAdded(text, type);
+    scheduleFlush();
+    
+    return msg.id;
+}
+
+void ConsoleMessageRepository::scheduleFlush()
+{
+    if (!m_flushTimer->isActive()) {
+        m_flushTimer->start();
+    }
+}
+
+void ConsoleMessageRepository::flushPendingMessages()
+{
+    m_flushTimer->stop();
+    if (m_pending.isEmpty()) return;
+    
+    const int capacity = m_ring.size();
+    const int incoming = m_pending.size();
+    
+    // Evict the oldest rows in one block to make room for the batch
+    const int overflow = m_count + incoming - capacity;
+    if (overflow > 0) {
+        const int evict = qMin(overflow, m_count);
+        beginRemoveRows(QModelIndex(), 0, evict - 1);
+        for (int i = 0; i < evict; ++i) {
+            messageAt(i) = Message();
+        }
+        m_head = (m_head + evict) % capacity;
+        m_count -= evict;
+        endRemoveRows();
+    }
+    
+    beginInsertRows(QModelIndex(), m_count, m_count + incoming - 1);
+    for (Message &msg : m_pending) {
+        m_ring[(m_head + m_count) % capacity] = std::move(msg);
+        ++m_count;
+    }
+    m_pending.clear();
+    endInsertRows();
+    
     emit messagesChanged();
 }
 
+MemoryUsage ConsoleMessageRepository::memoryUsage() const
+{
+    MemoryUsage usage;
+    usage.objects = m_count + m_pending.size();
+    // The ring is allocated at full capacity up front
+    usage.bytes = (m_ring.capacity() + m_pending.capacity()) * qint64(sizeof(Message));
+    for (int row = 0; row < m_count; ++row) {
+        usage.bytes += MemoryEstimate::of(messageAt(row).text);
+    }
+    for (const Message& message : m_pending) {
+        usage.bytes += MemoryEstimate::of(message.text);
+    }
+    return usage;
+}
+
 void ConsoleMessageRepository::clearMessages()
 {
-    m_messages.clear();
+    m_flushTimer->stop();
+    m_pending.clear();
+    
+    beginResetModel();
+    m_ring.fill(Message());
+    m_head = 0;
+    m_count = 0;
+    endResetModel();
+    
     emit messagesChanged();
 }
 
+int ConsoleMessageRepository::findRow(quint64 id) const
+{
+    // Ids are handed out in increasing order, so the ring is sorted by id
+    int low = 0;
+    int high = m_count - 1;
+    while (low <= high) {
+        int mid = (low + high) / 2;
+        quint64 midId = messageAt(mid).id;
+        if (midId == id) return mid;
+        if (midId < id) low = mid + 1;
+        else high = mid - 1;
+    }
+    return -1;
+}
+
 QString ConsoleMessageRepository::messageTypeToString(MessageType type) const
 {
     switch (type) {
@@ -127,49 +253,51 @@ void ConsoleMessageRepository::processConsoleCommand(const QString& command, QOb
 
 QString ConsoleMessageRepository::addMessageWithId(const QString &text, MessageType type)
 {
-    Message msg;
-    msg.id = QUuid::createUuid().toString(QUuid::WithoutBraces);
-    msg.text = text;
-    msg.type = type;
-    msg.timestamp = QDateTime::currentDateTime();
-    
-    m_messages.append(msg);
-    
-    // Log to debug console as well
-    switch (type) {
-    case Error:
-        qCritical() << "[Console]" << text;
-        break;
-    case Warning:
-        qWarning() << "[Console]" << text;
-        break;
-    default:
-        qDebug() << "[Console]" << text;
-        break;
-    }
-    
-    emit messageAdded(text, type);
-    emit messagesChanged();
-    
-    return msg.id;
+    return QString::number(enqueueMessage(text, type));
 }
 
 void ConsoleMessageRepository::updateMessage(const QString &id, const QString &text)
 {
-    for (int i = 0; i < m_messages.size(); ++i) {
-        if (m_messages[i].id == id) {
-            m_messages[i].text = text;
-            emit messagesChanged();
-            break;
+    const quint64 messageId = id.toULongLong();
+    
+    for (Message &pending : m_pending) {
+        if (pending.id == messageId) {
+            pending.text = text;
+            return;
         }
     }
+    
+    int row = findRow(messageId);
+    if (row >= 0) {
+        messageAt(row).text = text;
+        QModelIndex modelIndex = createIndex(row, 0);
+        emit dataChanged(modelIndex, modelIndex, {TextRole, Qt::DisplayRole});
+    }
 }
 
 void ConsoleMessageRepository::removeMessage(const QString &id)
 {
-    m_messages.removeIf([&id](const Message &msg) {
-        return msg.id == id;
-    });
+    const quint64 messageId = id.toULongLong();
+    
+    for (int i = 0; i < m_pending.size(); ++i) {
+        if (m_pending[i].id == messageId) {
+            m_pending.removeAt(i);
+            return;
+        }
+    }
+    
+    int row = findRow(messageId);
+    if (row < 0) return;
+    
+    beginRemoveRows(QModelIndex(), row, row);
+    // Close the gap by shifting the newer rows down one slot
+    for (int i = row; i < m_count - 1; ++i) {
+        messageAt(i) = std::move(messageAt(i + 1));
+    }
+    messageAt(m_count - 1) = Message();
+    --m_count;
+    endRemoveRows();
+    
     emit messagesChanged();
 }
 
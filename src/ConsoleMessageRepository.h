@@ -1,16 +1,26 @@
 #ifndef CONSOLEMESSAGEREPOSITORY_H
 #define CONSOLEMESSAGEREPOSITORY_H
 
-#include <QObject>
+#include <QAbstractListModel>
 #include <QString>
 #include <QDateTime>
 #include <QList>
-#include <QVariantMap>
+#include <QVector>
+#include "MemoryUsage.h"
 
-class ConsoleMessageRepository : public QObject
+class QTimer;
+
+/**
+ * ConsoleMessageRepository is a list model over a fixed-capacity ring buffer.
+ * Appends are queued and flushed in batches (at most every
+ * Config::CONSOLE_FLUSH_INTERVAL ms) with a single beginInsertRows/endInsertRows,
+ * and the oldest rows are evicted with beginRemoveRows/endRemoveRows once
+ * Config::CONSOLE_MAX_MESSAGES is reached. Timestamps are formatted lazily in data().
+ */
+class ConsoleMessageRepository : public QAbstractListModel
 {
     Q_OBJECT
-    Q_PROPERTY(QVariantList messages READ messages NOTIFY messagesChanged)
+    Q_PROPERTY(int count READ count NOTIFY messagesChanged)
     Q_PROPERTY(bool isUsingAI READ isUsingAI WRITE setIsUsingAI NOTIFY isUsingAIChanged)
     Q_PROPERTY(int selectedOption READ selectedOption WRITE setSelectedOption NOTIFY selectedOptionChanged)
     Q_PROPERTY(bool showAIPrompt READ showAIPrompt WRITE setShowAIPrompt NOTIFY showAIPromptChanged)
@@ -25,9 +35,26 @@ public:
     };
     Q_ENUM(MessageType)
     
+    enum MessageRoles {
+        IdRole = Qt::UserRole + 1,
+        TextRole,
+        TypeRole,
+        TimestampRole
+    };
+    
     explicit ConsoleMessageRepository(QObject *parent = nullptr);
     
-    QVariantList messages() const;
+    // QAbstractListModel interface
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+    
+    int count() const { return m_count; }
+    
+    // Also write every console message to the Qt log; off by default since
+    // formatting each line costs more than storing it
+    static void setEchoToLog(bool echo) { s_echoToLog = echo; }
+    static bool echoToLog() { return s_echoToLog; }
     
     Q_INVOKABLE void addMessage(const QString &text, MessageType type = Output);
     Q_INVOKABLE void addInput(const QString &text) { addMessage(text, Input); }
@@ -40,6 +67,12 @@ public:
     Q_INVOKABLE QString messageTypeToString(MessageType type) const;
     Q_INVOKABLE void processConsoleCommand(const QString& command, QObject* project = nullptr);
     
+    // Apply any queued messages to the model immediately
+    Q_INVOKABLE void flushPendingMessages();
+    
+    // Estimated footprint of the ring and the queued messages; objects counts messages
+    MemoryUsage memoryUsage() const;
+    
     // Message with ID support for updates
     QString addMessageWithId(const QString &text, MessageType type = Output);
     void updateMessage(const QString &id, const QString &text);
@@ -69,13 +102,30 @@ signals:
     
 private:
     struct Message {
-        QString id;
+        quint64 id = 0;
         QString text;
-        MessageType type;
+        MessageType type = Output;
         QDateTime timestamp;
     };
     
-    QList<Message> m_messages;
+    quint64 enqueueMessage(const QString &text, MessageType type);
+    void scheduleFlush();
+    const Message &messageAt(int row) const { return m_ring[(m_head + row) % m_ring.size()]; }
+    Message &messageAt(int row) { return m_ring[(m_head + row) % m_ring.size()]; }
+    int findRow(quint64 id) const;
+    
+    // Ring buffer: m_head is the slot of the oldest row, m_count the number of live rows
+    QVector<Message> m_ring;
+    int m_head = 0;
+    int m_count = 0;
+    
+    // Messages waiting for the next batched insert
+    QList<Message> m_pending;
+    QTimer* m_flushTimer;
+    quint64 m_nextId = 1;
+    
+    static bool s_echoToLog;
+    
     bool m_isUsingAI;
     int m_selectedOption;
     bool m_showAIPrompt;
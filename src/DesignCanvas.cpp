@@ -11,6 +11,8 @@
 #include "Project.h"
 #include "PlatformConfig.h"
 #include <QDebug>
+#include <algorithm>
+#include <iterator>
 
 DesignCanvas::DesignCanvas(ElementModel& model,
                            SelectionManager& sel,
@@ -90,6 +92,8 @@ void DesignCanvas::setIsDesignControlsMovementDisabled(bool disabled)
 
 void DesignCanvas::updateHover(qreal x, qreal y)
 {
+    inputRecorder()->record(InputEvent::Hover, x, y);
+    
     // Update hover in select mode
     if (mode() == Mode::Select) {
         Element* element = hitTestForHover(x, y);
@@ -108,33 +112,59 @@ bool DesignCanvas::isDescendantOf(QObject* elementA, QObject* elementB) const
     Element* elemB = qobject_cast<Element*>(elementB);
     if (!elemA || !elemB) return false;
     
-    Element* current = elemA;
-    int maxDepth = 100; // Prevent infinite loops
-    int depth = 0;
+    return m_elementModel.isDescendantOf(elemA, elemB);
+}
+
+bool DesignCanvas::isChildOfSelected(QObject* element) const
+{
+    Element* elem = qobject_cast<Element*>(element);
+    if (!elem) return false;
     
-    while (current && !current->getParentElementId().isEmpty() && depth < maxDepth) {
-        if (current->getParentElementId() == elemB->getId()) {
-            return true;
-        }
-        // Find the parent element
-        current = m_elementModel.getElementById(current->getParentElementId());
-        depth++;
-    }
+    const ElementModel::TreeInterval interval = m_elementModel.treeInterval(elem);
+    if (!interval.isValid()) return false;
     
-    return false;
+    // Selected roots never nest, so only the last one starting before the
+    // element can contain it
+    const std::vector<ElementModel::TreeInterval>& roots = selectedRoots();
+    auto it = std::upper_bound(roots.begin(), roots.end(), interval.enter,
+                               [](int enter, const ElementModel::TreeInterval& root) {
+                                   return enter < root.enter;
+                               });
+    return it != roots.begin() && std::prev(it)->contains(interval);
 }
 
-bool DesignCanvas::isChildOfSelected(QObject* element) const
+const std::vector<ElementModel::TreeInterval>& DesignCanvas::selectedRoots() const
 {
-    if (!element) return false;
+    if (m_selectedRootsValid && m_selectedRootsRevision == m_elementModel.hierarchyRevision()) {
+        return m_selectedRoots;
+    }
     
-    const QList<Element*>& selectedElements = m_selectionManager.selectedElements();
+    const QList<Element*> selectedElements = m_selectionManager.selectedElements();
+    std::vector<ElementModel::TreeInterval> intervals;
+    intervals.reserve(selectedElements.size());
     for (Element* selected : selectedElements) {
-        if (isDescendantOf(element, selected)) {
-            return true;
+        const ElementModel::TreeInterval interval = m_elementModel.treeInterval(selected);
+        if (interval.isValid()) {
+            intervals.push_back(interval);
+        }
+    }
+    std::sort(intervals.begin(), intervals.end(),
+              [](const ElementModel::TreeInterval& a, const ElementModel::TreeInterval& b) {
+                  return a.enter < b.enter;
+              });
+    
+    // In pre-order an element follows its ancestors, so it is a root unless
+    // the last root found contains it
+    m_selectedRoots.clear();
+    for (const ElementModel::TreeInterval& interval : intervals) {
+        if (m_selectedRoots.empty() || !m_selectedRoots.back().contains(interval)) {
+            m_selectedRoots.push_back(interval);
         }
     }
-    return false;
+    
+    m_selectedRootsValid = true;
+    m_selectedRootsRevision = m_elementModel.hierarchyRevision();
+    return m_selectedRoots;
 }
 
 void DesignCanvas::updateParentingDuringDrag()
@@ -143,7 +173,11 @@ void DesignCanvas::updateParentingDuringDrag()
         return;
     }
     
-    const QList<Element*>& selectedElements = m_selectionManager.selectedElements();
+    const QList<Element*> selectedElements = m_selectionManager.selectedElements();
+    
+    // Decide every element against the hierarchy as it is now and reparent
+    // afterwards, so the tree intervals are renumbered at most once per move
+    QList<Element*> toReparent;
     
     // If no element is hovered, unparent the selected elements
     if (!m_hoveredElement) {
@@ -160,11 +194,15 @@ void DesignCanvas::updateParentingDuringDrag()
                 continue;
             }
             
-            // Unparent the element by setting parentId to empty string
             if (!element->getParentElementId().isEmpty()) {
-                element->setParentElementId("");
+                toReparent.append(element);
             }
         }
+        
+        // Unparent the element by setting parentId to empty string
+        for (Element* element : toReparent) {
+            element->setParentElementId("");
+        }
         return;
     }
     
@@ -173,6 +211,17 @@ void DesignCanvas::updateParentingDuringDrag()
         return;
     }
     
+    // Guard: Don't parent to children of selected elements
+    if (isChildOfSelected(hovered)) {
+        return;
+    }
+    
+    // Guard: Check if the hovered element accepts children
+    Frame* frameHovered = qobject_cast<Frame*>(hovered);
+    if (frameHovered && !frameHovered->acceptsChildren()) {
+        return;
+    }
+    
     for (Element* element : selectedElements) {
         if (!element) continue;
         
@@ -192,18 +241,7 @@ void DesignCanvas::updateParentingDuringDrag()
         }
         
         // Guard: Don't create circular dependencies
-        if (isDescendantOf(hovered, element)) {
-            continue;
-        }
-        
-        // Guard: Don't parent to children of selected elements
-        if (isChildOfSelected(hovered)) {
-            continue;
-        }
-        
-        // Guard: Check if the hovered element accepts children
-        Frame* frameHovered = qobject_cast<Frame*>(hovered);
-        if (frameHovered && !frameHovered->acceptsChildren()) {
+        if (m_elementModel.isDescendantOf(hovered, element)) {
             continue;
         }
         
@@ -218,13 +256,18 @@ void DesignCanvas::updateParentingDuringDrag()
         
         // Update parentId if it's different
         if (element->getParentElementId() != hovered->getId()) {
-            element->setParentElementId(hovered->getId());
+            toReparent.append(element);
         }
     }
+    
+    for (Element* element : toReparent) {
+        element->setParentElementId(hovered->getId());
+    }
 }
 
 void DesignCanvas::onSelectionChanged()
 {
+    m_selectedRootsValid = false;
     clearHoverIfSelected();
     
     // Shape editing is now handled through ShapeControlsController
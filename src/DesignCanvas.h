@@ -1,5 +1,7 @@
 #pragma once
 #include "CanvasController.h"
+#include "ElementModel.h"
+#include <vector>
 
 class DesignCanvas : public CanvasController {
     Q_OBJECT
@@ -56,4 +58,11 @@ private:
     
     // Clear hover when appropriate
     void clearHoverIfSelected();
+    
+    // Tree intervals of the selected elements that have no selected ancestor,
+    // sorted by enter; rebuilt after the selection or the hierarchy changed
+    mutable std::vector<ElementModel::TreeInterval> m_selectedRoots;
+    mutable bool m_selectedRootsValid = false;
+    mutable quint64 m_selectedRootsRevision = 0;
+    const std::vector<ElementModel::TreeInterval>& selectedRoots() const;
 };
\ No newline at end of file
@@ -8,9 +8,14 @@
 #include "Element.h"
 #include "CanvasElement.h"
 #include "CanvasController.h"
+#include "Frame.h"
+#include "HitTestService.h"
+#include "InputRecording.h"
 #include <QMetaObject>
 #include <QQmlEngine>
 #include <QObject>
+#include <algorithm>
+#include <vector>
 
 // Default constructor for QML
 DesignControlsController::DesignControlsController(QObject* parent)
@@ -190,6 +195,12 @@ ElementModel* DesignControlsController::getActiveElementModel() const
     return project->elementModel();
 }
 
+InputRecorder* DesignControlsController::getActiveInputRecorder() const
+{
+    DesignCanvas* canvas = getActiveDesignCanvas();
+    return canvas ? canvas->inputRecorder() : nullptr;
+}
+
 void DesignControlsController::updateCache()
 {
     bool newIsResizingEnabled = isResizingEnabled();
@@ -287,12 +298,20 @@ void DesignControlsController::disconnectFromActiveCanvas()
     }
 }
 
-void DesignControlsController::startDragOperation()
+void DesignControlsController::startDragOperation(const QRectF& controlRect)
 {
+    if (InputRecorder* recorder = getActiveInputRecorder()) {
+        recorder->recordRect(InputEvent::DragStart, controlRect);
+    }
+    
     // Clear previous state
     m_dragStartSelectedElements.clear();
     m_dragStartElementPositions.clear();
     m_dragStartElementSizes.clear();
+    m_dragStartStates.clear();
+    m_dragStartFlexParentSizes.clear();
+    m_dragStartControlRect = controlRect;
+    m_snappingService.endSession();
     
     // Get active selection manager
     SelectionManager* selectionManager = getActiveSelectionManager();
@@ -313,10 +332,131 @@ void DesignControlsController::startDragOperation()
         }
     }
     
+    // Capture the selected elements and their descendants for the updates.
+    // Parents of descendants are among the captured elements, so only the
+    // selected ones need a model lookup to find a flex parent
+    ElementModel* elementModel = getActiveElementModel();
+    QHash<QString, Element*> captured;
+    auto capture = [&](CanvasElement* element, bool selected) {
+        Frame* frame = element->getType() == Element::FrameType ? qobject_cast<Frame*>(element) : nullptr;
+        Frame* flexParent = nullptr;
+        if (frame && frame->position() == Frame::Relative) {
+            Element* parent = captured.value(frame->getParentElementId());
+            if (!parent && elementModel) {
+                parent = elementModel->getElementById(frame->getParentElementId());
+            }
+            Frame* parentFrame = parent && parent->getType() == Element::FrameType ? qobject_cast<Frame*>(parent) : nullptr;
+            if (parentFrame && parentFrame->flex()) {
+                flexParent = parentFrame;
+            }
+        }
+        captured.insert(element->getId(), element);
+        m_dragStartStates.append({element, element->rect(), flexParent, selected, !frame || frame->controlled()});
+        
+        // A resize grows fit-content flex parents from their starting size
+        if (selected && flexParent && !m_dragStartFlexParentSizes.contains(flexParent->getId())) {
+            m_dragStartFlexParentSizes.insert(flexParent->getId(), flexParent->rect().size());
+        }
+    };
+    for (Element* element : std::as_const(m_dragStartSelectedElements)) {
+        capture(static_cast<CanvasElement*>(element), true);
+        if (!elementModel) continue;
+        for (Element* child : elementModel->getChildrenRecursive(element->getId())) {
+            if (CanvasElement* canvasChild = qobject_cast<CanvasElement*>(child)) {
+                capture(canvasChild, false);
+            }
+        }
+    }
+    
+    // Snap against the canvas's hit-testable elements, leaving out the ones
+    // being dragged
+    if (DesignCanvas* designCanvas = getActiveDesignCanvas()) {
+        m_snappingService.setHitTestService(designCanvas->hitTestService());
+    }
+    m_snappingService.beginSession(m_dragStartSelectedElements);
+}
+
+void DesignControlsController::updateMoveOperation(const QPointF& controlPosition)
+{
+    if (InputRecorder* recorder = getActiveInputRecorder()) {
+        recorder->record(InputEvent::DragMove, controlPosition.x(), controlPosition.y());
+    }
+    
+    // Simple translation; frames the flex layout places stay where it puts them
+    const QPointF delta = controlPosition - m_dragStartControlRect.topLeft();
+    for (const DragStartState& state : std::as_const(m_dragStartStates)) {
+        if (!state.controlled || state.flexParent) continue;
+        
+        state.element->setX(state.rect.x() + delta.x());
+        state.element->setY(state.rect.y() + delta.y());
+    }
+}
+
+void DesignControlsController::updateResizeOperation(const QRectF& controlRect)
+{
+    if (InputRecorder* recorder = getActiveInputRecorder()) {
+        recorder->recordRect(InputEvent::DragResize, controlRect);
+    }
+    
+    // Scale from the starting control size; a negative size flips the
+    // selection around the controls' far edge
+    const QRectF& start = m_dragStartControlRect;
+    const qreal scaleX = qFuzzyIsNull(start.width()) ? 1.0 : controlRect.width() / start.width();
+    const qreal scaleY = qFuzzyIsNull(start.height()) ? 1.0 : controlRect.height() / start.height();
+    const qreal absScaleX = qAbs(scaleX);
+    const qreal absScaleY = qAbs(scaleY);
+    const QPointF delta = controlRect.topLeft() - start.topLeft();
+    const QSizeF sizeDelta = controlRect.size() - start.size();
+    
+    for (const DragStartState& state : std::as_const(m_dragStartStates)) {
+        if (!state.controlled) continue;
+        CanvasElement* element = state.element;
+        
+        if (state.selected && !state.flexParent) {
+            // Selected elements scale with the controls
+            const qreal relX = state.rect.x() - start.x();
+            const qreal relY = state.rect.y() - start.y();
+            const qreal newX = scaleX < 0
+                ? controlRect.x() + qAbs(controlRect.width()) - (relX + state.rect.width()) * absScaleX
+                : controlRect.x() + relX * absScaleX;
+            const qreal newY = scaleY < 0
+                ? controlRect.y() + qAbs(controlRect.height()) - (relY + state.rect.height()) * absScaleY
+                : controlRect.y() + relY * absScaleY;
+            
+            element->setX(newX);
+            element->setY(newY);
+            element->setWidth(std::max(1.0, state.rect.width() * absScaleX));
+            element->setHeight(std::max(1.0, state.rect.height() * absScaleY));
+        } else if (state.selected) {
+            // A flex child grows by the drag distance and the layout places
+            // it; its parent follows only along fit-content axes
+            element->setWidth(std::max(1.0, state.rect.width() + sizeDelta.width()));
+            element->setHeight(std::max(1.0, state.rect.height() + sizeDelta.height()));
+            
+            const QSizeF parentSize = m_dragStartFlexParentSizes.value(state.flexParent->getId());
+            if (state.flexParent->widthType() == Frame::SizeFitContent) {
+                state.flexParent->setWidth(std::max(1.0, parentSize.width() + sizeDelta.width()));
+            }
+            if (state.flexParent->heightType() == Frame::SizeFitContent) {
+                state.flexParent->setHeight(std::max(1.0, parentSize.height() + sizeDelta.height()));
+            }
+        } else if (!state.flexParent) {
+            // Descendants keep their size and follow the controls' origin
+            element->setX(state.rect.x() + delta.x());
+            element->setY(state.rect.y() + delta.y());
+        }
+    }
 }
 
 void DesignControlsController::endMoveOperation(const QPointF& totalDelta)
 {
+    if (InputRecorder* recorder = getActiveInputRecorder()) {
+        recorder->record(InputEvent::DragEndMove, totalDelta.x(), totalDelta.y());
+    }
+    
+    m_snappingService.endSession();
+    m_dragStartStates.clear();
+    m_dragStartFlexParentSizes.clear();
     
     // Only fire command if there was actual movement
     if (qAbs(totalDelta.x()) < 0.001 && qAbs(totalDelta.y()) < 0.001) {
@@ -340,6 +480,13 @@ void DesignControlsController::endMoveOperation(const QPointF& totalDelta)
 
 void DesignControlsController::endResizeOperation()
 {
+    if (InputRecorder* recorder = getActiveInputRecorder()) {
+        recorder->record(InputEvent::DragEndResize);
+    }
+    
+    m_snappingService.endSession();
+    m_dragStartStates.clear();
+    m_dragStartFlexParentSizes.clear();
     
     if (m_dragStartSelectedElements.isEmpty()) {
         return;
@@ -372,4 +519,92 @@ void DesignControlsController::endResizeOperation()
             designCanvas->resizeElement(canvasElement, oldRect, newRect);
         }
     }
-}
\ No newline at end of file
+}
+
+bool DesignControlsController::reorderInFlexParent(QObject* element, const QPointF& canvasPoint)
+{
+    Frame* dragged = qobject_cast<Frame*>(element);
+    if (!dragged || dragged->position() != Frame::Relative) {
+        return false; // Only relatively positioned frames take part in the layout
+    }
+    
+    ElementModel* elementModel = getActiveElementModel();
+    if (!elementModel) {
+        return false;
+    }
+    
+    Frame* parentFrame = qobject_cast<Frame*>(elementModel->getElementById(dragged->getParentElementId()));
+    if (!parentFrame || !parentFrame->flex()) {
+        return false;
+    }
+    
+    // The flex engine lays siblings out in model order, so their centers along
+    // the layout axis are sorted and the drop slot can be bisected
+    const bool isRow = parentFrame->orientation() == Frame::Row;
+    QList<Frame*> siblings;
+    std::vector<qreal> centers;
+    int currentSlot = -1;
+    for (Element* child : elementModel->getDirectChildren(parentFrame->getId())) {
+        Frame* frame = qobject_cast<Frame*>(child);
+        if (!frame || frame->position() != Frame::Relative) continue;
+        
+        if (frame == dragged) {
+            currentSlot = siblings.size();
+            continue;
+        }
+        siblings.append(frame);
+        centers.push_back(isRow ? frame->x() + frame->width() / 2 : frame->y() + frame->height() / 2);
+    }
+    
+    if (siblings.isEmpty() || currentSlot < 0) {
+        return false;
+    }
+    
+    const qreal along = isRow ? canvasPoint.x() : canvasPoint.y();
+    const int slot = static_cast<int>(std::upper_bound(centers.begin(), centers.end(), along) - centers.begin());
+    if (slot == currentSlot) {
+        return false;
+    }
+    
+    // Land just before the sibling now in that slot, or after the last one
+    const int currentIndex = elementModel->rowOf(dragged);
+    int newIndex;
+    if (slot < siblings.size()) {
+        const int anchorIndex = elementModel->rowOf(siblings[slot]);
+        newIndex = anchorIndex > currentIndex ? anchorIndex - 1 : anchorIndex;
+    } else {
+        const int anchorIndex = elementModel->rowOf(siblings.last());
+        newIndex = anchorIndex > currentIndex ? anchorIndex : anchorIndex + 1;
+    }
+    
+    elementModel->reorderElement(dragged, newIndex);
+    
+    // Only the frame whose children moved needs a new layout
+    parentFrame->triggerLayout();
+    return true;
+}
+
+QVariantMap DesignControlsController::snapRect(const QRectF& rect, int edges, const QRectF& visibleRect, qreal zoom)
+{
+    const SnappingService::Result snapped = m_snappingService.snap(rect, edges, visibleRect, zoom);
+    
+    const auto toVariant = [](const QList<QLineF>& lines) {
+        QVariantList result;
+        result.reserve(lines.size());
+        for (const QLineF& line : lines) {
+            QVariantMap entry;
+            entry["x1"] = line.x1();
+            entry["y1"] = line.y1();
+            entry["x2"] = line.x2();
+            entry["y2"] = line.y2();
+            result.append(entry);
+        }
+        return result;
+    };
+    
+    QVariantMap result;
+    result["rect"] = snapped.rect;
+    result["guides"] = toVariant(snapped.guides);
+    result["spacings"] = toVariant(snapped.spacings);
+    return result;
+}
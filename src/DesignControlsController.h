@@ -1,9 +1,12 @@
 #pragma once
 #include <QObject>
 #include <QPointF>
+#include <QRectF>
 #include <QSizeF>
 #include <QHash>
 #include <QList>
+#include <QVariantMap>
+#include "SnappingService.h"
 
 // Forward declarations
 class Application;
@@ -11,6 +14,9 @@ class DesignCanvas;
 class SelectionManager;
 class ElementModel;
 class Element;
+class CanvasElement;
+class Frame;
+class InputRecorder;
 
 // Forward declare Project for Q_PROPERTY
 class Project;
@@ -52,11 +58,26 @@ public:
     // Helper methods for coordinate transformation
     Q_INVOKABLE QPointF mapToCanvas(QObject* parent, const QPointF& point, qreal zoom, QObject* flickable, const QPointF& canvasMin) const;
     
-    // Design controls drag operation methods
-    Q_INVOKABLE void startDragOperation();
+    // Design controls drag operation methods. controlRect is the controls'
+    // rectangle in canvas coordinates when the drag starts; each update then
+    // applies the controls' current position or rectangle to the elements
+    // captured at the start
+    Q_INVOKABLE void startDragOperation(const QRectF& controlRect);
+    Q_INVOKABLE void updateMoveOperation(const QPointF& controlPosition);
+    Q_INVOKABLE void updateResizeOperation(const QRectF& controlRect);
     Q_INVOKABLE void endMoveOperation(const QPointF& totalDelta);
     Q_INVOKABLE void endResizeOperation();
     
+    // Move a relatively positioned frame to the flex slot under canvasPoint
+    // while it is dragged; returns true when the order changed
+    Q_INVOKABLE bool reorderInFlexParent(QObject* element, const QPointF& canvasPoint);
+    
+    // Snap the dragged control rectangle, in canvas coordinates, to the
+    // elements around it. edges combines SnappingService::Edge values for the
+    // sides being dragged. Returns the snapped rect, plus guides and spacings
+    // as lists of {x1, y1, x2, y2} lines in canvas coordinates
+    Q_INVOKABLE QVariantMap snapRect(const QRectF& rect, int edges, const QRectF& visibleRect, qreal zoom);
+    
 signals:
     void isResizingEnabledChanged();
     void isMovementEnabledChanged();
@@ -77,6 +98,7 @@ private:
     DesignCanvas* getActiveDesignCanvas() const;
     SelectionManager* getActiveSelectionManager() const;
     ElementModel* getActiveElementModel() const;
+    InputRecorder* getActiveInputRecorder() const;
     
     // Cache for current state
     mutable bool m_cachedIsResizingEnabled = true;
@@ -90,6 +112,21 @@ private:
     QHash<QString, QPointF> m_dragStartElementPositions;
     QHash<QString, QSizeF> m_dragStartElementSizes;
     
+    // Geometry of the selected elements and their descendants at drag start
+    struct DragStartState {
+        CanvasElement* element;
+        QRectF rect;
+        Frame* flexParent;  // Set for relatively positioned frames the flex layout places
+        bool selected;
+        bool controlled;
+    };
+    QList<DragStartState> m_dragStartStates;
+    QHash<QString, QSizeF> m_dragStartFlexParentSizes;
+    QRectF m_dragStartControlRect;
+    
+    // Alignment snapping for the drag in progress
+    SnappingService m_snappingService;
+    
     // Update cache and emit signals if needed
     void updateCache();
     void connectToActiveCanvas();
@@ -45,20 +45,24 @@ void DesignElement::executeScriptEvent(const QString& eventName, const QVariantM
     }
     
     
+    // Get element model and project from the parent hierarchy
+    ElementModel* elementModel = qobject_cast<ElementModel*>(parent());
+    Project* project = elementModel ? qobject_cast<Project*>(elementModel->parent()) : nullptr;
+    
+    // Run through the project's runtime so heavy scripts stay off the GUI thread
+    if (project && project->scriptRuntime()) {
+        project->scriptRuntime()->executeEvent(m_scripts.get(), eventName, eventData);
+        return;
+    }
+    
     // Create a temporary script executor for this element
     ScriptExecutor executor(this);
     executor.setScripts(m_scripts.get());
-    
-    // Get element model and canvas controller from the parent hierarchy
-    ElementModel* elementModel = qobject_cast<ElementModel*>(parent());
     if (elementModel) {
         executor.setElementModel(elementModel);
-        
-        // Get the Project from the ElementModel's parent
-        Project* project = qobject_cast<Project*>(elementModel->parent());
-        if (project && project->controller()) {
-            executor.setCanvasController(project->controller());
-        }
+    }
+    if (project && project->controller()) {
+        executor.setCanvasController(project->controller());
     }
     
     executor.executeEvent(eventName, eventData);
@@ -66,6 +70,7 @@ void DesignElement::executeScriptEvent(const QString& eventName, const QVariantM
 
 void DesignElement::setLeft(qreal value) {
     if (!qFuzzyCompare(m_left, value)) {
+        notifyAboutToChange();
         m_left = value;
         emit leftChanged();
         
@@ -90,6 +95,7 @@ void DesignElement::setLeft(qreal value) {
 
 void DesignElement::setRight(qreal value) {
     if (!qFuzzyCompare(m_right, value)) {
+        notifyAboutToChange();
         m_right = value;
         emit rightChanged();
         
@@ -113,6 +119,7 @@ void DesignElement::setRight(qreal value) {
 
 void DesignElement::setTop(qreal value) {
     if (!qFuzzyCompare(m_top, value)) {
+        notifyAboutToChange();
         m_top = value;
         emit topChanged();
         
@@ -137,6 +144,7 @@ void DesignElement::setTop(qreal value) {
 
 void DesignElement::setBottom(qreal value) {
     if (!qFuzzyCompare(m_bottom, value)) {
+        notifyAboutToChange();
         m_bottom = value;
         emit bottomChanged();
         
@@ -160,6 +168,7 @@ void DesignElement::setBottom(qreal value) {
 
 void DesignElement::setLeftAnchored(bool anchored) {
     if (m_leftAnchored != anchored) {
+        notifyAboutToChange();
         m_leftAnchored = anchored;
         emit leftAnchoredChanged();
         
@@ -175,6 +184,7 @@ void DesignElement::setLeftAnchored(bool anchored) {
 
 void DesignElement::setRightAnchored(bool anchored) {
     if (m_rightAnchored != anchored) {
+        notifyAboutToChange();
         m_rightAnchored = anchored;
         emit rightAnchoredChanged();
         
@@ -190,6 +200,7 @@ void DesignElement::setRightAnchored(bool anchored) {
 
 void DesignElement::setTopAnchored(bool anchored) {
     if (m_topAnchored != anchored) {
+        notifyAboutToChange();
         m_topAnchored = anchored;
         emit topAnchoredChanged();
         
@@ -205,6 +216,7 @@ void DesignElement::setTopAnchored(bool anchored) {
 
 void DesignElement::setBottomAnchored(bool anchored) {
     if (m_bottomAnchored != anchored) {
+        notifyAboutToChange();
         m_bottomAnchored = anchored;
         emit bottomAnchoredChanged();
         
@@ -0,0 +1,404 @@
+#include "EdgesModel.h"
+#include "Edge.h"
+#include "Node.h"
+#include "Scripts.h"
+#include <QDebug>
+
+namespace {
+// Node layout metrics, matching NodeElement.qml
+constexpr qreal kHeaderHeight = 30.0;
+constexpr qreal kRowsTopMargin = 15.0;
+constexpr qreal kColumnsMargin = 10.0;
+constexpr qreal kColumnSpacing = 20.0;
+constexpr qreal kRowPitch = 40.0;          // 30px row + 10px spacing
+constexpr qreal kHalfRow = 15.0;
+constexpr qreal kHalfHandle = 10.0;
+constexpr qreal kVariableHandleInset = 15.0;
+}
+
+EdgesModel::EdgesModel(QObject *parent)
+    : QAbstractListModel(parent)
+{
+}
+
+int EdgesModel::rowCount(const QModelIndex &parent) const
+{
+    if (parent.isValid())
+        return 0;
+    return m_edges.size();
+}
+
+QVariant EdgesModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_edges.size())
+        return QVariant();
+
+    Edge *edge = m_edges.at(index.row());
+    switch (role) {
+    case ElementRole:
+        return QVariant::fromValue(edge);
+    case ElementIdRole:
+        return edge->getId();
+    case ElementTypeRole:
+        return edge->getTypeName();
+    case SourceNodeRole:
+        return QVariant::fromValue(m_nodesById.value(edge->sourceNodeId()));
+    case TargetNodeRole:
+        return QVariant::fromValue(m_nodesById.value(edge->targetNodeId()));
+    case SourcePointRole:
+        return edge->sourcePoint();
+    case TargetPointRole:
+        return edge->targetPoint();
+    default:
+        return QVariant();
+    }
+}
+
+QHash<int, QByteArray> EdgesModel::roleNames() const
+{
+    QHash<int, QByteArray> roles;
+    roles[ElementRole] = "element";
+    roles[ElementIdRole] = "elementId";
+    roles[ElementTypeRole] = "elementType";
+    roles[SourceNodeRole] = "sourceNode";
+    roles[TargetNodeRole] = "targetNode";
+    roles[SourcePointRole] = "sourcePoint";
+    roles[TargetPointRole] = "targetPoint";
+    return roles;
+}
+
+void EdgesModel::setScripts(Scripts *scripts)
+{
+    if (m_scripts == scripts) return;
+
+    if (m_scripts) {
+        disconnect(m_scripts, nullptr, this, nullptr);
+    }
+
+    m_scripts = scripts;
+
+    if (m_scripts) {
+        connect(m_scripts, &Scripts::nodeAdded, this, &EdgesModel::onNodeAdded);
+        connect(m_scripts, &Scripts::nodeRemoved, this, &EdgesModel::onNodeRemoved);
+        connect(m_scripts, &Scripts::edgeAdded, this, &EdgesModel::onEdgeAdded);
+        connect(m_scripts, &Scripts::edgeRemoved, this, &EdgesModel::onEdgeRemoved);
+        // clearNodes()/clearEdges() only emit the *Changed signals; catch them by count
+        connect(m_scripts, &Scripts::nodesChanged, this, [this]() {
+            if (m_scripts && m_scripts->nodeCount() != m_nodesById.size()) {
+                resync();
+            }
+        });
+        connect(m_scripts, &Scripts::edgesChanged, this, [this]() {
+            if (m_scripts && m_scripts->edgeCount() != m_edges.size()) {
+                resync();
+            }
+        });
+        connect(m_scripts, &QObject::destroyed, this, &EdgesModel::resync);
+    }
+
+    resync();
+    emit scriptsChanged();
+}
+
+Edge* EdgesModel::edgeAt(int row) const
+{
+    if (row >= 0 && row < m_edges.size()) {
+        return m_edges.at(row);
+    }
+    return nullptr;
+}
+
+void EdgesModel::updateAllEndpoints()
+{
+    for (Edge *edge : std::as_const(m_edges)) {
+        updateEndpoints(edge);
+    }
+}
+
+bool EdgesModel::sourcePortPosition(const Node *node, int portIndex, QPointF &point)
+{
+    if (node->nodeType() == "Variable") {
+        // Variable nodes have a single output handle in the header
+        point = QPointF(node->x() + node->width() - kVariableHandleInset,
+                        node->y() + kVariableHandleInset);
+        return true;
+    }
+
+    if (portIndex == -1) {
+        // Flow output sits at the right edge of the first row
+        point = QPointF(node->x() + node->width() - kColumnsMargin - kHalfHandle,
+                        node->y() + kHeaderHeight + kRowsTopMargin + kHalfRow);
+        return true;
+    }
+
+    int sourceRow = 0;
+    for (const Node::RowConfig &row : node->rows()) {
+        if (!row.hasSource) continue;
+        if (row.sourcePortIndex == portIndex) {
+            const qreal columnWidth = (node->width() - 2 * kColumnsMargin - kColumnSpacing) / 2;
+            const qreal rightColumnX = node->x() + kColumnsMargin + columnWidth + kColumnSpacing;
+            point = QPointF(rightColumnX + columnWidth - kHalfHandle,
+                            node->y() + kHeaderHeight + kRowsTopMargin + sourceRow * kRowPitch + kHalfRow);
+            return true;
+        }
+        ++sourceRow;
+    }
+    return false;
+}
+
+bool EdgesModel::targetPortPosition(const Node *node, int portIndex, QPointF &point)
+{
+    if (portIndex == -1) {
+        // Flow input sits at the left edge of the first row
+        point = QPointF(node->x() + kColumnsMargin + kHalfHandle,
+                        node->y() + kHeaderHeight + kRowsTopMargin + kHalfRow);
+        return true;
+    }
+
+    int targetRow = 0;
+    for (const Node::RowConfig &row : node->rows()) {
+        if (!row.hasTarget) continue;
+        if (row.targetPortIndex == portIndex) {
+            point = QPointF(node->x() + kColumnsMargin + kHalfHandle,
+                            node->y() + kHeaderHeight + kRowsTopMargin + targetRow * kRowPitch + kHalfRow);
+            return true;
+        }
+        ++targetRow;
+    }
+    return false;
+}
+
+void EdgesModel::resync()
+{
+    const int oldCount = m_edges.size();
+
+    beginResetModel();
+    for (auto it = m_nodeIds.cbegin(); it != m_nodeIds.cend(); ++it) {
+        disconnect(it.key(), nullptr, this, nullptr);
+    }
+    for (Edge *edge : std::as_const(m_edges)) {
+        disconnect(edge, nullptr, this, nullptr);
+    }
+    m_edges.clear();
+    m_rows.clear();
+    m_nodesById.clear();
+    m_nodeIds.clear();
+    m_incidentEdges.clear();
+    m_indexedEnds.clear();
+
+    if (m_scripts) {
+        for (Node *node : m_scripts->getAllNodes()) {
+            watchNode(node);
+        }
+        const QList<Edge*> edges = m_scripts->getAllEdges();
+        m_edges.reserve(edges.size());
+        for (Edge *edge : edges) {
+            m_rows.insert(edge, m_edges.size());
+            m_edges.append(edge);
+            indexEdge(edge);
+        }
+    }
+    endResetModel();
+
+    // Edges loaded from a file have no positions until their nodes are placed
+    updateAllEndpoints();
+
+    if (m_edges.size() != oldCount) {
+        emit countChanged();
+    }
+}
+
+void EdgesModel::watchNode(Node *node)
+{
+    m_nodesById.insert(node->getId(), node);
+    m_nodeIds.insert(node, node->getId());
+    connect(node, &CanvasElement::geometryChanged, this, &EdgesModel::onNodeGeometryChanged);
+    connect(node, &Node::rowConfigurationsChanged, this, &EdgesModel::onNodeGeometryChanged);
+    connect(node, &QObject::destroyed, this, &EdgesModel::onObjectDestroyed);
+}
+
+void EdgesModel::onNodeAdded(Node *node)
+{
+    if (!node || m_nodeIds.contains(node)) return;
+
+    watchNode(node);
+
+    // Edges may have been added before the node they point at
+    const QList<Edge*> edges = m_incidentEdges.values(node->getId());
+    for (Edge *edge : edges) {
+        updateEndpoints(edge);
+        emitRowChanged(edge);
+    }
+}
+
+void EdgesModel::onNodeRemoved(Node *node)
+{
+    if (!node || !m_nodeIds.contains(node)) return;
+
+    const QString nodeId = m_nodeIds.take(node);
+    disconnect(node, nullptr, this, nullptr);
+    if (m_nodesById.value(nodeId) == node) {
+        m_nodesById.remove(nodeId);
+    }
+
+    // Scripts removes incident edges first; anything left just loses its endpoint
+    const QList<Edge*> edges = m_incidentEdges.values(nodeId);
+    for (Edge *edge : edges) {
+        emitRowChanged(edge);
+    }
+}
+
+void EdgesModel::onEdgeAdded(Edge *edge)
+{
+    if (edge && !m_rows.contains(edge)) {
+        insertEdge(edge);
+    }
+}
+
+void EdgesModel::onEdgeRemoved(Edge *edge)
+{
+    removeRow(m_rows.value(edge, -1));
+}
+
+void EdgesModel::onNodeGeometryChanged()
+{
+    Node *node = qobject_cast<Node*>(sender());
+    if (!node) return;
+
+    // Only the edges attached to this node need new port positions
+    const QList<Edge*> edges = m_incidentEdges.values(node->getId());
+    for (Edge *edge : edges) {
+        updateEndpoints(edge);
+    }
+}
+
+void EdgesModel::onEdgeEndpointsChanged()
+{
+    Edge *edge = qobject_cast<Edge*>(sender());
+    if (!edge || !m_rows.contains(edge)) return;
+
+    unindexEdge(edge);
+    indexEdge(edge);
+    updateEndpoints(edge);
+    emitRowChanged(edge);
+}
+
+void EdgesModel::onObjectDestroyed(QObject *object)
+{
+    // Compare addresses only; the Node/Edge part of the object is already gone
+    if (m_nodeIds.contains(object)) {
+        const QString nodeId = m_nodeIds.take(object);
+        if (static_cast<QObject*>(m_nodesById.value(nodeId)) == object) {
+            m_nodesById.remove(nodeId);
+        }
+        return;
+    }
+    for (int row = 0; row < m_edges.size(); ++row) {
+        if (static_cast<QObject*>(m_edges.at(row)) == object) {
+            removeRow(row);
+            return;
+        }
+    }
+}
+
+void EdgesModel::insertEdge(Edge *edge)
+{
+    const int row = m_edges.size();
+    beginInsertRows(QModelIndex(), row, row);
+    m_rows.insert(edge, row);
+    m_edges.append(edge);
+    indexEdge(edge);
+    endInsertRows();
+
+    updateEndpoints(edge);
+    emit countChanged();
+}
+
+void EdgesModel::removeRow(int row)
+{
+    if (row < 0 || row >= m_edges.size()) return;
+
+    beginRemoveRows(QModelIndex(), row, row);
+    Edge *edge = m_edges.takeAt(row);
+    unindexEdge(edge);
+    disconnect(edge, nullptr, this, nullptr);
+    m_rows.remove(edge);
+    rebuildRows(row);
+    endRemoveRows();
+    emit countChanged();
+}
+
+void EdgesModel::rebuildRows(int fromRow)
+{
+    for (int row = fromRow; row < m_edges.size(); ++row) {
+        m_rows[m_edges.at(row)] = row;
+    }
+}
+
+void EdgesModel::indexEdge(Edge *edge)
+{
+    const QString sourceId = edge->sourceNodeId();
+    const QString targetId = edge->targetNodeId();
+    m_incidentEdges.insert(sourceId, edge);
+    if (targetId != sourceId) {
+        m_incidentEdges.insert(targetId, edge);
+    }
+    m_indexedEnds.insert(edge, qMakePair(sourceId, targetId));
+
+    // Re-indexing after an endpoint change reconnects; UniqueConnection keeps it single
+    connect(edge, &Edge::sourceNodeIdChanged, this, &EdgesModel::onEdgeEndpointsChanged, Qt::UniqueConnection);
+    connect(edge, &Edge::targetNodeIdChanged, this, &EdgesModel::onEdgeEndpointsChanged, Qt::UniqueConnection);
+    connect(edge, &Edge::sourcePortIndexChanged, this, &EdgesModel::onEdgeEndpointsChanged, Qt::UniqueConnection);
+    connect(edge, &Edge::targetPortIndexChanged, this, &EdgesModel::onEdgeEndpointsChanged, Qt::UniqueConnection);
+    connect(edge, &QObject::destroyed, this, &EdgesModel::onObjectDestroyed, Qt::UniqueConnection);
+}
+
+void EdgesModel::unindexEdge(Edge *edge)
+{
+    // The edge's node ids may already have changed; remove by the ids it was indexed under
+    const QPair<QString, QString> ends = m_indexedEnds.take(edge);
+    m_incidentEdges.remove(ends.first, edge);
+    m_incidentEdges.remove(ends.second, edge);
+}
+
+void EdgesModel::updateEndpoints(Edge *edge)
+{
+    const Node *sourceNode = m_nodesById.value(edge->sourceNodeId());
+    const Node *targetNode = m_nodesById.value(edge->targetNodeId());
+    if (!sourceNode || !targetNode) return;
+
+    QPointF sourcePoint;
+    QPointF targetPoint;
+    if (!sourcePortPosition(sourceNode, edge->sourcePortIndex(), sourcePoint)) {
+        qWarning() << "EdgesModel: source port" << edge->sourcePortIndex()
+                   << "not found on node" << sourceNode->nodeTitle();
+        return;
+    }
+    if (!targetPortPosition(targetNode, edge->targetPortIndex(), targetPoint)) {
+        qWarning() << "EdgesModel: target port" << edge->targetPortIndex()
+                   << "not found on node" << targetNode->nodeTitle();
+        return;
+    }
+
+    if (edge->sourcePoint() == sourcePoint && edge->targetPoint() == targetPoint) {
+        return;
+    }
+
+    edge->setSourcePoint(sourcePoint);
+    edge->setTargetPoint(targetPoint);
+
+    const int row = m_rows.value(edge, -1);
+    if (row >= 0) {
+        QModelIndex modelIndex = index(row, 0);
+        emit dataChanged(modelIndex, modelIndex, {SourcePointRole, TargetPointRole});
+    }
+}
+
+void EdgesModel::emitRowChanged(Edge *edge)
+{
+    const int row = m_rows.value(edge, -1);
+    if (row >= 0) {
+        QModelIndex modelIndex = index(row, 0);
+        emit dataChanged(modelIndex, modelIndex);
+    }
+}
@@ -0,0 +1,87 @@
+#pragma once
+#include <QAbstractListModel>
+#include <QHash>
+#include <QList>
+#include <QMultiHash>
+#include <QPointF>
+#include <QPointer>
+
+class Edge;
+class Node;
+class Scripts;
+
+/**
+ * EdgesModel lists the edges of a Scripts graph with their endpoint nodes
+ * resolved, so edge delegates do not search the element model for them.
+ *
+ * The model keeps a node id -> incident edges index. When a node moves or
+ * resizes only the edges attached to it get new port positions, which are
+ * written back to the Edge (sourcePoint/targetPoint) and announced with a
+ * per-row dataChanged.
+ */
+class EdgesModel : public QAbstractListModel {
+    Q_OBJECT
+    Q_PROPERTY(Scripts* scripts READ scripts WRITE setScripts NOTIFY scriptsChanged)
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+
+public:
+    enum EdgeRoles {
+        ElementRole = Qt::UserRole + 1,
+        ElementIdRole,
+        ElementTypeRole,
+        SourceNodeRole,
+        TargetNodeRole,
+        SourcePointRole,
+        TargetPointRole
+    };
+
+    explicit EdgesModel(QObject *parent = nullptr);
+
+    // QAbstractListModel interface
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    Scripts* scripts() const { return m_scripts; }
+    void setScripts(Scripts *scripts);
+    int count() const { return m_edges.size(); }
+
+    Q_INVOKABLE Edge* edgeAt(int row) const;
+    Q_INVOKABLE void updateAllEndpoints();
+
+    // Port anchor positions in canvas coordinates; false if the port is not on the node
+    static bool sourcePortPosition(const Node *node, int portIndex, QPointF &point);
+    static bool targetPortPosition(const Node *node, int portIndex, QPointF &point);
+
+signals:
+    void scriptsChanged();
+    void countChanged();
+
+private slots:
+    void onNodeAdded(Node *node);
+    void onNodeRemoved(Node *node);
+    void onEdgeAdded(Edge *edge);
+    void onEdgeRemoved(Edge *edge);
+    void onNodeGeometryChanged();
+    void onEdgeEndpointsChanged();
+    void onObjectDestroyed(QObject *object);
+    void resync();
+
+private:
+    void watchNode(Node *node);
+    void insertEdge(Edge *edge);
+    void removeRow(int row);
+    void indexEdge(Edge *edge);
+    void unindexEdge(Edge *edge);
+    void updateEndpoints(Edge *edge);
+    void emitRowChanged(Edge *edge);
+    void rebuildRows(int fromRow);
+
+    QPointer<Scripts> m_scripts;
+    QList<Edge*> m_edges;
+    QHash<Edge*, int> m_rows;                   // Edge -> row in m_edges
+    QHash<QString, Node*> m_nodesById;
+    QHash<QObject*, QString> m_nodeIds;         // Watched node -> id, for destroyed()
+    QMultiHash<QString, Edge*> m_incidentEdges; // Node id -> edges touching it
+    QHash<Edge*, QPair<QString, QString>> m_indexedEnds;  // Edge -> ids it is indexed under
+};
@@ -66,6 +66,7 @@ public:
     Q_INVOKABLE virtual bool hasProperty(const QString& name) const;
     Q_INVOKABLE virtual QStringList propertyNames() const;
     Q_INVOKABLE virtual QVariantList getPropertyMetadata() const;
+    const PropertyRegistry* propertyRegistry() const { return m_properties.get(); }
     
     // Register element properties - to be overridden by subclasses
     virtual void registerProperties() {}
@@ -12,6 +12,7 @@
 #include <QDebug>
 #include <QPointer>
 #include <QJsonObject>
+#include <algorithm>
 
 ElementModel::ElementModel(QObject *parent)
     : QAbstractListModel(parent)
@@ -43,7 +44,13 @@ QVariant ElementModel::data(const QModelIndex &index, int role) const
     if (!index.isValid() || index.row() >= m_elements.size())
         return QVariant();
     
-    Element *element = m_elements[index.row()];
+    return elementData(m_elements[index.row()], role);
+}
+
+QVariant ElementModel::elementData(Element *element, int role) const
+{
+    if (!element)
+        return QVariant();
     
     switch (role) {
     case ElementRole:
@@ -171,8 +178,10 @@ void ElementModel::addElement(Element *element)
     
     beginInsertRows(QModelIndex(), insertIndex, insertIndex);
     m_elements.insert(insertIndex, element);
+    invalidateRows();
     connectElement(element);
     endInsertRows();
+    indexInsert(element);
     
     emit elementAdded(element);
     emit elementChanged();
@@ -198,6 +207,50 @@ void ElementModel::addElement(Element *element)
     } else {    }
 }
 
+void ElementModel::addElements(const QList<Element*> &elements)
+{
+    QList<Element*> added;
+    added.reserve(elements.size());
+    QSet<Element*> seen;
+    for (Element *element : elements) {
+        if (!element) continue;
+        if (m_indexedParentIds.contains(element) || seen.contains(element)) {
+            qWarning() << "ElementModel::addElements - Element already in model:" << element->getId();
+            continue;
+        }
+        seen.insert(element);
+        added.append(element);
+    }
+    if (added.isEmpty()) return;
+    
+    for (Element *element : added) {
+        if (!element->parent()) {
+            element->setParent(this);
+        }
+        if (Frame* frame = qobject_cast<Frame*>(element)) {
+            frame->setElementModel(this);
+        }
+    }
+    
+    const int first = m_elements.size();
+    beginInsertRows(QModelIndex(), first, first + added.size() - 1);
+    m_elements.append(added);
+    invalidateRows();
+    // Connected after all are in, so an instance finds a source that comes later
+    for (Element *element : added) {
+        connectElement(element);
+    }
+    endInsertRows();
+    for (Element *element : added) {
+        indexInsert(element);
+    }
+    
+    for (Element *element : added) {
+        emit elementAdded(element);
+    }
+    emit elementChanged();
+}
+
 void ElementModel::removeElement(const QString &elementId)
 {
     int index = findElementIndex(elementId);
@@ -235,8 +288,10 @@ void ElementModel::removeElement(const QString &elementId)
             if (instanceIndex >= 0) {
                 beginRemoveRows(QModelIndex(), instanceIndex, instanceIndex);
                 Element* instanceElement = m_elements.takeAt(instanceIndex);
+                invalidateRows();
                 disconnectElement(instanceElement);
                 endRemoveRows();
+                indexRemove(instanceElement);
                 emit elementRemoved(instanceId);
                 instanceElement->deleteLater();
             }
@@ -249,8 +304,10 @@ void ElementModel::removeElement(const QString &elementId)
     
     beginRemoveRows(QModelIndex(), index, index);
     element = m_elements.takeAt(index);
+    invalidateRows();
     disconnectElement(element);
     endRemoveRows();
+    indexRemove(element);
     
     emit elementRemoved(elementId);
     emit elementChanged();
@@ -266,8 +323,10 @@ void ElementModel::removeElementWithoutDelete(Element *element)
     
     beginRemoveRows(QModelIndex(), index, index);
     m_elements.removeAt(index);
+    invalidateRows();
     disconnectElement(element);
     endRemoveRows();
+    indexRemove(element);
     
     emit elementRemoved(element->getId());
     emit elementChanged();
@@ -300,11 +359,16 @@ void ElementModel::clear()
     // Make a copy to avoid issues if elements are deleted during iteration
     QList<Element*> elementsToDelete = m_elements;
     m_elements.clear();
+    invalidateRows();
+    m_childIndex.clear();
+    m_indexedParentIds.clear();
+    invalidateHierarchy();
     
     // End the model reset before deleting elements
     // This ensures QML views are notified that the model is empty
     // before we start destroying the actual objects
     endResetModel();
+    emit childIndexReset();
     
     // Now delete the elements after QML has been notified
     for (Element *element : elementsToDelete) {
@@ -378,6 +442,7 @@ void ElementModel::connectElement(Element *element)
 {
     connect(element, &Element::elementChanged, this, &ElementModel::onElementChanged);
     connect(element, &Element::selectedChanged, this, &ElementModel::onElementChanged);
+    connect(element, &Element::parentIdChanged, this, &ElementModel::onElementParentIdChanged);
     
     // Connect to handle when this element is added as a child to a source element
     connect(element, &Element::childAddedToSourceElement,
@@ -418,6 +483,181 @@ void ElementModel::disconnectElement(Element *element)
     // Use QObject::disconnect which is safer during destruction
     QObject::disconnect(element, &Element::elementChanged, this, &ElementModel::onElementChanged);
     QObject::disconnect(element, &Element::selectedChanged, this, &ElementModel::onElementChanged);
+    QObject::disconnect(element, &Element::parentIdChanged, this, &ElementModel::onElementParentIdChanged);
+}
+
+void ElementModel::onElementParentIdChanged()
+{
+    Element *element = qobject_cast<Element*>(sender());
+    if (!element || !m_indexedParentIds.contains(element)) return;
+    
+    const QString parentId = element->getParentElementId();
+    if (m_indexedParentIds.value(element) != parentId) {
+        indexRemove(element);
+        indexInsert(element, siblingRowFor(element, parentId));
+    }
+}
+
+int ElementModel::siblingRowFor(Element *element, const QString &parentId) const
+{
+    // Siblings are filed in model order, so element's row places it among them
+    const auto siblings = m_childIndex.constFind(parentId);
+    if (siblings == m_childIndex.constEnd()) {
+        return 0;
+    }
+    const int row = rowOf(element);
+    const auto it = std::lower_bound(siblings->begin(), siblings->end(), row,
+                                     [this](const Element *sibling, int r) { return rowOf(sibling) < r; });
+    return int(it - siblings->begin());
+}
+
+void ElementModel::indexInsert(Element *element, int row)
+{
+    if (m_indexedParentIds.contains(element)) return;
+    
+    const QString parentId = element->getParentElementId();
+    QList<Element*> &siblings = m_childIndex[parentId];
+    
+    // Added elements land after their parent's existing descendants, so they
+    // are always the topmost sibling; a reparent passes its looked-up row
+    if (row < 0 || row > siblings.size()) {
+        row = siblings.size();
+    }
+    
+    siblings.insert(row, element);
+    m_indexedParentIds.insert(element, parentId);
+    invalidateHierarchy();
+    emit childInserted(parentId, row, element);
+}
+
+void ElementModel::indexRemove(Element *element)
+{
+    auto it = m_indexedParentIds.find(element);
+    if (it == m_indexedParentIds.end()) return;
+    
+    const QString parentId = it.value();
+    m_indexedParentIds.erase(it);
+    invalidateHierarchy();
+    
+    auto childrenIt = m_childIndex.find(parentId);
+    if (childrenIt == m_childIndex.end()) return;
+    
+    const int row = childrenIt->indexOf(element);
+    if (row < 0) return;
+    
+    childrenIt->removeAt(row);
+    if (childrenIt->isEmpty()) {
+        m_childIndex.erase(childrenIt);
+    }
+    emit childRemoved(parentId, row);
+}
+
+void ElementModel::indexReposition(Element *element)
+{
+    auto it = m_indexedParentIds.constFind(element);
+    if (it == m_indexedParentIds.constEnd()) return;
+    
+    const QString parentId = it.value();
+    QList<Element*> &siblings = m_childIndex[parentId];
+    const int fromRow = siblings.indexOf(element);
+    if (fromRow < 0) return;
+    
+    siblings.removeAt(fromRow);
+    const int toRow = siblingRowFor(element, parentId);
+    siblings.insert(toRow, element);
+    
+    if (fromRow != toRow) {
+        emit childMoved(parentId, fromRow, toRow);
+    }
+}
+
+void ElementModel::invalidateHierarchy()
+{
+    ++m_hierarchyRevision;
+    m_treeIntervalsValid = false;
+}
+
+void ElementModel::rebuildTreeIntervals() const
+{
+    m_treeIntervals.clear();
+    m_treeIntervals.reserve(m_indexedParentIds.size());
+    
+    QSet<QString> indexedIds;
+    indexedIds.reserve(m_indexedParentIds.size());
+    for (auto it = m_indexedParentIds.constBegin(); it != m_indexedParentIds.constEnd(); ++it) {
+        indexedIds.insert(it.key()->getId());
+    }
+    
+    // Iterative DFS over the parent->children index; a child is numbered on
+    // the way down and closed once all of its children are
+    int counter = 0;
+    struct Visit { const Element *element; int nextChild; };
+    QList<Visit> stack;
+    auto number = [&](const Element *root) {
+        m_treeIntervals.insert(root, TreeInterval{counter++, -1, 0});
+        stack.append({root, 0});
+        while (!stack.isEmpty()) {
+            Visit &top = stack.last();
+            const auto childrenIt = m_childIndex.constFind(top.element->getId());
+            if (childrenIt != m_childIndex.constEnd() && top.nextChild < childrenIt->size()) {
+                const Element *child = childrenIt->at(top.nextChild++);
+                if (!m_treeIntervals.contains(child)) {
+                    m_treeIntervals.insert(child, TreeInterval{counter++, -1, int(stack.size())});
+                    stack.append({child, 0});
+                }
+                continue;
+            }
+            m_treeIntervals[top.element].exit = counter++;
+            stack.removeLast();
+        }
+    };
+    
+    // Roots have no parent or one that is not in the model
+    for (auto it = m_childIndex.constBegin(); it != m_childIndex.constEnd(); ++it) {
+        if (it.key().isEmpty() || !indexedIds.contains(it.key())) {
+            for (const Element *root : it.value()) {
+                number(root);
+            }
+        }
+    }
+    
+    // Whatever is left sits on a parent cycle; break it anywhere
+    for (auto it = m_indexedParentIds.constBegin(); it != m_indexedParentIds.constEnd(); ++it) {
+        if (!m_treeIntervals.contains(it.key())) {
+            number(it.key());
+        }
+    }
+    
+    m_treeIntervalsValid = true;
+}
+
+ElementModel::TreeInterval ElementModel::treeInterval(const Element *element) const
+{
+    if (!m_treeIntervalsValid) {
+        rebuildTreeIntervals();
+    }
+    return m_treeIntervals.value(element);
+}
+
+int ElementModel::rowOf(const Element *element) const
+{
+    if (!m_rowsValid) {
+        m_rows.clear();
+        m_rows.reserve(m_elements.size());
+        for (int i = 0; i < m_elements.size(); ++i) {
+            m_rows.insert(m_elements[i], i);
+        }
+        m_rowsValid = true;
+    }
+    return m_rows.value(element, -1);
+}
+
+bool ElementModel::isDescendantOf(const Element *element, const Element *ancestor) const
+{
+    if (!element || !ancestor) return false;
+    
+    const TreeInterval ancestorInterval = treeInterval(ancestor);
+    return ancestorInterval.isValid() && ancestorInterval.contains(treeInterval(element));
 }
 
 int ElementModel::findElementIndex(const QString &elementId) const
@@ -433,16 +673,25 @@ void ElementModel::reorderElement(Element *element, int newIndex)
 {
     if (!element) return;
     
-    int currentIndex = m_elements.indexOf(element);
+    int currentIndex = rowOf(element);
     if (currentIndex < 0 || currentIndex == newIndex) return;
     
     // Clamp newIndex to valid range
     newIndex = qBound(0, newIndex, m_elements.size() - 1);
     
-    // Perform the reorder
-    beginResetModel();
+    if (currentIndex == newIndex) return;
+    
+    // A row move keeps every other delegate alive; the destination is the
+    // row the element ends up in front of, counted before the move
+    const int destinationRow = newIndex > currentIndex ? newIndex + 1 : newIndex;
+    if (!beginMoveRows(QModelIndex(), currentIndex, currentIndex, QModelIndex(), destinationRow)) return;
     m_elements.move(currentIndex, newIndex);
-    endResetModel();
+    // Only the rows between the two positions shifted
+    for (int row = qMin(currentIndex, newIndex); row <= qMax(currentIndex, newIndex); ++row) {
+        m_rows[m_elements[row]] = row;
+    }
+    endMoveRows();
+    indexReposition(element);
     
     emit elementChanged();
     
@@ -706,6 +955,7 @@ void ElementModel::createChildInstancesForSourceChild(Element* childElement, con
             // Instead, we'll insert it directly
             beginInsertRows(QModelIndex(), m_elements.size(), m_elements.size());
             m_elements.append(newChildInstance);
+            invalidateRows();
             newChildInstance->setParent(this);  // Set parent BEFORE calling setInstanceOf            // Now that parent is set, setInstanceOf can find the ElementModel
             childDesignInstance->setInstanceOf(childElement->getId());
             
@@ -721,6 +971,7 @@ void ElementModel::createChildInstancesForSourceChild(Element* childElement, con
                 canvasChild->setParentElement(parentInstance);
             }            connectElement(newChildInstance);
             endInsertRows();
+            indexInsert(newChildInstance);
             
             emit elementAdded(newChildInstance);
             emit elementChanged();        } else {
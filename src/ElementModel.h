@@ -1,6 +1,7 @@
 #pragma once
 #include <QAbstractListModel>
 #include <QList>
+#include <QHash>
 #include "Element.h"
 
 class ElementModel : public QAbstractListModel {
@@ -28,8 +29,16 @@ public:
     QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
     QHash<int, QByteArray> roleNames() const override;
     
+    // Role data for a single element; shared with ChildrenProxyModel
+    QVariant elementData(Element *element, int role) const;
+    
     // Element management
     Q_INVOKABLE void addElement(Element *element);
+    // Bulk insert for loading: appends the elements in the given order with one
+    // row insertion, so they must already be in model order (each element after
+    // its parent's earlier descendants), as serialized projects are. Unlike
+    // addElement() no child instances are created; loaded data already has them.
+    void addElements(const QList<Element*> &elements);
     Q_INVOKABLE void removeElement(const QString &elementId);
     Q_INVOKABLE void removeElement(Element *element);
     Q_INVOKABLE void removeElementWithoutDelete(Element *element);
@@ -37,6 +46,27 @@ public:
     Q_INVOKABLE Element* elementAt(int index) const;
     Q_INVOKABLE QList<Element*> getAllElements() const { return m_elements; }
     Q_INVOKABLE QList<Element*> getChildrenRecursive(const QString &parentId) const;
+    // Direct children of parentId in z-order (back to front), served from the parent->children index
+    Q_INVOKABLE QList<Element*> getDirectChildren(const QString &parentId) const { return m_childIndex.value(parentId); }
+    
+    // Pre/post-order numbers of an element in the parent hierarchy: a is an
+    // ancestor of d exactly when a.enter < d.enter && d.exit < a.exit.
+    // depth counts the ancestors. All are -1 for elements that are not in the model.
+    struct TreeInterval {
+        int enter = -1;
+        int exit = -1;
+        int depth = -1;
+        bool isValid() const { return enter >= 0; }
+        bool contains(const TreeInterval &other) const { return enter < other.enter && other.exit < exit; }
+    };
+    TreeInterval treeInterval(const Element *element) const;
+    // True when ancestor is a parent, grandparent, ... of element
+    bool isDescendantOf(const Element *element, const Element *ancestor) const;
+    // Bumped whenever an element is added, removed or reparented
+    quint64 hierarchyRevision() const { return m_hierarchyRevision; }
+    // Row of element in the model, or -1; the same as getAllElements().indexOf()
+    // without the scan
+    int rowOf(const Element *element) const;
     Q_INVOKABLE void clear();
     Q_INVOKABLE void reorderElement(Element *element, int newIndex);
     Q_INVOKABLE void refresh();  // Force a refresh of the model
@@ -62,14 +92,44 @@ signals:
     void elementUpdated(Element *element);
     void elementChanged();
     
+    // Parent->children index updates, emitted after the model has changed.
+    // Rows are positions within the parent's direct children.
+    void childInserted(const QString &parentId, int row, Element *child);
+    void childRemoved(const QString &parentId, int row);
+    void childMoved(const QString &parentId, int fromRow, int toRow);
+    void childIndexReset();
+    
 private slots:
     void onElementChanged();
+    void onElementParentIdChanged();
     void onSourceElementPropertyChanged();
     
 private:
     QList<Element*> m_elements;
     QSet<QString> m_connectedSourceElements; // Track which source elements we've connected to
     
+    // Parent->children index, each list in m_elements order
+    QHash<QString, QList<Element*>> m_childIndex;
+    QHash<Element*, QString> m_indexedParentIds;  // Parent each element is currently filed under
+    
+    // Tree intervals, renumbered on the first query after the hierarchy changed
+    mutable QHash<const Element*, TreeInterval> m_treeIntervals;
+    mutable bool m_treeIntervalsValid = false;
+    quint64 m_hierarchyRevision = 0;
+    void invalidateHierarchy();
+    void rebuildTreeIntervals() const;
+    
+    // Rows of m_elements, renumbered on the first lookup after rows were
+    // inserted or removed; reorderElement keeps them current
+    mutable QHash<const Element*, int> m_rows;
+    mutable bool m_rowsValid = false;
+    void invalidateRows() { m_rowsValid = false; }
+    
+    void indexInsert(Element *element, int row = -1);  // -1 appends
+    void indexRemove(Element *element);
+    void indexReposition(Element *element);
+    int siblingRowFor(Element *element, const QString &parentId) const;
+    
     void connectElement(Element *element);
     void disconnectElement(Element *element);
     void connectSourceElement(Element* sourceElement);
@@ -56,6 +56,12 @@ ElementTypeInfo ElementTypeRegistry::getTypeInfo(const QString& typeName) const
     return m_types.value(typeName);
 }
 
+const QMetaObject* ElementTypeRegistry::metaObjectForType(const QString& typeName) const
+{
+    auto it = m_types.constFind(typeName);
+    return it != m_types.constEnd() ? it->metaObject : nullptr;
+}
+
 QList<QString> ElementTypeRegistry::registeredTypes() const
 {
     return m_types.keys();
@@ -93,6 +99,7 @@ void ElementTypeRegistry::registerElementType()
     info.factory = [](const QString& id) -> DesignElement* {
         return ElementCreator<TElement>::createAsDesignElement(id);
     };
+    info.metaObject = &TElement::staticMetaObject;
     
     m_types[info.typeName] = info;
 }
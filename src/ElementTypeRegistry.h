@@ -10,6 +10,7 @@
 
 class Element;
 class DesignElement;
+struct QMetaObject;
 
 struct ElementTypeInfo {
     QString typeName;
@@ -17,6 +18,7 @@ struct ElementTypeInfo {
     QString category; // "Basic", "Layout", "Media", etc.
     QList<PropertyDefinition> properties;
     std::function<DesignElement*(const QString& id)> factory;
+    const QMetaObject* metaObject = nullptr;  // Class the factory creates, when known
     bool isContainer = false;
     bool acceptsChildren = false;
 };
@@ -39,6 +41,9 @@ public:
     // Get type information
     bool hasType(const QString& typeName) const;
     ElementTypeInfo getTypeInfo(const QString& typeName) const;
+    // Meta-object of the type's class, or null; safe from worker threads once
+    // types are registered
+    const QMetaObject* metaObjectForType(const QString& typeName) const;
     QList<QString> registeredTypes() const;
     QList<QString> typesByCategory(const QString& category) const;
     
@@ -4,6 +4,7 @@
 #include "ElementModel.h"
 #include "platforms/web/WebTextInput.h"
 #include "Text.h"
+#include "PerformanceTrace.h"
 #include <QDebug>
 #include <QTimer>
 #include <limits>
@@ -101,6 +102,12 @@ void FlexLayoutEngine::layoutChildren(Frame* parentFrame, ElementModel* elementM
         captureInitialMargins(parentFrame, layoutChildren);
     }
     
+    // Temporarily disconnect geometry signals to avoid triggering additional layouts
+    disconnectChildGeometrySignals(parentFrame);
+    
+    // Measure step: size content-driven children before anything is positioned
+    measureChildren(layoutChildren);
+    
     // Calculate required size for parent frame
     QSizeF requiredSize = calculateRequiredSize(layoutChildren, parentFrame);
     
@@ -145,9 +152,6 @@ void FlexLayoutEngine::layoutChildren(Frame* parentFrame, ElementModel* elementM
         containerBounds = QRectF(0, 0, parentFrame->width(), parentFrame->height());
     }
     
-    // Temporarily disconnect geometry signals to avoid triggering additional layouts
-    disconnectChildGeometrySignals(parentFrame);
-    
     // Perform layout
     calculateFlexLayout(layoutChildren, parentFrame, containerBounds);
     
@@ -159,16 +163,40 @@ void FlexLayoutEngine::layoutChildren(Frame* parentFrame, ElementModel* elementM
 
 QList<Element*> FlexLayoutEngine::getDirectChildren(const QString& parentId, ElementModel* elementModel) const
 {
-    QList<Element*> children;
-    QList<Element*> allElements = elementModel->getAllElements();
+    // Served from the model's parent->children index, already in model order
+    return elementModel->getDirectChildren(parentId);
+}
+
+void FlexLayoutEngine::measureChildren(const QList<Element*>& children)
+{
+    const qreal tolerance = 0.25;
     
-    for (Element* element : allElements) {
-        if (element->getParentElementId() == parentId) {
-            children.append(element);
+    for (Element* child : children) {
+        Text* textElement = qobject_cast<Text*>(child);
+        if (textElement) {
+            if (textElement->autoSize() == Text::AutoSizeNone) {
+                continue;
+            }
+            
+            // Auto-height text keeps its width and wraps within it
+            qreal widthConstraint = textElement->autoSize() == Text::AutoSizeHeight ? textElement->width() : -1;
+            QSizeF size = textElement->intrinsicSize(widthConstraint);
+            if (qAbs(size.width() - textElement->width()) > tolerance ||
+                qAbs(size.height() - textElement->height()) > tolerance) {
+                textElement->setRect(QRectF(textElement->x(), textElement->y(), size.width(), size.height()));
+            }
+            continue;
+        }
+        
+        WebTextInput* webTextInput = qobject_cast<WebTextInput*>(child);
+        if (webTextInput) {
+            // Never let an input collapse below the height of its text line
+            qreal minHeight = webTextInput->intrinsicSize().height();
+            if (webTextInput->height() < minHeight - tolerance) {
+                webTextInput->setHeight(minHeight);
+            }
         }
     }
-    
-    return children;
 }
 
 void FlexLayoutEngine::calculateFlexLayout(const QList<Element*>& children, 
@@ -598,6 +626,7 @@ void FlexLayoutEngine::scheduleLayout(Frame* parentFrame, ElementModel* elementM
     } else {
         m_pendingLayoutFrames[parentFrame] = pending;
     }
+    TRACE_COUNTER("pendingLayouts", m_pendingLayoutFrames.size());
     
     // Start the timer if not already running
     if (!m_layoutBatchTimer->isActive()) {
@@ -608,10 +637,12 @@ void FlexLayoutEngine::scheduleLayout(Frame* parentFrame, ElementModel* elementM
 
 void FlexLayoutEngine::processPendingLayouts()
 {
+    TRACE_SCOPE("FlexLayoutEngine::processPendingLayouts", "layout");
     
     // Process all pending layout requests
     QMap<Frame*, PendingLayout> pendingLayouts = m_pendingLayoutFrames;
     m_pendingLayoutFrames.clear();
+    TRACE_COUNTER("pendingLayouts", 0);
     
     // Layout each frame
     for (auto it = pendingLayouts.begin(); it != pendingLayouts.end(); ++it) {
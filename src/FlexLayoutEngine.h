@@ -52,6 +52,10 @@ private:
     // Helper methods
     QList<Element*> getDirectChildren(const QString& parentId, ElementModel* elementModel) const;
     
+    // Resize children whose size comes from their content (auto-sized Text,
+    // WebTextInput minimum height) using C++ text measurement
+    void measureChildren(const QList<Element*>& children);
+    
     // Layout calculations
     void layoutRow(const QList<Element*>& children, 
                    Frame* parentFrame,
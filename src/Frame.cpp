@@ -347,6 +347,11 @@ void Frame::triggerLayout()
     }
 }
 
+bool Frame::isLayouting() const
+{
+    return m_layoutEngine && m_layoutEngine->isLayouting();
+}
+
 void Frame::setWidth(qreal w)
 {
     // Check if parent is currently laying out (in addition to our own layout engine)
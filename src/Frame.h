@@ -123,6 +123,8 @@ public:
     SizeType heightType() const { return m_heightType; }
     bool canResizeWidth() const;
     bool canResizeHeight() const;
+    // True while this frame's layout engine is positioning its children
+    bool isLayouting() const;
     bool controlled() const { return m_controlled; }
     Role role() const { return m_role; }
     QString platform() const { return m_platform; }
@@ -1,5 +1,9 @@
 #include "GoogleFonts.h"
 #include "Secrets.h"
+#include "Config.h"
+#include "Element.h"
+#include "Text.h"
+#include "NetworkTransport.h"
 #include <QNetworkRequest>
 #include <QJsonDocument>
 #include <QJsonArray>
@@ -7,6 +11,14 @@
 #include <QFontDatabase>
 #include <QUrl>
 #include <QUrlQuery>
+#include <QStandardPaths>
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QCryptographicHash>
+#include <QTimer>
 #include <QDebug>
 
 GoogleFonts* GoogleFonts::s_instance = nullptr;
@@ -20,12 +32,25 @@ GoogleFonts* GoogleFonts::instance() {
 
 GoogleFonts::GoogleFonts(QObject *parent) 
     : QObject(parent)
-    , m_networkManager(new QNetworkAccessManager(this))
     , m_isLoading(false)
     , m_fontListLoaded(false) {
     
-    // Fetch the font list on initialization
-    fetchFontList();
+    m_cacheDir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/fonts";
+    
+    QString overrideUrl = qEnvironmentVariable("CUBIT_GOOGLE_FONTS_URL");
+    if (!overrideUrl.isEmpty()) {
+        m_catalogUrl = QUrl(overrideUrl);
+    } else {
+        m_catalogUrl = QUrl(Config::GOOGLE_FONTS_API_URL);
+        QUrlQuery query;
+        query.addQueryItem("key", Secrets::GOOGLE_FONTS_API_KEY);
+        query.addQueryItem("sort", "popularity");
+        m_catalogUrl.setQuery(query);
+    }
+    
+    // Load the cached catalog (and revalidate it if stale) once the event loop runs,
+    // so the cache directory and endpoint can still be overridden after instance()
+    QTimer::singleShot(0, this, &GoogleFonts::initialize);
 }
 
 GoogleFonts::~GoogleFonts() {
@@ -34,70 +59,153 @@ GoogleFonts::~GoogleFonts() {
     }
 }
 
+void GoogleFonts::setCacheDirectory(const QString& path) {
+    if (m_initialized) {
+        qWarning() << "GoogleFonts::setCacheDirectory - cache already initialized";
+        return;
+    }
+    m_cacheDir = path;
+}
+
+void GoogleFonts::setCatalogUrl(const QUrl& url) {
+    if (m_initialized) {
+        qWarning() << "GoogleFonts::setCatalogUrl - catalog already requested";
+        return;
+    }
+    m_catalogUrl = url;
+}
+
+void GoogleFonts::initialize() {
+    if (m_initialized) {
+        return;
+    }
+    m_initialized = true;
+    
+    QDir().mkpath(m_cacheDir + "/files");
+    loadCacheIndex();
+    
+    // Serve the cached catalog immediately so projects open without a network round trip
+    QFile catalogFile(catalogCachePath());
+    if (catalogFile.open(QIODevice::ReadOnly)) {
+        if (!applyFontList(catalogFile.readAll())) {
+            qWarning() << "Discarding unreadable Google Fonts catalog cache";
+            m_cacheIndex.remove("catalog");
+        }
+    }
+    
+    QJsonObject catalogMeta = m_cacheIndex["catalog"].toObject();
+    qint64 fetchedAt = catalogMeta["fetchedAt"].toInteger();
+    qint64 age = QDateTime::currentSecsSinceEpoch() - fetchedAt;
+    if (!m_fontListLoaded || age > Config::FONT_CATALOG_MAX_AGE) {
+        fetchFontList();
+    }
+}
+
 QStringList GoogleFonts::availableFonts() const {
     return m_availableFonts;
 }
 
 void GoogleFonts::fetchFontList() {
-    if (m_fontListLoaded || m_isLoading) {
+    if (m_isLoading) {
         return;
     }
     
-    m_isLoading = true;
-    emit isLoadingChanged();
+    // Only show the spinner when there is nothing cached to show yet
+    if (!m_fontListLoaded) {
+        m_isLoading = true;
+        emit isLoadingChanged();
+    }
     
-    QUrl url("https://www.googleapis.com/webfonts/v1/webfonts");
-    QUrlQuery query;
-    query.addQueryItem("key", Secrets::GOOGLE_FONTS_API_KEY);
-    query.addQueryItem("sort", "popularity");
-    url.setQuery(query);
+    QNetworkRequest request(m_catalogUrl);
     
-    QNetworkRequest request(url);
-    QNetworkReply* reply = m_networkManager->get(request);
+    // Revalidate a cached catalog rather than downloading it again
+    QString etag = m_cacheIndex["catalog"].toObject()["etag"].toString();
+    if (m_fontListLoaded && !etag.isEmpty()) {
+        request.setRawHeader("If-None-Match", etag.toUtf8());
+    }
     
-    connect(reply, &QNetworkReply::finished, this, [this, reply]() {
-        handleFontListReply();
-        reply->deleteLater();
+    NetworkTransport::instance()->get(request, this, [this](QNetworkReply* reply) {
+        handleFontListReply(reply);
     });
 }
 
-void GoogleFonts::handleFontListReply() {
-    auto reply = qobject_cast<QNetworkReply*>(sender());
-    if (!reply) return;
-    
-    m_isLoading = false;
-    emit isLoadingChanged();
+void GoogleFonts::handleFontListReply(QNetworkReply* reply) {
+    if (m_isLoading) {
+        m_isLoading = false;
+        emit isLoadingChanged();
+    }
     
     if (reply->error() != QNetworkReply::NoError) {
         qWarning() << "Failed to fetch Google Fonts list:" << reply->errorString();
+        if (!m_fontListLoaded) {
+            // Nothing cached to fall back to - fail the requests waiting on the catalog
+            const QList<FontRequest> pending = m_queue;
+            m_queue.clear();
+            for (const FontRequest& request : pending) {
+                emit fontLoadError(request.family, reply->errorString());
+            }
+        }
         return;
     }
     
-    QByteArray data = reply->readAll();
-    QJsonDocument doc = QJsonDocument::fromJson(data);
+    QJsonObject catalogMeta = m_cacheIndex["catalog"].toObject();
+    int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
     
-    if (!doc.isObject()) {
+    if (status == 304) {
+        // Cached catalog is still current
+        catalogMeta["fetchedAt"] = QDateTime::currentSecsSinceEpoch();
+        m_cacheIndex["catalog"] = catalogMeta;
+        saveCacheIndex();
+        return;
+    }
+    
+    QByteArray data = reply->readAll();
+    if (!applyFontList(data)) {
         qWarning() << "Invalid JSON response from Google Fonts API";
         return;
     }
     
+    // Persist the catalog for the next start
+    QSaveFile catalogFile(catalogCachePath());
+    if (catalogFile.open(QIODevice::WriteOnly)) {
+        catalogFile.write(data);
+        catalogFile.commit();
+    }
+    catalogMeta["etag"] = QString::fromUtf8(reply->rawHeader("ETag"));
+    catalogMeta["fetchedAt"] = QDateTime::currentSecsSinceEpoch();
+    m_cacheIndex["catalog"] = catalogMeta;
+    saveCacheIndex();
+}
+
+bool GoogleFonts::applyFontList(const QByteArray& data) {
+    QJsonDocument doc = QJsonDocument::fromJson(data);
+    if (!doc.isObject()) {
+        return false;
+    }
+    
     QJsonObject root = doc.object();
     m_fontList = root["items"].toArray();
     
     m_availableFonts.clear();
+    m_fontFiles.clear();
     for (const QJsonValue& value : m_fontList) {
         QJsonObject font = value.toObject();
         QString family = font["family"].toString();
         if (!family.isEmpty()) {
             m_availableFonts.append(family);
+            m_fontFiles.insert(family, font["files"].toObject());
         }
     }
     
     m_fontListLoaded = true;
     emit availableFontsChanged();
+    
+    // Requests made before the catalog was available can now be resolved
+    processQueue();
+    return true;
 }
 
-void GoogleFonts::loadFont(const QString& fontFamily, const QString& weight) {
+void GoogleFonts::loadFont(const QString& fontFamily, const QString& weight, int priority) {
     QString normalizedWeight = normalizeWeight(weight);
     QString key = fontFamily + ":" + normalizedWeight;
     
@@ -106,38 +214,154 @@ void GoogleFonts::loadFont(const QString& fontFamily, const QString& weight) {
         return;
     }
     
-    QString url = getFontUrl(fontFamily, normalizedWeight);
-    if (url.isEmpty()) {
-        emit fontLoadError(fontFamily, "Font not found in Google Fonts");
-        return;
+    // Already downloading
+    for (const DownloadInfo& info : std::as_const(m_activeDownloads)) {
+        if (info.family == fontFamily && info.weight == normalizedWeight) {
+            return;
+        }
     }
     
-    QNetworkRequest request((QUrl(url)));
-    QNetworkReply* reply = m_networkManager->get(request);
+    if (m_fontListLoaded) {
+        QString url = getFontUrl(fontFamily, normalizedWeight);
+        if (url.isEmpty()) {
+            emit fontLoadError(fontFamily, "Font not found in Google Fonts");
+            return;
+        }
+        
+        // Served from disk without touching the network
+        if (loadFontFromCache(fontFamily, normalizedWeight, url)) {
+            return;
+        }
+    }
     
-    DownloadInfo info;
-    info.family = fontFamily;
-    info.weight = normalizedWeight;
-    m_activeDownloads[reply] = info;
-    
-    connect(reply, &QNetworkReply::finished, this, [this, fontFamily, normalizedWeight, reply]() {
-        handleFontFileReply(fontFamily, normalizedWeight);
-        m_activeDownloads.remove(reply);
-        reply->deleteLater();
-    });
+    enqueue(fontFamily, normalizedWeight, priority);
+    processQueue();
 }
 
 void GoogleFonts::loadFontWithAllWeights(const QString& fontFamily) {
     QStringList weights = getAvailableWeights(fontFamily);
     for (const QString& weight : weights) {
-        loadFont(fontFamily, weight);
+        // The regular weight is what gets previewed; the rest can wait
+        loadFont(fontFamily, weight, weight == "regular" ? NormalPriority : BackgroundPriority);
+    }
+}
+
+void GoogleFonts::prefetchFontsForElements(const QList<Element*>& elements, const QRectF& viewport) {
+    for (Element* element : elements) {
+        if (!element || element->getType() != Element::TextType) {
+            continue;
+        }
+        Text* text = qobject_cast<Text*>(element);
+        if (!text) {
+            continue;
+        }
+        
+        QFont font = text->font();
+        if (font.family().isEmpty()) {
+            continue;
+        }
+        // Skip families we know are not in the catalog (system fonts)
+        if (m_fontListLoaded && !m_fontFiles.contains(font.family())) {
+            continue;
+        }
+        
+        int weight = font.weight();
+        QString googleWeight = weight == QFont::Normal ? QString("regular") : QString::number(weight);
+        
+        int priority = BackgroundPriority;
+        if (!viewport.isEmpty() && viewport.intersects(text->rect())) {
+            priority = ViewportPriority;
+        }
+        loadFont(font.family(), googleWeight, priority);
+    }
+}
+
+void GoogleFonts::enqueue(const QString& fontFamily, const QString& weight, int priority) {
+    // A repeated request can only raise the priority of one already queued
+    for (FontRequest& queued : m_queue) {
+        if (queued.family == fontFamily && queued.weight == weight) {
+            queued.priority = qMax(queued.priority, priority);
+            return;
+        }
+    }
+    
+    FontRequest request;
+    request.family = fontFamily;
+    request.weight = weight;
+    request.priority = priority;
+    request.sequence = m_nextSequence++;
+    m_queue.append(request);
+}
+
+void GoogleFonts::processQueue() {
+    if (!m_fontListLoaded) {
+        return;
+    }
+    
+    while (!m_queue.isEmpty() && m_activeDownloads.size() < Config::FONT_MAX_CONCURRENT_DOWNLOADS) {
+        // Highest priority first, FIFO within a priority
+        int best = 0;
+        for (int i = 1; i < m_queue.size(); ++i) {
+            const FontRequest& candidate = m_queue[i];
+            const FontRequest& current = m_queue[best];
+            if (candidate.priority > current.priority ||
+                (candidate.priority == current.priority && candidate.sequence < current.sequence)) {
+                best = i;
+            }
+        }
+        FontRequest request = m_queue.takeAt(best);
+        
+        QString key = request.family + ":" + request.weight;
+        if (m_loadedFonts.contains(key)) {
+            emit fontLoaded(request.family);
+            continue;
+        }
+        
+        QString url = getFontUrl(request.family, request.weight);
+        if (url.isEmpty()) {
+            // Background prefetches of system fonts are expected to miss
+            if (request.priority > BackgroundPriority) {
+                emit fontLoadError(request.family, "Font not found in Google Fonts");
+            }
+            continue;
+        }
+        
+        if (loadFontFromCache(request.family, request.weight, url)) {
+            continue;
+        }
+        
+        startDownload(request);
     }
 }
 
-void GoogleFonts::handleFontFileReply(const QString& fontFamily, const QString& weight) {
-    auto reply = qobject_cast<QNetworkReply*>(sender());
-    if (!reply) return;
+void GoogleFonts::startDownload(const FontRequest& request) {
+    QString url = getFontUrl(request.family, request.weight);
+    
+    QNetworkRequest networkRequest((QUrl(url)));
+    
+    // Prefetches yield to everything else on the shared transport
+    const NetworkTransport::Priority priority = request.priority > BackgroundPriority
+        ? NetworkTransport::NormalPriority
+        : NetworkTransport::BackgroundPriority;
     
+    QString fontFamily = request.family;
+    QString weight = request.weight;
+    QString key = fontFamily + ":" + weight;
+    NetworkTransport::instance()->get(networkRequest, this,
+        [this, fontFamily, weight, key](QNetworkReply* reply) {
+            handleFontFileReply(reply, fontFamily, weight);
+            m_activeDownloads.remove(key);
+            processQueue();
+        },
+        priority);
+    
+    DownloadInfo info;
+    info.family = request.family;
+    info.weight = request.weight;
+    m_activeDownloads[key] = info;
+}
+
+void GoogleFonts::handleFontFileReply(QNetworkReply* reply, const QString& fontFamily, const QString& weight) {
     if (reply->error() != QNetworkReply::NoError) {
         emit fontLoadError(fontFamily, reply->errorString());
         return;
@@ -145,16 +369,102 @@ void GoogleFonts::handleFontFileReply(const QString& fontFamily, const QString&
     
     QByteArray fontData = reply->readAll();
     
+    if (!registerFontData(fontFamily, weight, fontData)) {
+        emit fontLoadError(fontFamily, "Failed to load font data");
+        return;
+    }
+    
+    // Store the file under its content hash and remember which URL it came from
+    QString contentHash = QString::fromLatin1(
+        QCryptographicHash::hash(fontData, QCryptographicHash::Sha256).toHex());
+    QString path = fontFilePath(contentHash);
+    if (!QFileInfo::exists(path)) {
+        QSaveFile fontFile(path);
+        if (fontFile.open(QIODevice::WriteOnly)) {
+            fontFile.write(fontData);
+            fontFile.commit();
+        }
+    }
+    
+    QJsonObject files = m_cacheIndex["files"].toObject();
+    QJsonObject entry;
+    entry["sha256"] = contentHash;
+    entry["etag"] = QString::fromUtf8(reply->rawHeader("ETag"));
+    files[reply->request().url().toString()] = entry;
+    m_cacheIndex["files"] = files;
+    saveCacheIndex();
+    
+    emit fontLoaded(fontFamily);
+}
+
+bool GoogleFonts::loadFontFromCache(const QString& fontFamily, const QString& weight, const QString& url) {
+    // Catalog font URLs are versioned, so a cached file for a URL never goes stale
+    const QString urlKey = QUrl(url).toString();
+    QJsonObject entry = m_cacheIndex["files"].toObject()[urlKey].toObject();
+    QString contentHash = entry["sha256"].toString();
+    if (contentHash.isEmpty()) {
+        return false;
+    }
+    
+    QFile fontFile(fontFilePath(contentHash));
+    if (!fontFile.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    
+    if (!registerFontData(fontFamily, weight, fontFile.readAll())) {
+        // Corrupt cache entry - drop it and fall back to the network
+        fontFile.close();
+        fontFile.remove();
+        QJsonObject files = m_cacheIndex["files"].toObject();
+        files.remove(urlKey);
+        m_cacheIndex["files"] = files;
+        saveCacheIndex();
+        return false;
+    }
+    
+    emit fontLoaded(fontFamily);
+    return true;
+}
+
+bool GoogleFonts::registerFontData(const QString& fontFamily, const QString& weight, const QByteArray& fontData) {
     // Add font to Qt's font database
     int fontId = QFontDatabase::addApplicationFontFromData(fontData);
     if (fontId == -1) {
-        emit fontLoadError(fontFamily, "Failed to load font data");
-        return;
+        return false;
     }
     
     QString key = fontFamily + ":" + weight;
     m_loadedFonts[key] = true;
-    emit fontLoaded(fontFamily);
+    return true;
+}
+
+void GoogleFonts::loadCacheIndex() {
+    QFile indexFile(m_cacheDir + "/index.json");
+    if (!indexFile.open(QIODevice::ReadOnly)) {
+        return;
+    }
+    QJsonDocument doc = QJsonDocument::fromJson(indexFile.readAll());
+    if (doc.isObject()) {
+        m_cacheIndex = doc.object();
+    }
+}
+
+void GoogleFonts::saveCacheIndex() const {
+    QSaveFile indexFile(m_cacheDir + "/index.json");
+    if (!indexFile.open(QIODevice::WriteOnly)) {
+        qWarning() << "Failed to write Google Fonts cache index:" << indexFile.errorString();
+        return;
+    }
+    indexFile.write(QJsonDocument(m_cacheIndex).toJson(QJsonDocument::Compact));
+    indexFile.commit();
+}
+
+QString GoogleFonts::catalogCachePath() const {
+    return m_cacheDir + "/catalog.json";
+}
+
+QString GoogleFonts::fontFilePath(const QString& contentHash) const {
+    return m_cacheDir + "/files/" + contentHash + ".ttf";
 }
 
 bool GoogleFonts::isFontLoaded(const QString& fontFamily, const QString& weight) const {
@@ -164,19 +474,7 @@ bool GoogleFonts::isFontLoaded(const QString& fontFamily, const QString& weight)
 }
 
 QStringList GoogleFonts::getAvailableWeights(const QString& fontFamily) const {
-    QStringList weights;
-    
-    // Find the font in our list
-    for (const QJsonValue& value : m_fontList) {
-        QJsonObject font = value.toObject();
-        if (font["family"].toString() == fontFamily) {
-            QJsonObject files = font["files"].toObject();
-            weights = files.keys();
-            break;
-        }
-    }
-    
-    return weights;
+    return m_fontFiles.value(fontFamily).keys();
 }
 
 QString GoogleFonts::normalizeWeight(const QString& weight) const {
@@ -209,38 +507,36 @@ QString GoogleFonts::normalizeWeight(const QString& weight) const {
 QString GoogleFonts::getFontUrl(const QString& fontFamily, const QString& weight) const {
     QString normalizedWeight = normalizeWeight(weight);
     
-    // Find the font in our list
-    for (const QJsonValue& value : m_fontList) {
-        QJsonObject font = value.toObject();
-        if (font["family"].toString() == fontFamily) {
-            QJsonObject files = font["files"].toObject();
-            
-            // Try to find the requested weight
-            if (files.contains(normalizedWeight)) {
-                return files[normalizedWeight].toString();
-            }
-            
-            // Try numeric version if named version not found
-            if (normalizedWeight == "regular" && files.contains("400")) {
-                return files["400"].toString();
-            }
-            if (normalizedWeight == "700" && files.contains("bold")) {
-                return files["bold"].toString();
-            }
-            
-            // Fallback to regular weight
-            if (files.contains("regular")) {
-                return files["regular"].toString();
-            }
-            if (files.contains("400")) {
-                return files["400"].toString();
-            }
-            
-            // Return first available weight
-            if (!files.isEmpty()) {
-                return files.begin().value().toString();
-            }
-        }
+    auto it = m_fontFiles.constFind(fontFamily);
+    if (it == m_fontFiles.constEnd()) {
+        return QString();
+    }
+    const QJsonObject& files = it.value();
+    
+    // Try to find the requested weight
+    if (files.contains(normalizedWeight)) {
+        return files[normalizedWeight].toString();
+    }
+    
+    // Try numeric version if named version not found
+    if (normalizedWeight == "regular" && files.contains("400")) {
+        return files["400"].toString();
+    }
+    if (normalizedWeight == "700" && files.contains("bold")) {
+        return files["bold"].toString();
+    }
+    
+    // Fallback to regular weight
+    if (files.contains("regular")) {
+        return files["regular"].toString();
+    }
+    if (files.contains("400")) {
+        return files["400"].toString();
+    }
+    
+    // Return first available weight
+    if (!files.isEmpty()) {
+        return files.begin().value().toString();
     }
     
     return QString();
@@ -1,20 +1,40 @@
 #pragma once
 
 #include <QObject>
-#include <QNetworkAccessManager>
 #include <QNetworkReply>
 #include <QFont>
 #include <QFontDatabase>
 #include <QHash>
 #include <QJsonArray>
 #include <QJsonObject>
+#include <QRectF>
+#include <QUrl>
 
+class Element;
+
+/**
+ * GoogleFonts resolves font families against the Google Fonts catalog and
+ * registers the TTF data with QFontDatabase.
+ *
+ * Both the catalog and the font files are cached on disk under the app data
+ * directory. The catalog is reused until it is older than
+ * Config::FONT_CATALOG_MAX_AGE and then revalidated with its ETag; font files
+ * are stored by the SHA-256 of their content. Downloads go through a
+ * priority queue so fonts for on-screen text are fetched before prefetches.
+ */
 class GoogleFonts : public QObject {
     Q_OBJECT
     Q_PROPERTY(QStringList availableFonts READ availableFonts NOTIFY availableFontsChanged)
     Q_PROPERTY(bool isLoading READ isLoading NOTIFY isLoadingChanged)
     
 public:
+    enum FontPriority {
+        BackgroundPriority = 0,  // Prefetch, extra weights
+        NormalPriority,          // Explicit requests (font picker, property panel)
+        ViewportPriority         // Text currently visible on the canvas
+    };
+    Q_ENUM(FontPriority)
+    
     static GoogleFonts* instance();
     
     // Get list of available Google Fonts
@@ -22,11 +42,15 @@ public:
     bool isLoading() const { return m_isLoading; }
     
     // Load a specific font family with weight
-    Q_INVOKABLE void loadFont(const QString& fontFamily, const QString& weight = "regular");
+    Q_INVOKABLE void loadFont(const QString& fontFamily, const QString& weight = "regular",
+                              int priority = NormalPriority);
     
     // Load all common weights for a font family
     Q_INVOKABLE void loadFontWithAllWeights(const QString& fontFamily);
     
+    // Queue the fonts used by Text elements; those intersecting the viewport go first
+    void prefetchFontsForElements(const QList<Element*>& elements, const QRectF& viewport = QRectF());
+    
     // Check if a font with specific weight is already loaded
     Q_INVOKABLE bool isFontLoaded(const QString& fontFamily, const QString& weight = "regular") const;
     
@@ -36,6 +60,13 @@ public:
     // Get the font URL for a specific family and weight
     QString getFontUrl(const QString& fontFamily, const QString& weight = "regular") const;
     
+    // Cache location and catalog endpoint. Both must be set before the event loop
+    // runs the deferred initialization; useful for pointing at a local HTTP stand-in.
+    void setCacheDirectory(const QString& path);
+    QString cacheDirectory() const { return m_cacheDir; }
+    void setCatalogUrl(const QUrl& url);
+    QUrl catalogUrl() const { return m_catalogUrl; }
+    
 signals:
     void availableFontsChanged();
     void fontLoaded(const QString& fontFamily);
@@ -46,23 +77,52 @@ private:
     explicit GoogleFonts(QObject *parent = nullptr);
     ~GoogleFonts();
     
+    void initialize();
     void fetchFontList();
-    void handleFontListReply();
-    void handleFontFileReply(const QString& fontFamily, const QString& weight);
+    void handleFontListReply(QNetworkReply* reply);
+    bool applyFontList(const QByteArray& data);
+    void handleFontFileReply(QNetworkReply* reply, const QString& fontFamily, const QString& weight);
     QString normalizeWeight(const QString& weight) const;
     
+    // Disk cache
+    void loadCacheIndex();
+    void saveCacheIndex() const;
+    QString catalogCachePath() const;
+    QString fontFilePath(const QString& contentHash) const;
+    bool loadFontFromCache(const QString& fontFamily, const QString& weight, const QString& url);
+    bool registerFontData(const QString& fontFamily, const QString& weight, const QByteArray& fontData);
+    
+    // Download queue
+    struct FontRequest {
+        QString family;
+        QString weight;
+        int priority = NormalPriority;
+        quint64 sequence = 0;
+    };
+    void enqueue(const QString& fontFamily, const QString& weight, int priority);
+    void processQueue();
+    void startDownload(const FontRequest& request);
+    
     static GoogleFonts* s_instance;
-    QNetworkAccessManager* m_networkManager;
     QJsonArray m_fontList;
+    QHash<QString, QJsonObject> m_fontFiles;  // family -> "files" object from the catalog
     QStringList m_availableFonts;
     QHash<QString, bool> m_loadedFonts;  // Key: "family:weight"
     bool m_isLoading;
     bool m_fontListLoaded;
+    bool m_initialized = false;
+    
+    QString m_cacheDir;
+    QUrl m_catalogUrl;
+    QJsonObject m_cacheIndex;  // { "catalog": {etag, fetchedAt}, "files": {url: {sha256, etag}} }
+    
+    QList<FontRequest> m_queue;
+    quint64 m_nextSequence = 0;
     
     // Active downloads - store both family and weight
     struct DownloadInfo {
         QString family;
         QString weight;
     };
-    QHash<QNetworkReply*, DownloadInfo> m_activeDownloads;
+    QHash<QString, DownloadInfo> m_activeDownloads;  // Key: "family:weight"
 };
\ No newline at end of file
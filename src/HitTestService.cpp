@@ -11,7 +11,9 @@
 #include "PlatformConfig.h"
 #include "Project.h"
 #include "CanvasContext.h"
+#include "PerformanceTrace.h"
 #include <QElapsedTimer>
+#include <utility>
 
 HitTestService::HitTestService(QObject *parent)
     : QObject(parent)
@@ -154,38 +156,75 @@ Element* HitTestService::hitTestForHover(const QPointF& point) const
 
 std::vector<Element*> HitTestService::elementsInRect(const QRectF& rect) const
 {
-    if (!m_elementModel) return std::vector<Element*>();
-    
     std::vector<Element*> result;
-    auto candidates = queryCandidates(rect);
+    elementsInRect(rect, result);
+    return result;
+}
+
+std::vector<Element*> HitTestService::elementsAt(const QPointF& point) const
+{
+    std::vector<Element*> result;
+    elementsAt(point, result);
+    return result;
+}
+
+void HitTestService::elementsInRect(const QRectF& rect, std::vector<Element*>& result) const
+{
+    result.clear();
+    visitElementsInRect(rect, [&result](Element* element) {
+        result.push_back(element);
+        return true;
+    });
+}
+
+void HitTestService::elementsAt(const QPointF& point, std::vector<Element*>& result) const
+{
+    result.clear();
+    visitElementsAt(point, [&result](Element* element) {
+        result.push_back(element);
+        return true;
+    });
+}
+
+void HitTestService::visitElementsInRect(const QRectF& rect, ElementVisitor visit) const
+{
+    if (!m_elementModel) return;
     
-    for (Element* element : candidates) {
+    visitCandidates(rect, [&](Element* element) {
         if (!shouldTestElement(element)) {
-            continue;
+            return true;
         }
         
         // Only visual elements can be selected by rectangle
-        CanvasElement* canvasElement = qobject_cast<CanvasElement*>(element);
-        if (canvasElement && rect.intersects(canvasElement->cachedBounds())) {
-            result.push_back(element);
-        }
-    }
-    
-    return result;
+        CanvasElement* canvasElement = static_cast<CanvasElement*>(element);
+        return !rect.intersects(canvasElement->cachedBounds()) || visit(element);
+    });
 }
 
-std::vector<Element*> HitTestService::elementsAt(const QPointF& point) const
+void HitTestService::visitElementsAt(const QPointF& point, ElementVisitor visit) const
 {
-    if (!m_elementModel) return std::vector<Element*>();
+    if (!m_elementModel) return;
     
-    return findAll(point, [this](Element* e) {
-        return !shouldTestElement(e);
+    visitCandidates(point, [&](Element* element) {
+        if (!shouldTestElement(element)) {
+            return true;
+        }
+        
+        CanvasElement* canvasElement = static_cast<CanvasElement*>(element);
+        return !canvasElement->containsPoint(point) || visit(element);
     });
 }
 
 void HitTestService::rebuildSpatialIndex()
 {
     if (!m_elementModel) return;
+
+    if (m_batchDepth > 0) {
+        m_batchDirty = true;
+        return;
+    }
+    
+    TRACE_SCOPE("HitTestService::rebuildSpatialIndex", "canvas");
     
     // First rebuild the visuals cache
     rebuildVisualsCache();
@@ -197,17 +236,19 @@ void HitTestService::rebuildSpatialIndex()
         bounds = QRectF(0, 0, 10000, 10000);
     }
     
-    // Create new quadtree
+    // Create new quadtree, built in one pass from all visual elements
     m_quadTree = std::make_unique<QuadTree>(bounds);
-    m_elementMap.clear();
+    m_quadTree->rebuild(m_visualElements);
     
-    // Add all visual elements to the quadtree
+    m_elementMap.clear();
+    m_elementMap.reserve(static_cast<qsizetype>(m_visualElements.size()));
     for (CanvasElement* ce : m_visualElements) {
-        m_quadTree->insert(ce);
         m_elementMap[ce->getId()] = ce;
     }
     
     m_needsRebuild = false;
+    TRACE_COUNTER("elements", m_elementModel->rowCount());
+    TRACE_COUNTER("quadtreeDepth", m_quadTree->getStats().maxDepth);
     emit spatialIndexRebuilt();
     
     // Spatial index rebuilt
@@ -227,6 +268,7 @@ void HitTestService::removeElement(Element* element)
 {
     if (!element) return;
     
+    m_batchUpdated.remove(element);
     if (m_quadTree) {
         m_quadTree->remove(element);
         m_elementMap.remove(element->getId());
@@ -264,6 +306,28 @@ void HitTestService::updateElement(Element* element)
     }
 }
 
+bool HitTestService::isIndexed(Element* element) const
+{
+    return element && m_quadTree && m_elementMap.value(element->getId()) == element;
+}
+
+MemoryUsage HitTestService::memoryUsage() const
+{
+    MemoryUsage usage;
+    if (m_quadTree) {
+        const QuadTree::Stats stats = m_quadTree->getStats();
+        usage.bytes += sizeof(QuadTree) + stats.bytes;
+        usage.objects += stats.totalNodes;
+    }
+    usage.bytes += m_elementMap.capacity() * qint64(sizeof(void*));
+    for (auto it = m_elementMap.cbegin(); it != m_elementMap.cend(); ++it) {
+        usage.bytes += MemoryEstimate::HASH_NODE_OVERHEAD + qint64(sizeof(QString) + sizeof(Element*))
+                       + MemoryEstimate::of(it.key());
+    }
+    usage.bytes += m_visualElements.capacity() * sizeof(CanvasElement*);
+    return usage;
+}
+
 void HitTestService::setUseQuadTree(bool use)
 {
     if (m_useQuadTree != use) {
@@ -274,9 +338,34 @@ void HitTestService::setUseQuadTree(bool use)
     }
 }
 
+void HitTestService::beginBatch()
+{
+    ++m_batchDepth;
+}
+
+void HitTestService::endBatch()
+{
+    if (m_batchDepth == 0 || --m_batchDepth > 0) return;
+
+    const QSet<Element*> updated = std::exchange(m_batchUpdated, {});
+    if (m_batchDirty) {
+        m_batchDirty = false;
+        rebuildSpatialIndex();
+    } else {
+        for (Element* element : updated) {
+            updateElement(element);
+        }
+    }
+}
+
 void HitTestService::onElementAdded(Element* element)
 {
     m_visualsCacheValid = false;  // Invalidate cache
+
+    if (m_batchDepth > 0) {
+        m_batchDirty = true;
+        return;
+    }
     
     // For programmatically created elements, we need to ensure the spatial index
     // is properly updated. Instead of just inserting, rebuild if needed.
@@ -298,6 +387,18 @@ void HitTestService::onElementRemoved(const QString& elementId)
 void HitTestService::onElementUpdated(Element* element)
 {
     m_visualsCacheValid = false;  // Invalidate cache
+
+    if (m_batchDepth > 0) {
+        // Past a quarter of the index one rebuild is cheaper than reinserting
+        if (!m_batchDirty) {
+            m_batchUpdated.insert(element);
+            if (m_batchUpdated.size() > m_elementMap.size() / 4) {
+                m_batchDirty = true;
+                m_batchUpdated.clear();
+            }
+        }
+        return;
+    }
     updateElement(element);
 }
 
@@ -412,110 +513,62 @@ void HitTestService::rebuildVisualsCache() const
     m_visualsCacheValid = true;
 }
 
-std::vector<Element*> HitTestService::queryCandidates(const QPointF& point) const
+void HitTestService::visitCandidates(const QPointF& point, ElementVisitor visit) const
 {
+    if (m_useQuadTree && m_quadTree) {
+        m_quadTree->visit(point, visit);
+        return;
+    }
+    
+    // Only the linear fallback walks the cached element list
     if (!m_visualsCacheValid) {
         rebuildVisualsCache();
     }
-    
-    if (m_useQuadTree && m_quadTree) {
-        return m_quadTree->query(point);
-    } else {
-        // Return visual elements as Element* list for compatibility
-        std::vector<Element*> result;
-        result.reserve(m_visualElements.size());
-        for (CanvasElement* ce : m_visualElements) {
-            result.push_back(ce);
-        }
-        return result;
+    for (CanvasElement* ce : m_visualElements) {
+        if (!visit(ce)) return;
     }
 }
 
-std::vector<Element*> HitTestService::queryCandidates(const QRectF& rect) const
+void HitTestService::visitCandidates(const QRectF& rect, ElementVisitor visit) const
 {
-    if (!m_visualsCacheValid) {
-        rebuildVisualsCache();
-    }
-    
     if (m_useQuadTree && m_quadTree) {
-        return m_quadTree->query(rect);
-    } else {
-        // Return visual elements as Element* list for compatibility
-        std::vector<Element*> result;
-        result.reserve(m_visualElements.size());
-        for (CanvasElement* ce : m_visualElements) {
-            result.push_back(ce);
-        }
-        return result;
+        m_quadTree->visit(rect, visit);
+        return;
     }
-}
-
-// Template implementations
-template<typename Pred>
-Element* HitTestService::findTopmost(const QPointF& pt, Pred shouldSkip) const {
-    auto candidates = queryCandidates(pt);
     
-    // Test in reverse order (top to bottom) for proper z-ordering
-    for (int i = int(candidates.size()) - 1; i >= 0; --i) {
-        Element* e = candidates.at(i);
-        
-        if (shouldSkip(e)) continue;
-        
-        // If we're using cached visuals, we know it's already a CanvasElement
-        // and it's visual, so we can skip those checks
-        CanvasElement* ce = static_cast<CanvasElement*>(e);
-        if (!ce->containsPoint(pt)) continue;
-        
-        return e;
+    // Only the linear fallback walks the cached element list
+    if (!m_visualsCacheValid) {
+        rebuildVisualsCache();
     }
-    return nullptr;
-}
-
-template<typename Pred>
-std::vector<Element*> HitTestService::findAll(const QPointF& pt, Pred shouldSkip) const {
-    std::vector<Element*> result;
-    auto candidates = queryCandidates(pt);
-    
-    for (Element* e : candidates) {
-        if (shouldSkip(e)) continue;
-        
-        // If we're using cached visuals, we know it's already a CanvasElement
-        CanvasElement* ce = static_cast<CanvasElement*>(e);
-        if (ce->containsPoint(pt)) {
-            result.push_back(e);
-        }
+    for (CanvasElement* ce : m_visualElements) {
+        if (!visit(ce)) return;
     }
-    
-    return result;
 }
 
+// Template implementations
 template<typename Pred>
 Element* HitTestService::findDeepest(const QPointF& pt, Pred shouldSkip) const {
     if (!m_elementModel) return nullptr;
     
-    // Get all elements that contain the point
-    auto allAtPoint = findAll(pt, shouldSkip);
-    if (allAtPoint.empty()) return nullptr;
-    
-    // Find the deepest element (one that has no children containing the point)
+    // Find the deepest element containing the point in a single pass; the
+    // depth comes from the model's hierarchy numbering instead of a parent walk
     Element* deepest = nullptr;
     int maxDepth = -1;
     
-    for (Element* e : allAtPoint) {
-        // Calculate depth of this element
-        int depth = 0;
-        Element* current = e;
-        while (current && !current->getParentElementId().isEmpty()) {
-            current = m_elementModel->getElementById(current->getParentElementId());
-            depth++;
-        }
+    visitCandidates(pt, [&](Element* e) {
+        if (shouldSkip(e)) return true;
+        
+        // Candidates are always CanvasElements (quadtree or cached visuals)
+        CanvasElement* ce = static_cast<CanvasElement*>(e);
+        if (!ce->containsPoint(pt)) return true;
         
-        // Check if this is deeper than our current deepest
-        if (depth > maxDepth) {
+        const int depth = m_elementModel->treeInterval(e).depth;
+        if (!deepest || depth > maxDepth) {
             maxDepth = depth;
             deepest = e;
         }
-    }
+        return true;
+    });
     
     return deepest;
-}
\ No newline at end of file
+}
@@ -3,13 +3,15 @@
 #include <QPointF>
 #include <QRectF>
 #include <QHash>
+#include <QSet>
 #include <memory>
 #include <vector>
+#include "QuadTree.h"
+#include "MemoryUsage.h"
 
 class Element;
 class CanvasElement;
 class ElementModel;
-class QuadTree;
 class CanvasContext;
 class ElementFilterProxy;
 
@@ -27,6 +29,7 @@ public:
     ~HitTestService();
     
     void setElementModel(ElementModel* elementModel);
+    ElementModel* elementModel() const { return m_elementModel; }
     void setCanvasType(CanvasType type);
     Q_INVOKABLE void setEditingElement(QObject* editingElement);
     void setCanvasContext(CanvasContext* context);
@@ -44,11 +47,30 @@ public:
     std::vector<Element*> elementsInRect(const QRectF& rect) const;
     std::vector<Element*> elementsAt(const QPointF& point) const;
     
+    // Allocation-free variants for per-mouse-move callers: fill a reused,
+    // caller-owned buffer, or visit each hit-testable element until the
+    // visitor returns false
+    void elementsInRect(const QRectF& rect, std::vector<Element*>& result) const;
+    void elementsAt(const QPointF& point, std::vector<Element*>& result) const;
+    void visitElementsInRect(const QRectF& rect, ElementVisitor visit) const;
+    void visitElementsAt(const QPointF& point, ElementVisitor visit) const;
+    
     // Spatial index management
     void rebuildSpatialIndex();
     void insertElement(Element* element);
     void removeElement(Element* element);
     void updateElement(Element* element);
+    // True if the element is currently held by the spatial index
+    bool isIndexed(Element* element) const;
+    // Estimated footprint of the quadtree, its id map and the visuals cache;
+    // objects counts quadtree nodes
+    MemoryUsage memoryUsage() const;
+
+    // Between beginBatch() and endBatch() additions and rebuild requests are
+    // folded into one rebuild at the end, and updated elements are reindexed
+    // once each unless a rebuild is due anyway; removals still apply immediately
+    void beginBatch();
+    void endBatch();
     
     // Performance monitoring
     bool isUsingQuadTree() const { return m_useQuadTree; }
@@ -72,6 +94,9 @@ private:
     mutable std::unique_ptr<QuadTree> m_quadTree;
     bool m_useQuadTree = true;
     bool m_needsRebuild = false;
+    int m_batchDepth = 0;
+    bool m_batchDirty = false;
+    QSet<Element*> m_batchUpdated;  // Elements updated during the batch
     
     // Helper to filter elements based on canvas type
     // This filtering logic should match ElementFilterProxy to ensure consistent behavior
@@ -92,17 +117,10 @@ private:
     // Rebuild the visual elements cache
     void rebuildVisualsCache() const;
     
-    // Query candidates from spatial index or fallback
-    std::vector<Element*> queryCandidates(const QPointF& point) const;
-    std::vector<Element*> queryCandidates(const QRectF& rect) const;
-    
-    // Unified helper for finding topmost element with custom predicate
-    template<typename Pred>
-    Element* findTopmost(const QPointF& pt, Pred shouldSkip) const;
-    
-    // Unified helper for finding all elements with custom predicate
-    template<typename Pred>
-    std::vector<Element*> findAll(const QPointF& pt, Pred shouldSkip) const;
+    // Visit candidates from the spatial index, or every cached visual when it
+    // is off, until visit returns false
+    void visitCandidates(const QPointF& point, ElementVisitor visit) const;
+    void visitCandidates(const QRectF& rect, ElementVisitor visit) const;
     
     // Helper for finding the deepest nested element at a point
     template<typename Pred>
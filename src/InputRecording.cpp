@@ -0,0 +1,217 @@
+#include "InputRecording.h"
+#include "CanvasController.h"
+#include "Application.h"
+#include "Project.h"
+#include <QDataStream>
+#include <QDebug>
+#include <QFile>
+#include <QJsonDocument>
+
+namespace {
+constexpr quint32 Magic = 0x43424952;   // "CBIR"
+constexpr quint16 Version = 2;        // 2 added the drag events; 1 reads unchanged
+}
+
+bool InputRecording::save(const QString& filePath) const
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "InputRecording: cannot write" << filePath << file.errorString();
+        return false;
+    }
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_6_0);
+    out.setFloatingPointPrecision(QDataStream::SinglePrecision);
+    out << Magic << Version << qCompress(projectData) << quint32(events.size());
+
+    qint64 previous = 0;
+    for (const InputEvent& event : events) {
+        out << quint8(event.type) << quint32(event.time - previous);
+        previous = event.time;
+        switch (event.type) {
+        case InputEvent::Press:
+        case InputEvent::Move:
+        case InputEvent::Release:
+        case InputEvent::Hover:
+        case InputEvent::DragMove:
+        case InputEvent::DragEndMove:
+            out << event.x << event.y;
+            break;
+        case InputEvent::SelectRect:
+        case InputEvent::DragStart:
+        case InputEvent::DragResize:
+            out << event.x << event.y << event.width << event.height;
+            break;
+        case InputEvent::Viewport:
+            out << event.x << event.y << event.zoom;
+            break;
+        case InputEvent::ModeChange:
+            out << quint8(event.mode);
+            break;
+        case InputEvent::EscapeKey:
+        case InputEvent::EnterKey:
+        case InputEvent::DragEndResize:
+            break;
+        }
+    }
+    return out.status() == QDataStream::Ok;
+}
+
+bool InputRecording::load(const QString& filePath)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "InputRecording: cannot read" << filePath << file.errorString();
+        return false;
+    }
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_6_0);
+    in.setFloatingPointPrecision(QDataStream::SinglePrecision);
+
+    quint32 magic = 0;
+    quint16 version = 0;
+    in >> magic >> version;
+    if (magic != Magic || version < 1 || version > Version) {
+        qWarning() << "InputRecording:" << filePath << "is not an input recording this version can read";
+        return false;
+    }
+
+    QByteArray compressedProject;
+    quint32 count = 0;
+    in >> compressedProject >> count;
+    projectData = qUncompress(compressedProject);
+    events.clear();
+    // count is read from the file, so a corrupt one must not size the
+    // allocation; every event takes at least its type and time delta
+    constexpr qint64 minimumEventSize = sizeof(quint8) + sizeof(quint32);
+    events.reserve(qMin<qint64>(count, file.bytesAvailable() / minimumEventSize));
+
+    qint64 time = 0;
+    for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        quint8 type = 0;
+        quint32 delta = 0;
+        in >> type >> delta;
+        time += delta;
+
+        InputEvent event;
+        event.type = static_cast<InputEvent::Type>(type);
+        event.time = time;
+        switch (event.type) {
+        case InputEvent::Press:
+        case InputEvent::Move:
+        case InputEvent::Release:
+        case InputEvent::Hover:
+        case InputEvent::DragMove:
+        case InputEvent::DragEndMove:
+            in >> event.x >> event.y;
+            break;
+        case InputEvent::SelectRect:
+        case InputEvent::DragStart:
+        case InputEvent::DragResize:
+            in >> event.x >> event.y >> event.width >> event.height;
+            break;
+        case InputEvent::Viewport:
+            in >> event.x >> event.y >> event.zoom;
+            break;
+        case InputEvent::ModeChange: {
+            quint8 mode = 0;
+            in >> mode;
+            event.mode = mode;
+            break;
+        }
+        case InputEvent::EscapeKey:
+        case InputEvent::EnterKey:
+        case InputEvent::DragEndResize:
+            break;
+        default:
+            qWarning() << "InputRecording: unknown event type" << type << "in" << filePath;
+            return false;
+        }
+        events.append(event);
+    }
+
+    if (in.status() != QDataStream::Ok) {
+        qWarning() << "InputRecording:" << filePath << "is truncated";
+        return false;
+    }
+    return true;
+}
+
+InputRecorder::InputRecorder(CanvasController* controller)
+    : QObject(controller)
+    , m_controller(controller)
+{
+}
+
+void InputRecorder::start()
+{
+    m_session = InputRecording();
+
+    Project* project = qobject_cast<Project*>(m_controller->parent());
+    if (project && Application::instance()) {
+        const QJsonObject projectJson = Application::instance()->serializeProjectData(project);
+        m_session.projectData = QJsonDocument(projectJson).toJson(QJsonDocument::Compact);
+    }
+
+    m_clock.start();
+    m_recording = true;
+    recordMode(static_cast<int>(m_controller->mode()));
+    recordViewport(m_controller->savedContentX(), m_controller->savedContentY(), m_controller->savedZoom());
+    emit recordingChanged();
+}
+
+void InputRecorder::stop()
+{
+    if (!m_recording) return;
+    m_recording = false;
+    emit recordingChanged();
+}
+
+bool InputRecorder::save(const QUrl& fileUrl) const
+{
+    return m_session.save(fileUrl.isLocalFile() ? fileUrl.toLocalFile() : fileUrl.toString());
+}
+
+InputEvent& InputRecorder::append(InputEvent::Type type)
+{
+    InputEvent event;
+    event.type = type;
+    event.time = m_clock.nsecsElapsed() / 1000;
+    m_session.events.append(event);
+    return m_session.events.last();
+}
+
+void InputRecorder::record(InputEvent::Type type, qreal x, qreal y)
+{
+    if (!m_recording) return;
+    InputEvent& event = append(type);
+    event.x = x;
+    event.y = y;
+}
+
+void InputRecorder::recordRect(InputEvent::Type type, const QRectF& rect)
+{
+    if (!m_recording) return;
+    InputEvent& event = append(type);
+    event.x = rect.x();
+    event.y = rect.y();
+    event.width = rect.width();
+    event.height = rect.height();
+}
+
+void InputRecorder::recordMode(int mode)
+{
+    if (!m_recording) return;
+    append(InputEvent::ModeChange).mode = mode;
+}
+
+void InputRecorder::recordViewport(qreal contentX, qreal contentY, qreal zoom)
+{
+    if (!m_recording) return;
+    InputEvent& event = append(InputEvent::Viewport);
+    event.x = contentX;
+    event.y = contentY;
+    event.zoom = zoom;
+}
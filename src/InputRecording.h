@@ -0,0 +1,102 @@
+#pragma once
+#include <QObject>
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QRectF>
+#include <QString>
+#include <QUrl>
+#include <QVector>
+
+class CanvasController;
+
+// One canvas input call, in canvas coordinates
+struct InputEvent {
+    enum Type : quint8 {
+        Press,
+        Move,
+        Release,
+        Hover,
+        SelectRect,    // Marquee selection; x, y, width, height hold the rect
+        EscapeKey,
+        EnterKey,
+        ModeChange,    // mode holds the new CanvasController::Mode
+        Viewport,      // x, y hold contentX, contentY
+        DragStart,     // Selection controls pressed; x, y, width, height hold their rect
+        DragMove,      // x, y hold the controls' position
+        DragResize,    // x, y, width, height hold the controls' rect
+        DragEndMove,   // x, y hold the total delta
+        DragEndResize
+    };
+
+    Type type = Move;
+    qint64 time = 0;   // Microseconds since the recording started
+    qreal x = 0;
+    qreal y = 0;
+    qreal width = 0;   // SelectRect, DragStart and DragResize only
+    qreal height = 0;
+    qreal zoom = 1;    // Viewport only
+    int mode = 0;      // ModeChange only
+};
+
+/**
+ * InputRecording is a recorded input session: the canvas input calls in
+ * order, and the serialized project as it was when recording started, so a
+ * replay starts from exactly the state the session did.
+ *
+ * The file is a QDataStream: magic, version, the qCompress'ed project JSON,
+ * then the event count and each event as a type byte, the time since the
+ * previous event in microseconds and a type-specific payload stored as
+ * single precision floats.
+ */
+class InputRecording {
+public:
+    QVector<InputEvent> events;
+    QByteArray projectData;    // Compact project JSON; empty when no project was available
+
+    bool save(const QString& filePath) const;
+    bool load(const QString& filePath);
+
+    // Duration from the first to the last event (microseconds)
+    qint64 duration() const { return events.isEmpty() ? 0 : events.last().time; }
+};
+
+/**
+ * InputRecorder captures the input a CanvasController receives. The
+ * controller reports pointer, key and mode calls; the canvas view reports
+ * viewport changes through recordViewport(), since scrolling and zoom only
+ * exist in QML. Element drags and resizes in Select mode go through the
+ * selection controls rather than the controller, so DesignControlsController
+ * reports those. While not recording each hook is a single bool test.
+ */
+class InputRecorder : public QObject {
+    Q_OBJECT
+    Q_PROPERTY(bool recording READ isRecording NOTIFY recordingChanged)
+
+public:
+    explicit InputRecorder(CanvasController* controller);
+
+    bool isRecording() const { return m_recording; }
+    const InputRecording& recording() const { return m_session; }
+
+    // Start a new session: snapshots the project, the mode and the last known viewport
+    Q_INVOKABLE void start();
+    Q_INVOKABLE void stop();
+    Q_INVOKABLE bool save(const QUrl& fileUrl) const;
+
+    void record(InputEvent::Type type, qreal x = 0, qreal y = 0);
+    // Events whose payload is a rectangle: SelectRect, DragStart, DragResize
+    void recordRect(InputEvent::Type type, const QRectF& rect);
+    void recordMode(int mode);
+    Q_INVOKABLE void recordViewport(qreal contentX, qreal contentY, qreal zoom);
+
+signals:
+    void recordingChanged();
+
+private:
+    InputEvent& append(InputEvent::Type type);
+
+    CanvasController* m_controller;
+    InputRecording m_session;
+    QElapsedTimer m_clock;
+    bool m_recording = false;
+};
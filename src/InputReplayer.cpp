@@ -0,0 +1,198 @@
+#include "InputReplayer.h"
+#include "CanvasController.h"
+#include "DesignCanvas.h"
+#include "DesignControlsController.h"
+#include "Project.h"
+#include "PerformanceTrace.h"
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QThread>
+#include <algorithm>
+#include <array>
+#include <vector>
+
+namespace {
+
+constexpr int EventTypeCount = InputEvent::DragEndResize + 1;
+
+const char* eventTypeName(InputEvent::Type type)
+{
+    switch (type) {
+    case InputEvent::Press: return "press";
+    case InputEvent::Move: return "move";
+    case InputEvent::Release: return "release";
+    case InputEvent::Hover: return "hover";
+    case InputEvent::SelectRect: return "selectRect";
+    case InputEvent::EscapeKey: return "escapeKey";
+    case InputEvent::EnterKey: return "enterKey";
+    case InputEvent::ModeChange: return "modeChange";
+    case InputEvent::Viewport: return "viewport";
+    case InputEvent::DragStart: return "dragStart";
+    case InputEvent::DragMove: return "dragMove";
+    case InputEvent::DragResize: return "dragResize";
+    case InputEvent::DragEndMove: return "dragEndMove";
+    case InputEvent::DragEndResize: return "dragEndResize";
+    }
+    return "unknown";
+}
+
+// Runs whatever the last event queued; returns the time it took (us)
+qint64 processPendingWork()
+{
+    QElapsedTimer timer;
+    timer.start();
+    QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+    QCoreApplication::processEvents(QEventLoop::AllEvents);
+    return timer.nsecsElapsed() / 1000;
+}
+
+QJsonObject latencyStats(std::vector<qint64>& samples)
+{
+    std::sort(samples.begin(), samples.end());
+    const auto percentile = [&samples](double p) {
+        return samples[std::min(samples.size() - 1, static_cast<size_t>(p * samples.size()))];
+    };
+
+    QJsonObject stats;
+    stats["count"] = static_cast<qint64>(samples.size());
+    stats["p50Us"] = percentile(0.5);
+    stats["p95Us"] = percentile(0.95);
+    stats["p99Us"] = percentile(0.99);
+    stats["maxUs"] = samples.back();
+    return stats;
+}
+
+}
+
+InputReplayer::InputReplayer(CanvasController* controller)
+    : m_controller(controller)
+{
+    if (Project* project = qobject_cast<Project*>(controller->parent())) {
+        m_designControls = std::make_unique<DesignControlsController>(project);
+    }
+}
+
+InputReplayer::~InputReplayer() = default;
+
+QJsonObject InputReplayer::replay(const InputRecording& recording, Speed speed)
+{
+    std::array<std::vector<qint64>, EventTypeCount> latencies;
+    qint64 inputWork = 0;
+    qint64 frameWork = 0;
+
+    QElapsedTimer wall;
+    wall.start();
+    QElapsedTimer call;
+
+    for (const InputEvent& event : recording.events) {
+        if (speed == OriginalSpeed) {
+            // Let timers fire during the recorded gap, as they did in the session
+            while (wall.nsecsElapsed() / 1000 < event.time) {
+                frameWork += processPendingWork();
+                const qint64 remaining = event.time - wall.nsecsElapsed() / 1000;
+                if (remaining > 0) {
+                    QThread::usleep(static_cast<unsigned long>(std::min<qint64>(remaining, 1000)));
+                }
+            }
+        }
+
+        call.start();
+        dispatch(event);
+        const qint64 latency = call.nsecsElapsed() / 1000;
+        latencies[event.type].push_back(latency);
+        inputWork += latency;
+
+        frameWork += processPendingWork();
+    }
+    frameWork += processPendingWork();
+
+    QJsonObject perType;
+    for (int type = 0; type < EventTypeCount; ++type) {
+        if (!latencies[type].empty()) {
+            perType[eventTypeName(static_cast<InputEvent::Type>(type))] = latencyStats(latencies[type]);
+        }
+    }
+
+    QJsonObject report;
+    report["speed"] = speed == OriginalSpeed ? "original" : "maximum";
+    report["events"] = static_cast<qint64>(recording.events.size());
+    report["recordedDurationUs"] = recording.duration();
+    report["wallTimeUs"] = wall.nsecsElapsed() / 1000;
+    report["inputWorkUs"] = inputWork;
+    report["frameWorkUs"] = frameWork;
+    report["latency"] = perType;
+    return report;
+}
+
+void InputReplayer::dispatch(const InputEvent& event)
+{
+    TRACE_SCOPE("InputReplayer::dispatch", "input");
+
+    switch (event.type) {
+    case InputEvent::Press:
+        m_controller->handleMousePress(event.x, event.y);
+        break;
+    case InputEvent::Move:
+        m_controller->handleMouseMove(event.x, event.y);
+        break;
+    case InputEvent::Release:
+        m_controller->handleMouseRelease(event.x, event.y);
+        break;
+    case InputEvent::Hover:
+        if (DesignCanvas* designCanvas = qobject_cast<DesignCanvas*>(m_controller)) {
+            designCanvas->updateHover(event.x, event.y);
+        }
+        break;
+    case InputEvent::SelectRect:
+        m_controller->selectElementsInRect(QRectF(event.x, event.y, event.width, event.height));
+        break;
+    case InputEvent::EscapeKey:
+        m_controller->handleEscapeKey();
+        break;
+    case InputEvent::EnterKey:
+        m_controller->handleEnterKey();
+        break;
+    case InputEvent::ModeChange:
+        m_controller->setMode(static_cast<CanvasController::Mode>(event.mode));
+        break;
+    case InputEvent::Viewport:
+        // No view to scroll headless; keep the controller's copy current so a
+        // view attached later opens where the session was looking
+        m_controller->setSavedContentX(event.x);
+        m_controller->setSavedContentY(event.y);
+        m_controller->setSavedZoom(event.zoom);
+        break;
+    case InputEvent::DragStart:
+    case InputEvent::DragMove:
+    case InputEvent::DragResize:
+    case InputEvent::DragEndMove:
+    case InputEvent::DragEndResize:
+        dispatchDrag(event);
+        break;
+    }
+}
+
+void InputReplayer::dispatchDrag(const InputEvent& event)
+{
+    if (!m_designControls) return;
+
+    switch (event.type) {
+    case InputEvent::DragStart:
+        m_designControls->startDragOperation(QRectF(event.x, event.y, event.width, event.height));
+        break;
+    case InputEvent::DragMove:
+        m_designControls->updateMoveOperation(QPointF(event.x, event.y));
+        break;
+    case InputEvent::DragResize:
+        m_designControls->updateResizeOperation(QRectF(event.x, event.y, event.width, event.height));
+        break;
+    case InputEvent::DragEndMove:
+        m_designControls->endMoveOperation(QPointF(event.x, event.y));
+        break;
+    case InputEvent::DragEndResize:
+        m_designControls->endResizeOperation();
+        break;
+    default:
+        break;
+    }
+}
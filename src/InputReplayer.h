@@ -0,0 +1,44 @@
+#pragma once
+#include <QJsonObject>
+#include <memory>
+#include "InputRecording.h"
+
+class CanvasController;
+class DesignControlsController;
+
+/**
+ * InputReplayer feeds a recorded input session to a CanvasController and
+ * measures it. Drags and resizes of the selection controls go to a
+ * DesignControlsController for the controller's project, as they do in the
+ * editor. Each event's latency is the time its controller call takes;
+ * work the call queues (throttled updates, batched flex layouts, deferred
+ * deletes) runs when the replayer processes events afterwards and is
+ * counted as frame work.
+ *
+ * At original speed the replayer keeps the recorded gaps between events, so
+ * timers fire as they did in the session; at maximum speed events follow each
+ * other as soon as the previous one's work is done.
+ */
+class InputReplayer {
+public:
+    enum Speed {
+        OriginalSpeed,
+        MaximumSpeed
+    };
+
+    explicit InputReplayer(CanvasController* controller);
+    ~InputReplayer();
+
+    // Replays the events, blocking until done. The returned report has the
+    // event count, total wall time, total frame work, and for every event type
+    // seen its count and p50/p95/p99/max latency, all times in microseconds.
+    QJsonObject replay(const InputRecording& recording, Speed speed);
+
+private:
+    void dispatch(const InputEvent& event);
+    // Selection control drags, which bypass the canvas controller
+    void dispatchDrag(const InputEvent& event);
+
+    CanvasController* m_controller;
+    std::unique_ptr<DesignControlsController> m_designControls;
+};
@@ -0,0 +1,190 @@
+#include "MemoryDiagnostics.h"
+#include "Application.h"
+#include "CommandHistory.h"
+#include "Config.h"
+#include "ConsoleMessageRepository.h"
+#include "Element.h"
+#include "HitTestService.h"
+#include "Project.h"
+#include "PropertyRegistry.h"
+#include "TextMeasurementService.h"
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDebug>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QTimer>
+#include <algorithm>
+
+MemoryDiagnostics* MemoryDiagnostics::s_instance = nullptr;
+
+MemoryDiagnostics* MemoryDiagnostics::instance()
+{
+    if (!s_instance) {
+        s_instance = new MemoryDiagnostics(QCoreApplication::instance());
+    }
+    return s_instance;
+}
+
+MemoryDiagnostics::MemoryDiagnostics(QObject *parent)
+    : QObject(parent)
+    , m_logTimer(new QTimer(this))
+{
+    connect(m_logTimer, &QTimer::timeout, this, &MemoryDiagnostics::logSample);
+}
+
+QList<MemoryDiagnostics::Row> MemoryDiagnostics::collect() const
+{
+    QList<Row> rows;
+    Application* app = Application::instance();
+    if (!app) {
+        return rows;
+    }
+
+    for (const auto& project : app->canvases()) {
+        const QString id = project->id();
+        const QString name = project->name();
+
+        MemoryUsage properties;
+        for (Element* element : project->elementModel()->getAllElements()) {
+            if (const PropertyRegistry* registry = element->propertyRegistry()) {
+                properties += registry->memoryUsage();
+            }
+        }
+        rows.append({id, name, "properties", properties});
+
+        CanvasController* controller = project->controller();
+        rows.append({id, name, "spatialIndex",
+                     controller->hitTestService() ? controller->hitTestService()->memoryUsage() : MemoryUsage()});
+        rows.append({id, name, "commandHistory",
+                     controller->commandHistory() ? controller->commandHistory()->memoryUsage() : MemoryUsage()});
+        rows.append({id, name, "console",
+                     project->console() ? project->console()->memoryUsage() : MemoryUsage()});
+        rows.append({id, name, "prototypeSnapshot",
+                     project->prototypeController() ? project->prototypeController()->snapshotMemoryUsage() : MemoryUsage()});
+        rows.append({id, name, "compiledScripts",
+                     project->scripts() ? project->scripts()->compiledMemoryUsage() : MemoryUsage()});
+    }
+
+    if (app->commandHistory()) {
+        rows.append({QString(), QString(), "commandHistory", app->commandHistory()->memoryUsage()});
+    }
+    const TextMeasurementService* textMeasurement = TextMeasurementService::instance();
+    rows.append({QString(), QString(), "textMeasurement", textMeasurement->memoryUsage(), textMeasurement->hitRate()});
+    return rows;
+}
+
+QVariantList MemoryDiagnostics::sample() const
+{
+    QVariantList result;
+    for (const Row& row : collect()) {
+        QVariantMap entry;
+        entry["projectId"] = row.projectId;
+        entry["project"] = row.project;
+        entry["subsystem"] = QString::fromLatin1(row.subsystem);
+        entry["bytes"] = row.usage.bytes;
+        entry["objects"] = row.usage.objects;
+        if (row.hitRate >= 0) {
+            entry["hitRate"] = row.hitRate;
+        }
+        result.append(entry);
+    }
+    return result;
+}
+
+QJsonObject MemoryDiagnostics::toJson() const
+{
+    QJsonArray projects;
+    QJsonObject application;
+    QJsonObject current;
+    qint64 projectBytes = 0;
+    qint64 totalBytes = 0;
+
+    const auto finishProject = [&]() {
+        if (current.isEmpty()) return;
+        current["totalBytes"] = projectBytes;
+        projects.append(current);
+        current = QJsonObject();
+        projectBytes = 0;
+    };
+
+    for (const Row& row : collect()) {
+        QJsonObject usage;
+        usage["bytes"] = row.usage.bytes;
+        usage["objects"] = row.usage.objects;
+        if (row.hitRate >= 0) {
+            usage["hitRate"] = row.hitRate;
+        }
+        totalBytes += row.usage.bytes;
+
+        if (row.projectId.isEmpty()) {
+            application[QString::fromLatin1(row.subsystem)] = usage;
+            continue;
+        }
+        if (current.value("id").toString() != row.projectId) {
+            finishProject();
+            current["id"] = row.projectId;
+            current["name"] = row.project;
+        }
+        QJsonObject subsystems = current.value("subsystems").toObject();
+        subsystems[QString::fromLatin1(row.subsystem)] = usage;
+        current["subsystems"] = subsystems;
+        projectBytes += row.usage.bytes;
+    }
+    finishProject();
+
+    QJsonObject result;
+    result["timestamp"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODateWithMs);
+    result["totalBytes"] = totalBytes;
+    result["projects"] = projects;
+    result["application"] = application;
+    return result;
+}
+
+bool MemoryDiagnostics::writeJson(const QUrl& fileUrl) const
+{
+    const QString filePath = fileUrl.isLocalFile() ? fileUrl.toLocalFile() : fileUrl.toString();
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "MemoryDiagnostics: cannot write" << filePath << file.errorString();
+        return false;
+    }
+    file.write(QJsonDocument(toJson()).toJson(QJsonDocument::Indented));
+    return true;
+}
+
+int MemoryDiagnostics::logInterval() const
+{
+    return m_logTimer->isActive() ? m_logTimer->interval() : 0;
+}
+
+void MemoryDiagnostics::setLogInterval(int ms)
+{
+    // A sample walks every element; keep periodic sampling coarse
+    if (ms > 0) {
+        ms = std::max(ms, Config::MEMORY_LOG_MIN_INTERVAL);
+    }
+    if (ms == logInterval()) return;
+
+    if (ms > 0) {
+        m_logTimer->start(ms);
+    } else {
+        m_logTimer->stop();
+    }
+    emit logIntervalChanged();
+}
+
+void MemoryDiagnostics::logSample() const
+{
+    // One line per subsystem so the log can be grepped and plotted
+    for (const Row& row : collect()) {
+        QDebug line = qInfo().noquote();
+        line << "MemoryDiagnostics:"
+             << (row.projectId.isEmpty() ? QStringLiteral("<application>") : row.projectId)
+             << row.subsystem << row.usage.bytes << "bytes" << row.usage.objects << "objects";
+        if (row.hitRate >= 0) {
+            line << "hit rate" << row.hitRate;
+        }
+    }
+}
@@ -0,0 +1,70 @@
+#pragma once
+#include <QObject>
+#include <QJsonObject>
+#include <QUrl>
+#include <QVariantList>
+#include "MemoryUsage.h"
+
+class QTimer;
+
+/**
+ * MemoryDiagnostics attributes the editor's memory to the subsystems that
+ * hold it. For every open project it asks each subsystem for an estimate of
+ * its footprint:
+ *
+ *   properties         element PropertyRegistry maps and PropertyMetadata
+ *   spatialIndex       HitTestService quadtree nodes and lookup tables
+ *   commandHistory     undo/redo stacks, including deleted elements they keep
+ *   console            ConsoleMessageRepository messages
+ *   prototypeSnapshot  the journal kept while prototyping
+ *   compiledScripts    the compiled script and ScriptCompiler's event cache
+ *
+ * plus the application's own command history and TextMeasurementService's
+ * layout cache, which also reports its hit rate. Numbers are estimates (see
+ * MemoryEstimate), good for spotting which subsystem grows, not for adding up
+ * to the resident size.
+ *
+ * A sample walks every element, so it is taken on request: from the
+ * diagnostics panel, as a JSON dump, or every logInterval ms into the log
+ * (also enabled at startup with CUBIT_MEMORY_LOG_INTERVAL=<ms>).
+ */
+class MemoryDiagnostics : public QObject {
+    Q_OBJECT
+    Q_PROPERTY(int logInterval READ logInterval WRITE setLogInterval NOTIFY logIntervalChanged)
+
+public:
+    static MemoryDiagnostics* instance();
+
+    // One map per subsystem and project: projectId, project, subsystem,
+    // bytes and objects; the application-wide rows have an empty projectId.
+    // Cache rows also have hitRate, from 0 to 1
+    Q_INVOKABLE QVariantList sample() const;
+
+    // The same sample grouped by project, with totals and a timestamp
+    QJsonObject toJson() const;
+    // False when the file cannot be written
+    Q_INVOKABLE bool writeJson(const QUrl& fileUrl) const;
+
+    // Log a sample every logInterval ms; 0 turns periodic logging off
+    int logInterval() const;
+    void setLogInterval(int ms);
+
+signals:
+    void logIntervalChanged();
+
+private:
+    explicit MemoryDiagnostics(QObject *parent = nullptr);
+
+    struct Row {
+        QString projectId;
+        QString project;
+        const char* subsystem;
+        MemoryUsage usage;
+        qreal hitRate = -1;  // Cache rows only
+    };
+    QList<Row> collect() const;
+    void logSample() const;
+
+    static MemoryDiagnostics* s_instance;
+    QTimer* m_logTimer;
+};
@@ -0,0 +1,69 @@
+#include "MemoryUsage.h"
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QString>
+#include <QStringList>
+#include <QVariant>
+
+namespace {
+// Header in front of every QArrayData allocation (ref count, flags, capacity)
+constexpr qint64 ArrayHeader = 16;
+}
+
+qint64 MemoryEstimate::of(const QString& string)
+{
+    if (string.isNull()) return 0;
+    return ArrayHeader + string.capacity() * qint64(sizeof(QChar));
+}
+
+qint64 MemoryEstimate::of(const QStringList& list)
+{
+    if (list.isEmpty()) return 0;
+    qint64 bytes = ArrayHeader + list.capacity() * qint64(sizeof(QString));
+    for (const QString& string : list) {
+        bytes += of(string);
+    }
+    return bytes;
+}
+
+qint64 MemoryEstimate::of(const QVariant& value)
+{
+    // Small types live inside the QVariant itself
+    switch (value.typeId()) {
+    case QMetaType::QString:
+        return of(value.toString());
+    case QMetaType::QStringList:
+        return of(value.toStringList());
+    case QMetaType::QByteArray:
+        return ArrayHeader + value.toByteArray().capacity();
+    case QMetaType::QVariantList: {
+        const QVariantList list = value.toList();
+        qint64 bytes = ArrayHeader + list.capacity() * qint64(sizeof(QVariant));
+        for (const QVariant& item : list) {
+            bytes += of(item);
+        }
+        return bytes;
+    }
+    case QMetaType::QVariantMap: {
+        const QVariantMap map = value.toMap();
+        qint64 bytes = 0;
+        for (auto it = map.cbegin(); it != map.cend(); ++it) {
+            // std::map node: parent, left and right pointers plus the colour
+            bytes += 4 * qint64(sizeof(void*)) + qint64(sizeof(QString) + sizeof(QVariant))
+                     + of(it.key()) + of(it.value());
+        }
+        return bytes;
+    }
+    case QMetaType::QJsonObject:
+        return of(value.toJsonObject());
+    default:
+        return 0;
+    }
+}
+
+qint64 MemoryEstimate::of(const QJsonObject& object)
+{
+    // QJsonObject keeps a CBOR container close to the compact JSON in size
+    if (object.isEmpty()) return 0;
+    return ArrayHeader + QJsonDocument(object).toJson(QJsonDocument::Compact).size();
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include <QtGlobal>
+
+class QString;
+class QStringList;
+class QVariant;
+class QJsonObject;
+
+// Estimated footprint of a subsystem, as reported to MemoryDiagnostics
+struct MemoryUsage {
+    qint64 bytes = 0;
+    qint64 objects = 0;
+
+    MemoryUsage& operator+=(const MemoryUsage& other)
+    {
+        bytes += other.bytes;
+        objects += other.objects;
+        return *this;
+    }
+};
+
+/**
+ * Heap estimates for the payloads subsystems hold, for use in their
+ * memoryUsage() functions. They count allocated capacity plus the container
+ * header, not allocator overhead, and implicitly shared data is counted at
+ * every reference; the numbers are for attributing growth, not for adding
+ * up to the process's resident size.
+ */
+namespace MemoryEstimate {
+    // Per-entry bookkeeping of node based hashes (next pointer and hash)
+    constexpr qint64 HASH_NODE_OVERHEAD = 2 * sizeof(void*);
+    // The QObjectPrivate behind every QObject, beyond sizeof the object itself
+    constexpr qint64 QOBJECT_OVERHEAD = 128;
+
+    qint64 of(const QString& string);
+    qint64 of(const QStringList& list);
+    qint64 of(const QVariant& value);
+    qint64 of(const QJsonObject& object);
+}
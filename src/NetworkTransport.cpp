@@ -0,0 +1,333 @@
+#include "NetworkTransport.h"
+#include "Config.h"
+#include <QCoreApplication>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QRandomGenerator>
+#include <QTimer>
+#include <QtMath>
+#include <algorithm>
+#include <utility>
+
+NetworkTransport* NetworkTransport::s_instance = nullptr;
+
+// Upper bounds of the latency buckets; the last bucket takes everything slower
+const std::array<int, NetworkTransport::LatencyBucketCount - 1> NetworkTransport::s_bucketBoundsMs = {
+    10, 25, 50, 100, 250, 500, 1000, 2500, 5000, 10000
+};
+
+NetworkTransport* NetworkTransport::instance()
+{
+    if (!s_instance) {
+        s_instance = new NetworkTransport(QCoreApplication::instance());
+    }
+    return s_instance;
+}
+
+NetworkTransport::NetworkTransport(QObject *parent)
+    : QObject(parent)
+    , m_manager(new QNetworkAccessManager(this))
+{
+    // Replies are handed to the caller's handler first and deleted afterwards
+    m_manager->setAutoDeleteReplies(false);
+
+    m_statisticsTimer = new QTimer(this);
+    m_statisticsTimer->setSingleShot(true);
+    m_statisticsTimer->setInterval(500);
+    connect(m_statisticsTimer, &QTimer::timeout, this, &NetworkTransport::statisticsChanged);
+}
+
+quint64 NetworkTransport::get(const QNetworkRequest& request, QObject* context, Handler handler,
+                              Priority priority)
+{
+    return enqueue(QByteArrayLiteral("GET"), request, QByteArray(), context, std::move(handler), priority);
+}
+
+quint64 NetworkTransport::post(const QNetworkRequest& request, const QByteArray& body, QObject* context,
+                               Handler handler, Priority priority)
+{
+    return enqueue(QByteArrayLiteral("POST"), request, body, context, std::move(handler), priority);
+}
+
+quint64 NetworkTransport::enqueue(const QByteArray& verb, const QNetworkRequest& request, const QByteArray& body,
+                                  QObject* context, Handler handler, Priority priority)
+{
+    PendingRequest pending;
+    pending.id = m_nextId++;
+    pending.verb = verb;
+    pending.request = request;
+    pending.request.setAttribute(QNetworkRequest::Http2AllowedAttribute, true);
+    pending.body = body;
+    pending.contextKey = context;
+    pending.context = context;
+    pending.handler = std::move(handler);
+    pending.priority = priority;
+
+    if (context) {
+        connect(context, &QObject::destroyed, this, &NetworkTransport::onContextDestroyed,
+                Qt::UniqueConnection);
+    }
+
+    const quint64 id = pending.id;
+    m_queues[priority].enqueue(std::move(pending));
+    dispatch();
+    scheduleStatisticsChanged();
+    return id;
+}
+
+void NetworkTransport::requeue(PendingRequest pending)
+{
+    if (!pending.context) return;
+
+    // A retry goes ahead of requests of the same priority that arrived after it
+    m_queues[pending.priority].prepend(std::move(pending));
+    dispatch();
+}
+
+int NetworkTransport::queued() const
+{
+    int total = m_backingOff.size();
+    for (const auto& queue : m_queues) {
+        total += queue.size();
+    }
+    return total;
+}
+
+bool NetworkTransport::canStart(Priority priority) const
+{
+    const int limit = priority == InteractivePriority
+        ? Config::NETWORK_MAX_IN_FLIGHT
+        : Config::NETWORK_MAX_IN_FLIGHT - Config::NETWORK_INTERACTIVE_RESERVE;
+    return m_active.size() < limit;
+}
+
+void NetworkTransport::dispatch()
+{
+    for (int priority = InteractivePriority; priority >= BackgroundPriority; --priority) {
+        QQueue<PendingRequest>& queue = m_queues[priority];
+        while (!queue.isEmpty() && canStart(static_cast<Priority>(priority))) {
+            PendingRequest pending = queue.dequeue();
+            if (pending.context) {
+                start(std::move(pending));
+            }
+        }
+        // Lower priorities wait until this level is drained
+        if (!queue.isEmpty()) return;
+    }
+}
+
+void NetworkTransport::start(PendingRequest pending)
+{
+    QNetworkReply* reply = pending.verb == "GET"
+        ? m_manager->get(pending.request)
+        : m_manager->sendCustomRequest(pending.request, pending.verb, pending.body);
+
+    pending.started.start();
+    m_active.insert(reply, std::move(pending));
+    connect(reply, &QNetworkReply::finished, this, &NetworkTransport::onReplyFinished);
+}
+
+void NetworkTransport::onReplyFinished()
+{
+    QNetworkReply* reply = qobject_cast<QNetworkReply*>(sender());
+    if (!reply || !m_active.contains(reply)) {
+        return;
+    }
+
+    PendingRequest pending = m_active.take(reply);
+    const bool failed = reply->error() != QNetworkReply::NoError;
+    const bool retry = failed && shouldRetry(reply, pending);
+    if (reply->error() != QNetworkReply::OperationCanceledError) {
+        record(endpointKey(pending.request.url()), pending.started.elapsed(), failed, retry);
+    }
+
+    if (retry) {
+        const int delay = retryDelay(reply, pending.attempt);
+        ++pending.attempt;
+        const quint64 id = pending.id;
+        m_backingOff.insert(id, std::move(pending));
+        QTimer::singleShot(delay, this, [this, id]() {
+            if (m_backingOff.contains(id)) {
+                requeue(m_backingOff.take(id));
+            }
+        });
+    } else if (pending.context && pending.handler) {
+        pending.handler(reply);
+    }
+
+    reply->deleteLater();
+    dispatch();
+}
+
+bool NetworkTransport::shouldRetry(QNetworkReply* reply, const PendingRequest& pending) const
+{
+    if (pending.attempt >= Config::NETWORK_MAX_RETRIES || !pending.context) {
+        return false;
+    }
+
+    // The request never reached the server, or the server said it did not act on it
+    switch (reply->error()) {
+    case QNetworkReply::ConnectionRefusedError:
+    case QNetworkReply::HostNotFoundError:
+    case QNetworkReply::TemporaryNetworkFailureError:
+    case QNetworkReply::NetworkSessionFailedError:
+    case QNetworkReply::ProxyConnectionRefusedError:
+        return true;
+    default:
+        break;
+    }
+
+    const int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (status == 429 || status == 503) {
+        return true;
+    }
+
+    // Anything else may have been applied server-side; only repeat requests without side effects
+    if (pending.verb != "GET") {
+        return false;
+    }
+    return reply->error() == QNetworkReply::RemoteHostClosedError
+        || reply->error() == QNetworkReply::TimeoutError
+        || status == 502 || status == 504;
+}
+
+int NetworkTransport::retryDelay(QNetworkReply* reply, int attempt) const
+{
+    // Honour a Retry-After given in seconds
+    bool ok = false;
+    const int retryAfter = reply->rawHeader("Retry-After").toInt(&ok);
+    if (ok && retryAfter >= 0) {
+        return std::min(retryAfter, Config::NETWORK_RETRY_MAX_DELAY / 1000) * 1000;
+    }
+
+    // Exponential backoff with up to 25% jitter so clients do not retry in lockstep
+    const int base = std::min(Config::NETWORK_RETRY_BASE_DELAY << std::min(attempt, 10),
+                              Config::NETWORK_RETRY_MAX_DELAY);
+    return base + QRandomGenerator::global()->bounded(base / 4 + 1);
+}
+
+void NetworkTransport::cancel(quint64 id)
+{
+    m_backingOff.remove(id);
+
+    for (auto& queue : m_queues) {
+        for (auto it = queue.begin(); it != queue.end(); ++it) {
+            if (it->id == id) {
+                queue.erase(it);
+                scheduleStatisticsChanged();
+                return;
+            }
+        }
+    }
+
+    for (auto it = m_active.begin(); it != m_active.end(); ++it) {
+        if (it->id == id) {
+            // Drop the handler before abort() delivers finished()
+            it->handler = nullptr;
+            it.key()->abort();
+            return;
+        }
+    }
+}
+
+void NetworkTransport::onContextDestroyed(QObject* context)
+{
+    for (auto& queue : m_queues) {
+        queue.removeIf([context](const PendingRequest& pending) {
+            return pending.contextKey == context;
+        });
+    }
+    m_backingOff.removeIf([context](const QHash<quint64, PendingRequest>::iterator it) {
+        return it->contextKey == context;
+    });
+
+    QList<QNetworkReply*> orphaned;
+    for (auto it = m_active.begin(); it != m_active.end(); ++it) {
+        if (it->contextKey == context) {
+            it->handler = nullptr;
+            orphaned.append(it.key());
+        }
+    }
+    for (QNetworkReply* reply : std::as_const(orphaned)) {
+        reply->abort();
+    }
+
+    scheduleStatisticsChanged();
+}
+
+QString NetworkTransport::endpointKey(const QUrl& url)
+{
+    return url.adjusted(QUrl::RemoveUserInfo | QUrl::RemoveQuery | QUrl::RemoveFragment).toString();
+}
+
+void NetworkTransport::record(const QString& endpoint, qint64 elapsedMs, bool failed, bool retried)
+{
+    EndpointStats& stats = m_stats[endpoint];
+    ++stats.count;
+    if (failed) ++stats.errors;
+    if (retried) ++stats.retries;
+    stats.totalMs += elapsedMs;
+    stats.maxMs = std::max(stats.maxMs, elapsedMs);
+
+    const auto bound = std::lower_bound(s_bucketBoundsMs.begin(), s_bucketBoundsMs.end(), elapsedMs);
+    ++stats.buckets[bound - s_bucketBoundsMs.begin()];
+
+    scheduleStatisticsChanged();
+}
+
+void NetworkTransport::scheduleStatisticsChanged()
+{
+    if (!m_statisticsTimer->isActive()) {
+        m_statisticsTimer->start();
+    }
+}
+
+QVariantList NetworkTransport::latencyStatistics() const
+{
+    QVariantList bounds;
+    for (int bound : s_bucketBoundsMs) {
+        bounds.append(bound);
+    }
+
+    QVariantList result;
+    for (auto it = m_stats.cbegin(); it != m_stats.cend(); ++it) {
+        const EndpointStats& stats = it.value();
+
+        // Percentiles are reported as the upper bound of the bucket they fall in
+        auto percentile = [&stats](double fraction) -> qint64 {
+            const qint64 target = qCeil(stats.count * fraction);
+            qint64 seen = 0;
+            for (int i = 0; i < LatencyBucketCount - 1; ++i) {
+                seen += stats.buckets[i];
+                if (seen >= target) return s_bucketBoundsMs[i];
+            }
+            return stats.maxMs;
+        };
+
+        QVariantList buckets;
+        for (qint64 count : stats.buckets) {
+            buckets.append(count);
+        }
+
+        QVariantMap entry;
+        entry["endpoint"] = it.key();
+        entry["count"] = stats.count;
+        entry["errors"] = stats.errors;
+        entry["retries"] = stats.retries;
+        entry["meanMs"] = stats.count > 0 ? double(stats.totalMs) / stats.count : 0.0;
+        entry["maxMs"] = stats.maxMs;
+        entry["p50Ms"] = percentile(0.50);
+        entry["p90Ms"] = percentile(0.90);
+        entry["p99Ms"] = percentile(0.99);
+        entry["buckets"] = buckets;
+        entry["bucketBoundsMs"] = bounds;
+        result.append(entry);
+    }
+    return result;
+}
+
+void NetworkTransport::resetStatistics()
+{
+    m_stats.clear();
+    emit statisticsChanged();
+}
@@ -0,0 +1,128 @@
+#pragma once
+#include <QObject>
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QList>
+#include <QNetworkRequest>
+#include <QPointer>
+#include <QQueue>
+#include <QString>
+#include <QVariantList>
+#include <array>
+#include <functional>
+
+class QNetworkAccessManager;
+class QNetworkReply;
+class QTimer;
+
+/**
+ * NetworkTransport is the one QNetworkAccessManager the application talks to
+ * the network through, so connections, TLS sessions and HTTP/2 streams to the
+ * same host are shared by every client instead of being set up per request.
+ *
+ * Requests wait in per-priority queues and at most NETWORK_MAX_IN_FLIGHT of
+ * them run at once; a few slots are kept free of background work so an
+ * interactive AI request never queues behind a burst of sync saves. Requests
+ * that fail before the server could have acted on them (connection refused,
+ * 429/503, and for GETs also dropped connections and gateway errors) are
+ * retried with exponential backoff.
+ *
+ * The handler runs once with the final reply, in the context object's thread,
+ * and the reply is deleted after it returns. If the context is destroyed first
+ * the request is dropped and the handler never runs.
+ *
+ * Per-endpoint (scheme, host and path) latency histograms are kept for every
+ * attempt and exposed to QML through latencyStatistics().
+ */
+class NetworkTransport : public QObject {
+    Q_OBJECT
+    Q_PROPERTY(int inFlight READ inFlight NOTIFY statisticsChanged)
+    Q_PROPERTY(int queued READ queued NOTIFY statisticsChanged)
+
+public:
+    enum Priority {
+        BackgroundPriority = 0,  // Sync saves, prefetches
+        NormalPriority,          // Loads the user asked for but is not blocked on
+        InteractivePriority      // AI chat and auth, the user is waiting
+    };
+    Q_ENUM(Priority)
+
+    using Handler = std::function<void(QNetworkReply*)>;
+
+    static NetworkTransport* instance();
+
+    // Queue a request; returns an id usable with cancel()
+    quint64 get(const QNetworkRequest& request, QObject* context, Handler handler,
+                Priority priority = NormalPriority);
+    quint64 post(const QNetworkRequest& request, const QByteArray& body, QObject* context,
+                 Handler handler, Priority priority = NormalPriority);
+
+    // Drop a queued request or abort a running one; its handler is not called
+    void cancel(quint64 id);
+
+    int inFlight() const { return static_cast<int>(m_active.size()); }
+    int queued() const;
+
+    // One map per endpoint: endpoint, count, errors, retries, meanMs, maxMs,
+    // p50Ms, p90Ms, p99Ms, buckets (counts) and bucketBoundsMs
+    Q_INVOKABLE QVariantList latencyStatistics() const;
+    Q_INVOKABLE void resetStatistics();
+
+signals:
+    void statisticsChanged();
+
+private slots:
+    void onReplyFinished();
+    void onContextDestroyed(QObject* context);
+
+private:
+    explicit NetworkTransport(QObject *parent = nullptr);
+
+    static constexpr int LatencyBucketCount = 11;
+    static const std::array<int, LatencyBucketCount - 1> s_bucketBoundsMs;
+
+    struct PendingRequest {
+        quint64 id = 0;
+        QByteArray verb;
+        QNetworkRequest request;
+        QByteArray body;
+        QObject* contextKey = nullptr;   // For matching in onContextDestroyed
+        QPointer<QObject> context;
+        Handler handler;
+        Priority priority = NormalPriority;
+        int attempt = 0;
+        QElapsedTimer started;
+    };
+
+    struct EndpointStats {
+        qint64 count = 0;
+        qint64 errors = 0;
+        qint64 retries = 0;
+        qint64 totalMs = 0;
+        qint64 maxMs = 0;
+        std::array<qint64, LatencyBucketCount> buckets{};
+    };
+
+    quint64 enqueue(const QByteArray& verb, const QNetworkRequest& request, const QByteArray& body,
+                    QObject* context, Handler handler, Priority priority);
+    void requeue(PendingRequest pending);
+    void dispatch();
+    bool canStart(Priority priority) const;
+    void start(PendingRequest pending);
+    bool shouldRetry(QNetworkReply* reply, const PendingRequest& pending) const;
+    int retryDelay(QNetworkReply* reply, int attempt) const;
+    void record(const QString& endpoint, qint64 elapsedMs, bool failed, bool retried);
+    void scheduleStatisticsChanged();
+    static QString endpointKey(const QUrl& url);
+
+    QNetworkAccessManager* m_manager;
+    std::array<QQueue<PendingRequest>, InteractivePriority + 1> m_queues;
+    QHash<QNetworkReply*, PendingRequest> m_active;
+    QHash<quint64, PendingRequest> m_backingOff;   // Waiting out a retry delay
+    QHash<QString, EndpointStats> m_stats;
+    quint64 m_nextId = 1;
+    QTimer* m_statisticsTimer;
+
+    static NetworkTransport* s_instance;
+};
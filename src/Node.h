@@ -78,6 +78,7 @@ public:
     void addRow(const RowConfig &config);
     void clearRows();
     QVariantList rowConfigurations() const;
+    const QList<RowConfig>& rows() const { return m_rowConfigs; }
     Q_INVOKABLE int getRowForInputPort(int portIndex) const;
     Q_INVOKABLE int getRowForOutputPort(int portIndex) const;
     
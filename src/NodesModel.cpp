@@ -0,0 +1,145 @@
+#include "NodesModel.h"
+#include "Node.h"
+#include "Scripts.h"
+
+NodesModel::NodesModel(QObject *parent)
+    : QAbstractListModel(parent)
+{
+}
+
+int NodesModel::rowCount(const QModelIndex &parent) const
+{
+    if (parent.isValid())
+        return 0;
+    return m_nodes.size();
+}
+
+QVariant NodesModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_nodes.size())
+        return QVariant();
+
+    Node *node = m_nodes.at(index.row());
+    switch (role) {
+    case ElementRole:
+        return QVariant::fromValue(node);
+    case ElementIdRole:
+        return node->getId();
+    case ElementTypeRole:
+        return node->getTypeName();
+    case NodeTypeRole:
+        return node->nodeType();
+    default:
+        return QVariant();
+    }
+}
+
+QHash<int, QByteArray> NodesModel::roleNames() const
+{
+    QHash<int, QByteArray> roles;
+    roles[ElementRole] = "element";
+    roles[ElementIdRole] = "elementId";
+    roles[ElementTypeRole] = "elementType";
+    roles[NodeTypeRole] = "nodeType";
+    return roles;
+}
+
+void NodesModel::setScripts(Scripts *scripts)
+{
+    if (m_scripts == scripts) return;
+
+    if (m_scripts) {
+        disconnect(m_scripts, nullptr, this, nullptr);
+    }
+
+    m_scripts = scripts;
+
+    if (m_scripts) {
+        connect(m_scripts, &Scripts::nodeAdded, this, &NodesModel::onNodeAdded);
+        connect(m_scripts, &Scripts::nodeRemoved, this, &NodesModel::onNodeRemoved);
+        // clearNodes() only emits nodesChanged; catch it by count
+        connect(m_scripts, &Scripts::nodesChanged, this, [this]() {
+            if (m_scripts && m_scripts->nodeCount() != m_nodes.size()) {
+                resync();
+            }
+        });
+        connect(m_scripts, &QObject::destroyed, this, &NodesModel::resync);
+    }
+
+    resync();
+    emit scriptsChanged();
+}
+
+Node* NodesModel::nodeAt(int row) const
+{
+    if (row >= 0 && row < m_nodes.size()) {
+        return m_nodes.at(row);
+    }
+    return nullptr;
+}
+
+void NodesModel::resync()
+{
+    const int oldCount = m_nodes.size();
+
+    beginResetModel();
+    for (Node *node : std::as_const(m_nodes)) {
+        disconnect(node, nullptr, this, nullptr);
+    }
+    m_nodes.clear();
+    if (m_scripts) {
+        for (Node *node : m_scripts->getAllNodes()) {
+            m_nodes.append(node);
+            connect(node, &QObject::destroyed, this, &NodesModel::onNodeDestroyed);
+        }
+    }
+    endResetModel();
+
+    if (m_nodes.size() != oldCount) {
+        emit countChanged();
+    }
+}
+
+void NodesModel::onNodeAdded(Node *node)
+{
+    if (node && !m_nodes.contains(node)) {
+        insertNode(node);
+    }
+}
+
+void NodesModel::onNodeRemoved(Node *node)
+{
+    removeRow(m_nodes.indexOf(node));
+}
+
+void NodesModel::onNodeDestroyed(QObject *object)
+{
+    // Compare addresses only; the Node part of the object is already gone
+    for (int row = 0; row < m_nodes.size(); ++row) {
+        if (static_cast<QObject*>(m_nodes.at(row)) == object) {
+            removeRow(row);
+            return;
+        }
+    }
+}
+
+void NodesModel::insertNode(Node *node)
+{
+    const int row = m_nodes.size();
+    beginInsertRows(QModelIndex(), row, row);
+    m_nodes.append(node);
+    connect(node, &QObject::destroyed, this, &NodesModel::onNodeDestroyed);
+    endInsertRows();
+    emit countChanged();
+}
+
+void NodesModel::removeRow(int row)
+{
+    if (row < 0 || row >= m_nodes.size()) return;
+
+    beginRemoveRows(QModelIndex(), row, row);
+    Node *node = m_nodes.takeAt(row);
+    disconnect(node, nullptr, this, nullptr);
+    endRemoveRows();
+    emit countChanged();
+}
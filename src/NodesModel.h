@@ -0,0 +1,53 @@
+#pragma once
+#include <QAbstractListModel>
+#include <QList>
+#include <QPointer>
+
+class Node;
+class Scripts;
+
+// List model of the nodes in a Scripts graph, for the script canvas node layer.
+// Rows follow Scripts' node order and update on nodeAdded/nodeRemoved.
+class NodesModel : public QAbstractListModel {
+    Q_OBJECT
+    Q_PROPERTY(Scripts* scripts READ scripts WRITE setScripts NOTIFY scriptsChanged)
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+
+public:
+    enum NodeRoles {
+        ElementRole = Qt::UserRole + 1,
+        ElementIdRole,
+        ElementTypeRole,
+        NodeTypeRole
+    };
+
+    explicit NodesModel(QObject *parent = nullptr);
+
+    // QAbstractListModel interface
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    Scripts* scripts() const { return m_scripts; }
+    void setScripts(Scripts *scripts);
+    int count() const { return m_nodes.size(); }
+
+    Q_INVOKABLE Node* nodeAt(int row) const;
+
+signals:
+    void scriptsChanged();
+    void countChanged();
+
+private slots:
+    void onNodeAdded(Node *node);
+    void onNodeRemoved(Node *node);
+    void onNodeDestroyed(QObject *object);
+    void resync();
+
+private:
+    void insertNode(Node *node);
+    void removeRow(int row);
+
+    QPointer<Scripts> m_scripts;
+    QList<Node*> m_nodes;
+};
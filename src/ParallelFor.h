@@ -0,0 +1,34 @@
+#pragma once
+#include <QSemaphore>
+#include <QThreadPool>
+#include <algorithm>
+#include <atomic>
+
+// Runs work(begin, end) over [0, count) in chunks of chunkSize, on idle global
+// thread pool threads and the calling thread, and returns once every chunk is
+// done. Only threads that are free right away are used, so it never waits on
+// queued work and may be nested or called from a pool thread. work must be
+// safe to run concurrently for disjoint ranges.
+template<typename Work>
+void parallelForChunks(int count, int chunkSize, Work work)
+{
+    const int chunkCount = (count + chunkSize - 1) / chunkSize;
+    std::atomic<int> nextChunk{0};
+    auto drain = [&]() {
+        for (int chunk = nextChunk++; chunk < chunkCount; chunk = nextChunk++) {
+            work(chunk * chunkSize, std::min(count, (chunk + 1) * chunkSize));
+        }
+    };
+
+    QThreadPool* pool = QThreadPool::globalInstance();
+    QSemaphore finished;
+    int helpers = 0;
+    while (helpers < chunkCount - 1 && pool->tryStart([&drain, &finished]() {
+        drain();
+        finished.release();
+    })) {
+        ++helpers;
+    }
+    drain();
+    finished.acquire(helpers);
+}
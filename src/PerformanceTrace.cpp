@@ -0,0 +1,235 @@
+#include "PerformanceTrace.h"
+#include "Config.h"
+#include <QCoreApplication>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QThread>
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+std::atomic<bool> PerformanceTrace::s_enabled{false};
+
+namespace {
+
+struct TraceEvent {
+    const char* name = nullptr;
+    const char* category = nullptr;
+    char phase = 'X';          // 'X' complete span, 'A' async span, 'C' counter
+    qint64 timestamp = 0;      // ns on the trace clock
+    qint64 duration = 0;       // ns, spans only
+    double value = 0;          // Counters only
+    QString detail;
+};
+
+// One thread's events. The recording thread is the only writer; the mutex is
+// there for clear() and export, so it is uncontended while recording.
+struct ThreadBuffer {
+    std::mutex mutex;
+    std::vector<TraceEvent> events;
+    quint64 written = 0;       // Total appended; events wrap once it passes the capacity
+    int threadId = 0;
+    QString threadName;
+
+    void append(TraceEvent&& event)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        events[written % events.size()] = std::move(event);
+        ++written;
+    }
+};
+
+struct Registry {
+    std::mutex mutex;
+    // Buffers outlive their threads so events from finished threads still export
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+};
+
+Registry& registry()
+{
+    static Registry instance;
+    return instance;
+}
+
+ThreadBuffer& threadBuffer()
+{
+    thread_local std::shared_ptr<ThreadBuffer> buffer;
+    if (!buffer) {
+        buffer = std::make_shared<ThreadBuffer>();
+        buffer->events.resize(Config::TRACE_BUFFER_EVENTS);
+
+        QThread* thread = QThread::currentThread();
+        if (QCoreApplication::instance() && thread == QCoreApplication::instance()->thread()) {
+            buffer->threadName = QStringLiteral("Main");
+        } else if (thread && !thread->objectName().isEmpty()) {
+            buffer->threadName = thread->objectName();
+        }
+
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        buffer->threadId = static_cast<int>(reg.buffers.size()) + 1;
+        if (buffer->threadName.isEmpty()) {
+            buffer->threadName = QString("Thread %1").arg(buffer->threadId);
+        }
+        reg.buffers.push_back(buffer);
+    }
+    return *buffer;
+}
+
+void appendSpan(char phase, const char* name, const char* category, qint64 start, qint64 end,
+                const QString& detail)
+{
+    TraceEvent event;
+    event.name = name;
+    event.category = category;
+    event.phase = phase;
+    event.timestamp = start;
+    event.duration = end - start;
+    event.detail = detail;
+    threadBuffer().append(std::move(event));
+}
+
+const QElapsedTimer& traceClock()
+{
+    static const QElapsedTimer clock = [] {
+        QElapsedTimer timer;
+        timer.start();
+        return timer;
+    }();
+    return clock;
+}
+
+}
+
+void PerformanceTrace::setEnabled(bool enabled)
+{
+    // Start the clock before the first event so timestamps begin near zero
+    traceClock();
+    s_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+qint64 PerformanceTrace::now()
+{
+    return traceClock().nsecsElapsed();
+}
+
+void PerformanceTrace::complete(const char* name, const char* category, qint64 start,
+                                const QString& detail)
+{
+    appendSpan('X', name, category, start, now(), detail);
+}
+
+void PerformanceTrace::asyncSpan(const char* name, const char* category, qint64 start,
+                                 const QString& detail)
+{
+    appendSpan('A', name, category, start, now(), detail);
+}
+
+void PerformanceTrace::counter(const char* name, double value)
+{
+    TraceEvent event;
+    event.name = name;
+    event.category = "counter";
+    event.phase = 'C';
+    event.timestamp = now();
+    event.value = value;
+    threadBuffer().append(std::move(event));
+}
+
+void PerformanceTrace::clear()
+{
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (const auto& buffer : reg.buffers) {
+        std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+        buffer->written = 0;
+    }
+}
+
+QByteArray PerformanceTrace::toChromeTraceJson()
+{
+    const qint64 pid = QCoreApplication::applicationPid();
+    QJsonArray traceEvents;
+
+    QJsonObject processName;
+    processName["name"] = "process_name";
+    processName["ph"] = "M";
+    processName["pid"] = pid;
+    processName["args"] = QJsonObject{{"name", QCoreApplication::applicationName()}};
+    traceEvents.append(processName);
+
+    int asyncId = 0;
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (const auto& buffer : reg.buffers) {
+        std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+
+        QJsonObject threadName;
+        threadName["name"] = "thread_name";
+        threadName["ph"] = "M";
+        threadName["pid"] = pid;
+        threadName["tid"] = buffer->threadId;
+        threadName["args"] = QJsonObject{{"name", buffer->threadName}};
+        traceEvents.append(threadName);
+
+        // Oldest first; once the ring has wrapped the oldest sits at the write position
+        const quint64 capacity = buffer->events.size();
+        const quint64 count = std::min(buffer->written, capacity);
+        const quint64 first = buffer->written - count;
+        for (quint64 i = first; i < buffer->written; ++i) {
+            const TraceEvent& event = buffer->events[i % capacity];
+
+            // Chrome trace timestamps are in microseconds
+            QJsonObject json;
+            json["name"] = QString::fromUtf8(event.name);
+            json["cat"] = QString::fromUtf8(event.category);
+            json["ts"] = event.timestamp / 1000.0;
+            json["pid"] = pid;
+            json["tid"] = buffer->threadId;
+            if (event.phase == 'C') {
+                json["ph"] = "C";
+                json["args"] = QJsonObject{{"value", event.value}};
+                traceEvents.append(json);
+                continue;
+            }
+            if (!event.detail.isEmpty()) {
+                json["args"] = QJsonObject{{"detail", event.detail}};
+            }
+            if (event.phase == 'X') {
+                json["ph"] = "X";
+                json["dur"] = event.duration / 1000.0;
+                traceEvents.append(json);
+            } else {
+                // Async spans export as a begin/end pair joined by an id
+                json["ph"] = "b";
+                json["id"] = ++asyncId;
+                traceEvents.append(json);
+                json["ph"] = "e";
+                json["ts"] = (event.timestamp + event.duration) / 1000.0;
+                json.remove("args");
+                traceEvents.append(json);
+            }
+        }
+    }
+
+    QJsonObject trace;
+    trace["traceEvents"] = traceEvents;
+    trace["displayTimeUnit"] = "ms";
+    return QJsonDocument(trace).toJson(QJsonDocument::Compact);
+}
+
+bool PerformanceTrace::writeChromeTrace(const QString& filePath)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "PerformanceTrace: cannot write" << filePath << file.errorString();
+        return false;
+    }
+    file.write(toChromeTraceJson());
+    return true;
+}
@@ -0,0 +1,91 @@
+#pragma once
+#include <QByteArray>
+#include <QString>
+#include <atomic>
+
+/**
+ * PerformanceTrace records spans and counters from the editor's hot paths and
+ * writes them as Chrome trace-event JSON, which Perfetto (ui.perfetto.dev) and
+ * chrome://tracing open directly.
+ *
+ * Tracing is off until setEnabled(true); while off a trace point costs one
+ * relaxed atomic load. Each thread records into its own ring buffer of
+ * Config::TRACE_BUFFER_EVENTS events, so recording never waits on another
+ * thread and a long session keeps the most recent events. Building with
+ * DEFINES += CUBIT_NO_TRACING compiles the trace points out entirely.
+ *
+ * Names and categories are not copied and must be string literals.
+ */
+class PerformanceTrace {
+public:
+    static bool isEnabled()
+    {
+#ifdef CUBIT_NO_TRACING
+        return false;
+#else
+        return s_enabled.load(std::memory_order_relaxed);
+#endif
+    }
+    static void setEnabled(bool enabled);
+
+    // Nanoseconds on the trace clock
+    static qint64 now();
+
+    // A span that started at start and ended now; detail is shown in the
+    // event's arguments
+    static void complete(const char* name, const char* category, qint64 start,
+                         const QString& detail = QString());
+    // Same for spans that may overlap others on this thread, such as network
+    // requests; they are shown on a track of their own
+    static void asyncSpan(const char* name, const char* category, qint64 start,
+                          const QString& detail = QString());
+    static void counter(const char* name, double value);
+
+    // Forget everything recorded so far
+    static void clear();
+
+    static QByteArray toChromeTraceJson();
+    // False when the file cannot be written
+    static bool writeChromeTrace(const QString& filePath);
+
+    // Records a span from construction to destruction, if tracing is on at both ends
+    class Scope {
+    public:
+        Scope(const char* name, const char* category)
+            : m_name(name)
+            , m_category(category)
+            , m_start(isEnabled() ? now() : -1)
+        {
+        }
+        ~Scope()
+        {
+            if (m_start >= 0 && isEnabled()) {
+                complete(m_name, m_category, m_start);
+            }
+        }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        const char* m_name;
+        const char* m_category;
+        qint64 m_start;
+    };
+
+private:
+    static std::atomic<bool> s_enabled;
+};
+
+#ifdef CUBIT_NO_TRACING
+#define TRACE_SCOPE(name, category) do { } while (false)
+#define TRACE_COUNTER(name, value) do { } while (false)
+#else
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+// Trace the rest of the enclosing block
+#define TRACE_SCOPE(name, category) \
+    PerformanceTrace::Scope TRACE_CONCAT(traceScope_, __LINE__)(name, category)
+// value is only evaluated while tracing is on, so it may be expensive to compute
+#define TRACE_COUNTER(name, value) \
+    do { if (PerformanceTrace::isEnabled()) PerformanceTrace::counter(name, value); } while (false)
+#endif
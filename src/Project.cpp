@@ -86,6 +86,14 @@ Scripts* Project::scripts() const {
     return m_scripts.get();
 }
 
+ScriptRuntime* Project::scriptRuntime() const {
+    return m_scriptRuntime.get();
+}
+
+ProjectSyncQueue* Project::syncQueue() const {
+    return m_syncQueue.get();
+}
+
 PrototypeController* Project::prototypeController() const {
     return m_prototypeController.get();
 }
@@ -344,6 +352,7 @@ void Project::initialize() {
     m_selectionManager = std::make_unique<SelectionManager>(this);
     m_scripts = std::make_unique<Scripts>(this);
     m_scriptExecutor = std::make_unique<ScriptExecutor>(this);
+    m_syncQueue = std::make_unique<ProjectSyncQueue>(this);
     m_bindingManager = std::make_unique<VariableBindingManager>(this);
     
     // Create the controller with its required dependencies
@@ -383,6 +392,9 @@ void Project::initialize() {
     m_scriptExecutor->setElementModel(m_elementModel.get());
     m_scriptExecutor->setCanvasController(m_controller.get());
     
+    // Events run on the runtime's worker thread, falling back to the executor above
+    m_scriptRuntime = std::make_unique<ScriptRuntime>(m_scriptExecutor.get(), m_elementModel.get(), this);
+    
     // Connect to element model changes to track when nodes/edges are added in script mode
     // The ScriptCanvasContext handles the script synchronization, but we still need to
     // ensure proper ownership when elements are created by the controller
@@ -549,14 +561,13 @@ void Project::createContextForViewMode(const QString& mode) {
 
 
 void Project::executeScriptEvent(const QString& eventName) {
-    if (!m_scriptExecutor) {
-        qWarning() << "Project: ScriptExecutor not initialized";
+    if (!m_scriptRuntime) {
+        qWarning() << "Project: ScriptRuntime not initialized";
         return;
     }
     
     // Execute event on canvas scripts
-    m_scriptExecutor->setScripts(m_scripts.get());
-    m_scriptExecutor->executeEvent(eventName);
+    m_scriptRuntime->executeEvent(m_scripts.get(), eventName);
 }
 
 void Project::handleAICommand(const QString& prompt) {
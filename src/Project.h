@@ -11,6 +11,8 @@
 #include "Scripts.h"
 #include "DesignElement.h"
 #include "ScriptExecutor.h"
+#include "ScriptRuntime.h"
+#include "ProjectSyncQueue.h"
 #include "PrototypeController.h"
 #include "PlatformConfig.h"
 
@@ -33,6 +35,8 @@ class Project : public QObject {
     Q_PROPERTY(SelectionManager* selectionManager READ selectionManager CONSTANT)
     Q_PROPERTY(ElementModel* elementModel READ elementModel CONSTANT)
     Q_PROPERTY(Scripts* scripts READ scripts CONSTANT)
+    Q_PROPERTY(ScriptRuntime* scriptRuntime READ scriptRuntime CONSTANT)
+    Q_PROPERTY(ProjectSyncQueue* syncQueue READ syncQueue CONSTANT)
     Q_PROPERTY(PrototypeController* prototypeController READ prototypeController CONSTANT)
     Q_PROPERTY(QString name READ name WRITE setName NOTIFY nameChanged)
     Q_PROPERTY(QString id READ id CONSTANT)
@@ -55,6 +59,8 @@ public:
     SelectionManager* selectionManager() const;
     ElementModel* elementModel() const;
     Scripts* scripts() const;
+    ScriptRuntime* scriptRuntime() const;
+    ProjectSyncQueue* syncQueue() const;
     PrototypeController* prototypeController() const;
     QString name() const;
     QString id() const;
@@ -119,6 +125,8 @@ private:
     std::unique_ptr<ElementModel> m_elementModel;
     std::unique_ptr<Scripts> m_scripts;
     std::unique_ptr<ScriptExecutor> m_scriptExecutor;
+    std::unique_ptr<ScriptRuntime> m_scriptRuntime;   // After m_scriptExecutor, which it uses
+    std::unique_ptr<ProjectSyncQueue> m_syncQueue;
     std::unique_ptr<PrototypeController> m_prototypeController;
     std::unique_ptr<StreamingAIClient> m_aiClient;
     std::unique_ptr<ConsoleMessageRepository> m_console;
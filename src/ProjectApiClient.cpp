@@ -2,7 +2,9 @@
 #include "AuthenticationManager.h"
 #include "Config.h"
 #include "Application.h"
+#include "NetworkTransport.h"
 #include "Project.h"
+#include "PerformanceTrace.h"
 #include <QDebug>
 #include <QJsonDocument>
 #include <QNetworkRequest>
@@ -11,22 +13,11 @@
 ProjectApiClient::ProjectApiClient(AuthenticationManager* authManager, QObject *parent)
     : QObject(parent)
     , m_authManager(authManager)
-    , m_networkManager(new QNetworkAccessManager(this))
 {
 }
 
-ProjectApiClient::~ProjectApiClient()
-{
-    // Cancel any pending requests
-    for (auto it = m_pendingRequests.begin(); it != m_pendingRequests.end(); ++it) {
-        QNetworkReply* reply = it.key();
-        if (reply) {
-            reply->abort();
-            reply->deleteLater();
-        }
-    }
-    m_pendingRequests.clear();
-}
+// Requests still in flight are dropped by NetworkTransport when this object goes away
+ProjectApiClient::~ProjectApiClient() = default;
 
 void ProjectApiClient::createProject(const QString& name, const QJsonObject& canvasData)
 {
@@ -225,17 +216,8 @@ void ProjectApiClient::syncCreateElement(const QString& apiProjectId, const QJso
     }
     
     
-    // Get current project data
-    QJsonObject currentProjectData = m_application->serializeProjectData(project);
-    
-    // Debug: Check if the element is in the serialized data
-    if (currentProjectData.contains("elements")) {
-        QJsonArray elements = currentProjectData["elements"].toArray();
-    } else {
-    }
-    
-    // Update the project via API using the project's ID (which is the API project ID)
-    updateProject(apiProjectId, project->name(), currentProjectData);
+    // Push the current project state
+    pushProjectState(apiProjectId, project);
     
     // Emit success immediately since updateProject handles API communication
     QString elementId = elementData["elementId"].toString();
@@ -261,11 +243,8 @@ void ProjectApiClient::syncUpdateElement(const QString& apiProjectId, const QStr
         return;
     }
     
-    // Get current project data
-    QJsonObject currentProjectData = m_application->serializeProjectData(project);
-    
-    // Update the project via API using the project's ID (which is the API project ID)
-    updateProject(apiProjectId, project->name(), currentProjectData);
+    // Push the current project state
+    pushProjectState(apiProjectId, project);
     
     // Emit success immediately since updateProject handles API communication
     emit elementUpdated(apiProjectId, elementId);
@@ -290,11 +269,8 @@ void ProjectApiClient::syncMoveElements(const QString& apiProjectId, const QJson
         return;
     }
     
-    // Get current project data
-    QJsonObject currentProjectData = m_application->serializeProjectData(project);
-    
-    // Update the project via API using the project's ID (which is the API project ID)
-    updateProject(apiProjectId, project->name(), currentProjectData);
+    // Push the current project state
+    pushProjectState(apiProjectId, project);
     
     // Emit success immediately since updateProject handles API communication
     emit elementsMoved(apiProjectId, elementIds);
@@ -319,14 +295,36 @@ void ProjectApiClient::syncDeleteElements(const QString& apiProjectId, const QJs
         return;
     }
     
+    // Push the current project state
+    pushProjectState(apiProjectId, project);
+    
+    // Emit success immediately since updateProject handles API communication
+    emit elementsDeleted(apiProjectId, elementIds);
+}
+
+void ProjectApiClient::syncProjectState(const QString& apiProjectId)
+{
+    if (!m_authManager || !m_authManager->isAuthenticated()) {
+        emit updateProjectFailed(apiProjectId, "Not authenticated");
+        return;
+    }
+    
+    Project* project = m_application ? m_application->getProject(apiProjectId) : nullptr;
+    if (!project) {
+        emit updateProjectFailed(apiProjectId, "Project not found");
+        return;
+    }
+    
+    pushProjectState(apiProjectId, project);
+}
+
+void ProjectApiClient::pushProjectState(const QString& apiProjectId, Project* project)
+{
     // Get current project data
     QJsonObject currentProjectData = m_application->serializeProjectData(project);
     
     // Update the project via API using the project's ID (which is the API project ID)
     updateProject(apiProjectId, project->name(), currentProjectData);
-    
-    // Emit success immediately since updateProject handles API communication
-    emit elementsDeleted(apiProjectId, elementIds);
 }
 
 void ProjectApiClient::syncAddPlatform(const QString& apiProjectId, const QString& platformName)
@@ -411,96 +409,30 @@ void ProjectApiClient::sendGraphQLRequest(const QString& query, const QJsonObjec
     body["variables"] = variables;
 
     QNetworkRequest request = createAuthenticatedRequest();
-    QNetworkReply* reply = m_networkManager->post(request, QJsonDocument(body).toJson(QJsonDocument::Compact));
 
     // Store request details for handling response
     PendingRequest pendingRequest;
     pendingRequest.operation = operation;
     pendingRequest.projectId = projectId;
     pendingRequest.projectName = projectName;
-    m_pendingRequests[reply] = pendingRequest;
-
-    // Connect to appropriate slot based on operation
-    if (operation == "createProject") {
-        connect(reply, &QNetworkReply::finished, this, &ProjectApiClient::onCreateProjectFinished);
-    } else if (operation == "fetchProjects") {
-        connect(reply, &QNetworkReply::finished, this, &ProjectApiClient::onFetchProjectsFinished);
-    } else if (operation == "listProjects") {
-        connect(reply, &QNetworkReply::finished, this, &ProjectApiClient::onListProjectsFinished);
-    } else if (operation == "getProject") {
-        connect(reply, &QNetworkReply::finished, this, &ProjectApiClient::onGetProjectFinished);
-    } else if (operation == "updateProject") {
-        connect(reply, &QNetworkReply::finished, this, &ProjectApiClient::onUpdateProjectFinished);
-    } else if (operation == "deleteProject") {
-        connect(reply, &QNetworkReply::finished, this, &ProjectApiClient::onDeleteProjectFinished);
-    }
 
-}
-
-void ProjectApiClient::onCreateProjectFinished()
-{
-    QNetworkReply* reply = qobject_cast<QNetworkReply*>(sender());
-    if (!reply || !m_pendingRequests.contains(reply)) {
-        return;
-    }
-
-    PendingRequest request = m_pendingRequests[reply];
-    handleGraphQLResponse(reply, request);
-}
-
-void ProjectApiClient::onFetchProjectsFinished()
-{
-    QNetworkReply* reply = qobject_cast<QNetworkReply*>(sender());
-    if (!reply || !m_pendingRequests.contains(reply)) {
-        return;
-    }
-
-    PendingRequest request = m_pendingRequests[reply];
-    handleGraphQLResponse(reply, request);
-}
-
-void ProjectApiClient::onListProjectsFinished()
-{
-    QNetworkReply* reply = qobject_cast<QNetworkReply*>(sender());
-    if (!reply || !m_pendingRequests.contains(reply)) {
-        return;
-    }
-
-    PendingRequest request = m_pendingRequests[reply];
-    handleGraphQLResponse(reply, request);
-}
-
-void ProjectApiClient::onGetProjectFinished()
-{
-    QNetworkReply* reply = qobject_cast<QNetworkReply*>(sender());
-    if (!reply || !m_pendingRequests.contains(reply)) {
-        return;
-    }
-
-    PendingRequest request = m_pendingRequests[reply];
-    handleGraphQLResponse(reply, request);
-}
-
-void ProjectApiClient::onUpdateProjectFinished()
-{
-    QNetworkReply* reply = qobject_cast<QNetworkReply*>(sender());
-    if (!reply || !m_pendingRequests.contains(reply)) {
-        return;
-    }
-
-    PendingRequest request = m_pendingRequests[reply];
-    handleGraphQLResponse(reply, request);
-}
-
-void ProjectApiClient::onDeleteProjectFinished()
-{
-    QNetworkReply* reply = qobject_cast<QNetworkReply*>(sender());
-    if (!reply || !m_pendingRequests.contains(reply)) {
-        return;
-    }
-
-    PendingRequest request = m_pendingRequests[reply];
-    handleGraphQLResponse(reply, request);
+    // Saves pushed by canvas sync must not hold up requests the user is waiting on
+    const NetworkTransport::Priority priority = operation == "updateProject"
+        ? NetworkTransport::BackgroundPriority
+        : NetworkTransport::NormalPriority;
+
+    // Traced from send to reply, including time spent queued in the transport
+    const qint64 traceStart = PerformanceTrace::isEnabled() ? PerformanceTrace::now() : -1;
+
+    NetworkTransport::instance()->post(request, QJsonDocument(body).toJson(QJsonDocument::Compact), this,
+                                       [this, pendingRequest, traceStart](QNetworkReply* reply) {
+                                           if (traceStart >= 0 && PerformanceTrace::isEnabled()) {
+                                               PerformanceTrace::asyncSpan("ProjectApiClient::request", "network",
+                                                                           traceStart, pendingRequest.operation);
+                                           }
+                                           handleGraphQLResponse(reply, pendingRequest);
+                                       },
+                                       priority);
 }
 
 void ProjectApiClient::handleGraphQLResponse(QNetworkReply* reply, const PendingRequest& request)
@@ -610,52 +542,6 @@ void ProjectApiClient::handleGraphQLResponse(QNetworkReply* reply, const Pending
         
         emitErrorForOperation(request.operation, request.projectId, error);
     }
-
-    cleanupRequest(reply);
-}
-
-void ProjectApiClient::onSyncCreateElementFinished()
-{
-    QNetworkReply* reply = qobject_cast<QNetworkReply*>(sender());
-    if (!reply || !m_pendingRequests.contains(reply)) {
-        return;
-    }
-
-    PendingRequest request = m_pendingRequests[reply];
-    handleGraphQLResponse(reply, request);
-}
-
-void ProjectApiClient::onSyncUpdateElementFinished()
-{
-    QNetworkReply* reply = qobject_cast<QNetworkReply*>(sender());
-    if (!reply || !m_pendingRequests.contains(reply)) {
-        return;
-    }
-
-    PendingRequest request = m_pendingRequests[reply];
-    handleGraphQLResponse(reply, request);
-}
-
-void ProjectApiClient::onSyncMoveElementsFinished()
-{
-    QNetworkReply* reply = qobject_cast<QNetworkReply*>(sender());
-    if (!reply || !m_pendingRequests.contains(reply)) {
-        return;
-    }
-
-    PendingRequest request = m_pendingRequests[reply];
-    handleGraphQLResponse(reply, request);
-}
-
-void ProjectApiClient::onSyncDeleteElementsFinished()
-{
-    QNetworkReply* reply = qobject_cast<QNetworkReply*>(sender());
-    if (!reply || !m_pendingRequests.contains(reply)) {
-        return;
-    }
-
-    PendingRequest request = m_pendingRequests[reply];
-    handleGraphQLResponse(reply, request);
 }
 
 void ProjectApiClient::emitErrorForOperation(const QString& operation, const QString& projectId, const QString& error)
@@ -682,11 +568,3 @@ void ProjectApiClient::emitErrorForOperation(const QString& operation, const QSt
         emit syncDeleteElementsFailed(projectId, error);
     }
 }
-
-void ProjectApiClient::cleanupRequest(QNetworkReply* reply)
-{
-    if (reply) {
-        m_pendingRequests.remove(reply);
-        reply->deleteLater();
-    }
-}
\ No newline at end of file
@@ -2,7 +2,6 @@
 #define PROJECTAPICLIENT_H
 
 #include <QObject>
-#include <QNetworkAccessManager>
 #include <QNetworkReply>
 #include <QJsonObject>
 #include <QJsonArray>
@@ -35,6 +34,10 @@ public:
     void syncUpdateElement(const QString& apiProjectId, const QString& elementId);
     void syncMoveElements(const QString& apiProjectId, const QJsonArray& elementIds);
     void syncDeleteElements(const QString& apiProjectId, const QJsonArray& elementIds);
+
+    // Push the project's current state; ProjectSyncQueue calls this once per
+    // flush and completion is reported through projectUpdated/updateProjectFailed
+    void syncProjectState(const QString& apiProjectId);
     
     // Platform synchronization
     void syncAddPlatform(const QString& apiProjectId, const QString& platformName);
@@ -77,20 +80,6 @@ signals:
     void syncAddPlatformFailed(const QString& apiProjectId, const QString& platformName, const QString& error);
     void syncRemovePlatformFailed(const QString& apiProjectId, const QString& platformName, const QString& error);
 
-private slots:
-    void onCreateProjectFinished();
-    void onFetchProjectsFinished();
-    void onListProjectsFinished();
-    void onGetProjectFinished();
-    void onUpdateProjectFinished();
-    void onDeleteProjectFinished();
-    
-    // Canvas operation sync response handlers
-    void onSyncCreateElementFinished();
-    void onSyncUpdateElementFinished();
-    void onSyncMoveElementsFinished();
-    void onSyncDeleteElementsFinished();
-
 private:
     struct PendingRequest {
         QString operation;
@@ -108,12 +97,10 @@ private:
                            const QString& projectName = QString());
     void handleGraphQLResponse(QNetworkReply* reply, const PendingRequest& request);
     void emitErrorForOperation(const QString& operation, const QString& projectId, const QString& error);
-    void cleanupRequest(QNetworkReply* reply);
+    void pushProjectState(const QString& apiProjectId, Project* project);
 
     AuthenticationManager* m_authManager;
-    QNetworkAccessManager* m_networkManager;
     Application* m_application = nullptr;
-    QHash<QNetworkReply*, PendingRequest> m_pendingRequests;
 };
 
 #endif // PROJECTAPICLIENT_H
\ No newline at end of file
@@ -0,0 +1,193 @@
+#include "ProjectSyncQueue.h"
+#include "Application.h"
+#include "Config.h"
+#include "Project.h"
+#include "ProjectApiClient.h"
+#include <QTimer>
+#include <algorithm>
+#include <utility>
+
+ProjectSyncQueue::ProjectSyncQueue(Project* project)
+    : QObject(project)
+    , m_project(project)
+    , m_flushInterval(Config::SYNC_FLUSH_INTERVAL)
+{
+    m_flushTimer = new QTimer(this);
+    m_flushTimer->setSingleShot(true);
+    connect(m_flushTimer, &QTimer::timeout, this, &ProjectSyncQueue::flush);
+}
+
+ProjectSyncQueue* ProjectSyncQueue::forObject(QObject* object)
+{
+    // Elements live in an ElementModel owned by the project or one of its platforms
+    for (QObject* p = object; p; p = p->parent()) {
+        if (Project* project = qobject_cast<Project*>(p)) {
+            return project->syncQueue();
+        }
+    }
+    return nullptr;
+}
+
+bool ProjectSyncQueue::merge(Change& earlier, Change later)
+{
+    if (earlier == Created) {
+        // Still a creation as far as the server knows, unless it is gone again
+        return later != Deleted;
+    }
+
+    // Deleted and then restored by undo is an update
+    earlier = (earlier == Deleted && later == Created) ? Updated : later;
+    return true;
+}
+
+void ProjectSyncQueue::markDirty(const QString& elementId, Change change)
+{
+    markDirty(QStringList{elementId}, change);
+}
+
+void ProjectSyncQueue::markDirty(const QStringList& elementIds, Change change)
+{
+    for (const QString& elementId : elementIds) {
+        if (elementId.isEmpty()) continue;
+
+        auto it = m_pending.find(elementId);
+        if (it == m_pending.end()) {
+            m_pending.insert(elementId, change);
+            continue;
+        }
+
+        ++m_mergedCount;
+        if (!merge(it.value(), change)) {
+            m_pending.erase(it);
+        }
+    }
+    scheduleFlush();
+}
+
+void ProjectSyncQueue::markProjectDirty()
+{
+    if (m_projectDirty) {
+        ++m_mergedCount;
+    }
+    m_projectDirty = true;
+    scheduleFlush();
+}
+
+void ProjectSyncQueue::beginBatch()
+{
+    ++m_batchDepth;
+    m_flushTimer->stop();
+}
+
+void ProjectSyncQueue::endBatch()
+{
+    if (m_batchDepth == 0 || --m_batchDepth > 0) return;
+    scheduleFlush();
+}
+
+void ProjectSyncQueue::setFlushInterval(int milliseconds)
+{
+    milliseconds = std::max(milliseconds, Config::SYNC_IDLE_DELAY);
+    if (m_flushInterval != milliseconds) {
+        m_flushInterval = milliseconds;
+        emit flushIntervalChanged();
+        scheduleFlush();
+    }
+}
+
+void ProjectSyncQueue::scheduleFlush()
+{
+    if (pendingCount() == 0) {
+        m_flushTimer->stop();
+        m_firstPending.invalidate();
+        emit queueChanged();
+        return;
+    }
+
+    if (!m_firstPending.isValid()) {
+        m_firstPending.start();
+    }
+
+    // endBatch() and the in-flight request's completion schedule again
+    if (m_batchDepth == 0 && !m_inFlight) {
+        // Wait for an idle moment, but not past the flush interval
+        const qint64 remaining = m_flushInterval - m_firstPending.elapsed();
+        m_flushTimer->start(static_cast<int>(std::clamp<qint64>(remaining, 0, Config::SYNC_IDLE_DELAY)));
+    }
+
+    emit queueChanged();
+}
+
+void ProjectSyncQueue::flush()
+{
+    m_flushTimer->stop();
+    if (m_inFlight || pendingCount() == 0) {
+        return;
+    }
+
+    Application* app = Application::instance();
+    ProjectApiClient* apiClient = app ? app->projectApiClient() : nullptr;
+    if (!apiClient) {
+        return;
+    }
+    connectApiClient();
+
+    m_sent = std::exchange(m_pending, {});
+    m_sentProjectDirty = std::exchange(m_projectDirty, false);
+    m_firstPending.invalidate();
+    m_inFlight = true;
+    ++m_flushCount;
+    emit queueChanged();
+
+    // The request carries the full project state, so it covers every pending change
+    apiClient->syncProjectState(m_project->id());
+}
+
+void ProjectSyncQueue::connectApiClient()
+{
+    if (m_updatedConnection) return;
+
+    ProjectApiClient* apiClient = Application::instance()->projectApiClient();
+    m_updatedConnection = connect(apiClient, &ProjectApiClient::projectUpdated, this,
+        [this](const QString& apiProjectId) {
+            onRequestFinished(apiProjectId, true);
+        });
+    m_failedConnection = connect(apiClient, &ProjectApiClient::updateProjectFailed, this,
+        [this](const QString& apiProjectId, const QString&) {
+            onRequestFinished(apiProjectId, false);
+        });
+}
+
+void ProjectSyncQueue::onRequestFinished(const QString& apiProjectId, bool succeeded)
+{
+    if (!m_inFlight || apiProjectId != m_project->id()) {
+        return;
+    }
+    m_inFlight = false;
+
+    const QHash<QString, Change> sent = std::exchange(m_sent, {});
+    if (succeeded) {
+        m_sentProjectDirty = false;
+        scheduleFlush();
+        return;
+    }
+
+    // Put the changes back in front of anything marked since; they go out
+    // with the next edit or an explicit flush() rather than retrying in a loop
+    QHash<QString, Change> pending = std::exchange(m_pending, sent);
+    for (auto it = pending.cbegin(); it != pending.cend(); ++it) {
+        auto existing = m_pending.find(it.key());
+        if (existing == m_pending.end()) {
+            m_pending.insert(it.key(), it.value());
+        } else if (!merge(existing.value(), it.value())) {
+            m_pending.erase(existing);
+        }
+    }
+    if (std::exchange(m_sentProjectDirty, false)) {
+        m_projectDirty = true;
+    }
+    if (pendingCount() > 0 && !m_firstPending.isValid()) {
+        m_firstPending.start();
+    }
+    emit queueChanged();
+}
@@ -0,0 +1,92 @@
+#pragma once
+#include <QObject>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMetaObject>
+#include <QString>
+#include <QStringList>
+
+class Project;
+class QTimer;
+
+/**
+ * ProjectSyncQueue collects a project's edits and pushes them to the API in
+ * as few requests as possible. Commands only mark what changed; the queue
+ * flushes once editing goes idle for Config::SYNC_IDLE_DELAY, or at the
+ * latest flushInterval after the first unsynced edit, so a long drag or an
+ * AI batch still syncs periodically.
+ *
+ * Consecutive changes to one element are merged (an element created and then
+ * deleted before a flush needs no sync at all), and while an update request
+ * is in flight nothing else is sent; edits made meanwhile go out in a single
+ * request once it completes. Each flush pushes the whole project state, so
+ * a flush always carries every edit made up to that point.
+ */
+class ProjectSyncQueue : public QObject {
+    Q_OBJECT
+    Q_PROPERTY(int pendingCount READ pendingCount NOTIFY queueChanged)
+    Q_PROPERTY(bool inFlight READ inFlight NOTIFY queueChanged)
+    Q_PROPERTY(int flushCount READ flushCount NOTIFY queueChanged)
+    Q_PROPERTY(int mergedCount READ mergedCount NOTIFY queueChanged)
+    Q_PROPERTY(int flushInterval READ flushInterval WRITE setFlushInterval NOTIFY flushIntervalChanged)
+
+public:
+    enum Change {
+        Created,
+        Updated,
+        Deleted
+    };
+    Q_ENUM(Change)
+
+    explicit ProjectSyncQueue(Project* project);
+
+    // The queue of the project an element, model or platform belongs to
+    static ProjectSyncQueue* forObject(QObject* object);
+
+    void markDirty(const QString& elementId, Change change = Updated);
+    void markDirty(const QStringList& elementIds, Change change = Updated);
+
+    // A change that is not tied to an element (platforms, compiled scripts)
+    void markProjectDirty();
+
+    // Hold flushes until the matching endBatch(); batches nest
+    void beginBatch();
+    void endBatch();
+
+    // Send pending changes now; with a request in flight they follow once it completes
+    Q_INVOKABLE void flush();
+
+    int pendingCount() const { return m_pending.size() + (m_projectDirty ? 1 : 0); }
+    bool inFlight() const { return m_inFlight; }
+    int flushCount() const { return m_flushCount; }
+    int mergedCount() const { return m_mergedCount; }
+    int flushInterval() const { return m_flushInterval; }
+    void setFlushInterval(int milliseconds);
+
+signals:
+    void queueChanged();
+    void flushIntervalChanged();
+
+private:
+    // Fold a later change into an earlier one; false when the two cancel out
+    static bool merge(Change& earlier, Change later);
+
+    void scheduleFlush();
+    void connectApiClient();
+    void onRequestFinished(const QString& apiProjectId, bool succeeded);
+
+    Project* m_project;
+    QHash<QString, Change> m_pending;
+    QHash<QString, Change> m_sent;     // Changes carried by the request in flight
+    bool m_projectDirty = false;
+    bool m_sentProjectDirty = false;
+    bool m_inFlight = false;
+    int m_batchDepth = 0;
+    int m_flushInterval;
+    int m_flushCount = 0;
+    int m_mergedCount = 0;
+    QElapsedTimer m_firstPending;      // Started by the oldest unsynced edit
+    QTimer* m_flushTimer;
+    QMetaObject::Connection m_updatedConnection;
+    QMetaObject::Connection m_failedConnection;
+};
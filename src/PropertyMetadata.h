@@ -4,6 +4,7 @@
 #include <QString>
 #include <QVariant>
 #include <QObject>
+#include "MemoryUsage.h"
 
 class PropertyMetadata : public QObject
 {
@@ -64,6 +65,17 @@ public:
     void setReadOnly(bool readOnly) { m_readOnly = readOnly; }
     void setAcceptsVariableTypes(const QStringList& types) { m_acceptsVariableTypes = types; }
     
+    MemoryUsage memoryUsage() const {
+        MemoryUsage usage;
+        usage.objects = 1;
+        usage.bytes = sizeof(PropertyMetadata) + MemoryEstimate::QOBJECT_OVERHEAD
+                      + MemoryEstimate::of(m_name) + MemoryEstimate::of(m_displayName)
+                      + MemoryEstimate::of(m_category) + MemoryEstimate::of(m_defaultValue)
+                      + MemoryEstimate::of(m_minValue) + MemoryEstimate::of(m_maxValue)
+                      + MemoryEstimate::of(m_enumValues) + MemoryEstimate::of(m_acceptsVariableTypes);
+        return usage;
+    }
+    
 private:
     QString m_name;
     QString m_displayName;
@@ -115,4 +115,22 @@ PropertyMetadata* PropertyRegistry::getMetadata(const QString& name) const
         return nullptr;
     }
     return it->second.metadata.get();
-}
\ No newline at end of file
+}
+
+MemoryUsage PropertyRegistry::memoryUsage() const
+{
+    MemoryUsage usage;
+    usage.objects = 1;
+    usage.bytes = sizeof(PropertyRegistry) + MemoryEstimate::QOBJECT_OVERHEAD
+                  + m_properties.bucket_count() * sizeof(void*);
+    for (const auto& pair : m_properties) {
+        usage.bytes += sizeof(pair) + MemoryEstimate::HASH_NODE_OVERHEAD
+                       + MemoryEstimate::of(pair.first)
+                       + MemoryEstimate::of(pair.second.value)
+                       + MemoryEstimate::of(pair.second.defaultValue);
+        if (pair.second.metadata) {
+            usage += pair.second.metadata->memoryUsage();
+        }
+    }
+    return usage;
+}
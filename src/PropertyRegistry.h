@@ -7,6 +7,7 @@
 #include <memory>
 #include <unordered_map>
 #include "PropertyMetadata.h"
+#include "MemoryUsage.h"
 
 class PropertyRegistry : public QObject
 {
@@ -45,6 +46,9 @@ public:
     
     // Batch update properties
     void setProperties(const QVariantMap& properties);
+    
+    // Estimated footprint of the registry, its values and its metadata objects
+    MemoryUsage memoryUsage() const;
 
 signals:
     void propertyChanged(const QString& name, const QVariant& oldValue, const QVariant& newValue);
@@ -26,6 +26,10 @@ PrototypeController::PrototypeController(ElementModel& model,
             this, &PrototypeController::onSelectionChanged);
 }
 
+PrototypeController::~PrototypeController() {
+    CanvasElement::removeChangeObserver(this);
+}
+
 void PrototypeController::setIsPrototyping(bool value) {
     if (m_isPrototyping != value) {
         m_isPrototyping = value;
@@ -107,44 +111,70 @@ qreal PrototypeController::getSnapshotCanvasZoom() const {
 
 QRectF PrototypeController::getSnapshotElementPosition(const QString& elementId) const {
     if (m_prototypingStartSnapshot) {
-        return m_prototypingStartSnapshot->elementPositions.value(elementId, QRectF());
+        auto it = m_prototypingStartSnapshot->journal.constFind(elementId);
+        if (it != m_prototypingStartSnapshot->journal.constEnd()) {
+            return it->rect;
+        }
+        
+        // Elements missing from the journal have not changed since prototyping started
+        CanvasElement* canvasElement = qobject_cast<CanvasElement*>(m_elementModel.getElementById(elementId));
+        if (canvasElement) {
+            return canvasElement->rect();
+        }
     }
     return QRectF();
 }
 
+MemoryUsage PrototypeController::snapshotMemoryUsage() const {
+    MemoryUsage usage;
+    if (!m_prototypingStartSnapshot) {
+        return usage;
+    }
+    
+    const auto& journal = m_prototypingStartSnapshot->journal;
+    usage.objects = journal.size();
+    usage.bytes = sizeof(PrototypeSnapshot) + journal.capacity() * qint64(sizeof(void*));
+    for (auto it = journal.constBegin(); it != journal.constEnd(); ++it) {
+        // The QPointer shares a small guard block with the element
+        usage.bytes += MemoryEstimate::HASH_NODE_OVERHEAD + qint64(sizeof(QString) + sizeof(PrototypeJournalEntry))
+                       + MemoryEstimate::of(it.key()) + MemoryEstimate::of(it->value);
+    }
+    return usage;
+}
+
 void PrototypeController::restoreElementPositionsFromSnapshot() {
     if (!m_prototypingStartSnapshot) {
         return;
     }
     
-    // Restore all element positions without animation
-    for (auto it = m_prototypingStartSnapshot->elementPositions.constBegin(); 
-         it != m_prototypingStartSnapshot->elementPositions.constEnd(); ++it) {
-        const QString& elementId = it.key();
-        const QRectF& rect = it.value();
-        
-        Element* element = m_elementModel.getElementById(elementId);
-        CanvasElement* canvasElement = qobject_cast<CanvasElement*>(element);
-        if (canvasElement) {
-                canvasElement->setX(rect.x());
-                canvasElement->setY(rect.y());
-                canvasElement->setWidth(rect.width());
-                canvasElement->setHeight(rect.height());
+    // Restoring must not be journaled as new changes
+    m_restoringSnapshot = true;
+    
+    // Commit the restored geometry to the spatial index in one batch, which
+    // reindexes just the journaled elements when the batch ends
+    HitTestService* hitTestService = m_canvasController ? m_canvasController->hitTestService() : nullptr;
+    if (hitTestService) {
+        hitTestService->beginBatch();
+    }
+    
+    // Restore geometry first, then constraints and values
+    for (auto it = m_prototypingStartSnapshot->journal.constBegin();
+         it != m_prototypingStartSnapshot->journal.constEnd(); ++it) {
+        if (it->element) {
+            it->element->setRect(it->rect);
         }
     }
     
-    // Restore all constraint values
-    for (auto it = m_prototypingStartSnapshot->elementConstraints.constBegin();
-         it != m_prototypingStartSnapshot->elementConstraints.constEnd(); ++it) {
-        const QString& elementId = it.key();
-        const ConstraintValues& constraints = it.value();
+    // Then constraint values and WebTextInput values
+    for (auto it = m_prototypingStartSnapshot->journal.constBegin();
+         it != m_prototypingStartSnapshot->journal.constEnd(); ++it) {
+        const PrototypeJournalEntry& entry = it.value();
+        if (!entry.element) continue;
         
-        Element* element = m_elementModel.getElementById(elementId);
-        CanvasElement* canvasElement = qobject_cast<CanvasElement*>(element);
-        if (canvasElement && canvasElement->isDesignElement()) {
-            DesignElement* designElement = qobject_cast<DesignElement*>(canvasElement);
+        if (entry.hasConstraints) {
+            DesignElement* designElement = qobject_cast<DesignElement*>(entry.element.data());
             if (designElement) {
-                // Restore constraint values
+                const ConstraintValues& constraints = entry.constraints;
                 designElement->setLeft(constraints.left);
                 designElement->setRight(constraints.right);
                 designElement->setTop(constraints.top);
@@ -158,65 +188,74 @@ void PrototypeController::restoreElementPositionsFromSnapshot() {
                 designElement->updateFromParentGeometry();
             }
         }
-    }
-    
-    // Restore all WebTextInput values
-    for (auto it = m_prototypingStartSnapshot->webTextInputValues.constBegin();
-         it != m_prototypingStartSnapshot->webTextInputValues.constEnd(); ++it) {
-        const QString& elementId = it.key();
-        const QString& originalValue = it.value();
         
-        Element* element = m_elementModel.getElementById(elementId);
-        if (element && element->getType() == Element::WebTextInputType) {
-            WebTextInput* webInput = qobject_cast<WebTextInput*>(element);
+        if (entry.hasValue) {
+            WebTextInput* webInput = qobject_cast<WebTextInput*>(entry.element.data());
             if (webInput) {
-                webInput->setValue(originalValue);
+                webInput->setValue(entry.value);
             }
         }
     }
+    
+    if (hitTestService) {
+        hitTestService->endBatch();
+    }
+    
+    m_restoringSnapshot = false;
+}
+
+void PrototypeController::elementAboutToChange(CanvasElement* element) {
+    if (!m_prototypingStartSnapshot || m_restoringSnapshot || !element) {
+        return;
+    }
+    
+    // Only journal elements in this project's model. Instances of global
+    // elements are in the model but keep the platform's model as QObject parent
+    if (!m_elementModel.treeInterval(element).isValid()) {
+        return;
+    }
+    
+    const QString elementId = element->getId();
+    if (m_prototypingStartSnapshot->journal.contains(elementId)) {
+        return; // First write wins - we already hold the original state
+    }
+    
+    PrototypeJournalEntry entry;
+    entry.element = element;
+    entry.rect = element->rect();
+    
+    if (element->isDesignElement()) {
+        DesignElement* designElement = qobject_cast<DesignElement*>(element);
+        if (designElement) {
+            entry.hasConstraints = true;
+            entry.constraints.left = designElement->left();
+            entry.constraints.right = designElement->right();
+            entry.constraints.top = designElement->top();
+            entry.constraints.bottom = designElement->bottom();
+            entry.constraints.leftAnchored = designElement->leftAnchored();
+            entry.constraints.rightAnchored = designElement->rightAnchored();
+            entry.constraints.topAnchored = designElement->topAnchored();
+            entry.constraints.bottomAnchored = designElement->bottomAnchored();
+        }
+    }
+    
+    if (element->getType() == Element::WebTextInputType) {
+        WebTextInput* webInput = qobject_cast<WebTextInput*>(element);
+        if (webInput) {
+            entry.hasValue = true;
+            entry.value = webInput->value();
+        }
+    }
+    
+    m_prototypingStartSnapshot->journal.insert(elementId, entry);
 }
 
 void PrototypeController::startPrototyping(const QPointF& canvasCenter, qreal currentZoom) {
-    // Create a new snapshot
+    // Create a new snapshot. Element state is journaled lazily as elements change.
     m_prototypingStartSnapshot = std::make_unique<PrototypeSnapshot>();
     m_prototypingStartSnapshot->canvasPosition = canvasCenter;
     m_prototypingStartSnapshot->canvasZoom = currentZoom;
-    
-    // Capture all element positions and constraints
-    const auto elements = m_elementModel.getAllElements();
-    for (Element* element : elements) {
-        CanvasElement* canvasElement = qobject_cast<CanvasElement*>(element);
-        if (canvasElement) {
-            QRectF rect(canvasElement->x(), canvasElement->y(), 
-                       canvasElement->width(), canvasElement->height());
-            m_prototypingStartSnapshot->elementPositions[element->getId()] = rect;
-            
-            // If it's a design element, also capture constraint values
-            if (canvasElement->isDesignElement()) {
-                DesignElement* designElement = qobject_cast<DesignElement*>(canvasElement);
-                if (designElement) {
-                    ConstraintValues constraints;
-                    constraints.left = designElement->left();
-                    constraints.right = designElement->right();
-                    constraints.top = designElement->top();
-                    constraints.bottom = designElement->bottom();
-                    constraints.leftAnchored = designElement->leftAnchored();
-                    constraints.rightAnchored = designElement->rightAnchored();
-                    constraints.topAnchored = designElement->topAnchored();
-                    constraints.bottomAnchored = designElement->bottomAnchored();
-                    m_prototypingStartSnapshot->elementConstraints[element->getId()] = constraints;
-                }
-            }
-            
-            // If it's a WebTextInput, also capture its value
-            if (element->getType() == Element::WebTextInputType) {
-                WebTextInput* webInput = qobject_cast<WebTextInput*>(element);
-                if (webInput) {
-                    m_prototypingStartSnapshot->webTextInputValues[element->getId()] = webInput->value();
-                }
-            }
-        }
-    }
+    CanvasElement::addChangeObserver(this);
     
     // Set isPrototyping to true
     m_isInitializingPrototype = true;
@@ -238,7 +277,8 @@ void PrototypeController::startPrototyping(const QPointF& canvasCenter, qreal cu
 }
 
 void PrototypeController::stopPrototyping() {
-    // Clear the snapshot
+    // Stop journaling and drop the snapshot
+    CanvasElement::removeChangeObserver(this);
     m_prototypingStartSnapshot.reset();
     
     // Clear the active outer frame
@@ -272,14 +312,6 @@ void PrototypeController::stopPrototyping() {
     
     // Set isPrototyping to false
     setIsPrototyping(false);
-    
-    // Rebuild spatial index since elements may have moved during prototyping
-    if (m_canvasController) {
-        HitTestService* hitTestService = m_canvasController->hitTestService();
-        if (hitTestService) {
-            hitTestService->rebuildSpatialIndex();
-        }
-    }
 }
 
 QRectF PrototypeController::calculateViewportForMode(const QString& mode) const {
@@ -591,7 +623,7 @@ void PrototypeController::resetFrameScrollPosition(const QString& frameId) {
     CanvasElement* canvasElement = qobject_cast<CanvasElement*>(element);
     if (canvasElement) {
             // Get the original position from snapshot
-            QRectF snapshotRect = m_prototypingStartSnapshot->elementPositions.value(frameId, QRectF());
+            QRectF snapshotRect = getSnapshotElementPosition(frameId);
             if (snapshotRect.width() > 0 && snapshotRect.height() > 0) {
                 canvasElement->setY(snapshotRect.y());
             }
@@ -3,11 +3,13 @@
 #include <QPointF>
 #include <QRectF>
 #include <QHash>
+#include <QPointer>
 #include <memory>
+#include "CanvasElement.h"
+#include "MemoryUsage.h"
 
 class ElementModel;
 class SelectionManager;
-class CanvasElement;
 class HitTestService;
 class CanvasController;
 
@@ -23,16 +25,26 @@ struct ConstraintValues {
     bool bottomAnchored = false;
 };
 
-// Snapshot structure to capture canvas and element states
+// Original state of an element, recorded the first time it changes while prototyping
+struct PrototypeJournalEntry {
+    QPointer<CanvasElement> element;
+    QRectF rect;
+    bool hasConstraints = false;
+    ConstraintValues constraints;
+    bool hasValue = false;
+    QString value; // WebTextInput value
+};
+
+// Snapshot of the canvas view plus a sparse journal of the elements that changed.
+// Untouched elements are never copied, so entering and leaving prototype mode
+// costs O(changed elements) rather than O(all elements).
 struct PrototypeSnapshot {
     QPointF canvasPosition;
     qreal canvasZoom = 1.0;
-    QHash<QString, QRectF> elementPositions; // elementId -> QRectF(x, y, width, height)
-    QHash<QString, ConstraintValues> elementConstraints; // elementId -> constraint values
-    QHash<QString, QString> webTextInputValues; // elementId -> original value
+    QHash<QString, PrototypeJournalEntry> journal; // elementId -> original state (first write wins)
 };
 
-class PrototypeController : public QObject {
+class PrototypeController : public QObject, public CanvasElementChangeObserver {
     Q_OBJECT
     Q_PROPERTY(bool isPrototyping READ isPrototyping WRITE setIsPrototyping NOTIFY isPrototypingChanged)
     Q_PROPERTY(QRectF viewableArea READ viewableArea WRITE setViewableArea NOTIFY viewableAreaChanged)
@@ -55,7 +67,7 @@ public:
     explicit PrototypeController(ElementModel& model,
                                 SelectionManager& sel,
                                 QObject *parent = nullptr);
-    ~PrototypeController() = default;
+    ~PrototypeController();
     
     // Set the canvas controller (must be called after construction)
     void setCanvasController(CanvasController* controller) { m_canvasController = controller; }
@@ -77,6 +89,8 @@ public:
     Q_INVOKABLE qreal getSnapshotCanvasZoom() const;
     Q_INVOKABLE QRectF getSnapshotElementPosition(const QString& elementId) const;
     Q_INVOKABLE void restoreElementPositionsFromSnapshot();
+    // Estimated footprint of the snapshot; objects counts journal entries
+    MemoryUsage snapshotMemoryUsage() const;
     
     // Helper methods
     Q_INVOKABLE void startPrototyping(const QPointF& canvasCenter, qreal currentZoom);
@@ -130,6 +144,9 @@ public:
     // Method to reset scroll position for a specific frame
     Q_INVOKABLE void resetFrameScrollPosition(const QString& frameId);
     
+    // CanvasElementChangeObserver
+    void elementAboutToChange(CanvasElement* element) override;
+    
 private:
     void setDeviceFrames(bool isModeChange = false, qreal oldViewableHeight = 0.0);
     void updateChildLayouts(CanvasElement* parent);
@@ -161,6 +178,7 @@ private:
     QRectF m_viewableArea;
     QString m_prototypeMode = "web";
     std::unique_ptr<PrototypeSnapshot> m_prototypingStartSnapshot;
+    bool m_restoringSnapshot = false;
     
     // Animated bounds tracking
     qreal m_animatedBoundingX = 0;
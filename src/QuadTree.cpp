@@ -1,6 +1,10 @@
 #include "QuadTree.h"
 #include "Element.h"
 #include "CanvasElement.h"
+#include "Config.h"
+#include "ParallelFor.h"
+#include <algorithm>
+#include <array>
 
 QuadTree::QuadTree(const QRectF& bounds, int nodeCapacity)
     : m_nodeCapacity(nodeCapacity)
@@ -31,23 +35,47 @@ bool QuadTree::remove(Element* element)
 std::vector<Element*> QuadTree::query(const QPointF& point) const
 {
     std::vector<Element*> result;
-    if (m_root) {
-        result.reserve(16);  // Pre-allocate for better performance
-        queryNode(m_root.get(), point, result);
-    }
+    result.reserve(16);  // Pre-allocate for better performance
+    query(point, result);
     return result;
 }
 
 std::vector<Element*> QuadTree::query(const QRectF& rect) const
 {
     std::vector<Element*> result;
-    if (m_root) {
-        result.reserve(32);  // Pre-allocate for better performance
-        queryNode(m_root.get(), rect, result);
-    }
+    result.reserve(32);  // Pre-allocate for better performance
+    query(rect, result);
     return result;
 }
 
+void QuadTree::query(const QPointF& point, std::vector<Element*>& result) const
+{
+    result.clear();
+    visit(point, [&result](Element* element) {
+        result.push_back(element);
+        return true;
+    });
+}
+
+void QuadTree::query(const QRectF& rect, std::vector<Element*>& result) const
+{
+    result.clear();
+    visit(rect, [&result](Element* element) {
+        result.push_back(element);
+        return true;
+    });
+}
+
+bool QuadTree::visit(const QPointF& point, ElementVisitor visit) const
+{
+    return !m_root || visitNode(m_root.get(), point, visit);
+}
+
+bool QuadTree::visit(const QRectF& rect, ElementVisitor visit) const
+{
+    return !m_root || visitNode(m_root.get(), rect, visit);
+}
+
 void QuadTree::clear()
 {
     if (m_root) {
@@ -56,13 +84,98 @@ void QuadTree::clear()
 }
 
 void QuadTree::rebuild(const std::vector<Element*>& elements)
+{
+    std::vector<Entry> entries;
+    entries.reserve(elements.size());
+    for (Element* element : elements) {
+        if (CanvasElement* canvasElement = qobject_cast<CanvasElement*>(element)) {
+            entries.push_back({canvasElement->cachedBounds(), element});
+        }
+    }
+    build(entries);
+}
+
+void QuadTree::rebuild(const std::vector<CanvasElement*>& elements)
+{
+    std::vector<Entry> entries;
+    entries.reserve(elements.size());
+    for (CanvasElement* canvasElement : elements) {
+        if (canvasElement) {
+            entries.push_back({canvasElement->cachedBounds(), canvasElement});
+        }
+    }
+    build(entries);
+}
+
+void QuadTree::build(std::vector<Entry>& entries)
 {
     QRectF bounds = m_root ? m_root->bounds : QRectF();
-    clear();
     m_root = std::make_unique<Node>(bounds);
     
-    for (Element* element : elements) {
-        insert(element);
+    // Like insert(), drop elements that do not fit in the tree
+    entries.erase(std::remove_if(entries.begin(), entries.end(), [&bounds](const Entry& entry) {
+        return !bounds.contains(entry.bounds);
+    }), entries.end());
+    
+    std::vector<Entry> scratch(entries.size());
+    buildNode(m_root.get(), entries.data(), entries.data() + entries.size(), scratch.data(), 0);
+}
+
+void QuadTree::buildNode(Node* node, Entry* begin, Entry* end, Entry* scratch, int depth)
+{
+    // The same rule insertIntoNode() applies one element at a time: a node
+    // keeps up to m_nodeCapacity elements before it subdivides
+    const size_t count = end - begin;
+    if (depth >= MAX_DEPTH || count <= static_cast<size_t>(m_nodeCapacity)) {
+        node->elements.reserve(count);
+        for (const Entry* entry = begin; entry != end; ++entry) {
+            node->elements.push_back(entry->element);
+        }
+        return;
+    }
+    
+    subdivide(node);
+    
+    // Stable partition into the four quadrants followed by the elements
+    // spanning them, keeping input order so each node lists its elements in
+    // insertion order
+    std::array<size_t, 5> offsets = {};
+    for (const Entry* entry = begin; entry != end; ++entry) {
+        const int quadrant = getQuadrant(node->bounds, entry->bounds);
+        ++offsets[quadrant == -1 ? 4 : quadrant];
+    }
+    size_t start = 0;
+    for (size_t& offset : offsets) {
+        const size_t bucketSize = offset;
+        offset = start;
+        start += bucketSize;
+    }
+    std::array<size_t, 5> ends = offsets;
+    for (const Entry* entry = begin; entry != end; ++entry) {
+        const int quadrant = getQuadrant(node->bounds, entry->bounds);
+        scratch[ends[quadrant == -1 ? 4 : quadrant]++] = *entry;
+    }
+    std::copy(scratch, scratch + count, begin);
+    
+    node->elements.reserve(ends[4] - offsets[4]);
+    for (const Entry* entry = begin + offsets[4]; entry != begin + ends[4]; ++entry) {
+        node->elements.push_back(entry->element);
+    }
+    
+    // Quadrants own disjoint ranges of the entries and scratch space
+    const std::array<Node*, 4> children = {
+        node->northWest.get(), node->northEast.get(), node->southWest.get(), node->southEast.get()
+    };
+    auto buildChildren = [&](int first, int last) {
+        for (int quadrant = first; quadrant < last; ++quadrant) {
+            buildNode(children[quadrant], begin + offsets[quadrant], begin + ends[quadrant],
+                      scratch + offsets[quadrant], depth + 1);
+        }
+    };
+    if (count >= static_cast<size_t>(Config::QUADTREE_PARALLEL_BUILD_MIN)) {
+        parallelForChunks(4, 1, buildChildren);
+    } else {
+        buildChildren(0, 4);
     }
 }
 
@@ -190,50 +303,50 @@ bool QuadTree::removeFromNode(Node* node, Element* element)
     return false;
 }
 
-void QuadTree::queryNode(const Node* node, const QPointF& point, std::vector<Element*>& result) const
+bool QuadTree::visitNode(const Node* node, const QPointF& point, const ElementVisitor& visit) const
 {
     if (!node || !node->bounds.contains(point)) {
-        return;
+        return true;
     }
     
-    // Check elements at this node
+    // Check elements at this node; insert() only stores CanvasElements
     for (Element* element : node->elements) {
-        CanvasElement* canvasElement = qobject_cast<CanvasElement*>(element);
-        if (canvasElement && canvasElement->containsPoint(point)) {
-            result.push_back(element);
+        if (static_cast<CanvasElement*>(element)->containsPoint(point) && !visit(element)) {
+            return false;
         }
     }
     
     // Check child nodes
     if (!node->isLeaf()) {
-        queryNode(node->northWest.get(), point, result);
-        queryNode(node->northEast.get(), point, result);
-        queryNode(node->southWest.get(), point, result);
-        queryNode(node->southEast.get(), point, result);
+        return visitNode(node->northWest.get(), point, visit) &&
+               visitNode(node->northEast.get(), point, visit) &&
+               visitNode(node->southWest.get(), point, visit) &&
+               visitNode(node->southEast.get(), point, visit);
     }
+    return true;
 }
 
-void QuadTree::queryNode(const Node* node, const QRectF& rect, std::vector<Element*>& result) const
+bool QuadTree::visitNode(const Node* node, const QRectF& rect, const ElementVisitor& visit) const
 {
     if (!node || !node->bounds.intersects(rect)) {
-        return;
+        return true;
     }
     
-    // Check elements at this node
+    // Check elements at this node; insert() only stores CanvasElements
     for (Element* element : node->elements) {
-        CanvasElement* canvasElement = qobject_cast<CanvasElement*>(element);
-        if (canvasElement && rect.intersects(canvasElement->cachedBounds())) {
-            result.push_back(element);
+        if (rect.intersects(static_cast<CanvasElement*>(element)->cachedBounds()) && !visit(element)) {
+            return false;
         }
     }
     
     // Check child nodes
     if (!node->isLeaf()) {
-        queryNode(node->northWest.get(), rect, result);
-        queryNode(node->northEast.get(), rect, result);
-        queryNode(node->southWest.get(), rect, result);
-        queryNode(node->southEast.get(), rect, result);
+        return visitNode(node->northWest.get(), rect, visit) &&
+               visitNode(node->northEast.get(), rect, visit) &&
+               visitNode(node->southWest.get(), rect, visit) &&
+               visitNode(node->southEast.get(), rect, visit);
     }
+    return true;
 }
 
 void QuadTree::clearNode(Node* node)
@@ -266,6 +379,7 @@ void QuadTree::getStatsForNode(const Node* node, Stats& stats, int depth) const
     stats.totalNodes++;
     stats.totalElements += static_cast<int>(node->elements.size());
     stats.maxDepth = std::max(stats.maxDepth, depth);
+    stats.bytes += sizeof(Node) + node->elements.capacity() * sizeof(Element*);
     
     if (!node->isLeaf()) {
         getStatsForNode(node->northWest.get(), stats, depth + 1);
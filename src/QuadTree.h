@@ -2,11 +2,32 @@
 #include <QRectF>
 #include <QPointF>
 #include <memory>
+#include <type_traits>
 #include <vector>
 
 class Element;
 class CanvasElement;
 
+// Non-owning reference to a callable taking an Element* and returning false
+// to stop; lets spatial queries hand over results without allocating. Only
+// valid while the callable it was made from is alive.
+class ElementVisitor {
+public:
+    template<typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, ElementVisitor>>>
+    ElementVisitor(F&& callable)
+        : m_callable(const_cast<void*>(static_cast<const void*>(&callable)))
+        , m_invoke([](void* c, Element* element) -> bool {
+              return (*static_cast<std::remove_reference_t<F>*>(c))(element);
+          })
+    {}
+    
+    bool operator()(Element* element) const { return m_invoke(m_callable, element); }
+    
+private:
+    void* m_callable;
+    bool (*m_invoke)(void*, Element*);
+};
+
 class QuadTree {
 public:
     // Constructor with bounds and capacity
@@ -25,17 +46,31 @@ public:
     // Query elements within a rectangle
     std::vector<Element*> query(const QRectF& rect) const;
     
+    // Same queries into a caller-owned buffer; it is cleared first and keeps
+    // its capacity, so a reused buffer stops allocating
+    void query(const QPointF& point, std::vector<Element*>& result) const;
+    void query(const QRectF& rect, std::vector<Element*>& result) const;
+    
+    // Visit the matching elements until visit returns false; returns false
+    // when the walk was stopped early
+    bool visit(const QPointF& point, ElementVisitor visit) const;
+    bool visit(const QRectF& rect, ElementVisitor visit) const;
+    
     // Clear all elements
     void clear();
     
-    // Rebuild the entire tree (useful after many changes)
+    // Rebuild the entire tree (useful after many changes). Bounds are read once
+    // per element and the tree is built top-down, large subtrees in parallel;
+    // the result is the tree inserting the elements in order would give.
     void rebuild(const std::vector<Element*>& elements);
+    void rebuild(const std::vector<CanvasElement*>& elements);
     
     // Get statistics for debugging
     struct Stats {
         int totalNodes = 0;
         int totalElements = 0;
         int maxDepth = 0;
+        qint64 bytes = 0;   // Estimated: the nodes and their element vectors
     };
     Stats getStats() const;
     
@@ -58,13 +93,21 @@ private:
     std::unique_ptr<Node> m_root;
     int m_nodeCapacity;
     
+    // An element and its bounds, gathered once for a bulk build
+    struct Entry {
+        QRectF bounds;
+        Element* element;
+    };
+    
     // Helper methods
     void subdivide(Node* node);
     bool insertIntoNode(Node* node, Element* element, const QRectF& elementBounds, int depth = 0);
     bool removeFromNode(Node* node, Element* element);
-    void queryNode(const Node* node, const QPointF& point, std::vector<Element*>& result) const;
-    void queryNode(const Node* node, const QRectF& rect, std::vector<Element*>& result) const;
+    bool visitNode(const Node* node, const QPointF& point, const ElementVisitor& visit) const;
+    bool visitNode(const Node* node, const QRectF& rect, const ElementVisitor& visit) const;
     void clearNode(Node* node);
+    void build(std::vector<Entry>& entries);
+    void buildNode(Node* node, Entry* begin, Entry* end, Entry* scratch, int depth);
     void getStatsForNode(const Node* node, Stats& stats, int depth) const;
     
     // Get the quadrant for a rectangle within bounds
@@ -5,6 +5,8 @@
 #include "ScriptSerializer.h"
 #include "Scripts.h"
 #include "Node.h"
+#include "PerformanceTrace.h"
+#include <QJsonDocument>
 #include <QDebug>
 
 ScriptCompiler::ScriptCompiler(QObject *parent) 
@@ -22,6 +24,9 @@ ScriptCompiler::~ScriptCompiler() = default;
 
 QString ScriptCompiler::compile(Scripts* scripts, ElementModel* elementModel)
 {
+    TRACE_SCOPE("ScriptCompiler::compile", "scripts");
+    clearCache();
+    
     if (!scripts) {
         m_lastError = "No scripts object provided";
         return QString();
@@ -33,28 +38,104 @@ QString ScriptCompiler::compile(Scripts* scripts, ElementModel* elementModel)
         return QString();
     }
     
-    // Step 2: Find all event nodes and build invokes for each
-    QMap<QString, ScriptInvokeBuilder::BuildContext> eventContexts;
+    return compileEvents(scripts, elementModel, nullptr);
+}
+
+QString ScriptCompiler::compileChanged(Scripts* scripts, const QSet<QString>& changedNodeIds,
+                                       ElementModel* elementModel)
+{
+    // The cache only holds for the graph and model it was built from
+    if (!m_hasCache || scripts != m_cachedScripts || elementModel != m_cachedElementModel) {
+        return compile(scripts, elementModel);
+    }
+    
+    // Step 1: The rest of the graph passed validation last time
+    if (!m_validator->validateChanged(scripts, changedNodeIds)) {
+        m_lastError = m_validator->getLastError();
+        clearCache();
+        return QString();
+    }
+    
+    return compileEvents(scripts, elementModel, &changedNodeIds);
+}
+
+QString ScriptCompiler::compileEvents(Scripts* scripts, ElementModel* elementModel,
+                                      const QSet<QString>* changedNodeIds)
+{
+    // Step 2: Find all event nodes and build invokes for those that changed
+    QJsonObject root;
+    QHash<QString, CachedEvent> eventCache;
     
     QList<Node*> nodes = scripts->getAllNodes();
     for (Node* node : nodes) {
-        if (node && node->nodeType() == "Event") {
-            // Normalize event name
-            QString eventName = node->nodeTitle().toLower().remove(' ');
-            
-            // Build invokes for this event, passing elementModel for ComponentOnEditorLoadEvents handling
-            ScriptInvokeBuilder::BuildContext context = m_invokeBuilder->buildInvokes(node, scripts, elementModel);
-            
-            // Store context for this event
-            eventContexts[eventName] = context;
+        if (!node || node->nodeType() != "Event") {
+            continue;
+        }
+        
+        // Normalize event name
+        QString eventName = node->nodeTitle().toLower().remove(' ');
+        const QString eventNodeId = node->getId();
+        
+        auto cached = m_eventCache.constFind(eventNodeId);
+        if (changedNodeIds && cached != m_eventCache.constEnd() && cached->reusable &&
+            cached->eventName == eventName && !cached->nodeIds.intersects(*changedNodeIds)) {
+            root[eventName] = cached->compiled;
+            eventCache.insert(eventNodeId, cached.value());
+            continue;
+        }
+        
+        // Build invokes for this event, passing elementModel for ComponentOnEditorLoadEvents handling
+        ScriptInvokeBuilder::BuildContext context = m_invokeBuilder->buildInvokes(node, scripts, elementModel);
+        
+        // Step 3: Serialize to JSON
+        CachedEvent event;
+        event.eventName = eventName;
+        event.compiled = m_serializer->serializeEvent(context, scripts);
+        event.nodeIds.insert(eventNodeId);
+        for (auto it = context.nodeReferences.constBegin(); it != context.nodeReferences.constEnd(); ++it) {
+            event.nodeIds.insert(it.key());
+            if (it->scripts != scripts) {
+                event.reusable = false;
+            }
         }
+        
+        // A later event node with the same name replaces the earlier one
+        root[eventName] = event.compiled;
+        eventCache.insert(eventNodeId, event);
     }
     
-    // Step 3: Serialize to JSON
-    QJsonDocument doc = m_serializer->serialize(eventContexts, scripts);
+    m_eventCache = eventCache;
+    m_cachedScripts = scripts;
+    m_cachedElementModel = elementModel;
+    m_hasCache = true;
     
     m_lastError.clear();
-    return doc.toJson(QJsonDocument::Compact);
+    return QJsonDocument(root).toJson(QJsonDocument::Compact);
+}
+
+void ScriptCompiler::clearCache()
+{
+    m_eventCache.clear();
+    m_cachedScripts = nullptr;
+    m_cachedElementModel = nullptr;
+    m_hasCache = false;
+}
+
+MemoryUsage ScriptCompiler::cacheMemoryUsage() const
+{
+    MemoryUsage usage;
+    usage.objects = m_eventCache.size();
+    usage.bytes = m_eventCache.capacity() * qint64(sizeof(void*));
+    for (auto it = m_eventCache.cbegin(); it != m_eventCache.cend(); ++it) {
+        usage.bytes += MemoryEstimate::HASH_NODE_OVERHEAD + qint64(sizeof(QString) + sizeof(CachedEvent))
+                       + MemoryEstimate::of(it.key()) + MemoryEstimate::of(it->eventName)
+                       + MemoryEstimate::of(it->compiled)
+                       + it->nodeIds.capacity() * qint64(sizeof(void*));
+        for (const QString& nodeId : it->nodeIds) {
+            usage.bytes += MemoryEstimate::HASH_NODE_OVERHEAD + qint64(sizeof(QString)) + MemoryEstimate::of(nodeId);
+        }
+    }
+    return usage;
 }
 
 QString ScriptCompiler::getLastError() const
@@ -3,7 +3,11 @@
 
 #include <QObject>
 #include <QString>
+#include <QSet>
+#include <QHash>
+#include <QJsonObject>
 #include <memory>
+#include "MemoryUsage.h"
 
 class Scripts;
 class ScriptGraphValidator;
@@ -22,12 +26,41 @@ public:
     // Main compilation method
     Q_INVOKABLE QString compile(Scripts* scripts, ElementModel* elementModel = nullptr);
     
+    // Recompile after an edit. Only events whose subgraph contains one of
+    // changedNodeIds are rebuilt, the rest reuse their output from the last
+    // compile. Falls back to a full compile when there is nothing to reuse.
+    QString compileChanged(Scripts* scripts, const QSet<QString>& changedNodeIds,
+                           ElementModel* elementModel = nullptr);
+    
+    // Drop the compiled events kept from earlier compiles
+    void clearCache();
+    
+    // Estimated footprint of the compiled events kept; objects counts events
+    MemoryUsage cacheMemoryUsage() const;
+    
     // Get the last compilation error (if any)
     QString getLastError() const;
 
 private:
+    struct CachedEvent {
+        QString eventName;
+        QJsonObject compiled;
+        QSet<QString> nodeIds;   // Every node the event's build looked at
+        bool reusable = true;    // False when it pulled in nodes of another Scripts
+    };
+    
+    // Build the events; with changedNodeIds, cached events they do not touch are reused
+    QString compileEvents(Scripts* scripts, ElementModel* elementModel,
+                          const QSet<QString>* changedNodeIds);
+    
     QString m_lastError;
     
+    // Output of the last successful compile, by event node id
+    QHash<QString, CachedEvent> m_eventCache;
+    Scripts* m_cachedScripts = nullptr;
+    ElementModel* m_cachedElementModel = nullptr;
+    bool m_hasCache = false;
+    
     // Component classes
     std::unique_ptr<ScriptGraphValidator> m_validator;
     std::unique_ptr<ScriptInvokeBuilder> m_invokeBuilder;
@@ -7,11 +7,12 @@
 #include "AIService.h"
 #include "Project.h"
 #include "Variable.h"
+#include "ScriptIntrinsics.h"
+#include "PerformanceTrace.h"
 #include <QJsonDocument>
 #include <QJsonValue>
 #include <QDebug>
 #include <QApplication>
-#include <QJSValueIterator>
 
 // QtConsoleLog implementation
 QtConsoleLog::QtConsoleLog(ScriptExecutor* executor, QObject *parent)
@@ -22,11 +23,8 @@ QtConsoleLog::QtConsoleLog(ScriptExecutor* executor, QObject *parent)
 
 void QtConsoleLog::log(const QString& message)
 {
-    if (m_executor && m_executor->parent()) {
-        Project* project = qobject_cast<Project*>(m_executor->parent());
-        if (project && project->console()) {
-            project->console()->addOutput(message);
-        }
+    if (m_executor) {
+        m_executor->logOutput(message);
     }
 }
 
@@ -36,7 +34,6 @@ ScriptExecutor::ScriptExecutor(QObject *parent)
     , m_elementModel(nullptr)
     , m_canvasController(nullptr)
 {
-    setupJSContext();
 }
 
 ScriptExecutor::~ScriptExecutor() = default;
@@ -56,38 +53,104 @@ void ScriptExecutor::setCanvasController(CanvasController* controller)
     m_canvasController = controller;
 }
 
+void ScriptExecutor::setEffectSink(EffectSink sink)
+{
+    m_effectSink = std::move(sink);
+}
+
+void ScriptExecutor::setTimeSlice(int milliseconds, std::function<void()> onSliceEnd)
+{
+    m_timeSlice = milliseconds;
+    m_sliceEnd = std::move(onSliceEnd);
+}
+
+void ScriptExecutor::interrupt()
+{
+    QMutexLocker locker(&m_engineMutex);
+    m_interrupted = true;
+    
+    // Breaks out of a long running script
+    if (m_jsEngine) {
+        m_jsEngine->setInterrupted(true);
+    }
+}
+
+void ScriptExecutor::clearInterruption()
+{
+    QMutexLocker locker(&m_engineMutex);
+    m_interrupted = false;
+    if (m_jsEngine) {
+        m_jsEngine->setInterrupted(false);
+    }
+}
+
+bool ScriptExecutor::shouldStop()
+{
+    if (m_stopped) {
+        return true;
+    }
+    
+    if (m_timeSlice > 0 && m_sliceTimer.isValid() && m_sliceTimer.elapsed() >= m_timeSlice) {
+        m_sliceTimer.restart();
+        if (m_sliceEnd) {
+            m_sliceEnd();
+        }
+    }
+    
+    if (m_interrupted) {
+        m_stopped = true;
+        logError(QString("Script event '%1' was cancelled").arg(m_currentEventName));
+    }
+    
+    return m_stopped;
+}
+
+QJSEngine* ScriptExecutor::jsEngine()
+{
+    if (!m_jsEngine) {
+        {
+            QMutexLocker locker(&m_engineMutex);
+            m_jsEngine = std::make_unique<QJSEngine>();
+        }
+        setupJSContext();
+    }
+    return m_jsEngine.get();
+}
 
 void ScriptExecutor::setupJSContext()
 {
     // Register the QtConsoleLog helper object first
-    QtConsoleLog* consoleLogger = new QtConsoleLog(this, &m_jsEngine);
-    QJSValue qtConsole = m_jsEngine.newQObject(consoleLogger);
-    m_jsEngine.globalObject().setProperty("_qtConsoleLog", qtConsole);
+    QtConsoleLog* consoleLogger = new QtConsoleLog(this, m_jsEngine.get());
+    QJSValue qtConsole = m_jsEngine->newQObject(consoleLogger);
+    m_jsEngine->globalObject().setProperty("_qtConsoleLog", qtConsole);
     
     // Register the ScriptExecutor for async callbacks
-    QJSValue scriptExecutor = m_jsEngine.newQObject(this);
-    m_jsEngine.globalObject().setProperty("_scriptExecutor", scriptExecutor);
-    
-    // Create and register AIService
-    AIService* aiService = new AIService(&m_jsEngine);
-    QJSValue aiServiceValue = m_jsEngine.newQObject(aiService);
-    m_jsEngine.globalObject().setProperty("aiService", aiServiceValue);
-    
-    // Try to find and register the AuthenticationManager
-    // Look for it in the parent hierarchy (it's a global object)
-    QObject* p = parent();
-    while (p) {
-        // Check if this is the QApplication
-        if (qobject_cast<QApplication*>(p)) {
-            // Find AuthenticationManager among app's children
-            AuthenticationManager* authManager = p->findChild<AuthenticationManager*>();
-            if (authManager) {
-                QJSValue authManagerValue = m_jsEngine.newQObject(authManager);
-                m_jsEngine.globalObject().setProperty("authManager", authManagerValue);
+    QJSValue scriptExecutor = m_jsEngine->newQObject(this);
+    m_jsEngine->globalObject().setProperty("_scriptExecutor", scriptExecutor);
+    
+    // AI and auth live on the GUI thread, so a detached executor goes without them
+    if (!m_effectSink.log) {
+        // Create and register AIService
+        AIService* aiService = new AIService(m_jsEngine.get());
+        QJSValue aiServiceValue = m_jsEngine->newQObject(aiService);
+        m_jsEngine->globalObject().setProperty("aiService", aiServiceValue);
+        
+        // Try to find and register the AuthenticationManager
+        // Look for it in the parent hierarchy (it's a global object)
+        QObject* p = parent();
+        while (p) {
+            // Check if this is the QApplication
+            if (qobject_cast<QApplication*>(p)) {
+                // Find AuthenticationManager among app's children
+                AuthenticationManager* authManager = p->findChild<AuthenticationManager*>();
+                if (authManager) {
+                    QJSValue authManagerValue = m_jsEngine->newQObject(authManager);
+                    m_jsEngine->globalObject().setProperty("authManager", authManagerValue);
+                }
+                break;
             }
-            break;
+            p = p->parent();
         }
-        p = p->parent();
     }
     
     // Create console object with log function
@@ -100,7 +163,7 @@ void ScriptExecutor::setupJSContext()
         "    }"
         "};";
     
-    QJSValue result = m_jsEngine.evaluate(consoleScript);
+    QJSValue result = m_jsEngine->evaluate(consoleScript);
     if (result.isError()) {
         qWarning() << "Failed to setup console:" << result.toString();
     }
@@ -113,13 +176,6 @@ void ScriptExecutor::executeEvent(const QString& eventName, const QVariantMap& e
         return;
     }
     
-    // Clear any previous async results and param results
-    m_asyncResults.clear();
-    m_paramResults.clear();
-    
-    // Store the event data for use in scripts
-    m_currentEventData = eventData;
-    
     // Check if scripts are compiled
     if (!m_scripts->isCompiled()) {
         // Get console from parent project
@@ -150,7 +206,26 @@ void ScriptExecutor::executeEvent(const QString& eventName, const QVariantMap& e
         return;
     }
     
-    m_compiledScript = doc.object();
+    clearInterruption();
+    executeCompiledEvent(doc.object(), eventName, eventData);
+}
+
+void ScriptExecutor::executeCompiledEvent(const QJsonObject& compiledScript, const QString& eventName,
+                                          const QVariantMap& eventData)
+{
+    TRACE_SCOPE("ScriptExecutor::executeCompiledEvent", "scripts");
+    
+    // Clear any previous async results and param results
+    m_asyncResults.clear();
+    m_paramResults.clear();
+    
+    // Store the event data for use in scripts
+    m_currentEventData = eventData;
+    m_compiledScript = compiledScript;
+    
+    // A new event starts with a fresh time slice
+    m_stopped = false;
+    m_sliceTimer.start();
     
     // Find the event
     QString normalizedEventName = eventName.toLower().remove(' ');
@@ -160,7 +235,7 @@ void ScriptExecutor::executeEvent(const QString& eventName, const QVariantMap& e
         return;
     }
     
-    // Store the current event name for use in evaluateFunction
+    // Store the current event name for use in callFunction
     m_currentEventName = normalizedEventName;
     
     QJsonObject compiledEventData = m_compiledScript[normalizedEventName].toObject();
@@ -183,6 +258,11 @@ void ScriptExecutor::executeInvokeChain(const QJsonObject& eventData, const QJso
 
 void ScriptExecutor::executeInvoke(const QJsonObject& eventData, const QString& invokeId)
 {
+    if (shouldStop()) {
+        return;
+    }
+    TRACE_SCOPE("ScriptExecutor::executeInvoke", "scripts");
+    
     QJsonObject invokes = eventData["invoke"].toObject();
     
     if (!invokes.contains(invokeId)) {
@@ -196,39 +276,35 @@ void ScriptExecutor::executeInvoke(const QJsonObject& eventData, const QString&
     bool isAsync = invoke["isAsync"].toBool(false);
     bool isLoop = invoke["isLoop"].toBool(false);
     
-    // Get the function code
     QJsonObject functions = eventData["functions"].toObject();
     if (!functions.contains(functionId)) {
         qWarning() << "ScriptExecutor: Function not found:" << functionId;
         return;
     }
     
-    QString functionCode = functions[functionId].toString();
-    
     // Execute the function
-    // qDebug() << "ScriptExecutor: Executing function for invoke" << invokeId << "functionId:" << functionId;
-    QJSValue result = evaluateFunction(functionCode, params);
+    QJSValue promise;
+    QVariant result = callFunction(functionId, resolveParams(params), isAsync ? &promise : nullptr);
     
-    if (isAsync && result.isObject() && result.hasProperty("then")) {
-        
+    if (!promise.isUndefined()) {
         // This is a Promise - we need to wait for it
-        QJSValue thenFunc = result.property("then");
+        QJSValue thenFunc = promise.property("then");
         
         // Create callbacks for promise resolution
-        QJSValue onResolved = m_jsEngine.evaluate(
+        QJSValue onResolved = jsEngine()->evaluate(
             "(function(value) {"
             "   _scriptExecutor.handleAsyncResult('" + invokeId + "', value);"
             "})"
         );
         
-        QJSValue onRejected = m_jsEngine.evaluate(
+        QJSValue onRejected = jsEngine()->evaluate(
             "(function(error) {"
             "   _scriptExecutor.handleAsyncError('" + invokeId + "', error);"
             "})"
         );
         
         // Call then() with our callbacks
-        thenFunc.callWithInstance(result, QJSValueList() << onResolved << onRejected);
+        thenFunc.callWithInstance(promise, QJSValueList() << onResolved << onRejected);
         
         // Store the event data and next invokes for later
         m_pendingAsyncInvokes[invokeId] = QPair<QJsonObject, QJsonArray>(
@@ -259,51 +335,33 @@ void ScriptExecutor::executeInvoke(const QJsonObject& eventData, const QString&
     
     // Handle loop invokes
     if (isLoop) {
-        // qDebug() << "ScriptExecutor: Processing loop invoke" << invokeId;
         QString loopBodyInvoke = invoke["loopBody"].toString();
         QString loopCompleteInvoke = invoke["loopComplete"].toString();
-        // qDebug() << "ScriptExecutor: Loop body invoke:" << loopBodyInvoke << "complete invoke:" << loopCompleteInvoke;
         
         // Extract the array from the result
-        QVariantList arrayData;
-        if (result.isObject() && result.hasProperty("array")) {
-            QJSValue arrayValue = result.property("array");
-            if (arrayValue.isArray()) {
-                int length = arrayValue.property("length").toInt();
-                // qDebug() << "ScriptExecutor: Found array with length" << length;
-                for (int i = 0; i < length; i++) {
-                    arrayData.append(arrayValue.property(i).toVariant());
-                }
-            } else {
-                qWarning() << "ScriptExecutor: Result has 'array' property but it's not an array";
-            }
-        } else {
-            qWarning() << "ScriptExecutor: Result doesn't have 'array' property";
-            if (result.isObject()) {
-                // List all properties
-                QJSValueIterator it(result);
-                while (it.hasNext()) {
-                    it.next();
-                    qDebug() << "  Property:" << it.name() << "=" << it.value().toString();
-                }
-            }
+        QVariant arrayValue = result.toMap().value("array");
+        if (arrayValue.typeId() != QMetaType::QVariantList) {
+            qWarning() << "ScriptExecutor: Loop result doesn't have an 'array' property:" << result;
         }
+        const QVariantList arrayData = arrayValue.toList();
         
-        // qDebug() << "ScriptExecutor: Executing ForEachLoop with" << arrayData.size() << "items";
+        // Loops can nest; restore the outer loop's item afterwards
+        const bool outerInLoop = m_inLoop;
+        const QVariant outerItem = m_loopItem;
+        const int outerIndex = m_loopIndex;
         
         // Execute the loop body for each item
-        for (int i = 0; i < arrayData.size(); i++) {
+        for (int i = 0; i < arrayData.size() && !shouldStop(); i++) {
             // Clear param results cache for this iteration
             m_paramResults.clear();
             
-            // Make the current item available as a variable
-            QJSValue itemValue = m_jsEngine.toScriptValue(arrayData[i]);
-            // qDebug() << "ScriptExecutor: Setting currentLoopItem to:" << arrayData[i] << "as QJSValue:" << itemValue.toString();
-            m_jsEngine.globalObject().setProperty("currentLoopItem", itemValue);
-            m_jsEngine.globalObject().setProperty("currentLoopIndex", i);
+            // Make the current item available to the loop's outputs
+            m_inLoop = true;
+            m_loopItem = arrayData[i];
+            m_loopIndex = i;
             
             // Re-evaluate the loop node's function to get outputs with current item/index
-            QJSValue loopResult = evaluateFunction(functionCode, params);
+            QVariant loopResult = callFunction(functionId, resolveParams(params));
             
             // Handle outputs for the current iteration
             if (eventData.contains("outputs")) {
@@ -323,8 +381,9 @@ void ScriptExecutor::executeInvoke(const QJsonObject& eventData, const QString&
         }
         
         // Clear loop variables
-        m_jsEngine.globalObject().deleteProperty("currentLoopItem");
-        m_jsEngine.globalObject().deleteProperty("currentLoopIndex");
+        m_inLoop = outerInLoop;
+        m_loopItem = outerItem;
+        m_loopIndex = outerIndex;
         
         // Execute the complete branch
         if (!loopCompleteInvoke.isEmpty()) {
@@ -342,18 +401,45 @@ void ScriptExecutor::executeInvoke(const QJsonObject& eventData, const QString&
     }
 }
 
-QJSValue ScriptExecutor::evaluateFunction(const QString& functionCode, const QJsonArray& params)
+QVariant ScriptExecutor::callFunction(const QString& functionId, const QJsonArray& resolvedParams,
+                                      QJSValue* pendingPromise)
 {
-    // Make event data available as a global variable in the script
-    if (!m_currentEventData.isEmpty()) {
-        QJSValue eventDataObj = m_jsEngine.newObject();
-        for (auto it = m_currentEventData.begin(); it != m_currentEventData.end(); ++it) {
-            eventDataObj.setProperty(it.key(), m_jsEngine.toScriptValue(it.value()));
+    const QJsonObject event = currentEvent();
+    
+    // Built-in nodes run natively
+    const QJsonObject binding = event["natives"].toObject()[functionId].toObject();
+    const QString intrinsic = binding["intrinsic"].toString();
+    if (!intrinsic.isEmpty() && ScriptIntrinsics::instance().hasIntrinsic(intrinsic)) {
+        QVariantList args;
+        args.reserve(resolvedParams.size());
+        for (const QJsonValue& param : resolvedParams) {
+            const QJsonObject paramObj = param.toObject();
+            args.append(paramObj.contains("value") ? paramObj["value"].toVariant() : QVariant());
         }
-        m_jsEngine.globalObject().setProperty("eventData", eventDataObj);
+        
+        ScriptIntrinsics::CallContext context;
+        context.eventData = m_currentEventData;
+        context.inLoop = m_inLoop;
+        context.loopItem = m_loopItem;
+        context.loopIndex = m_loopIndex;
+        context.log = [this](const QString& message) { logOutput(message); };
+        return ScriptIntrinsics::instance().call(intrinsic, args, binding, context);
+    }
+    
+    // Everything else is JavaScript
+    const QString functionCode = event["functions"].toObject()[functionId].toString();
+    QJSValue result = evaluateFunction(functionCode, resolvedParams);
+    
+    if (pendingPromise && result.isObject() && result.hasProperty("then")) {
+        *pendingPromise = result;
+        return QVariant();
     }
     
-    // First, we need to resolve any output references in the parameters
+    return result.toVariant();
+}
+
+QJsonArray ScriptExecutor::resolveParams(const QJsonArray& params)
+{
     QJsonArray resolvedParams;
     
     for (const QJsonValue& param : params) {
@@ -362,272 +448,7 @@ QJSValue ScriptExecutor::evaluateFunction(const QString& functionCode, const QJs
         
         if (paramObj.contains("output")) {
             // This is an output reference, we need to get the actual value
-            QString outputId = paramObj["output"].toString();
-            QJsonObject outputs = m_compiledScript[m_currentEventName].toObject()["outputs"].toObject();
-            
-            if (outputs.contains(outputId)) {
-                QJsonObject outputDef = outputs[outputId].toObject();
-                QString outputType = outputDef["type"].toString();
-                
-                // qDebug() << "ScriptExecutor: Resolving output" << outputId << "type:" << outputType << "outputDef:" << outputDef;
-                
-                if (outputType == "eventData") {
-                    // For event data outputs, get the value from the current event data
-                    int sourcePortIndex = outputDef["sourcePortIndex"].toInt();
-                    
-                    // Map port indices to event data keys
-                    // For WebTextInput events: port 0 = "done" (Flow), port 1 = "value" (String)
-                    QString eventDataKey = "value"; // Default to "value"
-                    if (sourcePortIndex == 1) {
-                        eventDataKey = "value";
-                    }
-                    
-                    // Get the value from the current event data and convert to JSON-compatible type
-                    if (m_currentEventData.contains(eventDataKey)) {
-                        QVariant variant = m_currentEventData[eventDataKey];
-                        resolvedParam["value"] = QJsonValue::fromVariant(variant);
-                    } else {
-                        resolvedParam["value"] = "";
-                    }
-                } else if (outputType == "invokeResult") {
-                    // For invoke results, check if we have a stored result
-                    if (m_asyncResults.contains(outputId)) {
-                        QJSValue asyncResult = m_asyncResults[outputId];
-                        // Convert QJSValue to QVariant for JSON serialization
-                        if (asyncResult.isObject()) {
-                            // For objects, we need to convert to a proper JSON structure
-                            QVariantMap resultMap;
-                            if (asyncResult.hasProperty("array")) {
-                                // Handle array results
-                                QJSValue arrayValue = asyncResult.property("array");
-                                if (arrayValue.isArray()) {
-                                    QVariantList arrayList;
-                                    int length = arrayValue.property("length").toInt();
-                                    for (int i = 0; i < length; i++) {
-                                        arrayList.append(arrayValue.property(i).toVariant());
-                                    }
-                                    resultMap["array"] = arrayList;
-                                }
-                            } else if (asyncResult.hasProperty("response")) {
-                                // Handle async responses
-                                resultMap["response"] = asyncResult.property("response").toString();
-                            }
-                            resolvedParam["value"] = QJsonValue::fromVariant(resultMap);
-                        } else {
-                            resolvedParam["value"] = QJsonValue::fromVariant(asyncResult.toVariant());
-                        }
-                    } else {
-                        // Check if this is a ForEachLoop output that should use current loop values
-                        QString sourceInvoke = outputDef["sourceInvoke"].toString();
-                        QString sourceNodeId = outputDef["sourceNodeId"].toString();
-                        int sourcePortIndex = outputDef["sourcePortIndex"].toInt();
-                        
-                        // Check if we're in a loop context and this output is from the loop node
-                        if (m_jsEngine.globalObject().hasProperty("currentLoopItem") && 
-                            m_jsEngine.globalObject().hasProperty("currentLoopIndex")) {
-                            
-                            // Check if this output is from a ForEachLoop node
-                            QJsonObject invokes = m_compiledScript[m_currentEventName].toObject()["invoke"].toObject();
-                            if (invokes.contains(sourceInvoke)) {
-                                QJsonObject invoke = invokes[sourceInvoke].toObject();
-                                if (invoke["isLoop"].toBool()) {
-                                    // This is a loop output - use current loop values
-                                    if (sourcePortIndex == 1) {
-                                        // Array Element port - use currentLoopItem
-                                        QJSValue currentItem = m_jsEngine.globalObject().property("currentLoopItem");
-                                        resolvedParam["value"] = QJsonValue::fromVariant(currentItem.toVariant());
-                                    } else if (sourcePortIndex == 2) {
-                                        // Array Index port - use currentLoopIndex
-                                        QJSValue currentIndex = m_jsEngine.globalObject().property("currentLoopIndex");
-                                        resolvedParam["value"] = QJsonValue::fromVariant(currentIndex.toVariant());
-                                    } else {
-                                        resolvedParam["value"] = "";
-                                    }
-                                } else {
-                                    resolvedParam["value"] = "";
-                                }
-                            } else {
-                                resolvedParam["value"] = "";
-                            }
-                        } else {
-                            resolvedParam["value"] = "";
-                        }
-                    }
-                } else if (outputType == "paramResult") {
-                    // For param results, we need to evaluate the param function
-                    QString sourceInvoke = outputDef["sourceInvoke"].toString();
-                    
-                    // Check if we already computed this param
-                    if (m_paramResults.contains(sourceInvoke)) {
-                        QJSValue paramResult = m_paramResults[sourceInvoke];
-                        if (paramResult.isString()) {
-                            // If the result is a string, use it directly
-                            resolvedParam["value"] = paramResult.toString();
-                        } else if (paramResult.isNumber()) {
-                            // If the result is a number, convert to variant
-                            resolvedParam["value"] = paramResult.toNumber();
-                        } else if (paramResult.isObject()) {
-                            QVariantMap resultMap;
-                            if (paramResult.hasProperty("array")) {
-                                QJSValue arrayValue = paramResult.property("array");
-                                if (arrayValue.isArray()) {
-                                    QVariantList arrayList;
-                                    int length = arrayValue.property("length").toInt();
-                                    for (int i = 0; i < length; i++) {
-                                        arrayList.append(arrayValue.property(i).toVariant());
-                                    }
-                                    resultMap["array"] = arrayList;
-                                }
-                            }
-                            if (paramResult.hasProperty("string")) {
-                                QJSValue stringValue = paramResult.property("string");
-                                resultMap["string"] = stringValue.toString();
-                            }
-                            resolvedParam["value"] = QJsonValue::fromVariant(resultMap);
-                        } else {
-                            resolvedParam["value"] = QJsonValue::fromVariant(paramResult.toVariant());
-                        }
-                    } else {
-                        // Evaluate the param function
-                        QJsonObject paramInvokes = m_compiledScript[m_currentEventName].toObject()["params"].toObject();
-                        if (paramInvokes.contains(sourceInvoke)) {
-                            QJsonObject paramInvoke = paramInvokes[sourceInvoke].toObject();
-                            QString functionName = paramInvoke["function"].toString();
-                            QJsonArray paramParams = paramInvoke["params"].toArray();
-                            
-                            // Get the function code
-                            QJsonObject functions = m_compiledScript[m_currentEventName].toObject()["functions"].toObject();
-                            if (functions.contains(functionName)) {
-                                QString functionCode = functions[functionName].toString();
-                                
-                                // Pre-resolve output references in param parameters for loop context
-                                QJsonArray resolvedParamParams;
-                                for (const QJsonValue& paramParam : paramParams) {
-                                    QJsonObject paramParamObj = paramParam.toObject();
-                                    QJsonObject resolvedParamParam;
-                                    
-                                    if (paramParamObj.contains("output")) {
-                                        QString outputId = paramParamObj["output"].toString();
-                                        QJsonObject outputs = m_compiledScript[m_currentEventName].toObject()["outputs"].toObject();
-                                        
-                                        if (outputs.contains(outputId)) {
-                                            QJsonObject outputDef = outputs[outputId].toObject();
-                                            QString outputType = outputDef["type"].toString();
-                                            
-                                            // qDebug() << "ScriptExecutor: Resolving param param output" << outputId << "type:" << outputType << "outputDef:" << outputDef;
-                                            
-                                            if (outputType == "invokeResult") {
-                                                // Check if this is a ForEachLoop output in loop context
-                                                QString sourceInvoke = outputDef["sourceInvoke"].toString();
-                                                int sourcePortIndex = outputDef["sourcePortIndex"].toInt();
-                                                
-                                                // qDebug() << "ScriptExecutor: Checking loop context - hasLoopItem:" << m_jsEngine.globalObject().hasProperty("currentLoopItem") << "hasLoopIndex:" << m_jsEngine.globalObject().hasProperty("currentLoopIndex");
-                                                if (m_jsEngine.globalObject().hasProperty("currentLoopItem") && 
-                                                    m_jsEngine.globalObject().hasProperty("currentLoopIndex")) {
-                                                    
-                                                    QJsonObject invokes = m_compiledScript[m_currentEventName].toObject()["invoke"].toObject();
-                                                    if (invokes.contains(sourceInvoke)) {
-                                                        QJsonObject invoke = invokes[sourceInvoke].toObject();
-                                                        if (invoke["isLoop"].toBool()) {
-                                                            // This is a loop output - use current loop values
-                                                            // qDebug() << "ScriptExecutor: Loop output with sourcePortIndex:" << sourcePortIndex;
-                                                            if (sourcePortIndex == 1) {
-                                                                // Array Element port - use currentLoopItem
-                                                                QJSValue currentItem = m_jsEngine.globalObject().property("currentLoopItem");
-                                                                // qDebug() << "ScriptExecutor: Current loop item value:" << currentItem.toString() << "toVariant:" << currentItem.toVariant();
-                                                                resolvedParamParam["value"] = QJsonValue::fromVariant(currentItem.toVariant());
-                                                            } else if (sourcePortIndex == 2) {
-                                                                // Array Index port - use currentLoopIndex
-                                                                QJSValue currentIndex = m_jsEngine.globalObject().property("currentLoopIndex");
-                                                                // qDebug() << "ScriptExecutor: Current loop index value:" << currentIndex.toString() << "toVariant:" << currentIndex.toVariant();
-                                                                resolvedParamParam["value"] = QJsonValue::fromVariant(currentIndex.toVariant());
-                                                            } else {
-                                                                resolvedParamParam["value"] = "";
-                                                            }
-                                                        } else {
-                                                            resolvedParamParam["value"] = "";
-                                                        }
-                                                    } else {
-                                                        resolvedParamParam["value"] = "";
-                                                    }
-                                                } else {
-                                                    resolvedParamParam["value"] = "";
-                                                }
-                                            } else if (outputType == "literal") {
-                                                // For literal outputs, use the stored value
-                                                resolvedParamParam["value"] = outputDef["value"];
-                                            } else {
-                                                resolvedParamParam["value"] = "";
-                                            }
-                                        } else {
-                                            resolvedParamParam["value"] = "";
-                                        }
-                                    } else if (paramParamObj.contains("value")) {
-                                        resolvedParamParam["value"] = paramParamObj["value"];
-                                    }
-                                    
-                                    resolvedParamParams.append(resolvedParamParam);
-                                }
-                                
-                                // Evaluate the param function with resolved parameters
-                                // qDebug() << "ScriptExecutor: Evaluating param function" << functionName << "with params:" << resolvedParamParams;
-                                QJSValue result = evaluateFunction(functionCode, resolvedParamParams);
-                                // qDebug() << "ScriptExecutor: Param function result:" << result.toString();
-                                // qDebug() << "ScriptExecutor: Result isString:" << result.isString() << "isObject:" << result.isObject() << "isNumber:" << result.isNumber();
-                                
-                                // Special handling for string "0" 
-                                if (result.isString() && result.toString() == "[object Object]") {
-                                    // qDebug() << "ScriptExecutor: WARNING - String result is showing as [object Object]";
-                                    // Try to get the actual string value
-                                    QString strValue = result.toString();
-                                    // qDebug() << "ScriptExecutor: Actual string value:" << strValue;
-                                }
-                                if (result.isObject() && result.hasProperty("string")) {
-                                    // qDebug() << "ScriptExecutor: Param function returned string property:" << result.property("string").toString();
-                                }
-                                
-                                // Store the result for reuse
-                                m_paramResults[sourceInvoke] = result;
-                                
-                                // Convert result to proper format
-                                if (result.isString()) {
-                                    // If the result is a string, use it directly
-                                    resolvedParam["value"] = result.toString();
-                                } else if (result.isNumber()) {
-                                    // If the result is a number, convert to variant
-                                    resolvedParam["value"] = result.toNumber();
-                                } else if (result.isObject()) {
-                                    QVariantMap resultMap;
-                                    if (result.hasProperty("array")) {
-                                        QJSValue arrayValue = result.property("array");
-                                        if (arrayValue.isArray()) {
-                                            QVariantList arrayList;
-                                            int length = arrayValue.property("length").toInt();
-                                            for (int i = 0; i < length; i++) {
-                                                arrayList.append(arrayValue.property(i).toVariant());
-                                            }
-                                            resultMap["array"] = arrayList;
-                                        }
-                                    }
-                                    if (result.hasProperty("string")) {
-                                        QJSValue stringValue = result.property("string");
-                                        resultMap["string"] = stringValue.toString();
-                                    }
-                                    resolvedParam["value"] = QJsonValue::fromVariant(resultMap);
-                                } else {
-                                    resolvedParam["value"] = QJsonValue::fromVariant(result.toVariant());
-                                }
-                            }
-                        }
-                    }
-                } else if (outputDef.contains("value")) {
-                    // For literal outputs, use the stored value
-                    resolvedParam["value"] = outputDef["value"];
-                } else {
-                    // TODO: Handle other computed outputs
-                    resolvedParam["value"] = "";
-                }
-            }
+            resolvedParam["value"] = QJsonValue::fromVariant(resolveOutput(paramObj["output"].toString()));
         } else if (paramObj.contains("value")) {
             // Direct value parameter
             resolvedParam["value"] = paramObj["value"];
@@ -636,6 +457,86 @@ QJSValue ScriptExecutor::evaluateFunction(const QString& functionCode, const QJs
         resolvedParams.append(resolvedParam);
     }
     
+    return resolvedParams;
+}
+
+QVariant ScriptExecutor::resolveOutput(const QString& outputId)
+{
+    const QJsonObject event = currentEvent();
+    const QJsonObject outputs = event["outputs"].toObject();
+    if (!outputs.contains(outputId)) {
+        return QString();
+    }
+    
+    const QJsonObject outputDef = outputs[outputId].toObject();
+    const QString outputType = outputDef["type"].toString();
+    const QString sourceInvoke = outputDef["sourceInvoke"].toString();
+    
+    if (outputType == "eventData") {
+        // For WebTextInput events: port 0 = "done" (Flow), port 1 = "value" (String)
+        return m_currentEventData.value("value", QString());
+    }
+    
+    if (outputType == "invokeResult") {
+        // Array Element / Array Index of the loop that is currently running
+        if (m_inLoop && event["invoke"].toObject()[sourceInvoke].toObject()["isLoop"].toBool()) {
+            const int sourcePortIndex = outputDef["sourcePortIndex"].toInt();
+            if (sourcePortIndex == 1) {
+                return m_loopItem;
+            } else if (sourcePortIndex == 2) {
+                return m_loopIndex;
+            }
+            return QString();
+        }
+        
+        // Results of invokes that already ran (including async ones)
+        return m_asyncResults.value(outputId, QString());
+    }
+    
+    if (outputType == "paramResult") {
+        // Param nodes are evaluated on first use and cached (per loop iteration)
+        if (!m_paramResults.contains(sourceInvoke)) {
+            const QJsonObject paramInvoke = event["params"].toObject()[sourceInvoke].toObject();
+            const QString functionName = paramInvoke["function"].toString();
+            if (!event["functions"].toObject().contains(functionName)) {
+                return QString();
+            }
+            m_paramResults[sourceInvoke] = callFunction(functionName, resolveParams(paramInvoke["params"].toArray()));
+        }
+        return m_paramResults[sourceInvoke];
+    }
+    
+    if (outputDef.contains("value")) {
+        // For literal outputs, use the stored value
+        return outputDef["value"].toVariant();
+    }
+    
+    // TODO: Handle other computed outputs
+    return QString();
+}
+
+QJSValue ScriptExecutor::evaluateFunction(const QString& functionCode, const QJsonArray& resolvedParams)
+{
+    QJSEngine* engine = jsEngine();
+    
+    // Make event data available as a global variable in the script
+    if (!m_currentEventData.isEmpty()) {
+        QJSValue eventDataObj = engine->newObject();
+        for (auto it = m_currentEventData.begin(); it != m_currentEventData.end(); ++it) {
+            eventDataObj.setProperty(it.key(), engine->toScriptValue(it.value()));
+        }
+        engine->globalObject().setProperty("eventData", eventDataObj);
+    }
+    
+    // Loop state for scripts that read it
+    if (m_inLoop) {
+        engine->globalObject().setProperty("currentLoopItem", engine->toScriptValue(m_loopItem));
+        engine->globalObject().setProperty("currentLoopIndex", m_loopIndex);
+    } else {
+        engine->globalObject().deleteProperty("currentLoopItem");
+        engine->globalObject().deleteProperty("currentLoopIndex");
+    }
+    
     // Create a wrapper to call the function with parameters
     // Check if function expects context parameter (for async functions)
     bool needsContext = functionCode.contains("(params, context)");
@@ -657,90 +558,50 @@ QJSValue ScriptExecutor::evaluateFunction(const QString& functionCode, const QJs
     }
     
     
-    QJSValue result = m_jsEngine.evaluate(wrapper);
+    QJSValue result = engine->evaluate(wrapper);
     
-    if (result.isError()) {
+    // An interrupted script reports itself through shouldStop()
+    if (result.isError() && !m_interrupted) {
         QString error = result.toString();
-        if (parent()) {
-            Project* project = qobject_cast<Project*>(parent());
-            if (project && project->console()) {
-                project->console()->addError("Script execution error: " + error);
-            }
-        }
+        logError("Script execution error: " + error);
         qWarning() << "ScriptExecutor: JavaScript error:" << error;
     }
     
     return result;
 }
 
-void ScriptExecutor::handleOutput(const QJsonObject& outputDef, const QJSValue& value)
+void ScriptExecutor::handleOutput(const QJsonObject& outputDef, const QVariant& value)
 {
     QString type = outputDef["type"].toString();
     
     if (type == "console") {
-        // Output to console
-        QString message;
-        
-        // Check if the value is an object with a specific property to extract
-        if (value.isObject()) {
-            // For async results like AI responses, extract the response property if it exists
-            if (value.hasProperty("response")) {
-                message = value.property("response").toString();
-            } else {
-                // If no specific property, convert the whole object to string
-                message = value.toString();
-            }
-        } else {
-            // For simple values, just convert to string
-            message = value.toString();
-        }
-        
-        if (parent()) {
-            Project* project = qobject_cast<Project*>(parent());
-            if (project && project->console()) {
-                project->console()->addOutput(message);
-            }
-        }
+        // Output to console; async results like AI responses show their response property
+        logOutput(ScriptIntrinsics::toDisplayString(value));
     } else if (type == "invokeResult") {
         // This output will be populated by an async result
         // We'll update the outputs in the compiled script so subsequent nodes can use it
     } else if (type == "variable") {
         // Store in variable
         QString variableId = outputDef["targetId"].toString();
+        if (variableId.isEmpty()) {
+            return;
+        }
         
-        if (m_elementModel && !variableId.isEmpty()) {
-            // Get the variable element
-            Element* element = m_elementModel->getElementById(variableId);
-            if (element) {
-                Variable* variable = qobject_cast<Variable*>(element);
-                if (variable) {
-                    // Extract the value from the result
-                    QString newValue;
-                    if (value.isObject()) {
-                        // The result is an object with variableId and value properties
-                        if (value.hasProperty("value")) {
-                            newValue = value.property("value").toString();
-                        } else {
-                            newValue = value.toString();
-                        }
-                    } else {
-                        newValue = value.toString();
-                    }
-                    
-                    // Update the variable value
-                    variable->setValue(QVariant(newValue));
-                    
-                    // Log the update
-                    if (parent()) {
-                        Project* project = qobject_cast<Project*>(parent());
-                        if (project && project->console()) {
-                            project->console()->addOutput(QString("Variable '%1' updated to: %2")
-                                .arg(variable->getName())
-                                .arg(newValue));
-                        }
-                    }
-                }
-            }
+        // The result is an object with variableId and value properties
+        QVariantMap resultMap = value.toMap();
+        QString newValue = ScriptIntrinsics::toDisplayString(
+            resultMap.contains("value") ? resultMap.value("value") : value);
+        
+        if (m_effectSink.setVariable) {
+            m_effectSink.setVariable(variableId, newValue);
+            return;
+        }
+        
+        // Update the variable value and log the update
+        if (Variable* variable = setVariableValue(m_elementModel, variableId, newValue)) {
+            logOutput(QString("Variable '%1' updated to: %2")
+                .arg(variable->getName())
+                .arg(newValue));
         }
     } else if (type == "element") {
         // Update element property (future implementation)
@@ -750,23 +611,59 @@ void ScriptExecutor::handleOutput(const QJsonObject& outputDef, const QJSValue&
     }
 }
 
-void ScriptExecutor::handleAsyncResult(const QString& invokeId, const QJSValue& result)
+Variable* ScriptExecutor::setVariableValue(ElementModel* model, const QString& variableId, const QString& value)
 {
-    if (!m_pendingAsyncInvokes.contains(invokeId)) {
-        // Async invoke already processed or doesn't exist
+    if (!model) {
+        return nullptr;
+    }
+    
+    Variable* variable = qobject_cast<Variable*>(model->getElementById(variableId));
+    if (variable) {
+        variable->setValue(QVariant(value));
+    }
+    return variable;
+}
+
+void ScriptExecutor::logOutput(const QString& message)
+{
+    if (m_effectSink.log) {
+        m_effectSink.log(message, false);
         return;
     }
     
+    Project* project = qobject_cast<Project*>(parent());
+    if (project && project->console()) {
+        project->console()->addOutput(message);
+    }
+}
+
+void ScriptExecutor::logError(const QString& message)
+{
+    if (m_effectSink.log) {
+        m_effectSink.log(message, true);
+        return;
+    }
     
-    // Debug: log the result
-    if (result.isObject()) {
-        if (result.hasProperty("response")) {
-        }
+    Project* project = qobject_cast<Project*>(parent());
+    if (project && project->console()) {
+        project->console()->addError(message);
+    }
+}
+
+void ScriptExecutor::handleAsyncResult(const QString& invokeId, const QJSValue& result)
+{
+    if (!m_pendingAsyncInvokes.contains(invokeId)) {
+        // Async invoke already processed or doesn't exist
+        return;
     }
     
     QPair<QJsonObject, QJsonArray> pendingData = m_pendingAsyncInvokes.take(invokeId);
+    
+    // The wait does not count against the time slice
+    m_sliceTimer.restart();
     QJsonObject eventData = pendingData.first;
     QJsonArray nextInvokes = pendingData.second;
+    QVariant value = result.toVariant();
     
     // Store async results for later use by other nodes
     if (eventData.contains("outputs")) {
@@ -780,15 +677,14 @@ void ScriptExecutor::handleAsyncResult(const QString& invokeId, const QJSValue&
             
             if (sourceInvoke == invokeId) {
                 // Store the async result for this output
-                m_asyncResults[outputId] = result;
+                m_asyncResults[outputId] = value;
                 
                 // Also handle the output immediately if it's a console output
                 if (outputDef["type"].toString() == "console") {
-                    handleOutput(outputDef, result);
+                    handleOutput(outputDef, value);
                 }
             }
         }
-    } else {
     }
     
     // Continue with next invokes
@@ -800,14 +696,9 @@ void ScriptExecutor::handleAsyncResult(const QString& invokeId, const QJSValue&
 void ScriptExecutor::handleAsyncError(const QString& invokeId, const QJSValue& error)
 {
     QString errorMessage = error.toString();
-    if (parent()) {
-        Project* project = qobject_cast<Project*>(parent());
-        if (project && project->console()) {
-            project->console()->addError("Async script error in invoke " + invokeId + ": " + errorMessage);
-        }
-    }
+    logError("Async script error in invoke " + invokeId + ": " + errorMessage);
     qWarning() << "ScriptExecutor: Async error in invoke" << invokeId << ":" << errorMessage;
     
     // Remove from pending
     m_pendingAsyncInvokes.remove(invokeId);
-}
\ No newline at end of file
+}
@@ -7,6 +7,10 @@
 #include <QJsonArray>
 #include <QMap>
 #include <QPair>
+#include <QElapsedTimer>
+#include <QMutex>
+#include <atomic>
+#include <functional>
 #include <memory>
 
 // Forward declaration
@@ -28,6 +32,7 @@ private:
 class Scripts;
 class ElementModel;
 class CanvasController;
+class Variable;
 
 class ScriptExecutor : public QObject
 {
@@ -44,28 +49,84 @@ public:
     // Execute a specific event with optional data
     void executeEvent(const QString& eventName, const QVariantMap& eventData = QVariantMap());
     
+    // Execute an event of an already compiled script. Only reads the compiled
+    // script and event data, so it can run on a thread other than the model's.
+    void executeCompiledEvent(const QJsonObject& compiledScript, const QString& eventName,
+                              const QVariantMap& eventData = QVariantMap());
+    
+    // Where console output and variable writes go. Without one the executor
+    // applies them itself; ScriptRuntime sets one on its worker thread executor
+    // to hand them back to the GUI thread. An executor with a sink does not
+    // expose the GUI thread services (AI, auth) to scripts.
+    struct EffectSink {
+        std::function<void(const QString& message, bool isError)> log;
+        std::function<void(const QString& variableId, const QString& value)> setVariable;
+    };
+    void setEffectSink(EffectSink sink);
+    
+    // Call onSliceEnd between nodes after every milliseconds of running, so the
+    // owner can hand over output while a long event carries on; 0 for never.
+    // The clock restarts when an async result resumes the event.
+    void setTimeSlice(int milliseconds, std::function<void()> onSliceEnd);
+    
+    // Stop the running event at the next node, or inside the current script.
+    // Safe to call from any thread.
+    void interrupt();
+    
+    // Forget an earlier interrupt() before starting the next event;
+    // executeEvent does this itself
+    void clearInterruption();
+    
+    // Set a variable element's value; returns the variable, or nullptr if the
+    // id does not name one
+    static Variable* setVariableValue(ElementModel* model, const QString& variableId, const QString& value);
+    
     // Handle async results from JavaScript
     Q_INVOKABLE void handleAsyncResult(const QString& invokeId, const QJSValue& result);
     Q_INVOKABLE void handleAsyncError(const QString& invokeId, const QJSValue& error);
 
 private:
+    friend class QtConsoleLog;
+    
     // Execute a chain of invokes starting from given invoke IDs
     void executeInvokeChain(const QJsonObject& eventData, const QJsonArray& invokeIds);
     
     // Execute a single invoke
     void executeInvoke(const QJsonObject& eventData, const QString& invokeId);
     
-    // Evaluate a JavaScript function with given parameters
-    QJSValue evaluateFunction(const QString& functionCode, const QJsonArray& params);
+    // Run a compiled function with resolved parameters, natively when the compiler
+    // bound it to an intrinsic and in the JS engine otherwise. When pendingPromise
+    // is given and the JS function returns a Promise, it is stored there instead.
+    QVariant callFunction(const QString& functionId, const QJsonArray& resolvedParams,
+                          QJSValue* pendingPromise = nullptr);
+    
+    // Evaluate a JavaScript function with given (already resolved) parameters
+    QJSValue evaluateFunction(const QString& functionCode, const QJsonArray& resolvedParams);
+    
+    // Replace output references in invoke parameters with their current values
+    QJsonArray resolveParams(const QJsonArray& params);
+    QVariant resolveOutput(const QString& outputId);
+    
+    // The JS engine is only created once a script needs it
+    QJSEngine* jsEngine();
     
     // Setup the JavaScript execution context with necessary globals
     void setupJSContext();
     
     // Handle output from scripts
-    void handleOutput(const QJsonObject& outputDef, const QJSValue& value);
+    void handleOutput(const QJsonObject& outputDef, const QVariant& value);
+    
+    // Write to the owning project's console
+    void logOutput(const QString& message);
+    void logError(const QString& message);
+    
+    QJsonObject currentEvent() const { return m_compiledScript[m_currentEventName].toObject(); }
+    
+    // True once the event was interrupted; ends the time slice when it is due
+    bool shouldStop();
 
 private:
-    QJSEngine m_jsEngine;
+    std::unique_ptr<QJSEngine> m_jsEngine;
     Scripts* m_scripts;
     ElementModel* m_elementModel;
     CanvasController* m_canvasController;
@@ -73,8 +134,23 @@ private:
     QString m_currentEventName;
     QVariantMap m_currentEventData;
     QMap<QString, QPair<QJsonObject, QJsonArray>> m_pendingAsyncInvokes;
-    QMap<QString, QJSValue> m_asyncResults; // Store async results by output ID
-    QMap<QString, QJSValue> m_paramResults; // Store param node results by param invoke ID
+    QMap<QString, QVariant> m_asyncResults; // Store invoke results by output ID
+    QMap<QString, QVariant> m_paramResults; // Store param node results by param invoke ID
+    
+    // For Each Loop state while a loop body runs
+    bool m_inLoop = false;
+    QVariant m_loopItem;
+    int m_loopIndex = -1;
+    
+    EffectSink m_effectSink;
+    
+    // Cancellation and time slicing of the running event
+    std::atomic<bool> m_interrupted{false};
+    bool m_stopped = false;
+    int m_timeSlice = 0;
+    std::function<void()> m_sliceEnd;
+    QElapsedTimer m_sliceTimer;
+    QMutex m_engineMutex;   // Guards m_jsEngine and m_interrupted against interrupt() from other threads
 };
 
 #endif // SCRIPTEXECUTOR_H
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "ScriptFunctionRegistry.h"
+#include "ScriptIntrinsics.h"
 #include "Node.h"
 
 ScriptFunctionRegistry::ScriptFunctionRegistry()
@@ -60,6 +61,51 @@ QString ScriptFunctionRegistry::getFunctionCode(Node* node) const
     return "(params) => { }";
 }
 
+QJsonObject ScriptFunctionRegistry::getNativeFunction(Node* node) const
+{
+    QJsonObject binding;
+    if (!node) {
+        return binding;
+    }
+    
+    // Same precedence as getFunctionCode: a node only runs natively where its
+    // generated code would have been used, never in place of a node's own script
+    QString nodeType = node->nodeTitle().toLower().remove(' ');
+    const ScriptIntrinsics& intrinsics = ScriptIntrinsics::instance();
+    
+    if (nodeType == "consolelog" || nodeType == "convertnumbertostring" ||
+        nodeType == "createnumberarray") {
+        binding["intrinsic"] = nodeType;
+        return binding;
+    }
+    
+    if (!node->script().isEmpty()) {
+        return binding;
+    }
+    
+    if (intrinsics.hasIntrinsic(nodeType)) {
+        binding["intrinsic"] = nodeType;
+        return binding;
+    }
+    
+    if (nodeType.startsWith("set") && nodeType.endsWith("value")) {
+        QString variableId = node->sourceElementId();
+        if (!variableId.isEmpty()) {
+            binding["intrinsic"] = "setvariablevalue";
+            binding["variableId"] = variableId;
+            return binding;
+        }
+    }
+    
+    // Registered builders without an intrinsic (e.g. AI Prompt) stay in JavaScript
+    if (m_functionBuilders.contains(nodeType)) {
+        return binding;
+    }
+    
+    binding["intrinsic"] = "noop";
+    return binding;
+}
+
 bool ScriptFunctionRegistry::hasFunction(const QString& nodeType) const
 {
     return m_functionBuilders.contains(nodeType.toLower().remove(' '));
@@ -3,6 +3,7 @@
 
 #include <QString>
 #include <QMap>
+#include <QJsonObject>
 #include <functional>
 
 class Node;
@@ -20,6 +21,10 @@ public:
     // Get the JavaScript function code for a node
     QString getFunctionCode(Node* node) const;
     
+    // Get the native binding for a node: {"intrinsic": name, ...arguments}, or an
+    // empty object when the node has to run as JavaScript
+    QJsonObject getNativeFunction(Node* node) const;
+    
     // Check if a function is registered for a node type
     bool hasFunction(const QString& nodeType) const;
     
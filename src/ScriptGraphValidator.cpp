@@ -29,6 +29,28 @@ bool ScriptGraphValidator::validate(Scripts* scripts)
     return true;
 }
 
+bool ScriptGraphValidator::validateChanged(Scripts* scripts, const QSet<QString>& changedNodeIds)
+{
+    if (!scripts) {
+        m_lastError = "No scripts object provided";
+        return false;
+    }
+    
+    if (hasCyclesFrom(scripts, changedNodeIds)) {
+        m_lastError = "Circular dependency detected in script graph";
+        return false;
+    }
+    
+    // Changed edges mark both their endpoints, so these are all the nodes
+    // whose connections may differ from the last validation
+    if (!areRequiredPortsConnected(scripts, changedNodeIds)) {
+        return false; // Error already set
+    }
+    
+    m_lastError.clear();
+    return true;
+}
+
 QString ScriptGraphValidator::getLastError() const
 {
     return m_lastError;
@@ -52,6 +74,25 @@ bool ScriptGraphValidator::hasCycles(Scripts* scripts)
     return false;
 }
 
+bool ScriptGraphValidator::hasCyclesFrom(Scripts* scripts, const QSet<QString>& startNodeIds)
+{
+    QSet<QString> visited;
+    QSet<QString> recursionStack;
+    
+    for (const QString& nodeId : startNodeIds) {
+        if (visited.contains(nodeId)) {
+            continue;
+        }
+        // Removed nodes have no edges left to form a cycle
+        Node* node = scripts->getNode(nodeId);
+        if (node && hasCyclesHelper(node, visited, recursionStack, scripts)) {
+            return true;
+        }
+    }
+    
+    return false;
+}
+
 bool ScriptGraphValidator::hasCyclesHelper(Node* node, QSet<QString>& visited, 
                                           QSet<QString>& recursionStack, Scripts* scripts)
 {
@@ -95,6 +136,30 @@ QList<Edge*> ScriptGraphValidator::getOutgoingFlowEdges(Node* node, Scripts* scr
 
 bool ScriptGraphValidator::areRequiredPortsConnected(Scripts* scripts)
 {
+    const QList<Node*> nodes = scripts->getAllNodes();
+    for (Node* node : nodes) {
+        if (!checkRequiredPorts(node, scripts)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ScriptGraphValidator::areRequiredPortsConnected(Scripts* scripts, const QSet<QString>& nodeIds)
+{
+    for (const QString& nodeId : nodeIds) {
+        // Removed nodes have no ports left to check
+        Node* node = scripts->getNode(nodeId);
+        if (node && !checkRequiredPorts(node, scripts)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ScriptGraphValidator::checkRequiredPorts(Node* node, Scripts* scripts)
+{
+    Q_UNUSED(node);
     Q_UNUSED(scripts);
     // For now, we don't have required ports marked in the system
     // This is a placeholder for future validation
@@ -17,16 +17,31 @@ public:
     // Validate the entire script graph
     bool validate(Scripts* scripts);
     
+    // Validate after an edit, given a graph that passed validate() before and
+    // the nodes whose edges or ports changed since. A new cycle has to run
+    // through one of them, so only their reachable subgraph is searched, and
+    // only their ports are checked.
+    bool validateChanged(Scripts* scripts, const QSet<QString>& changedNodeIds);
+    
     // Get the last validation error
     QString getLastError() const;
     
     // Check for cycles in the graph
     bool hasCycles(Scripts* scripts);
     
+    // Check for cycles reachable from the given nodes
+    bool hasCyclesFrom(Scripts* scripts, const QSet<QString>& startNodeIds);
+    
     // Check if all required ports are connected
     bool areRequiredPortsConnected(Scripts* scripts);
     
+    // Check the required ports of the given nodes only
+    bool areRequiredPortsConnected(Scripts* scripts, const QSet<QString>& nodeIds);
+    
 private:
+    // Check one node's required ports
+    bool checkRequiredPorts(Node* node, Scripts* scripts);
+    
     // Helper for cycle detection using DFS
     bool hasCyclesHelper(Node* node, QSet<QString>& visited, QSet<QString>& recursionStack, Scripts* scripts);
     
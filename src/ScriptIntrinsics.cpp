@@ -0,0 +1,229 @@
+#include "ScriptIntrinsics.h"
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonValue>
+#include <QDebug>
+#include <cmath>
+
+namespace {
+
+QVariant argAt(const QVariantList& args, int index)
+{
+    return index < args.size() ? args.at(index) : QVariant();
+}
+
+// JavaScript's Number(value): blank strings and null are 0, a parameter
+// without a value (undefined) and anything else that does not parse is NaN
+double toNumber(const QVariant& value)
+{
+    if (!value.isValid()) {
+        return std::nan("");
+    }
+    if (value.isNull()) {
+        return 0.0;
+    }
+    if (value.typeId() == QMetaType::QString) {
+        const QString text = value.toString().trimmed();
+        if (text.isEmpty()) {
+            return 0.0;
+        }
+        bool ok = false;
+        const double number = text.toDouble(&ok);
+        return ok ? number : std::nan("");
+    }
+    bool ok = false;
+    const double number = value.toDouble(&ok);
+    return ok ? number : std::nan("");
+}
+
+// Operand of the math nodes: a parameter that is not there at all is 0, as
+// in the generated functions (params[i] ? Number(params[i].value) : 0)
+double numberArg(const QVariantList& args, int index)
+{
+    return index < args.size() ? toNumber(args.at(index)) : 0.0;
+}
+
+} // namespace
+
+const ScriptIntrinsics& ScriptIntrinsics::instance()
+{
+    static const ScriptIntrinsics intrinsics;
+    return intrinsics;
+}
+
+ScriptIntrinsics::ScriptIntrinsics()
+{
+    registerDefaultIntrinsics();
+}
+
+void ScriptIntrinsics::registerIntrinsic(const QString& name, Intrinsic intrinsic)
+{
+    m_intrinsics[name] = intrinsic;
+}
+
+bool ScriptIntrinsics::hasIntrinsic(const QString& name) const
+{
+    return m_intrinsics.contains(name);
+}
+
+QVariant ScriptIntrinsics::call(const QString& name, const QVariantList& args,
+                                const QJsonObject& binding, const CallContext& context) const
+{
+    auto it = m_intrinsics.constFind(name);
+    if (it == m_intrinsics.constEnd()) {
+        qWarning() << "ScriptIntrinsics: Unknown intrinsic:" << name;
+        return QVariant();
+    }
+    return it.value()(args, binding, context);
+}
+
+QString ScriptIntrinsics::toDisplayString(const QVariant& value)
+{
+    if (!value.isValid() || value.isNull()) {
+        return QString();
+    }
+
+    if (value.typeId() == QMetaType::QVariantMap) {
+        // Results of built-in nodes wrap their payload in a named property
+        const QVariantMap map = value.toMap();
+        for (const char* key : {"string", "response", "value"}) {
+            if (map.contains(key)) {
+                return toDisplayString(map.value(key));
+            }
+        }
+        return QString::fromUtf8(QJsonDocument(QJsonObject::fromVariantMap(map)).toJson(QJsonDocument::Compact));
+    }
+
+    if (value.typeId() == QMetaType::QVariantList) {
+        return QString::fromUtf8(QJsonDocument(QJsonArray::fromVariantList(value.toList())).toJson(QJsonDocument::Compact));
+    }
+
+    if (value.typeId() == QMetaType::Bool) {
+        return value.toBool() ? QStringLiteral("true") : QStringLiteral("false");
+    }
+
+    // Spelled the way String(number) does in JavaScript
+    if (value.typeId() == QMetaType::Double) {
+        const double number = value.toDouble();
+        if (std::isnan(number)) {
+            return QStringLiteral("NaN");
+        }
+        if (std::isinf(number)) {
+            return number > 0 ? QStringLiteral("Infinity") : QStringLiteral("-Infinity");
+        }
+    }
+
+    return value.toString();
+}
+
+bool ScriptIntrinsics::isTruthy(const QVariant& value)
+{
+    if (!value.isValid() || value.isNull()) {
+        return false;
+    }
+
+    switch (value.typeId()) {
+    case QMetaType::Bool:
+        return value.toBool();
+    case QMetaType::QString:
+        return !value.toString().isEmpty();
+    case QMetaType::Int:
+    case QMetaType::LongLong:
+    case QMetaType::Double: {
+        const double number = value.toDouble();
+        return number != 0.0 && !std::isnan(number);
+    }
+    default:
+        // Objects and arrays are always truthy
+        return true;
+    }
+}
+
+void ScriptIntrinsics::registerDefaultIntrinsics()
+{
+    registerIntrinsic("consolelog", [](const QVariantList& args, const QJsonObject&, const CallContext& context) {
+        if (context.log) {
+            context.log(toDisplayString(argAt(args, 0)));
+        }
+        return QVariant();
+    });
+
+    // Variables just pass through their value
+    registerIntrinsic("variable", [](const QVariantList& args, const QJsonObject&, const CallContext&) {
+        return argAt(args, 0);
+    });
+
+    registerIntrinsic("eventdata", [](const QVariantList&, const QJsonObject&, const CallContext& context) {
+        return context.eventData.value("value", QString());
+    });
+
+    registerIntrinsic("add", [](const QVariantList& args, const QJsonObject&, const CallContext&) {
+        return QVariant(numberArg(args, 0) + numberArg(args, 1));
+    });
+    registerIntrinsic("subtract", [](const QVariantList& args, const QJsonObject&, const CallContext&) {
+        return QVariant(numberArg(args, 0) - numberArg(args, 1));
+    });
+    registerIntrinsic("multiply", [](const QVariantList& args, const QJsonObject&, const CallContext&) {
+        return QVariant(numberArg(args, 0) * numberArg(args, 1));
+    });
+    registerIntrinsic("divide", [](const QVariantList& args, const QJsonObject&, const CallContext&) {
+        const double divisor = numberArg(args, 1);
+        return QVariant(divisor != 0.0 ? numberArg(args, 0) / divisor : 0.0);
+    });
+
+    const Intrinsic condition = [](const QVariantList& args, const QJsonObject&, const CallContext&) {
+        return QVariant(isTruthy(argAt(args, 0)));
+    };
+    registerIntrinsic("condition", condition);
+    registerIntrinsic("if", condition);
+
+    registerIntrinsic("convertnumbertostring", [](const QVariantList& args, const QJsonObject&, const CallContext&) {
+        return QVariant(toDisplayString(argAt(args, 0)));
+    });
+
+    // Parameters without a value are skipped; unlike the math nodes, anything
+    // that is not a number becomes 0 (Number(value) || 0)
+    registerIntrinsic("createnumberarray", [](const QVariantList& args, const QJsonObject&, const CallContext&) {
+        QVariantList array;
+        for (const QVariant& arg : args) {
+            if (arg.isValid()) {
+                const double number = toNumber(arg);
+                array.append(std::isnan(number) ? 0.0 : number);
+            }
+        }
+        return QVariant(QVariantMap{{"array", array}});
+    });
+
+    // The executor drives the iteration; this only picks out the array and
+    // reports the current item while the body runs
+    registerIntrinsic("foreachloop", [](const QVariantList& args, const QJsonObject&, const CallContext& context) {
+        QVariantList array;
+        for (const QVariant& arg : args) {
+            if (arg.typeId() == QMetaType::QVariantMap && arg.toMap().value("array").typeId() == QMetaType::QVariantList) {
+                array = arg.toMap().value("array").toList();
+            } else if (arg.typeId() == QMetaType::QVariantList) {
+                array = arg.toList();
+            }
+        }
+
+        QVariantMap result;
+        result["array"] = array;
+        result["arrayElement"] = context.inLoop ? context.loopItem : QVariant::fromValue(nullptr);
+        result["arrayIndex"] = context.inLoop ? context.loopIndex : -1;
+        return QVariant(result);
+    });
+
+    // "Set <variable> Value"; the compiler binds the variable id
+    registerIntrinsic("setvariablevalue", [](const QVariantList& args, const QJsonObject& binding, const CallContext&) {
+        const QVariant value = argAt(args, 0);
+        QVariantMap result;
+        result["variableId"] = binding.value("variableId").toString();
+        result["value"] = value.isValid() ? value : QVariant(QString());
+        return QVariant(result);
+    });
+
+    // Nodes with nothing to run
+    registerIntrinsic("noop", [](const QVariantList&, const QJsonObject&, const CallContext&) {
+        return QVariant();
+    });
+}
@@ -0,0 +1,59 @@
+#ifndef SCRIPTINTRINSICS_H
+#define SCRIPTINTRINSICS_H
+
+#include <QString>
+#include <QVariant>
+#include <QVariantList>
+#include <QVariantMap>
+#include <QJsonObject>
+#include <QHash>
+#include <functional>
+
+// Native C++ implementations of the built-in script nodes.
+//
+// The compiler binds a function to an intrinsic (see
+// ScriptFunctionRegistry::getNativeFunction) and ScriptExecutor calls it
+// directly with the resolved parameter values, so scripts built only from
+// built-in nodes run without the JavaScript engine. Each intrinsic mirrors the
+// JavaScript the registry would otherwise generate for that node.
+class ScriptIntrinsics
+{
+public:
+    // Executor state an intrinsic may read
+    struct CallContext {
+        QVariantMap eventData;
+        bool inLoop = false;
+        QVariant loopItem;
+        int loopIndex = -1;
+        std::function<void(const QString&)> log;   // Writes to the project console
+    };
+
+    // args holds one value per compiled parameter; an invalid QVariant stands
+    // for a parameter without a value (undefined in JavaScript). binding is
+    // the object the compiler stored with the function (e.g. variableId).
+    using Intrinsic = std::function<QVariant(const QVariantList& args,
+                                             const QJsonObject& binding,
+                                             const CallContext& context)>;
+
+    static const ScriptIntrinsics& instance();
+
+    bool hasIntrinsic(const QString& name) const;
+    QVariant call(const QString& name, const QVariantList& args,
+                  const QJsonObject& binding, const CallContext& context) const;
+
+    // String form of a value the way the console and variable outputs show it
+    static QString toDisplayString(const QVariant& value);
+
+    // JavaScript truthiness
+    static bool isTruthy(const QVariant& value);
+
+private:
+    ScriptIntrinsics();
+
+    void registerIntrinsic(const QString& name, Intrinsic intrinsic);
+    void registerDefaultIntrinsics();
+
+    QHash<QString, Intrinsic> m_intrinsics;
+};
+
+#endif // SCRIPTINTRINSICS_H
@@ -0,0 +1,309 @@
+#include "ScriptRuntime.h"
+#include "ScriptExecutor.h"
+#include "Scripts.h"
+#include "Project.h"
+#include "Variable.h"
+#include "ConsoleMessageRepository.h"
+#include "Config.h"
+#include <QJsonDocument>
+#include <QTimer>
+#include <QDebug>
+
+// ScriptWorker implementation
+ScriptWorker::ScriptWorker(QObject *parent)
+    : QObject(parent)
+{
+}
+
+// Runs on the worker thread, so the JS engine is destroyed where it was created
+ScriptWorker::~ScriptWorker() = default;
+
+void ScriptWorker::cancel()
+{
+    ++m_generation;
+
+    QMutexLocker locker(&m_executorMutex);
+    if (m_executor) {
+        m_executor->interrupt();
+    }
+}
+
+void ScriptWorker::interrupt(quint64 jobId)
+{
+    QMutexLocker locker(&m_executorMutex);
+    if (m_executor && m_runningJob == jobId) {
+        m_executor->interrupt();
+    }
+}
+
+void ScriptWorker::runEvent(quint64 jobId, quint64 generation, const QJsonObject& compiledScript,
+                            const QString& eventName, const QVariantMap& eventData)
+{
+    {
+        QMutexLocker locker(&m_executorMutex);
+        if (!m_executor) {
+            m_executor = std::make_unique<ScriptExecutor>();
+            // Output waiting in the batch goes out at least once per slice,
+            // even while a long loop stops producing more
+            m_executor->setTimeSlice(Config::SCRIPT_COMMAND_BATCH_INTERVAL, [this]() {
+                flushCommands();
+            });
+
+            ScriptExecutor::EffectSink sink;
+            sink.log = [this](const QString& message, bool isError) {
+                QVariantMap command;
+                command["type"] = isError ? "error" : "log";
+                command["message"] = message;
+                appendCommand(command);
+            };
+            sink.setVariable = [this](const QString& variableId, const QString& value) {
+                QVariantMap command;
+                command["type"] = "variable";
+                command["variableId"] = variableId;
+                command["value"] = value;
+                appendCommand(command);
+            };
+            m_executor->setEffectSink(sink);
+        }
+
+        // Cleared before the generation check, so a cancel() racing with the
+        // start either skips the event or interrupts it
+        m_executor->clearInterruption();
+        m_runningJob = jobId;
+    }
+
+    if (generation == m_generation) {
+        emit eventStarted(jobId);
+        m_batchTimer.start();
+        m_executor->executeCompiledEvent(compiledScript, eventName, eventData);
+        flushCommands();
+    }
+
+    m_runningJob = 0;
+    emit eventFinished(jobId);
+}
+
+void ScriptWorker::appendCommand(const QVariantMap& command)
+{
+    m_batch.append(command);
+    if (m_batchTimer.elapsed() >= Config::SCRIPT_COMMAND_BATCH_INTERVAL) {
+        flushCommands();
+    }
+}
+
+void ScriptWorker::flushCommands()
+{
+    if (!m_batch.isEmpty()) {
+        emit commandsReady(m_batch);
+        m_batch.clear();
+    }
+    m_batchTimer.restart();
+}
+
+// ScriptRuntime implementation
+ScriptRuntime::ScriptRuntime(ScriptExecutor* guiExecutor, ElementModel* elementModel, QObject *parent)
+    : QObject(parent)
+    , m_guiExecutor(guiExecutor)
+    , m_elementModel(elementModel)
+{
+    m_thread.setObjectName("ScriptRuntime");
+
+    // Commands from the worker are applied together once per frame
+    m_frameTimer = new QTimer(this);
+    m_frameTimer->setSingleShot(true);
+    m_frameTimer->setInterval(Config::SCRIPT_COMMAND_BATCH_INTERVAL);
+    connect(m_frameTimer, &QTimer::timeout, this, &ScriptRuntime::applyCommands);
+
+    m_watchdog = new QTimer(this);
+    m_watchdog->setSingleShot(true);
+    m_watchdog->setInterval(Config::SCRIPT_EVENT_TIME_LIMIT);
+    connect(m_watchdog, &QTimer::timeout, this, [this]() {
+        if (m_worker) {
+            log(QString("Script event stopped after running for %1 ms").arg(Config::SCRIPT_EVENT_TIME_LIMIT), true);
+            m_worker->interrupt(m_watchedJob);
+        }
+    });
+}
+
+ScriptRuntime::~ScriptRuntime()
+{
+    if (m_worker) {
+        m_worker->cancel();
+        m_thread.quit();
+        m_thread.wait();
+    }
+}
+
+void ScriptRuntime::ensureWorker()
+{
+    if (m_worker) {
+        return;
+    }
+
+    m_worker = new ScriptWorker();
+    m_worker->moveToThread(&m_thread);
+    connect(&m_thread, &QThread::finished, m_worker, &QObject::deleteLater);
+    connect(m_worker, &ScriptWorker::commandsReady, this, &ScriptRuntime::onCommandsReady);
+    connect(m_worker, &ScriptWorker::eventStarted, this, &ScriptRuntime::onEventStarted);
+    connect(m_worker, &ScriptWorker::eventFinished, this, &ScriptRuntime::onEventFinished);
+    m_thread.start();
+}
+
+void ScriptRuntime::setUseWorkerThread(bool enabled)
+{
+    if (m_useWorkerThread != enabled) {
+        m_useWorkerThread = enabled;
+        emit useWorkerThreadChanged();
+    }
+}
+
+void ScriptRuntime::executeEvent(Scripts* scripts, const QString& eventName, const QVariantMap& eventData)
+{
+    if (!scripts) {
+        qWarning() << "ScriptRuntime: No scripts object set";
+        return;
+    }
+
+    const QJsonObject compiledScript = parsedScript(scripts);
+    if (compiledScript.isEmpty()) {
+        return; // Compilation failed or nothing to run
+    }
+
+    // Nothing attached to this event is normal
+    const QJsonObject event = compiledScript[eventName.toLower().remove(' ')].toObject();
+    if (event.isEmpty()) {
+        return;
+    }
+
+    if (!m_useWorkerThread || hasAsyncInvokes(event)) {
+        if (m_guiExecutor) {
+            m_guiExecutor->clearInterruption();
+            m_guiExecutor->executeCompiledEvent(compiledScript, eventName, eventData);
+        }
+        return;
+    }
+
+    ensureWorker();
+
+    const quint64 jobId = m_nextJobId++;
+    const quint64 generation = m_worker->generation();
+    m_pendingJobs.insert(jobId);
+    if (m_pendingJobs.size() == 1) {
+        emit runningChanged();
+    }
+
+    ScriptWorker* worker = m_worker;
+    QMetaObject::invokeMethod(worker, [worker, jobId, generation, compiledScript, eventName, eventData]() {
+        worker->runEvent(jobId, generation, compiledScript, eventName, eventData);
+    }, Qt::QueuedConnection);
+}
+
+void ScriptRuntime::cancel()
+{
+    if (m_worker) {
+        m_worker->cancel();
+    }
+    if (m_guiExecutor) {
+        m_guiExecutor->interrupt();
+    }
+}
+
+QJsonObject ScriptRuntime::parsedScript(Scripts* scripts)
+{
+    if (!scripts->isCompiled()) {
+        Project* project = qobject_cast<Project*>(parent());
+        if (scripts->compile(m_elementModel, project ? project->console() : nullptr).isEmpty()) {
+            return QJsonObject();
+        }
+    }
+
+    // Parsing is the expensive part; only redo it when the compiled script changed
+    const QString source = scripts->compiledScript();
+    if (scripts != m_parsedScripts || source != m_parsedSource) {
+        QJsonDocument doc = QJsonDocument::fromJson(source.toUtf8());
+        if (!doc.isObject()) {
+            qWarning() << "ScriptRuntime: Invalid compiled script format";
+            return QJsonObject();
+        }
+        m_parsedScripts = scripts;
+        m_parsedSource = source;
+        m_parsedScript = doc.object();
+    }
+
+    return m_parsedScript;
+}
+
+bool ScriptRuntime::hasAsyncInvokes(const QJsonObject& event)
+{
+    const QJsonObject invokes = event["invoke"].toObject();
+    for (auto it = invokes.constBegin(); it != invokes.constEnd(); ++it) {
+        if (it.value().toObject()["isAsync"].toBool()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ScriptRuntime::onCommandsReady(const QVariantList& commands)
+{
+    m_pendingCommands.append(commands);
+    if (!m_frameTimer->isActive()) {
+        m_frameTimer->start();
+    }
+}
+
+void ScriptRuntime::onEventStarted(quint64 jobId)
+{
+    m_watchedJob = jobId;
+    if (Config::SCRIPT_EVENT_TIME_LIMIT > 0) {
+        m_watchdog->start();
+    }
+}
+
+void ScriptRuntime::onEventFinished(quint64 jobId)
+{
+    if (m_watchedJob == jobId) {
+        m_watchdog->stop();
+    }
+    if (m_pendingJobs.remove(jobId) && m_pendingJobs.isEmpty()) {
+        emit runningChanged();
+    }
+}
+
+void ScriptRuntime::applyCommands()
+{
+    const QVariantList commands = std::move(m_pendingCommands);
+    m_pendingCommands.clear();
+
+    for (const QVariant& entry : commands) {
+        const QVariantMap command = entry.toMap();
+        const QString type = command.value("type").toString();
+
+        if (type == "log") {
+            log(command.value("message").toString(), false);
+        } else if (type == "error") {
+            log(command.value("message").toString(), true);
+        } else if (type == "variable") {
+            const QString value = command.value("value").toString();
+            Variable* variable = ScriptExecutor::setVariableValue(
+                m_elementModel, command.value("variableId").toString(), value);
+            if (variable) {
+                log(QString("Variable '%1' updated to: %2").arg(variable->getName()).arg(value), false);
+            }
+        }
+    }
+}
+
+void ScriptRuntime::log(const QString& message, bool isError)
+{
+    Project* project = qobject_cast<Project*>(parent());
+    if (!project || !project->console()) {
+        return;
+    }
+
+    if (isError) {
+        project->console()->addError(message);
+    } else {
+        project->console()->addOutput(message);
+    }
+}
@@ -0,0 +1,136 @@
+#ifndef SCRIPTRUNTIME_H
+#define SCRIPTRUNTIME_H
+
+#include <QObject>
+#include <QJsonObject>
+#include <QVariantList>
+#include <QVariantMap>
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QSet>
+#include <QThread>
+#include <atomic>
+#include <memory>
+
+class Scripts;
+class ScriptExecutor;
+class ElementModel;
+class QTimer;
+
+// Runs events on the worker thread for ScriptRuntime. Console output and
+// variable writes are collected as commands and sent back in batches of at
+// most one frame's worth, instead of touching GUI thread objects.
+class ScriptWorker : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ScriptWorker(QObject *parent = nullptr);
+    ~ScriptWorker();
+
+    // Drop queued events and stop the running one. Safe to call from any thread.
+    void cancel();
+
+    // Stop the given event if it is still the one running. Safe to call from any thread.
+    void interrupt(quint64 jobId);
+
+    quint64 generation() const { return m_generation; }
+
+public slots:
+    // Events posted before the last cancel() carry an older generation and are skipped
+    void runEvent(quint64 jobId, quint64 generation, const QJsonObject& compiledScript,
+                  const QString& eventName, const QVariantMap& eventData);
+
+signals:
+    void eventStarted(quint64 jobId);
+    void eventFinished(quint64 jobId);
+
+    // Each command is a map with "type" ("log", "error" or "variable") and
+    // "message", or "variableId" and "value"
+    void commandsReady(const QVariantList& commands);
+
+private:
+    void appendCommand(const QVariantMap& command);
+    void flushCommands();
+
+    std::unique_ptr<ScriptExecutor> m_executor;   // Created on the worker thread
+    QMutex m_executorMutex;                       // Guards m_executor against cancel()
+    std::atomic<quint64> m_generation{0};
+    std::atomic<quint64> m_runningJob{0};
+    QVariantList m_batch;
+    QElapsedTimer m_batchTimer;
+};
+
+// ScriptRuntime runs a project's script events on a dedicated worker thread so
+// a heavy ForEach loop or a long synchronous script does not freeze the canvas.
+//
+// Scripts are compiled on the GUI thread, where the graph lives; the worker
+// only gets the compiled script and the event data, which it never shares
+// with the GUI. Its console output and variable writes come back as batched
+// commands that are applied once per frame. Events that wait on async nodes
+// (AI prompts) run on the GUI thread executor instead, since the services
+// they call live there.
+//
+// Worker events run to completion unless cancelled. While one runs, its
+// output is flushed at least once per frame. Setting
+// Config::SCRIPT_EVENT_TIME_LIMIT arms a watchdog that stops worker events
+// running longer than that.
+class ScriptRuntime : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(bool useWorkerThread READ useWorkerThread WRITE setUseWorkerThread NOTIFY useWorkerThreadChanged)
+    Q_PROPERTY(bool running READ running NOTIFY runningChanged)
+
+public:
+    // guiExecutor runs the events that have to stay on the GUI thread; its
+    // parent is the project whose console receives output
+    ScriptRuntime(ScriptExecutor* guiExecutor, ElementModel* elementModel, QObject *parent = nullptr);
+    ~ScriptRuntime();
+
+    // Compile if needed and run the event
+    void executeEvent(Scripts* scripts, const QString& eventName, const QVariantMap& eventData = QVariantMap());
+
+    // Stop the running event and drop the queued ones
+    Q_INVOKABLE void cancel();
+
+    bool useWorkerThread() const { return m_useWorkerThread; }
+    void setUseWorkerThread(bool enabled);
+    bool running() const { return !m_pendingJobs.isEmpty(); }
+
+signals:
+    void useWorkerThreadChanged();
+    void runningChanged();
+
+private slots:
+    void onCommandsReady(const QVariantList& commands);
+    void onEventStarted(quint64 jobId);
+    void onEventFinished(quint64 jobId);
+    void applyCommands();
+
+private:
+    void ensureWorker();
+    QJsonObject parsedScript(Scripts* scripts);
+    static bool hasAsyncInvokes(const QJsonObject& event);
+    void log(const QString& message, bool isError);
+
+    ScriptExecutor* m_guiExecutor;
+    ElementModel* m_elementModel;
+    bool m_useWorkerThread = true;
+
+    QThread m_thread;
+    ScriptWorker* m_worker = nullptr;   // Lives on m_thread
+    quint64 m_nextJobId = 1;
+    QSet<quint64> m_pendingJobs;
+
+    // Last parsed compiled script, reused until the scripts recompile
+    Scripts* m_parsedScripts = nullptr;
+    QString m_parsedSource;
+    QJsonObject m_parsedScript;
+
+    QVariantList m_pendingCommands;
+    QTimer* m_frameTimer;
+    QTimer* m_watchdog;
+    quint64 m_watchedJob = 0;
+};
+
+#endif // SCRIPTRUNTIME_H
@@ -3,6 +3,7 @@
 #include "Scripts.h"
 #include "Node.h"
 #include <QSet>
+#include <QCryptographicHash>
 
 ScriptSerializer::ScriptSerializer()
     : m_functionRegistry(nullptr)
@@ -21,37 +22,53 @@ QJsonDocument ScriptSerializer::serialize(const QMap<QString, ScriptInvokeBuilde
     
     // Serialize each event
     for (auto it = eventContexts.constBegin(); it != eventContexts.constEnd(); ++it) {
-        const QString& eventName = it.key();
-        const ScriptInvokeBuilder::BuildContext& context = it.value();
-        
-        // Get the initial invokes for this event (excluding param nodes)
-        QList<QString> initialInvokes;
-        for (const auto& invoke : context.invokes) {
-            // Skip param invokes - they don't execute in the chain
-            if (invoke.isParam) {
-                continue;
-            }
-            
-            bool isInitial = true;
-            // Check if this invoke is referenced by any other invoke
-            for (const auto& other : context.invokes) {
-                if (other.invokeId != invoke.invokeId && 
-                    (other.nextInvokes.contains(invoke.invokeId) ||
-                     other.loopBodyInvoke == invoke.invokeId ||
-                     other.loopCompleteInvoke == invoke.invokeId)) {
-                    isInitial = false;
-                    break;
-                }
-            }
-            if (isInitial) {
-                initialInvokes.append(invoke.invokeId);
+        root[it.key()] = serializeEvent(it.value(), scripts);
+    }
+    
+    return QJsonDocument(root);
+}
+
+QJsonObject ScriptSerializer::serializeEvent(const ScriptInvokeBuilder::BuildContext& context,
+                                            Scripts* scripts)
+{
+    // Get the initial invokes for this event (excluding param nodes)
+    QSet<QString> referenced;
+    for (const auto& invoke : context.invokes) {
+        for (const QString& nextId : invoke.nextInvokes) {
+            if (nextId != invoke.invokeId) {
+                referenced.insert(nextId);
             }
         }
-        
-        root[eventName] = serializeEventContext(context, initialInvokes, scripts);
+        if (invoke.loopBodyInvoke != invoke.invokeId) {
+            referenced.insert(invoke.loopBodyInvoke);
+        }
+        if (invoke.loopCompleteInvoke != invoke.invokeId) {
+            referenced.insert(invoke.loopCompleteInvoke);
+        }
     }
     
-    return QJsonDocument(root);
+    QList<QString> initialInvokes;
+    for (const auto& invoke : context.invokes) {
+        // Skip param invokes - they don't execute in the chain, and anything
+        // another invoke leads to
+        if (!invoke.isParam && !referenced.contains(invoke.invokeId)) {
+            initialInvokes.append(invoke.invokeId);
+        }
+    }
+    
+    return serializeEventContext(context, initialInvokes, scripts);
+}
+
+QByteArray ScriptSerializer::functionKey(Node* node)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    for (const QString& part : {node->nodeTitle(), node->script(), node->sourceElementId()}) {
+        const QByteArray bytes = part.toUtf8();
+        const qint64 size = bytes.size();
+        hash.addData(QByteArrayView(reinterpret_cast<const char*>(&size), sizeof(size)));
+        hash.addData(bytes);
+    }
+    return hash.result();
 }
 
 QJsonObject ScriptSerializer::serializeEventContext(const ScriptInvokeBuilder::BuildContext& context,
@@ -62,6 +79,7 @@ QJsonObject ScriptSerializer::serializeEventContext(const ScriptInvokeBuilder::B
     
     // Functions
     event["functions"] = serializeFunctions(context, scripts);
+    event["natives"] = serializeNatives(context);
     
     // Outputs
     event["outputs"] = serializeOutputs(context);
@@ -187,27 +205,65 @@ QJsonObject ScriptSerializer::serializeFunctions(const ScriptInvokeBuilder::Buil
     // Generate function code for each unique function
     for (const QString& functionName : functionNames) {
         // Find a node that uses this function to get its type
-        Node* sampleNode = nullptr;
-        for (const auto& invoke : context.invokes) {
-            if (invoke.functionName == functionName) {
-                // Use nodeReferences to find the node
-                auto nodeRefIt = context.nodeReferences.find(invoke.nodeId);
-                if (nodeRefIt != context.nodeReferences.end()) {
-                    sampleNode = nodeRefIt->node;
-                    break;
-                }
-            }
-        }
+        Node* sampleNode = sampleNodeForFunction(context, functionName);
         
         if (sampleNode) {
-            QString functionCode = m_functionRegistry->getFunctionCode(sampleNode);
-            functions[functionName] = functionCode;
+            const QByteArray key = functionKey(sampleNode);
+            auto cached = m_functionCodeCache.constFind(key);
+            if (cached == m_functionCodeCache.constEnd()) {
+                cached = m_functionCodeCache.insert(key, m_functionRegistry->getFunctionCode(sampleNode));
+            }
+            functions[functionName] = cached.value();
         }
     }
     
     return functions;
 }
 
+QJsonObject ScriptSerializer::serializeNatives(const ScriptInvokeBuilder::BuildContext& context)
+{
+    QJsonObject natives;
+    
+    if (!m_functionRegistry) {
+        return natives;
+    }
+    
+    // The JavaScript in "functions" is still emitted for these as a fallback
+    QSet<QString> functionNames = getUniqueFunctionNames(context);
+    for (const QString& functionName : functionNames) {
+        Node* sampleNode = sampleNodeForFunction(context, functionName);
+        if (!sampleNode) {
+            continue;
+        }
+        
+        const QByteArray key = functionKey(sampleNode);
+        auto cached = m_nativeCache.constFind(key);
+        if (cached == m_nativeCache.constEnd()) {
+            cached = m_nativeCache.insert(key, m_functionRegistry->getNativeFunction(sampleNode));
+        }
+        if (!cached.value().isEmpty()) {
+            natives[functionName] = cached.value();
+        }
+    }
+    
+    return natives;
+}
+
+Node* ScriptSerializer::sampleNodeForFunction(const ScriptInvokeBuilder::BuildContext& context,
+                                              const QString& functionName) const
+{
+    for (const auto& invoke : context.invokes) {
+        if (invoke.functionName == functionName) {
+            // Use nodeReferences to find the node
+            auto nodeRefIt = context.nodeReferences.find(invoke.nodeId);
+            if (nodeRefIt != context.nodeReferences.end()) {
+                return nodeRefIt->node;
+            }
+        }
+    }
+    return nullptr;
+}
+
 QSet<QString> ScriptSerializer::getUniqueFunctionNames(const ScriptInvokeBuilder::BuildContext& context)
 {
     QSet<QString> functionNames;
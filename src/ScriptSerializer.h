@@ -5,6 +5,8 @@
 #include <QJsonObject>
 #include <QJsonArray>
 #include <QMap>
+#include <QHash>
+#include <QByteArray>
 #include "ScriptInvokeBuilder.h"
 
 class Scripts;
@@ -23,6 +25,9 @@ public:
     QJsonDocument serialize(const QMap<QString, ScriptInvokeBuilder::BuildContext>& eventContexts,
                            Scripts* scripts);
     
+    // Serialize one event's build context into its compiled event object
+    QJsonObject serializeEvent(const ScriptInvokeBuilder::BuildContext& context, Scripts* scripts);
+    
 private:
     // Serialize a single event's context
     QJsonObject serializeEventContext(const ScriptInvokeBuilder::BuildContext& context,
@@ -39,10 +44,26 @@ private:
     QJsonObject serializeFunctions(const ScriptInvokeBuilder::BuildContext& context,
                                   Scripts* scripts);
     
+    // Serialize native bindings for functions that run without the JS engine
+    QJsonObject serializeNatives(const ScriptInvokeBuilder::BuildContext& context);
+    
+    // Find a node that uses the given function
+    Node* sampleNodeForFunction(const ScriptInvokeBuilder::BuildContext& context,
+                                const QString& functionName) const;
+    
     // Get unique function names from context
     QSet<QString> getUniqueFunctionNames(const ScriptInvokeBuilder::BuildContext& context);
     
+    // Key for the function caches: a hash of everything the registry reads
+    // from a node to generate its function
+    static QByteArray functionKey(Node* node);
+    
     ScriptFunctionRegistry* m_functionRegistry;
+    
+    // Generated code and native bindings by functionKey, so unchanged nodes
+    // are not regenerated on every compile
+    QHash<QByteArray, QString> m_functionCodeCache;
+    QHash<QByteArray, QJsonObject> m_nativeCache;
 };
 
 #endif // SCRIPTSERIALIZER_H
\ No newline at end of file
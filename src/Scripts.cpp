@@ -30,11 +30,10 @@ void Scripts::addNode(Node* node) {
     
     if (it == m_nodes.end()) {
         m_nodes.push_back(node);
+        trackNode(node);
         
         // Reset compiled state when graph changes
-        if (m_isCompiled) {
-            setIsCompiled(false);
-        }
+        markNodeDirty(node->getId());
         
         emit nodeAdded(node);
         emit nodesChanged();
@@ -82,11 +81,10 @@ void Scripts::removeNode(Node* node) {
         // qDebug() << "Scripts::removeNode - Erasing node from m_nodes";
         // Now erase the node from the vector
         m_nodes.erase(it);
+        disconnect(node, nullptr, this, nullptr);
         
         // Reset compiled state when graph changes
-        if (m_isCompiled) {
-            setIsCompiled(false);
-        }
+        markNodeDirty(nodeId);
         
         // qDebug() << "Scripts::removeNode - Emitting nodesChanged signal";
         emit nodesChanged();
@@ -98,7 +96,13 @@ void Scripts::removeNode(Node* node) {
 
 void Scripts::clearNodes() {
     if (!m_nodes.empty()) {
+        for (Node* node : m_nodes) {
+            if (node) {
+                disconnect(node, nullptr, this, nullptr);
+            }
+        }
         m_nodes.clear();
+        markAllDirty();
         emit nodesChanged();
     }
 }
@@ -146,8 +150,9 @@ void Scripts::fixNodeTypes() {
     }
     
     if (anyFixed) {
-        // Mark as not compiled to force recompilation
-        setIsCompiled(false);
+        // Mark as not compiled to force recompilation; node types have no
+        // change signal, so the next compile starts from scratch
+        markAllDirty();
         qDebug() << "Node types fixed - marked for recompilation";
     }
 }
@@ -161,11 +166,10 @@ void Scripts::addEdge(Edge* edge) {
     
     if (it == m_edges.end()) {
         m_edges.push_back(edge);
+        trackEdge(edge);
         
         // Reset compiled state when graph changes
-        if (m_isCompiled) {
-            setIsCompiled(false);
-        }
+        markEdgeDirty(edge);
         
         emit edgeAdded(edge);
         emit edgesChanged();
@@ -190,11 +194,10 @@ void Scripts::removeEdge(Edge* edge) {
         // qDebug() << "Scripts::removeEdge - Erasing edge from m_edges";
         // Now erase the edge from the vector
         m_edges.erase(it);
+        disconnect(edge, nullptr, this, nullptr);
         
         // Reset compiled state when graph changes
-        if (m_isCompiled) {
-            setIsCompiled(false);
-        }
+        markEdgeDirty(edge);
         
         // qDebug() << "Scripts::removeEdge - Emitting edgesChanged signal";
         emit edgesChanged();
@@ -206,7 +209,13 @@ void Scripts::removeEdge(Edge* edge) {
 
 void Scripts::clearEdges() {
     if (!m_edges.empty()) {
+        for (Edge* edge : m_edges) {
+            if (edge) {
+                disconnect(edge, nullptr, this, nullptr);
+            }
+        }
         m_edges.clear();
+        markAllDirty();
         emit edgesChanged();
     }
 }
@@ -274,11 +283,17 @@ QString Scripts::compile(ElementModel* elementModel, QObject* console) {
     // Fix node types before compilation
     fixNodeTypes();
     
-    ScriptCompiler compiler;
-    QString result = compiler.compile(this, elementModel);
+    if (!m_compiler) {
+        m_compiler = std::make_unique<ScriptCompiler>();
+    }
+    
+    // Rebuild only the events touched since the last successful compile
+    QString result = m_needsFullCompile
+        ? m_compiler->compile(this, elementModel)
+        : m_compiler->compileChanged(this, m_dirtyNodeIds, elementModel);
     
     if (result.isEmpty()) {
-        QString error = compiler.getLastError();
+        QString error = m_compiler->getLastError();
         if (console) {
             QMetaObject::invokeMethod(console, "addError", Q_ARG(QString, "Compilation failed: " + error));
         }
@@ -287,6 +302,9 @@ QString Scripts::compile(ElementModel* elementModel, QObject* console) {
         return QString();
     }
     
+    m_dirtyNodeIds.clear();
+    m_needsFullCompile = false;
+    
     // Store the compiled script
     m_compiledScript = result;
     setIsCompiled(true);
@@ -300,6 +318,56 @@ QString Scripts::compile(ElementModel* elementModel, QObject* console) {
     return result;
 }
 
+// Change tracking
+void Scripts::trackNode(Node* node) {
+    // Everything the compiler reads from a node; geometry and execution state are not
+    const auto compileSignals = {
+        &Node::nodeTitleChanged, &Node::inputPortsChanged, &Node::outputPortsChanged,
+        &Node::rowConfigurationsChanged, &Node::valueChanged, &Node::sourceElementIdChanged,
+        &Node::isAsyncChanged, &Node::scriptChanged
+    };
+    for (auto signal : compileSignals) {
+        connect(node, signal, this, [this, node]() {
+            markNodeDirty(node->getId());
+        });
+    }
+}
+
+void Scripts::trackEdge(Edge* edge) {
+    const auto portSignals = {
+        &Edge::sourcePortIndexChanged, &Edge::targetPortIndexChanged,
+        &Edge::sourcePortTypeChanged, &Edge::targetPortTypeChanged
+    };
+    for (auto signal : portSignals) {
+        connect(edge, signal, this, [this, edge]() {
+            markEdgeDirty(edge);
+        });
+    }
+    
+    // The previous endpoint is no longer known when these fire
+    connect(edge, &Edge::sourceNodeIdChanged, this, &Scripts::markAllDirty);
+    connect(edge, &Edge::targetNodeIdChanged, this, &Scripts::markAllDirty);
+}
+
+void Scripts::markNodeDirty(const QString& nodeId) {
+    m_dirtyNodeIds.insert(nodeId);
+    if (m_isCompiled) {
+        setIsCompiled(false);
+    }
+}
+
+void Scripts::markEdgeDirty(Edge* edge) {
+    m_dirtyNodeIds.insert(edge->sourceNodeId());
+    markNodeDirty(edge->targetNodeId());
+}
+
+void Scripts::markAllDirty() {
+    m_needsFullCompile = true;
+    if (m_isCompiled) {
+        setIsCompiled(false);
+    }
+}
+
 // Property getters
 QQmlListProperty<Node> Scripts::nodes() {
     return QQmlListProperty<Node>(this, nullptr,
@@ -333,6 +401,18 @@ QString Scripts::compiledScript() const {
     return m_compiledScript;
 }
 
+MemoryUsage Scripts::compiledMemoryUsage() const {
+    MemoryUsage usage;
+    if (!m_compiledScript.isEmpty()) {
+        usage.objects = 1;
+        usage.bytes = MemoryEstimate::of(m_compiledScript);
+    }
+    if (m_compiler) {
+        usage += m_compiler->cacheMemoryUsage();
+    }
+    return usage;
+}
+
 // Property setters
 void Scripts::setIsCompiled(bool compiled) {
     if (m_isCompiled != compiled) {
@@ -4,12 +4,15 @@
 #include <QObject>
 #include <QQmlEngine>
 #include <QQmlListProperty>
+#include <QSet>
 #include <vector>
 #include <memory>
+#include "MemoryUsage.h"
 
 class Node;
 class Edge;
 class ElementModel;
+class ScriptCompiler;
 
 class Scripts : public QObject {
     Q_OBJECT
@@ -51,6 +54,9 @@ public:
     
     // Compile the script graph to JSON
     Q_INVOKABLE QString compile(ElementModel* elementModel = nullptr, QObject* console = nullptr);
+    
+    // Estimated footprint of the compiled script and the compiler's event cache
+    MemoryUsage compiledMemoryUsage() const;
 
     // Property getters
     QQmlListProperty<Node> nodes();
@@ -80,6 +86,18 @@ private:
     bool m_isCompiled = false;
     QString m_compiledScript;
     
+    // Change tracking for incremental compiles: nodes edited, added or removed
+    // (or with edges that were) since the last successful compile
+    std::unique_ptr<ScriptCompiler> m_compiler;
+    QSet<QString> m_dirtyNodeIds;
+    bool m_needsFullCompile = true;
+    
+    void trackNode(Node* node);
+    void trackEdge(Edge* edge);
+    void markNodeDirty(const QString& nodeId);
+    void markEdgeDirty(Edge* edge);
+    void markAllDirty();
+    
     // Initialize default nodes
     void loadInitialNodes();
     void loadComponentInstanceNodes();
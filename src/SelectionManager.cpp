@@ -7,10 +7,17 @@
 #include "Project.h"
 #include <limits>
 #include <QDebug>
+#include <QTimer>
 
 SelectionManager::SelectionManager(QObject *parent)
     : QObject(parent)
 {
+    // Zero-interval single shot: all geometry changes made while handling one
+    // event (e.g. a drag move over many elements) are folded into one update
+    m_geometryFlushTimer = new QTimer(this);
+    m_geometryFlushTimer->setSingleShot(true);
+    m_geometryFlushTimer->setInterval(0);
+    connect(m_geometryFlushTimer, &QTimer::timeout, this, &SelectionManager::flushGeometryChanges);
 }
 
 bool SelectionManager::isSelected(Element *element) const
@@ -80,6 +87,8 @@ void SelectionManager::selectOnly(Element *element)
         updateElementSelection(e, false);
     }
     m_selectedElements.clear();
+    m_trackedRects.clear();
+    m_dirtyElements.clear();
     
     // Select only this element
     m_selectedElements.insert(element);  // O(1) with QSet
@@ -157,6 +166,8 @@ void SelectionManager::clearSelection()
     }
     
     m_selectedElements.clear();
+    m_trackedRects.clear();
+    m_dirtyElements.clear();
     
     // Reset bounding box
     m_boundingX = 0;
@@ -184,6 +195,7 @@ void SelectionManager::updateElementSelection(Element *element, bool selected)
             // Connect to geometry changes when selected - single connection with UniqueConnection flag
             CanvasElement* canvasElement = qobject_cast<CanvasElement*>(element);
             if (canvasElement) {
+                m_trackedRects.insert(canvasElement, canvasElement->rect());
                 connect(canvasElement, &CanvasElement::geometryChanged, 
                         this, &SelectionManager::onElementGeometryChanged,
                         Qt::UniqueConnection);
@@ -192,6 +204,8 @@ void SelectionManager::updateElementSelection(Element *element, bool selected)
             // Disconnect when deselected
             CanvasElement* canvasElement = qobject_cast<CanvasElement*>(element);
             if (canvasElement) {
+                m_trackedRects.remove(canvasElement);
+                m_dirtyElements.remove(canvasElement);
                 disconnect(canvasElement, &CanvasElement::geometryChanged, 
                            this, &SelectionManager::onElementGeometryChanged);
             }
@@ -258,15 +272,24 @@ void SelectionManager::recalculateBoundingBox()
     qreal maxX = std::numeric_limits<qreal>::lowest();
     qreal maxY = std::numeric_limits<qreal>::lowest();
     
-    for (Element *element : m_selectedElements) {
-        CanvasElement* canvasElement = qobject_cast<CanvasElement*>(element);
-        if (!canvasElement) continue;
-        if (canvasElement) {
-            minX = qMin(minX, canvasElement->x());
-            minY = qMin(minY, canvasElement->y());
-            maxX = qMax(maxX, canvasElement->x() + canvasElement->width());
-            maxY = qMax(maxY, canvasElement->y() + canvasElement->height());
-        }
+    // A full pass brings every tracked rect up to date
+    for (auto it = m_trackedRects.begin(); it != m_trackedRects.end(); ++it) {
+        const QRectF& bounds = it.key()->cachedBounds();
+        it.value() = bounds;
+        minX = qMin(minX, bounds.left());
+        minY = qMin(minY, bounds.top());
+        maxX = qMax(maxX, bounds.right());
+        maxY = qMax(maxY, bounds.bottom());
+    }
+    m_dirtyElements.clear();
+    
+    if (m_trackedRects.isEmpty()) {
+        // Only non-visual elements are selected
+        m_boundingX = 0;
+        m_boundingY = 0;
+        m_boundingWidth = 0;
+        m_boundingHeight = 0;
+        return;
     }
     
     m_boundingX = minX;
@@ -277,8 +300,92 @@ void SelectionManager::recalculateBoundingBox()
 
 void SelectionManager::onElementGeometryChanged()
 {
-    // When selected elements move/resize, we need to recalculate
-    recalculateBoundingBox();
+    CanvasElement* canvasElement = static_cast<CanvasElement*>(sender());
+    if (!canvasElement || !m_trackedRects.contains(canvasElement)) return;
+    
+    // Defer the bounds update so a drag over k elements costs O(k), not O(k^2)
+    m_dirtyElements.insert(canvasElement);
+    if (!m_geometryFlushTimer->isActive()) {
+        m_geometryFlushTimer->start();
+    }
+}
+
+void SelectionManager::flushGeometryChanges()
+{
+    if (m_dirtyElements.isEmpty()) return;
+    
+    // Fast path: every selected element moved by the same delta without resizing
+    bool pureTranslation = m_dirtyElements.size() == m_trackedRects.size();
+    QPointF delta;
+    bool firstElement = true;
+    if (pureTranslation) {
+        for (CanvasElement* element : m_dirtyElements) {
+            const QRectF& oldRect = m_trackedRects[element];
+            const QRectF& newRect = element->cachedBounds();
+            if (oldRect.size() != newRect.size()) {
+                pureTranslation = false;
+                break;
+            }
+            QPointF elementDelta = newRect.topLeft() - oldRect.topLeft();
+            if (firstElement) {
+                delta = elementDelta;
+                firstElement = false;
+            } else if (elementDelta != delta) {
+                pureTranslation = false;
+                break;
+            }
+        }
+    }
+    
+    if (pureTranslation) {
+        for (CanvasElement* element : m_dirtyElements) {
+            m_trackedRects[element] = element->cachedBounds();
+        }
+        m_dirtyElements.clear();
+        m_boundingX += delta.x();
+        m_boundingY += delta.y();
+        emit selectionChanged();
+        return;
+    }
+    
+    // General case: grow the box with the new rects. Only an element that sat on
+    // an edge of the box and moved inward from it can shrink the box, which
+    // requires a full recompute.
+    qreal left = m_boundingX;
+    qreal top = m_boundingY;
+    qreal right = m_boundingX + m_boundingWidth;
+    qreal bottom = m_boundingY + m_boundingHeight;
+    bool extremeShrunk = false;
+    
+    for (CanvasElement* element : m_dirtyElements) {
+        QRectF& trackedRect = m_trackedRects[element];
+        const QRectF& newRect = element->cachedBounds();
+        
+        if ((trackedRect.left() <= m_boundingX && newRect.left() > trackedRect.left()) ||
+            (trackedRect.top() <= m_boundingY && newRect.top() > trackedRect.top()) ||
+            (trackedRect.right() >= m_boundingX + m_boundingWidth && newRect.right() < trackedRect.right()) ||
+            (trackedRect.bottom() >= m_boundingY + m_boundingHeight && newRect.bottom() < trackedRect.bottom())) {
+            extremeShrunk = true;
+            break;
+        }
+        
+        trackedRect = newRect;
+        left = qMin(left, newRect.left());
+        top = qMin(top, newRect.top());
+        right = qMax(right, newRect.right());
+        bottom = qMax(bottom, newRect.bottom());
+    }
+    
+    if (extremeShrunk) {
+        recalculateBoundingBox();
+    } else {
+        m_dirtyElements.clear();
+        m_boundingX = left;
+        m_boundingY = top;
+        m_boundingWidth = right - left;
+        m_boundingHeight = bottom - top;
+    }
+    
     emit selectionChanged();
 }
 
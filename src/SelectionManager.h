@@ -2,9 +2,14 @@
 #include <QObject>
 #include <QList>
 #include <QSet>
+#include <QHash>
+#include <QRectF>
 #include <vector>
 #include "Element.h"
 
+class CanvasElement;
+class QTimer;
+
 class SelectionManager : public QObject {
     Q_OBJECT
     Q_PROPERTY(bool hasSelection READ hasSelection NOTIFY selectionChanged)
@@ -43,6 +48,7 @@ public slots:
     
 private slots:
     void onElementGeometryChanged();
+    void flushGeometryChanges();
     
 signals:
     void selectionChanged();
@@ -56,6 +62,13 @@ private:
     qreal m_boundingWidth = 0;
     qreal m_boundingHeight = 0;
     
+    // Incremental bounds tracking: the rect each selected element had when the
+    // bounding box last accounted for it, and the elements that moved since then.
+    // Geometry changes are coalesced and applied once per event loop pass.
+    QHash<CanvasElement*, QRectF> m_trackedRects;
+    QSet<CanvasElement*> m_dirtyElements;
+    QTimer* m_geometryFlushTimer;
+    
     void updateElementSelection(Element *element, bool selected);
     void recalculateBoundingBox();
     void expandBoundingBox(Element *element);
@@ -19,9 +19,13 @@
 #include "PlatformConfig.h"
 #include "ElementTypeRegistry.h"
 #include "ConsoleMessageRepository.h"
+#include "GoogleFonts.h"
 #include "CanvasController.h"
+#include "PerformanceTrace.h"
 #include "HitTestService.h"
 #include "VariableBinding.h"
+#include "Config.h"
+#include "ParallelFor.h"
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
@@ -31,6 +35,422 @@
 #include <QDebug>
 #include <QFont>
 #include <QColor>
+#include <vector>
+
+namespace {
+
+// An element decoded from JSON into plain values, ready to be applied to a
+// new element on the GUI thread
+struct ElementRecord {
+    QString elementId;
+    QString elementType;
+    QString name;
+    QString parentId;
+    
+    // Shape only; applied before the other properties
+    bool hasShapeType = false;
+    QString shapeType;
+    bool hasJoints = false;
+    QVariantList joints;
+    
+    // Meta property index and value, in meta-object order
+    const QMetaObject* propertiesMetaObject = nullptr;
+    QList<QPair<int, QVariant>> properties;
+    QJsonObject data;   // Only kept when the type's class was not known while decoding
+    
+    bool hasComponentElements = false;
+    QStringList componentElementIds;
+    QList<QPair<QString, QVariant>> registryProperties;
+};
+
+// Older files store some strings as arrays of one-character strings
+QString stringFromJsonValue(const QJsonValue& value) {
+    if (value.isString()) {
+        return value.toString();
+    } else if (value.isArray()) {
+        const QJsonArray arr = value.toArray();
+        QString result;
+        for (const QJsonValue& val : arr) {
+            result += val.toString();
+        }
+        return result;
+    }
+    return QString();
+}
+
+// Class a serialized element type is created as, or null when unknown
+const QMetaObject* metaObjectForElementType(const QString& elementType) {
+    if (const QMetaObject* metaObject = ElementTypeRegistry::instance().metaObjectForType(elementType.toLower())) {
+        return metaObject;
+    }
+    if (elementType == "Variable") return &Variable::staticMetaObject;
+    if (elementType == "Node") return &Node::staticMetaObject;
+    if (elementType == "Edge") return &Edge::staticMetaObject;
+    if (elementType == "ComponentElement") return &ComponentElement::staticMetaObject;
+    return nullptr;
+}
+
+// Convert a serialized property to the value written to the meta property;
+// an invalid QVariant means the value is not restored
+QVariant decodePropertyValue(const QMetaProperty& property, const QString& propNameStr, const QJsonValue& jsonValue) {
+    QVariant value;
+    
+    // Convert JSON value to appropriate QVariant type
+    if (jsonValue.isString()) {
+        QString stringValue = jsonValue.toString();
+        
+        // Try to convert numeric strings to proper types
+        bool isNumber;
+        double numberValue = stringValue.toDouble(&isNumber);
+        if (isNumber && (property.metaType().id() == QMetaType::Double || 
+                        property.metaType().id() == QMetaType::Float ||
+                        property.metaType().id() == QMetaType::Int)) {
+            if (property.metaType().id() == QMetaType::Int) {
+                value = QVariant(static_cast<int>(numberValue));
+            } else {
+                value = QVariant(numberValue);
+            }
+        } else if (stringValue == "true" || stringValue == "false") {
+            // Convert boolean strings
+            value = QVariant(stringValue == "true");
+        } else {
+            value = stringValue;
+        }
+    } else if (jsonValue.isDouble()) {
+        value = jsonValue.toDouble();
+    } else if (jsonValue.isBool()) {
+        value = jsonValue.toBool();
+    } else if (jsonValue.isObject()) {
+        // Handle complex types like fonts
+        QJsonObject obj = jsonValue.toObject();
+        if (obj.contains("family")) {
+            // It's a font
+            QFont font;
+            font.setFamily(obj["family"].toString());
+            font.setPointSize(obj["pointSize"].toInt());
+            font.setBold(obj["bold"].toBool());
+            font.setItalic(obj["italic"].toBool());
+            font.setWeight(QFont::Weight(obj["weight"].toInt()));
+            value = font;
+        }
+    } else if (jsonValue.isArray()) {
+        QJsonArray array = jsonValue.toArray();
+        
+        // Check if property expects QVariantList (like joints)
+        if (property.metaType().id() == QMetaType::QVariantList) {
+            QVariantList list;
+            for (const QJsonValue& val : array) {
+                if (val.isObject()) {
+                    // Convert JSON object to QVariantMap
+                    QJsonObject obj = val.toObject();
+                    QVariantMap map;
+                    for (auto it = obj.begin(); it != obj.end(); ++it) {
+                        if (it.value().isDouble()) {
+                            map[it.key()] = it.value().toDouble();
+                        } else if (it.value().isString()) {
+                            map[it.key()] = it.value().toString();
+                        } else if (it.value().isBool()) {
+                            map[it.key()] = it.value().toBool();
+                        } // integers will be handled as doubles
+                    }
+                    list.append(map);
+                } else if (val.isString()) {
+                    list.append(val.toString());
+                } else if (val.isDouble()) {
+                    list.append(val.toDouble());
+                } else if (val.isBool()) {
+                    list.append(val.toBool());
+                }
+            }
+            value = list;
+        } else {
+            // Handle as string lists for backwards compatibility
+            QStringList list;
+            for (const QJsonValue& val : array) {
+                list.append(val.toString());
+            }
+            value = list;
+        }
+    }
+    
+    // Handle color strings (hex format)
+    if (value.metaType().id() == QMetaType::QString && propNameStr.contains("color", Qt::CaseInsensitive)) {
+        QString colorStr = value.toString();
+        if (colorStr.startsWith("#")) {
+            QColor color(colorStr);
+            if (color.isValid()) {
+                value = color;
+            }
+        }
+    }
+    
+    // Handle font objects
+    if (jsonValue.isObject() && propNameStr == "font") {
+        QJsonObject fontObj = jsonValue.toObject();
+        QFont font;
+        if (fontObj.contains("family")) {
+            font.setFamily(fontObj["family"].toString());
+        }
+        if (fontObj.contains("pointSize")) {
+            font.setPointSize(fontObj["pointSize"].toInt());
+        }
+        if (fontObj.contains("bold")) {
+            font.setBold(fontObj["bold"].toBool());
+        }
+        if (fontObj.contains("italic")) {
+            font.setItalic(fontObj["italic"].toBool());
+        }
+        if (fontObj.contains("weight")) {
+            font.setWeight(static_cast<QFont::Weight>(fontObj["weight"].toInt()));
+        }
+        value = font;
+    }
+    
+    // Handle BoxShadow objects
+    if (jsonValue.isObject() && propNameStr == "boxShadow") {
+        QJsonObject shadowObj = jsonValue.toObject();
+        BoxShadow shadow;
+        if (shadowObj.contains("offsetX")) {
+            shadow.offsetX = shadowObj["offsetX"].toDouble();
+        }
+        if (shadowObj.contains("offsetY")) {
+            shadow.offsetY = shadowObj["offsetY"].toDouble();
+        }
+        if (shadowObj.contains("blurRadius")) {
+            shadow.blurRadius = shadowObj["blurRadius"].toDouble();
+        }
+        if (shadowObj.contains("spreadRadius")) {
+            shadow.spreadRadius = shadowObj["spreadRadius"].toDouble();
+        }
+        if (shadowObj.contains("color")) {
+            QString colorStr = shadowObj["color"].toString();
+            if (colorStr.startsWith("#")) {
+                shadow.color = QColor(colorStr);
+            }
+        }
+        if (shadowObj.contains("enabled")) {
+            shadow.enabled = shadowObj["enabled"].toBool();
+        }
+        value = QVariant::fromValue(shadow);
+    }
+    
+    return value;
+}
+
+// Fill record.properties with the meta properties of metaObject found in elementData
+void decodeMetaProperties(const QJsonObject& elementData, const QMetaObject* metaObject, ElementRecord& record) {
+    const bool isShape = record.elementType == "Shape";
+    record.properties.clear();
+    record.propertiesMetaObject = metaObject;
+    
+    for (int i = 0; i < metaObject->propertyCount(); ++i) {
+        QMetaProperty property = metaObject->property(i);
+        const char* propName = property.name();
+        QString propNameStr(propName);
+        
+        // Skip properties we don't want to restore or already handled
+        if (propNameStr == "objectName" || 
+            propNameStr == "selected" ||
+            propNameStr == "elementId" ||
+            propNameStr == "elementType" ||
+            propNameStr == "name" ||
+            propNameStr == "parentId" ||
+            propNameStr == "parentElement" ||
+            (isShape && propNameStr == "shapeType") ||  // Set before geometry
+            (isShape && propNameStr == "joints") ||     // Set before geometry
+            !property.isWritable()) {
+            continue;
+        }
+        
+        if (elementData.contains(propNameStr)) {
+            QVariant value = decodePropertyValue(property, propNameStr, elementData[propNameStr]);
+            if (value.isValid()) {
+                record.properties.append({i, value});
+            }
+        }
+    }
+}
+
+// Decode everything but the QObject itself. Reads only the JSON and static
+// meta-objects, so records for different elements can be decoded in parallel.
+void decodeElement(const QJsonObject& elementData, ElementRecord& record) {
+    record.elementId = stringFromJsonValue(elementData["elementId"]);
+    record.elementType = stringFromJsonValue(elementData["elementType"]);
+    record.name = stringFromJsonValue(elementData["name"]);
+    record.parentId = stringFromJsonValue(elementData["parentId"]);
+    
+    if (record.elementId.isEmpty() || record.elementType.isEmpty()) {
+        return;
+    }
+    
+    // For Shape elements, shapeType and joints are set before geometry to avoid losing custom joints
+    if (record.elementType == "Shape") {
+        if (elementData.contains("shapeType")) {
+            record.hasShapeType = true;
+            record.shapeType = stringFromJsonValue(elementData["shapeType"]);
+        }
+        
+        if (elementData.contains("joints")) {
+            record.hasJoints = true;
+            QJsonArray jointsArray = elementData["joints"].toArray();
+            for (const QJsonValue& jointValue : jointsArray) {
+                if (jointValue.isObject()) {
+                    QJsonObject jointObj = jointValue.toObject();
+                    QVariantMap jointMap;
+                    jointMap["x"] = jointObj["x"].toDouble();
+                    jointMap["y"] = jointObj["y"].toDouble();
+                    
+                    // Load new properties if they exist (for backward compatibility)
+                    if (jointObj.contains("mirroring")) {
+                        jointMap["mirroring"] = jointObj["mirroring"].toInt();
+                    } else {
+                        jointMap["mirroring"] = 0; // NoMirroring
+                    }
+                    
+                    if (jointObj.contains("cornerRadius")) {
+                        jointMap["cornerRadius"] = jointObj["cornerRadius"].toDouble();
+                    } else {
+                        jointMap["cornerRadius"] = 0.0;
+                    }
+                    
+                    record.joints.append(jointMap);
+                }
+            }
+        }
+    }
+    
+    // Meta properties need the element's class; a type without a known one
+    // keeps its JSON and is decoded once the element exists
+    if (const QMetaObject* metaObject = metaObjectForElementType(record.elementType)) {
+        decodeMetaProperties(elementData, metaObject, record);
+    } else {
+        record.data = elementData;
+    }
+    
+    // ComponentElement member ids, restored after all elements are loaded
+    if (elementData.contains("componentElements")) {
+        record.hasComponentElements = true;
+        QJsonArray elementsArray = elementData["componentElements"].toArray();
+        for (const QJsonValue& val : elementsArray) {
+            record.componentElementIds.append(val.toString());
+        }
+    }
+    
+    // PropertyRegistry properties
+    if (elementData.contains("registryProperties")) {
+        const QJsonObject registryProps = elementData["registryProperties"].toObject();
+        for (auto it = registryProps.begin(); it != registryProps.end(); ++it) {
+            QJsonValue jsonValue = it.value();
+            
+            // Convert JSON value to QVariant
+            QVariant value;
+            if (jsonValue.isBool()) {
+                value = jsonValue.toBool();
+            } else if (jsonValue.isDouble()) {
+                value = jsonValue.toDouble();
+            } else if (jsonValue.isString()) {
+                value = jsonValue.toString();
+            } else {
+                // Try to convert to variant
+                value = jsonValue.toVariant();
+            }
+            
+            if (value.isValid()) {
+                record.registryProperties.append({it.key(), value});
+            }
+        }
+    }
+}
+
+// Create the element a record describes and apply its values; GUI thread only
+Element* createElement(const ElementRecord& record, ElementModel* model) {
+    if (record.elementId.isEmpty() || record.elementType.isEmpty()) {
+        return nullptr;
+    }
+    
+    const QString& elementType = record.elementType;
+    const QString& elementId = record.elementId;
+    Element* element = nullptr;
+    
+    // Try to create element using registry first
+    ElementTypeRegistry& registry = ElementTypeRegistry::instance();
+    QString lowerTypeName = elementType.toLower();
+    
+    if (registry.hasType(lowerTypeName)) {
+        // Registry uses lowercase type names
+        element = registry.createElement(lowerTypeName, elementId);
+    } else {
+        // Fall back to direct creation for types not in registry yet
+        // (Variable, Node, Edge, ComponentElement)
+        if (elementType == "Variable") {
+            element = new Variable(elementId, model);
+        } else if (elementType == "Node") {
+            element = new Node(elementId, model);
+        } else if (elementType == "Edge") {
+            element = new Edge(elementId, model);
+        } else if (elementType == "ComponentElement") {
+            element = new ComponentElement(elementId, model);
+        } else {
+            qWarning() << "Unknown element type in deserialization:" << elementType;
+            return nullptr;
+        }
+    }
+    
+    if (!element) {
+        return nullptr;
+    }
+    
+    // Set basic properties
+    element->setName(record.name);
+    element->setParentElementId(record.parentId);
+    
+    if (Shape* shape = qobject_cast<Shape*>(element)) {
+        if (record.hasShapeType) {
+            if (record.shapeType == "Square") {
+                shape->setShapeType(Shape::Square);
+            } else if (record.shapeType == "Triangle") {
+                shape->setShapeType(Shape::Triangle);
+            } else if (record.shapeType == "Line" || record.shapeType == "Pen") {
+                shape->setShapeType(Shape::Pen);
+            }
+        }
+        if (record.hasJoints) {
+            shape->setJoints(record.joints);
+        }
+    }
+    
+    // Restore all other properties using Qt's meta-object system
+    if (record.propertiesMetaObject) {
+        for (const auto& property : record.properties) {
+            record.propertiesMetaObject->property(property.first).write(element, property.second);
+        }
+    } else {
+        // No class was known up front; decode against the element's own
+        ElementRecord decoded;
+        decoded.elementType = elementType;
+        decodeMetaProperties(record.data, element->metaObject(), decoded);
+        for (const auto& property : decoded.properties) {
+            decoded.propertiesMetaObject->property(property.first).write(element, property.second);
+        }
+    }
+    
+    // Special handling for ComponentElement - store element IDs to restore later
+    if (ComponentElement* component = qobject_cast<ComponentElement*>(element)) {
+        if (record.hasComponentElements) {
+            // We'll restore these connections after all elements are loaded
+            component->setPendingElementIds(record.componentElementIds);
+        }
+    }
+    
+    // Restore PropertyRegistry properties
+    for (const auto& property : record.registryProperties) {
+        element->setProperty(property.first, property.second);
+    }
+    
+    return element;
+}
+
+}
 
 Serializer::Serializer(Application* app, QObject *parent)
     : QObject(parent)
@@ -75,6 +495,7 @@ void Serializer::resolveComponentRelationships(ElementModel* model)
 
 QJsonObject Serializer::serializeProject(Project* project) const {
     if (!project) return QJsonObject();
+    TRACE_SCOPE("Serializer::serializeProject", "serializer");
     
     QJsonObject projectObj;
     projectObj["id"] = project->id();
@@ -359,6 +780,7 @@ QJsonObject Serializer::serializeElement(Element* element) const {
 }
 
 Project* Serializer::deserializeProject(const QJsonObject& projectData) {
+    TRACE_SCOPE("Serializer::deserializeProject", "serializer");
     try {
         QString id = projectData["id"].toString();
         QString name = projectData["name"].toString();
@@ -475,13 +897,7 @@ Project* Serializer::deserializeProject(const QJsonObject& projectData) {
                                 // Clear existing global elements (except the default ones created on platform init)
                                 globalElementsModel->clear();
                                 
-                                for (const QJsonValue& elementValue : globalElementsArray) {
-                                    QJsonObject elementData = elementValue.toObject();
-                                    Element* element = deserializeElement(elementData, globalElementsModel);
-                                    if (element) {
-                                        globalElementsModel->addElement(element);
-                                    }
-                                }
+                                globalElementsModel->addElements(deserializeElements(globalElementsArray, globalElementsModel));
                                 
                                 // Resolve parent relationships for global elements after loading
                                 globalElementsModel->resolveParentRelationships();
@@ -498,16 +914,17 @@ Project* Serializer::deserializeProject(const QJsonObject& projectData) {
         // Add to application's project list
         m_application->addCanvas(project);
         
+        // The spatial index is rebuilt once, at the end, instead of per added element
+        CanvasController* controller = project->controller();
+        HitTestService* hitTestService = controller ? controller->hitTestService() : nullptr;
+        if (hitTestService) {
+            hitTestService->beginBatch();
+        }
+        
         // Load elements after canvas is added
         if (projectData.contains("elements")) {
-            QJsonArray elementsArray = projectData["elements"].toArray();
-            for (const QJsonValue& elementValue : elementsArray) {
-                QJsonObject elementData = elementValue.toObject();
-                Element* element = deserializeElement(elementData, project->elementModel());
-                if (element) {
-                    project->elementModel()->addElement(element);
-                }
-            }
+            const QJsonArray elementsArray = projectData["elements"].toArray();
+            project->elementModel()->addElements(deserializeElements(elementsArray, project->elementModel()));
         }
         
         // Resolve parent relationships after all elements are loaded
@@ -538,9 +955,14 @@ Project* Serializer::deserializeProject(const QJsonObject& projectData) {
         }
         
         // Rebuild spatial index after all elements are loaded
-        CanvasController* controller = project->controller();
-        if (controller && controller->hitTestService()) {
-            controller->hitTestService()->rebuildSpatialIndex();
+        if (hitTestService) {
+            hitTestService->rebuildSpatialIndex();
+            hitTestService->endBatch();
+        }
+        
+        // Queue the project's fonts in the background; on-screen text raises its own priority
+        if (project->elementModel()) {
+            GoogleFonts::instance()->prefetchFontsForElements(project->elementModel()->getAllElements());
         }
         
         return project;
@@ -552,341 +974,38 @@ Project* Serializer::deserializeProject(const QJsonObject& projectData) {
 
 Element* Serializer::deserializeElement(const QJsonObject& elementData, ElementModel* model) {
     try {
-        // Handle case where strings are stored as character arrays
-        QString elementId;
-        QString elementType;
-        QString name;
-        QString parentId;
-        
-        auto getStringFromJsonValue = [](const QJsonValue& value) -> QString {
-            if (value.isString()) {
-                return value.toString();
-            } else if (value.isArray()) {
-                // Handle case where string is stored as array of characters
-                QJsonArray arr = value.toArray();
-                QString result;
-                for (const QJsonValue& val : arr) {
-                    result += val.toString();
-                }
-                return result;
-            }
-            return QString();
-        };
-        
-        elementId = getStringFromJsonValue(elementData["elementId"]);
-        elementType = getStringFromJsonValue(elementData["elementType"]);
-        name = getStringFromJsonValue(elementData["name"]);
-        parentId = getStringFromJsonValue(elementData["parentId"]);
-        
-        
-        if (elementId.isEmpty() || elementType.isEmpty()) {
-            return nullptr;
-        }
-        
-        Element* element = nullptr;
-        
-        // Try to create element using registry first
-        ElementTypeRegistry& registry = ElementTypeRegistry::instance();
-        QString lowerTypeName = elementType.toLower();
-        
-        
-        if (registry.hasType(lowerTypeName)) {
-            // Registry uses lowercase type names
-            element = registry.createElement(lowerTypeName, elementId);
-            if (!element) {
-            }
-        } else {
-            // Fall back to direct creation for types not in registry yet
-            // (Variable, Node, Edge, ComponentElement)
-            if (elementType == "Variable") {
-                element = new Variable(elementId, model);
-            } else if (elementType == "Node") {
-                element = new Node(elementId, model);
-            } else if (elementType == "Edge") {
-                element = new Edge(elementId, model);
-            } else if (elementType == "ComponentElement") {
-                element = new ComponentElement(elementId, model);
-            } else {
-                qWarning() << "Unknown element type in deserialization:" << elementType;
-                return nullptr;
-            }
-        }
-        
-        if (!element) {
-            return nullptr;
-        }
-        
-        
-        // Set basic properties
-        element->setName(name);
-        element->setParentElementId(parentId);
-        
-        // For Shape elements, we need to set shapeType and joints before geometry to avoid losing custom joints
-        if (elementType == "Shape") {
-            if (elementData.contains("shapeType")) {
-                QString shapeTypeStr = getStringFromJsonValue(elementData["shapeType"]);
-                if (Shape* shape = qobject_cast<Shape*>(element)) {
-                    if (shapeTypeStr == "Square") {
-                        shape->setShapeType(Shape::Square);
-                    } else if (shapeTypeStr == "Triangle") {
-                        shape->setShapeType(Shape::Triangle);
-                    } else if (shapeTypeStr == "Line" || shapeTypeStr == "Pen") {
-                        shape->setShapeType(Shape::Pen);
-                    }
-                }
-            }
-            
-            // Load joints immediately after shape type and before geometry
-            if (elementData.contains("joints")) {
-                QJsonArray jointsArray = elementData["joints"].toArray();
-                QVariantList variantJoints;
-                for (const QJsonValue& jointValue : jointsArray) {
-                    if (jointValue.isObject()) {
-                        QJsonObject jointObj = jointValue.toObject();
-                        QVariantMap jointMap;
-                        jointMap["x"] = jointObj["x"].toDouble();
-                        jointMap["y"] = jointObj["y"].toDouble();
-                        
-                        // Load new properties if they exist (for backward compatibility)
-                        if (jointObj.contains("mirroring")) {
-                            jointMap["mirroring"] = jointObj["mirroring"].toInt();
-                        } else {
-                            jointMap["mirroring"] = 0; // NoMirroring
-                        }
-                        
-                        if (jointObj.contains("cornerRadius")) {
-                            jointMap["cornerRadius"] = jointObj["cornerRadius"].toDouble();
-                        } else {
-                            jointMap["cornerRadius"] = 0.0;
-                        }
-                        
-                        variantJoints.append(jointMap);
-                    }
-                }
-                if (Shape* shape = qobject_cast<Shape*>(element)) {
-                    shape->setJoints(variantJoints);
-                }
-            }
-        }
-        
-        // Restore all other properties using Qt's meta-object system
-        const QMetaObject* metaObj = element->metaObject();
-        for (int i = 0; i < metaObj->propertyCount(); ++i) {
-            QMetaProperty property = metaObj->property(i);
-            const char* propName = property.name();
-            QString propNameStr(propName);
-            
-            // Skip properties we don't want to restore or already handled
-            if (propNameStr == "objectName" || 
-                propNameStr == "selected" ||
-                propNameStr == "elementId" ||
-                propNameStr == "elementType" ||
-                propNameStr == "name" ||
-                propNameStr == "parentId" ||
-                propNameStr == "parentElement" ||
-                (elementType == "Shape" && propNameStr == "shapeType") ||  // Already handled above
-                (elementType == "Shape" && propNameStr == "joints")) {     // Already handled above
-                continue;
-            }
-            
-            if (elementData.contains(propName)) {
-                QJsonValue jsonValue = elementData[propName];
-                QVariant value;
-                
-                // Convert JSON value to appropriate QVariant type
-                if (jsonValue.isString()) {
-                    QString stringValue = jsonValue.toString();
-                    
-                    // Try to convert numeric strings to proper types
-                    bool isNumber;
-                    double numberValue = stringValue.toDouble(&isNumber);
-                    if (isNumber && (property.metaType().id() == QMetaType::Double || 
-                                    property.metaType().id() == QMetaType::Float ||
-                                    property.metaType().id() == QMetaType::Int)) {
-                        if (property.metaType().id() == QMetaType::Int) {
-                            value = QVariant(static_cast<int>(numberValue));
-                        } else {
-                            value = QVariant(numberValue);
-                        }
-                    } else if (stringValue == "true" || stringValue == "false") {
-                        // Convert boolean strings
-                        value = QVariant(stringValue == "true");
-                    } else {
-                        value = stringValue;
-                    }
-                } else if (jsonValue.isDouble()) {
-                    value = jsonValue.toDouble();
-                } else if (jsonValue.isBool()) {
-                    value = jsonValue.toBool();
-                } else if (jsonValue.isObject()) {
-                    // Handle complex types like fonts
-                    QJsonObject obj = jsonValue.toObject();
-                    if (obj.contains("family")) {
-                        // It's a font
-                        QFont font;
-                        font.setFamily(obj["family"].toString());
-                        font.setPointSize(obj["pointSize"].toInt());
-                        font.setBold(obj["bold"].toBool());
-                        font.setItalic(obj["italic"].toBool());
-                        font.setWeight(QFont::Weight(obj["weight"].toInt()));
-                        value = font;
-                    }
-                } else if (jsonValue.isArray()) {
-                    QJsonArray array = jsonValue.toArray();
-                    
-                    // Check if property expects QVariantList (like joints)
-                    if (property.metaType().id() == QMetaType::QVariantList) {
-                        QVariantList list;
-                        for (const QJsonValue& val : array) {
-                            if (val.isObject()) {
-                                // Convert JSON object to QVariantMap
-                                QJsonObject obj = val.toObject();
-                                QVariantMap map;
-                                for (auto it = obj.begin(); it != obj.end(); ++it) {
-                                    if (it.value().isDouble()) {
-                                        map[it.key()] = it.value().toDouble();
-                                    } else if (it.value().isString()) {
-                                        map[it.key()] = it.value().toString();
-                                    } else if (it.value().isBool()) {
-                                        map[it.key()] = it.value().toBool();
-                                    } // integers will be handled as doubles
-                                }
-                                list.append(map);
-                            } else if (val.isString()) {
-                                list.append(val.toString());
-                            } else if (val.isDouble()) {
-                                list.append(val.toDouble());
-                            } else if (val.isBool()) {
-                                list.append(val.toBool());
-                            }
-                        }
-                        value = list;
-                    } else {
-                        // Handle as string lists for backwards compatibility
-                        QStringList list;
-                        for (const QJsonValue& val : array) {
-                            list.append(val.toString());
-                        }
-                        value = list;
-                    }
-                }
-                
-                // Handle color strings (hex format)
-                if (value.metaType().id() == QMetaType::QString && propNameStr.contains("color", Qt::CaseInsensitive)) {
-                    QString colorStr = value.toString();
-                    if (colorStr.startsWith("#")) {
-                        QColor color(colorStr);
-                        if (color.isValid()) {
-                            value = color;
-                        }
-                    }
-                }
-                
-                // Handle font objects
-                if (jsonValue.isObject() && propNameStr == "font") {
-                    QJsonObject fontObj = jsonValue.toObject();
-                    QFont font;
-                    if (fontObj.contains("family")) {
-                        font.setFamily(fontObj["family"].toString());
-                    }
-                    if (fontObj.contains("pointSize")) {
-                        font.setPointSize(fontObj["pointSize"].toInt());
-                    }
-                    if (fontObj.contains("bold")) {
-                        font.setBold(fontObj["bold"].toBool());
-                    }
-                    if (fontObj.contains("italic")) {
-                        font.setItalic(fontObj["italic"].toBool());
-                    }
-                    if (fontObj.contains("weight")) {
-                        font.setWeight(static_cast<QFont::Weight>(fontObj["weight"].toInt()));
-                    }
-                    value = font;
-                }
-                
-                // Handle BoxShadow objects
-                if (jsonValue.isObject() && propNameStr == "boxShadow") {
-                    QJsonObject shadowObj = jsonValue.toObject();
-                    BoxShadow shadow;
-                    if (shadowObj.contains("offsetX")) {
-                        shadow.offsetX = shadowObj["offsetX"].toDouble();
-                    }
-                    if (shadowObj.contains("offsetY")) {
-                        shadow.offsetY = shadowObj["offsetY"].toDouble();
-                    }
-                    if (shadowObj.contains("blurRadius")) {
-                        shadow.blurRadius = shadowObj["blurRadius"].toDouble();
-                    }
-                    if (shadowObj.contains("spreadRadius")) {
-                        shadow.spreadRadius = shadowObj["spreadRadius"].toDouble();
-                    }
-                    if (shadowObj.contains("color")) {
-                        QString colorStr = shadowObj["color"].toString();
-                        if (colorStr.startsWith("#")) {
-                            shadow.color = QColor(colorStr);
-                        }
-                    }
-                    if (shadowObj.contains("enabled")) {
-                        shadow.enabled = shadowObj["enabled"].toBool();
-                    }
-                    value = QVariant::fromValue(shadow);
-                }
-                
-                // Set the property if the value is valid and writable
-                if (value.isValid() && property.isWritable()) {
-                    property.write(element, value);
-                }
-            }
-        }
-        
-        // Special handling for ComponentElement - store element IDs to restore later
-        if (ComponentElement* component = qobject_cast<ComponentElement*>(element)) {
-            if (elementData.contains("componentElements")) {
-                QJsonArray elementsArray = elementData["componentElements"].toArray();
-                // Store the element IDs for later restoration
-                QStringList elementIds;
-                for (const QJsonValue& val : elementsArray) {
-                    QString id = val.toString();
-                    elementIds.append(id);
-                }
-                // We'll restore these connections after all elements are loaded
-                component->setPendingElementIds(elementIds);
-            } else {
-            }
+        ElementRecord record;
+        decodeElement(elementData, record);
+        return createElement(record, model);
+    } catch (const std::exception& e) {
+        return nullptr;
+    }
+}
+
+QList<Element*> Serializer::deserializeElements(const QJsonArray& elementsArray, ElementModel* model) {
+    TRACE_SCOPE("Serializer::deserializeElements", "serializer");
+    
+    // Decode on the worker pool, then create the QObjects here in file order
+    std::vector<ElementRecord> records(elementsArray.size());
+    parallelForChunks(static_cast<int>(records.size()), Config::DESERIALIZE_CHUNK_SIZE,
+                      [&elementsArray, &records](int begin, int end) {
+        TRACE_SCOPE("Serializer::decodeElements", "serializer");
+        for (int i = begin; i < end; ++i) {
+            decodeElement(elementsArray.at(i).toObject(), records[i]);
         }
-        
-        // Restore PropertyRegistry properties
-        if (elementData.contains("registryProperties")) {
-            QJsonObject registryProps = elementData["registryProperties"].toObject();
-            for (auto it = registryProps.begin(); it != registryProps.end(); ++it) {
-                QString propName = it.key();
-                QJsonValue jsonValue = it.value();
-                
-                // Convert JSON value to QVariant
-                QVariant value;
-                if (jsonValue.isBool()) {
-                    value = jsonValue.toBool();
-                } else if (jsonValue.isDouble()) {
-                    value = jsonValue.toDouble();
-                } else if (jsonValue.isString()) {
-                    value = jsonValue.toString();
-                } else {
-                    // Try to convert to variant
-                    value = jsonValue.toVariant();
-                }
-                
-                // Set the property through the PropertyRegistry system
-                if (value.isValid()) {
-                    element->setProperty(propName, value);
-                }
+    });
+    
+    QList<Element*> elements;
+    elements.reserve(static_cast<qsizetype>(records.size()));
+    for (const ElementRecord& record : records) {
+        try {
+            if (Element* element = createElement(record, model)) {
+                elements.append(element);
             }
+        } catch (const std::exception& e) {
         }
-        
-        return element;
-        
-    } catch (const std::exception& e) {
-        return nullptr;
     }
+    return elements;
 }
 
 QJsonObject Serializer::serializeNode(Node* node) const {
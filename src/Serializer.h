@@ -37,6 +37,10 @@ public:
 private:
     void resolveComponentRelationships(ElementModel* model);
     
+    // Decodes the array on the worker pool and creates the elements on this
+    // thread, in array order; they are not added to the model
+    QList<Element*> deserializeElements(const QJsonArray& elementsArray, ElementModel* model);
+    
     Application* m_application;
 };
 
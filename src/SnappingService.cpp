@@ -0,0 +1,392 @@
+#include "SnappingService.h"
+#include "CanvasElement.h"
+#include "Config.h"
+#include "Element.h"
+#include "ElementModel.h"
+#include "HitTestService.h"
+#include "PerformanceTrace.h"
+#include <algorithm>
+
+namespace {
+
+// Edges closer than this, in canvas units, count as aligned when drawing guides
+constexpr qreal ALIGNED_EPSILON = 0.01;
+
+template<typename Entry>
+bool positionLess(const Entry& entry, qreal position)
+{
+    return entry.position < position;
+}
+
+template<typename Entry>
+bool lessPosition(qreal position, const Entry& entry)
+{
+    return position < entry.position;
+}
+
+} // namespace
+
+SnappingService::SnappingService(QObject* parent)
+    : QObject(parent)
+{
+}
+
+void SnappingService::setHitTestService(HitTestService* hitTestService)
+{
+    if (m_hitTestService == hitTestService) return;
+
+    if (m_hitTestService) {
+        disconnect(m_hitTestService, nullptr, this, nullptr);
+    }
+    m_hitTestService = hitTestService;
+    m_indexValid = false;
+
+    if (m_hitTestService) {
+        // Element bounds may have changed; index again on the next snap
+        connect(m_hitTestService, &HitTestService::spatialIndexRebuilt, this, [this]() {
+            m_indexValid = false;
+        });
+        connect(m_hitTestService, &QObject::destroyed, this, [this]() {
+            m_hitTestService = nullptr;
+            m_indexValid = false;
+        });
+    }
+}
+
+void SnappingService::beginSession(const QList<Element*>& movingElements)
+{
+    m_movingElements = movingElements;
+    m_indexValid = false;
+}
+
+void SnappingService::endSession()
+{
+    m_movingElements.clear();
+    m_x.clear();
+    m_y.clear();
+    m_indexValid = false;
+}
+
+SnappingService::Result SnappingService::snap(const QRectF& rect, int edges, const QRectF& visibleRect, qreal zoom)
+{
+    Result result;
+    result.rect = rect;
+    if (!m_hitTestService || zoom <= 0 || !visibleRect.isValid() || rect.width() <= 0 || rect.height() <= 0) {
+        return result;
+    }
+
+    TRACE_SCOPE("SnappingService::snap", "canvas");
+    ensureIndex(visibleRect);
+
+    const qreal tolerance = Config::SNAP_TOLERANCE / zoom;
+    const bool moveX = (edges & LeftEdge) && (edges & RightEdge);
+    const bool moveY = (edges & TopEdge) && (edges & BottomEdge);
+
+    // The coordinates that move: all three when translating, otherwise the
+    // dragged side only
+    const auto movingX = [&](const QRectF& r, qreal* values) {
+        int count = 0;
+        if (moveX) {
+            values[count++] = r.left();
+            values[count++] = r.center().x();
+            values[count++] = r.right();
+        } else if (edges & LeftEdge) {
+            values[count++] = r.left();
+        } else if (edges & RightEdge) {
+            values[count++] = r.right();
+        }
+        return count;
+    };
+    const auto movingY = [&](const QRectF& r, qreal* values) {
+        int count = 0;
+        if (moveY) {
+            values[count++] = r.top();
+            values[count++] = r.center().y();
+            values[count++] = r.bottom();
+        } else if (edges & TopEdge) {
+            values[count++] = r.top();
+        } else if (edges & BottomEdge) {
+            values[count++] = r.bottom();
+        }
+        return count;
+    };
+    const auto spanX = [](const QRectF& r) { return Span{r.left(), r.right(), r.top(), r.bottom()}; };
+    const auto spanY = [](const QRectF& r) { return Span{r.top(), r.bottom(), r.left(), r.right()}; };
+
+    qreal xs[3];
+    qreal ys[3];
+    int xCount = movingX(rect, xs);
+    int yCount = movingY(rect, ys);
+    SpacingOption options[MAX_SPACING_OPTIONS];
+
+    // Nearest edge on each axis, then equal spacing if that is closer still;
+    // spacing only applies to moves, where the size is fixed
+    qreal dx = 0;
+    bool snappedX = findEdgeSnap(m_x, xs, xCount, tolerance, dx);
+    if (moveX) {
+        const int count = spacingOptions(m_x, spanX(rect), tolerance, true, options);
+        for (int i = 0; i < count; ++i) {
+            const qreal offset = options[i].start - rect.left();
+            if (qAbs(offset) <= tolerance && (!snappedX || qAbs(offset) < qAbs(dx))) {
+                dx = offset;
+                snappedX = true;
+            }
+        }
+    }
+
+    qreal dy = 0;
+    bool snappedY = findEdgeSnap(m_y, ys, yCount, tolerance, dy);
+    if (moveY) {
+        const int count = spacingOptions(m_y, spanY(rect), tolerance, false, options);
+        for (int i = 0; i < count; ++i) {
+            const qreal offset = options[i].start - rect.top();
+            if (qAbs(offset) <= tolerance && (!snappedY || qAbs(offset) < qAbs(dy))) {
+                dy = offset;
+                snappedY = true;
+            }
+        }
+    }
+
+    QRectF snapped = rect;
+    if (snappedX) {
+        if (moveX) {
+            snapped.translate(dx, 0);
+        } else if ((edges & LeftEdge) && snapped.left() + dx < snapped.right()) {
+            snapped.setLeft(snapped.left() + dx);
+        } else if ((edges & RightEdge) && snapped.right() + dx > snapped.left()) {
+            snapped.setRight(snapped.right() + dx);
+        }
+    }
+    if (snappedY) {
+        if (moveY) {
+            snapped.translate(0, dy);
+        } else if ((edges & TopEdge) && snapped.top() + dy < snapped.bottom()) {
+            snapped.setTop(snapped.top() + dy);
+        } else if ((edges & BottomEdge) && snapped.bottom() + dy > snapped.top()) {
+            snapped.setBottom(snapped.bottom() + dy);
+        }
+    }
+    result.rect = snapped;
+
+    // Guides for everything the final rectangle lines up with, snapped or not
+    xCount = movingX(snapped, xs);
+    yCount = movingY(snapped, ys);
+    collectGuides(m_x, xs, xCount, snapped.top(), snapped.bottom(), true, result.guides);
+    collectGuides(m_y, ys, yCount, snapped.left(), snapped.right(), false, result.guides);
+
+    if (moveX) {
+        const int count = spacingOptions(m_x, spanX(snapped), ALIGNED_EPSILON, true, options);
+        for (int i = 0; i < count; ++i) {
+            if (qAbs(options[i].start - snapped.left()) <= ALIGNED_EPSILON) {
+                result.spacings << options[i].gaps[0] << options[i].gaps[1];
+            }
+        }
+    }
+    if (moveY) {
+        const int count = spacingOptions(m_y, spanY(snapped), ALIGNED_EPSILON, false, options);
+        for (int i = 0; i < count; ++i) {
+            if (qAbs(options[i].start - snapped.top()) <= ALIGNED_EPSILON) {
+                result.spacings << options[i].gaps[0] << options[i].gaps[1];
+            }
+        }
+    }
+    return result;
+}
+
+void SnappingService::AxisIndex::clear()
+{
+    edges.clear();
+    starts.clear();
+    ends.clear();
+    spans.clear();
+}
+
+void SnappingService::AxisIndex::build()
+{
+    edges.clear();
+    starts.clear();
+    ends.clear();
+    edges.reserve(spans.size() * 3);
+    starts.reserve(spans.size());
+    ends.reserve(spans.size());
+
+    for (int i = 0; i < static_cast<int>(spans.size()); ++i) {
+        const Span& span = spans[i];
+        edges.push_back({span.start, span.acrossStart, span.acrossEnd});
+        edges.push_back({(span.start + span.end) / 2, span.acrossStart, span.acrossEnd});
+        edges.push_back({span.end, span.acrossStart, span.acrossEnd});
+        starts.push_back({span.start, i});
+        ends.push_back({span.end, i});
+    }
+
+    const auto byPosition = [](const auto& a, const auto& b) { return a.position < b.position; };
+    std::sort(edges.begin(), edges.end(), byPosition);
+    std::sort(starts.begin(), starts.end(), byPosition);
+    std::sort(ends.begin(), ends.end(), byPosition);
+}
+
+void SnappingService::ensureIndex(const QRectF& visibleRect)
+{
+    if (m_indexValid && m_indexedRect.contains(visibleRect)) {
+        return;
+    }
+
+    TRACE_SCOPE("SnappingService::ensureIndex", "canvas");
+
+    // Index a margin around the viewport so small pans during a drag reuse it
+    const qreal marginX = visibleRect.width() * Config::SNAP_INDEX_MARGIN;
+    const qreal marginY = visibleRect.height() * Config::SNAP_INDEX_MARGIN;
+    m_indexedRect = visibleRect.adjusted(-marginX, -marginY, marginX, marginY);
+
+    m_x.clear();
+    m_y.clear();
+    m_hitTestService->visitElementsInRect(m_indexedRect, [this](Element* element) {
+        if (!isExcluded(element)) {
+            const QRectF& bounds = static_cast<CanvasElement*>(element)->cachedBounds();
+            m_x.spans.push_back({bounds.left(), bounds.right(), bounds.top(), bounds.bottom()});
+            m_y.spans.push_back({bounds.top(), bounds.bottom(), bounds.left(), bounds.right()});
+        }
+        return true;
+    });
+    m_x.build();
+    m_y.build();
+
+    TRACE_COUNTER("snapCandidates", m_x.spans.size());
+    m_indexValid = true;
+}
+
+bool SnappingService::isExcluded(Element* element) const
+{
+    ElementModel* model = m_hitTestService->elementModel();
+    for (Element* moving : m_movingElements) {
+        if (element == moving || (model && model->isDescendantOf(element, moving))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool SnappingService::findEdgeSnap(const AxisIndex& axis, const qreal* moving, int movingCount,
+                                   qreal tolerance, qreal& offset)
+{
+    bool found = false;
+    const auto consider = [&](qreal candidate) {
+        if (qAbs(candidate) <= tolerance && (!found || qAbs(candidate) < qAbs(offset))) {
+            offset = candidate;
+            found = true;
+        }
+    };
+
+    // The nearest edge is either the first at or after the moving edge or the
+    // one just before it
+    for (int i = 0; i < movingCount; ++i) {
+        const auto it = std::lower_bound(axis.edges.begin(), axis.edges.end(), moving[i],
+                                         positionLess<EdgePosition>);
+        if (it != axis.edges.end()) {
+            consider(it->position - moving[i]);
+        }
+        if (it != axis.edges.begin()) {
+            consider(std::prev(it)->position - moving[i]);
+        }
+    }
+    return found;
+}
+
+int SnappingService::spacingOptions(const AxisIndex& axis, const Span& rect, qreal slack,
+                                    bool horizontal, SpacingOption* options)
+{
+    const qreal size = rect.end - rect.start;
+
+    // A gap drawn along the axis, halfway across where the two spans overlap
+    const auto gap = [horizontal](qreal from, qreal to, const Span& a, const Span& b) {
+        const qreal across = (std::max(a.acrossStart, b.acrossStart) + std::min(a.acrossEnd, b.acrossEnd)) / 2;
+        return horizontal ? QLineF(from, across, to, across) : QLineF(across, from, across, to);
+    };
+
+    // Neighbours are the nearest candidates on either side that overlap the
+    // rectangle across the axis; slack lets ones it slightly overlaps count
+    const int before = nearestBefore(axis, rect.start + slack, rect.acrossStart, rect.acrossEnd);
+    const int after = nearestAfter(axis, rect.end - slack, rect.acrossStart, rect.acrossEnd);
+
+    int count = 0;
+    if (before >= 0 && after >= 0) {
+        // Centered between the two neighbours
+        const Span& a = axis.spans[before];
+        const Span& b = axis.spans[after];
+        const qreal free = b.start - a.end - size;
+        if (free >= 0) {
+            const qreal start = a.end + free / 2;
+            options[count++] = {start, {gap(a.end, start, a, rect), gap(start + size, b.start, rect, b)}};
+        }
+    }
+    if (before >= 0) {
+        // The gap between the neighbour before and the element before that
+        const Span& a = axis.spans[before];
+        const int beyond = nearestBefore(axis, a.start, a.acrossStart, a.acrossEnd, before);
+        if (beyond >= 0) {
+            const Span& b = axis.spans[beyond];
+            const qreal start = a.end + (a.start - b.end);
+            options[count++] = {start, {gap(b.end, a.start, b, a), gap(a.end, start, a, rect)}};
+        }
+    }
+    if (after >= 0) {
+        // The gap between the neighbour after and the element after that
+        const Span& a = axis.spans[after];
+        const int beyond = nearestAfter(axis, a.end, a.acrossStart, a.acrossEnd, after);
+        if (beyond >= 0) {
+            const Span& b = axis.spans[beyond];
+            const qreal start = a.start - (b.start - a.end) - size;
+            options[count++] = {start, {gap(start + size, a.start, rect, a), gap(a.end, b.start, a, b)}};
+        }
+    }
+    return count;
+}
+
+int SnappingService::nearestBefore(const AxisIndex& axis, qreal position, qreal acrossStart, qreal acrossEnd, int skip)
+{
+    // Walk back from the last candidate ending at or before position to the
+    // first that overlaps across the axis
+    auto it = std::upper_bound(axis.ends.begin(), axis.ends.end(), position, lessPosition<SideEntry>);
+    while (it != axis.ends.begin()) {
+        --it;
+        const Span& span = axis.spans[it->candidate];
+        if (it->candidate != skip && span.acrossStart < acrossEnd && acrossStart < span.acrossEnd) {
+            return it->candidate;
+        }
+    }
+    return -1;
+}
+
+int SnappingService::nearestAfter(const AxisIndex& axis, qreal position, qreal acrossStart, qreal acrossEnd, int skip)
+{
+    auto it = std::lower_bound(axis.starts.begin(), axis.starts.end(), position, positionLess<SideEntry>);
+    for (; it != axis.starts.end(); ++it) {
+        const Span& span = axis.spans[it->candidate];
+        if (it->candidate != skip && span.acrossStart < acrossEnd && acrossStart < span.acrossEnd) {
+            return it->candidate;
+        }
+    }
+    return -1;
+}
+
+void SnappingService::collectGuides(const AxisIndex& axis, const qreal* moving, int movingCount,
+                                    qreal acrossStart, qreal acrossEnd, bool vertical, QList<QLineF>& guides)
+{
+    for (int i = 0; i < movingCount; ++i) {
+        // One guide per aligned coordinate, long enough to reach every
+        // element on it and the rectangle itself
+        qreal from = acrossStart;
+        qreal to = acrossEnd;
+        bool aligned = false;
+        auto it = std::lower_bound(axis.edges.begin(), axis.edges.end(), moving[i] - ALIGNED_EPSILON,
+                                   positionLess<EdgePosition>);
+        for (; it != axis.edges.end() && it->position <= moving[i] + ALIGNED_EPSILON; ++it) {
+            from = std::min(from, it->spanStart);
+            to = std::max(to, it->spanEnd);
+            aligned = true;
+        }
+        if (aligned) {
+            guides.append(vertical ? QLineF(moving[i], from, moving[i], to) : QLineF(from, moving[i], to, moving[i]));
+        }
+    }
+}
@@ -0,0 +1,119 @@
+#pragma once
+#include <QObject>
+#include <QLineF>
+#include <QList>
+#include <QRectF>
+#include <vector>
+
+class Element;
+class HitTestService;
+
+/**
+ * SnappingService aligns a rectangle being moved or resized with the elements
+ * around it, and reports the guides to draw.
+ *
+ * When a drag starts the service is told which elements move with it. On the
+ * first snap it asks HitTestService for the elements in and around the
+ * viewport and indexes their left, center and right x and top, middle and
+ * bottom y coordinates in two sorted arrays. Each snap then binary-searches
+ * those arrays for the edges within the tolerance of the moving edges, so a
+ * mouse move costs O(log n) per edge whatever the element count. The index
+ * is kept for the whole drag and only rebuilt when the viewport leaves the
+ * indexed area or the spatial index is rebuilt.
+ *
+ * Moves also snap to equal spacing: centering between the nearest neighbours
+ * on either side, or repeating the gap between a neighbour and the element
+ * beyond it.
+ */
+class SnappingService : public QObject {
+    Q_OBJECT
+
+public:
+    // Sides of the rectangle that may move; all four translate it
+    enum Edge {
+        LeftEdge = 0x1,
+        TopEdge = 0x2,
+        RightEdge = 0x4,
+        BottomEdge = 0x8,
+        AllEdges = LeftEdge | TopEdge | RightEdge | BottomEdge
+    };
+
+    struct Result {
+        QRectF rect;              // The snapped rectangle
+        QList<QLineF> guides;     // Alignment lines through the matching edges
+        QList<QLineF> spacings;   // One segment per gap of an equal spacing
+    };
+
+    explicit SnappingService(QObject* parent = nullptr);
+
+    void setHitTestService(HitTestService* hitTestService);
+
+    // Start a drag of the given elements; they and their descendants are
+    // never snapped to
+    void beginSession(const QList<Element*>& movingElements);
+    void endSession();
+
+    // Snap rect, in canvas coordinates, to the elements near visibleRect.
+    // edges is a combination of Edge values; the tolerance is
+    // Config::SNAP_TOLERANCE screen pixels at the given zoom
+    Result snap(const QRectF& rect, int edges, const QRectF& visibleRect, qreal zoom);
+
+private:
+    // One indexed edge: its coordinate and the element's extent across it
+    struct EdgePosition {
+        qreal position;
+        qreal spanStart;
+        qreal spanEnd;
+    };
+    // A candidate's start or end along an axis, for finding neighbours
+    struct SideEntry {
+        qreal position;
+        int candidate;
+    };
+    // Candidate bounds along one axis; the "across" extent is on the other axis
+    struct Span {
+        qreal start;
+        qreal end;
+        qreal acrossStart;
+        qreal acrossEnd;
+    };
+    // Everything indexed along one axis
+    struct AxisIndex {
+        std::vector<EdgePosition> edges;   // Start, center and end of every candidate
+        std::vector<SideEntry> starts;     // Candidates by start
+        std::vector<SideEntry> ends;       // Candidates by end
+        std::vector<Span> spans;
+        void clear();
+        // Fill the sorted arrays from spans
+        void build();
+    };
+    // Where the rectangle's start would sit to repeat a gap, and the two
+    // equal gaps to draw when it does
+    struct SpacingOption {
+        qreal start;
+        QLineF gaps[2];
+    };
+    static constexpr int MAX_SPACING_OPTIONS = 3;
+
+    void ensureIndex(const QRectF& visibleRect);
+    bool isExcluded(Element* element) const;
+
+    // Offset from the moving edges to the nearest indexed edge; false if
+    // none is within tolerance
+    static bool findEdgeSnap(const AxisIndex& axis, const qreal* moving, int movingCount,
+                             qreal tolerance, qreal& offset);
+    static int spacingOptions(const AxisIndex& axis, const Span& rect, qreal slack,
+                              bool horizontal, SpacingOption* options);
+    static int nearestBefore(const AxisIndex& axis, qreal position, qreal acrossStart, qreal acrossEnd, int skip = -1);
+    static int nearestAfter(const AxisIndex& axis, qreal position, qreal acrossStart, qreal acrossEnd, int skip = -1);
+    static void collectGuides(const AxisIndex& axis, const qreal* moving, int movingCount,
+                              qreal acrossStart, qreal acrossEnd, bool vertical, QList<QLineF>& guides);
+
+    HitTestService* m_hitTestService = nullptr;
+    QList<Element*> m_movingElements;
+
+    AxisIndex m_x;
+    AxisIndex m_y;
+    QRectF m_indexedRect;
+    bool m_indexValid = false;
+};
@@ -9,6 +9,7 @@
 #include "Element.h"
 #include "CanvasElement.h"
 #include "Project.h"
+#include "NetworkTransport.h"
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
@@ -18,7 +19,6 @@
 #include <QUrl>
 #include <QUrlQuery>
 #include <QDebug>
-#include <QNetworkAccessManager>
 #include <QNetworkRequest>
 #include <QNetworkReply>
 #include <QUuid>
@@ -72,6 +72,7 @@ void StreamingAIClient::sendMessage(const QString &description)
     m_pendingMessage = description;
     m_accumulatedResponse.clear();
     m_accumulatedCommands.clear();
+    m_awaitingRepair = false;
 
     QString authToken = getAuthToken();
     
@@ -385,7 +386,6 @@ void StreamingAIClient::createConversation()
         }
     )";
 
-    QNetworkAccessManager *manager = new QNetworkAccessManager(this);
     QNetworkRequest request((QUrl(Config::GRAPHQL_ENDPOINT)));
     request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
 
@@ -399,9 +399,8 @@ void StreamingAIClient::createConversation()
     QJsonObject body;
     body["query"] = mutation;
     body["variables"] = variables;
-    QNetworkReply *reply = manager->post(request, QJsonDocument(body).toJson(QJsonDocument::Compact));
-
-    connect(reply, &QNetworkReply::finished, this, [this, reply, manager]()
+    NetworkTransport::instance()->post(request, QJsonDocument(body).toJson(QJsonDocument::Compact), this,
+                                       [this](QNetworkReply *reply)
             {
         if (reply->error() == QNetworkReply::NoError) {
             QByteArray responseData = reply->readAll();
@@ -419,7 +418,8 @@ void StreamingAIClient::createConversation()
                     
                     // Add a small delay to ensure subscription is established
                     QTimer::singleShot(500, this, [this]() {
-                        // Send CubitAI rules as the first message
+                        // Send CubitAI rules as the first message. If re-enabled, send the
+                        // user's message from its completion callback so it follows the rules
                         // sendCubitAIRules(m_currentConversationId);  // Disabled - no longer sending rules
                         
                         // Check if this is just initialization (INIT_AI_WITH_RULES)
@@ -438,9 +438,8 @@ void StreamingAIClient::createConversation()
         } else {
             if (m_console) m_console->addError(
                 QString("Failed to create conversation: %1").arg(reply->errorString()));
-        }
-        reply->deleteLater();
-        manager->deleteLater(); });
+        } },
+                                       NetworkTransport::InteractivePriority);
 }
 
 void StreamingAIClient::subscribeToResponses(const QString &conversationId)
@@ -529,7 +528,7 @@ void StreamingAIClient::sendSubscription(const QString &subId, const QString &qu
     m_webSocket->sendTextMessage(msgJson);
 }
 
-void StreamingAIClient::sendCubitAIRules(const QString &conversationId)
+void StreamingAIClient::sendCubitAIRules(const QString &conversationId, std::function<void()> then)
 {
     // Read the CubitAI rules from file
     QString rulesPath = QCoreApplication::applicationDirPath() + "/../amplify/data/prompts/CubitAIRules.txt";
@@ -581,21 +580,22 @@ void StreamingAIClient::sendCubitAIRules(const QString &conversationId)
     body["query"] = mutation;
     body["variables"] = vars;
 
-    QNetworkAccessManager *manager = new QNetworkAccessManager(this);
     QNetworkRequest req((QUrl(Config::GRAPHQL_ENDPOINT)));
     req.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
     QString token = getAuthToken();
     if (!token.isEmpty())
         req.setRawHeader("Authorization", token.toUtf8());
 
-    QNetworkReply *reply = manager->post(req, QJsonDocument(body).toJson(QJsonDocument::Compact));
-    connect(reply, &QNetworkReply::finished, this, [reply, manager]() {
+    NetworkTransport::instance()->post(req, QJsonDocument(body).toJson(QJsonDocument::Compact), this,
+                                       [then = std::move(then)](QNetworkReply *reply) {
         if (reply->error() != QNetworkReply::NoError) {
             qWarning() << "Failed to send CubitAI rules:" << reply->errorString();
         }
-        reply->deleteLater();
-        manager->deleteLater();
-    });
+        if (then) {
+            then();
+        }
+    },
+                                       NetworkTransport::InteractivePriority);
 }
 
 void StreamingAIClient::sendConversationMessage(const QString &conversationId, const QString &message)
@@ -629,15 +629,14 @@ void StreamingAIClient::sendConversationMessage(const QString &conversationId, c
     body["query"] = mutation;
     body["variables"] = vars;
 
-    QNetworkAccessManager *manager = new QNetworkAccessManager(this);
     QNetworkRequest req((QUrl(Config::GRAPHQL_ENDPOINT)));
     req.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
     QString token = getAuthToken();
     if (!token.isEmpty())
         req.setRawHeader("Authorization", token.toUtf8());
 
-    QNetworkReply *reply = manager->post(req, QJsonDocument(body).toJson(QJsonDocument::Compact));
-    connect(reply, &QNetworkReply::finished, this, [this, reply, manager]()
+    NetworkTransport::instance()->post(req, QJsonDocument(body).toJson(QJsonDocument::Compact), this,
+                                       [this](QNetworkReply *reply)
             {
         QByteArray resp = reply->readAll();
         // qDebug() << "SendMessage response:" << resp;
@@ -666,9 +665,8 @@ void StreamingAIClient::sendConversationMessage(const QString &conversationId, c
                     // Message sent, AI response will stream automatically
                 }
             }
-        }
-        reply->deleteLater();
-        manager->deleteLater(); });
+        } },
+                                       NetworkTransport::InteractivePriority);
 }
 
 // Removed triggerAIResponse - backend Lambda now handles AI streaming automatically
@@ -717,7 +715,7 @@ void StreamingAIClient::processStreamingResponse(const QString &chunk, int idx,
     if (!chunk.isEmpty())
     {
         m_accumulatedResponse += chunk;
-        // Remove the legacy command accumulation since we'll parse from the full response
+        dispatchStreamedCommands(chunk);
         emit responseChunkReceived(chunk);
     }
     
@@ -728,9 +726,89 @@ void StreamingAIClient::processStreamingResponse(const QString &chunk, int idx,
     }
 }
 
+void StreamingAIClient::dispatchStreamedCommands(const QString &chunk)
+{
+    if (!m_responseStreaming) {
+        m_responseStreaming = true;
+        m_commandParser.reset();
+        // A repaired response repeats the commands that already ran; keep their
+        // count and temp IDs so only the new ones are dispatched
+        if (!m_awaitingRepair) {
+            m_dispatchedCommands = 0;
+            m_commandDispatcher->beginStream();
+        }
+        m_awaitingRepair = false;
+    }
+
+    // Queue each command as soon as its closing brace arrives
+    const QList<QJsonObject> commands = m_commandParser.feed(chunk);
+
+    // Plan proposals and tool requests never execute commands (see
+    // finalizeResponse); hold commands back until the response cannot be one
+    if (!canDispatchWhileStreaming()) {
+        return;
+    }
+
+    const int firstIndex = m_commandParser.commandCount() - commands.size();
+    for (int i = 0; i < commands.size(); ++i) {
+        const int index = firstIndex + i;
+        if (index < m_dispatchedCommands) {
+            continue;
+        }
+        // An earlier command was held back; finalizeResponse sends the rest in order
+        if (index > m_dispatchedCommands) {
+            break;
+        }
+        m_commandDispatcher->enqueueCommand(commands.at(i));
+        m_dispatchedCommands = index + 1;
+    }
+}
+
+bool StreamingAIClient::canDispatchWhileStreaming() const
+{
+    // Plan proposals and tool requests open with a fixed marker. Commands are
+    // held while the start of the response could still become one, and
+    // released as soon as the first characters rule all of them out
+    static const QStringList planMarkers = {
+        QStringLiteral("PLAN:"),
+        QStringLiteral("WAITING FOR PLAN CONFIRMATION")
+    };
+    static const QString toolRequestPrefix = QStringLiteral("Request tool list for category");
+
+    qsizetype start = 0;
+    while (start < m_accumulatedResponse.size() && m_accumulatedResponse.at(start).isSpace()) {
+        ++start;
+    }
+    if (start == m_accumulatedResponse.size()) {
+        return false;
+    }
+    const QStringView head = QStringView(m_accumulatedResponse).mid(start);
+
+    auto ambiguous = [&head](const QString &marker) {
+        // Either the marker has arrived or the text so far may still grow into it
+        return head.size() < marker.size() ? marker.startsWith(head) : head.startsWith(marker);
+    };
+
+    if (ambiguous(toolRequestPrefix)) {
+        return false;
+    }
+    // Plan text is stripped during plan execution, so it never holds commands there
+    if (m_pendingContinuationContext != "EXEC_STEP") {
+        for (const QString &marker : planMarkers) {
+            if (ambiguous(marker)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
 void StreamingAIClient::finalizeResponse()
 {
     stopLoadingIndicator();
+    m_responseStreaming = false;
+    // Streamed commands finish draining; anything queued below joins them
+    m_commandDispatcher->endStream();
 
     if (m_accumulatedResponse.isEmpty()) return;
 
@@ -757,8 +835,11 @@ void StreamingAIClient::finalizeResponse()
     emit responseReceived(m_accumulatedResponse);
 
     // --- 1) Detect PLAN phase ---
-    if (m_accumulatedResponse.contains("PLAN:") ||
-        m_accumulatedResponse.contains("WAITING FOR PLAN CONFIRMATION")) {
+    // Commands that already ran mean the response opened as a command reply,
+    // so plan markers quoted later in it do not make it a plan
+    if (m_dispatchedCommands == 0 &&
+        (m_accumulatedResponse.contains("PLAN:") ||
+         m_accumulatedResponse.contains("WAITING FOR PLAN CONFIRMATION"))) {
         m_pendingPlanSteps = extractPlanSteps(m_accumulatedResponse);
 
         if (!m_pendingPlanSteps.isEmpty()) {
@@ -885,7 +966,13 @@ void StreamingAIClient::finalizeResponse()
             if (cmdParseError.error == QJsonParseError::NoError && cmdDoc.isArray()) {
                 QJsonArray cmds = cmdDoc.array();
                 if (!cmds.isEmpty()) {
-                    m_commandDispatcher->executeCommands(cmds);
+                    // Most commands were already queued while streaming; send the rest
+                    for (int i = m_dispatchedCommands; i < cmds.size(); ++i) {
+                        if (cmds[i].isObject()) {
+                            m_commandDispatcher->enqueueCommand(cmds[i].toObject());
+                        }
+                    }
+                    m_dispatchedCommands = qMax(m_dispatchedCommands, int(cmds.size()));
                     emit commandsReceived(cmds);
                     
                     // ✅ After handling JSON/tool request, clear buffer so it won't re-run
@@ -1111,6 +1198,7 @@ void StreamingAIClient::requestJsonRepair(const QString &invalidJson, const QStr
     // Clear the accumulated response to prepare for the repaired version
     m_accumulatedResponse.clear();
     m_accumulatedCommands.clear();
+    m_awaitingRepair = true;
     
     // Construct a repair request message
     QString repairMessage = QString(
@@ -1138,14 +1226,10 @@ void StreamingAIClient::fetchToolRegistry(const QString &category) {
                     .arg(baseUrl)
                     .arg(category);
 
-    QNetworkAccessManager *manager = new QNetworkAccessManager(this);
     QNetworkRequest request((QUrl(url)));
 
-    QNetworkReply *reply = manager->get(request);
-    connect(reply, &QNetworkReply::finished, this, [this, reply, manager, category, url]() {
+    NetworkTransport::instance()->get(request, this, [this, category, url](QNetworkReply *reply) {
         QByteArray data = reply->readAll();
-        reply->deleteLater();
-        manager->deleteLater();
 
         if (reply->error() != QNetworkReply::NoError) {
             if (m_console) m_console->addError(
@@ -1174,5 +1258,5 @@ void StreamingAIClient::fetchToolRegistry(const QString &category) {
 
         // Send this back into the AI conversation
         sendConversationMessage(m_currentConversationId, toolListForAI);
-    });
+    }, NetworkTransport::InteractivePriority);
 }
@@ -4,7 +4,9 @@
 #include <QJsonArray>
 #include <QTimer>
 #include <QWebSocket>
+#include <functional>
 #include <memory>
+#include "AICommandStreamParser.h"
 
 class AuthenticationManager;
 class Application;
@@ -79,13 +81,20 @@ private:
 
     void sendConversationMessage(const QString &conversationId,
                                  const QString &message);
-    void sendCubitAIRules(const QString &conversationId);
+    // Sends the rules at the same priority as messages; then runs once the
+    // rules request has finished, so a message sent from it cannot overtake them
+    void sendCubitAIRules(const QString &conversationId,
+                          std::function<void()> then = nullptr);
 
     // ==== Subscription Handling ====
     void handleSubscriptionData(const QJsonObject &payload);
     void processStreamingResponse(const QString &chunk,
                                   int blockIndex,
                                   bool isComplete);
+    void dispatchStreamedCommands(const QString &chunk);
+    // True once the start of the response rules out the plan and tool
+    // request markers, so its commands may run before it finishes
+    bool canDispatchWhileStreaming() const;
     void finalizeResponse();
     void handleComplete(const QString &subscriptionId);
     void handleError(const QJsonObject &payload);
@@ -124,6 +133,12 @@ private:
     QString m_pendingMessage;
     QString m_accumulatedResponse;
     QString m_accumulatedCommands;
+
+    // Incremental command dispatch while a response streams in
+    AICommandStreamParser m_commandParser;
+    bool m_responseStreaming = false;  // First chunk of the current response seen
+    int m_dispatchedCommands = 0;      // Commands of the current reply already queued
+    bool m_awaitingRepair = false;     // Next response replaces one that failed to parse
     QString m_currentConversationId;
     QString m_currentSubscriptionId;
     int m_continuationCount;
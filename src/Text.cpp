@@ -1,6 +1,8 @@
 #include "Text.h"
 #include "Frame.h"
 #include "PropertyRegistry.h"
+#include "TextMeasurementService.h"
+#include "Config.h"
 #include <QDebug>
 
 Text::Text(const QString &id, QObject *parent)
@@ -23,6 +25,7 @@ void Text::setContent(const QString &content)
         m_content = content;
         emit contentChanged();
         emit elementChanged();
+        updateAutoSize();
     }
 }
 
@@ -33,6 +36,7 @@ void Text::setFont(const QFont &font)
     m_font = font;
     emit fontChanged();
     emit elementChanged();
+    updateAutoSize();
 }
 
 void Text::setColor(const QColor &color)
@@ -67,46 +71,82 @@ void Text::setPosition(PositionType position)
                 parentFrame->triggerLayout();
             }
         }
+        updateAutoSize();
     }
 }
 
-void Text::setWidth(qreal w)
+void Text::setAutoSize(AutoSize autoSize)
 {
-    DesignElement::setWidth(w);
+    if (m_autoSize != autoSize) {
+        m_autoSize = autoSize;
+        emit autoSizeChanged();
+        emit elementChanged();
+        updateAutoSize();
+    }
+}
+
+QSizeF Text::intrinsicSize(qreal widthConstraint) const
+{
+    const qreal padding = Config::TEXT_ELEMENT_PADDING;
+    const qreal contentConstraint = widthConstraint < 0 ? -1 : qMax<qreal>(0, widthConstraint - 2 * padding);
+    QSizeF content = TextMeasurementService::instance()->measure(m_font, m_content, contentConstraint,
+                                                                 Config::TEXT_ELEMENT_LINE_HEIGHT);
+    return QSizeF(content.width() + 2 * padding, content.height() + 2 * padding);
+}
+
+Frame* Text::flexParentFrame() const
+{
+    if (m_position != Relative || !parentElement()) {
+        return nullptr;
+    }
+    Frame* parentFrame = qobject_cast<Frame*>(parentElement());
+    return parentFrame && parentFrame->flex() ? parentFrame : nullptr;
+}
+
+void Text::triggerParentLayout()
+{
+    // Trigger layout on parent if it's a frame with flex and this element has relative position.
+    // Skip it while the parent is already laying us out (its measure step resizes us).
+    Frame* parentFrame = flexParentFrame();
+    if (parentFrame && !parentFrame->isLayouting()) {
+        parentFrame->triggerLayout();
+    }
+}
+
+void Text::updateAutoSize()
+{
+    if (m_autoSize == AutoSizeNone) {
+        return;
+    }
     
-    // Trigger layout on parent if it's a frame with flex and this element has relative position
-    if (parentElement() && m_position == Relative) {
-        Frame* parentFrame = qobject_cast<Frame*>(parentElement());
-        if (parentFrame && parentFrame->flex()) {
-            parentFrame->triggerLayout();
-        }
+    // Inside a flex frame the layout engine measures this element as part of its pass
+    if (flexParentFrame()) {
+        triggerParentLayout();
+        return;
+    }
+    
+    QSizeF size = intrinsicSize(m_autoSize == AutoSizeHeight ? width() : -1);
+    if (!qFuzzyCompare(size.width(), width()) || !qFuzzyCompare(size.height(), height())) {
+        setRect(QRectF(x(), y(), size.width(), size.height()));
     }
 }
 
+void Text::setWidth(qreal w)
+{
+    DesignElement::setWidth(w);
+    triggerParentLayout();
+}
+
 void Text::setHeight(qreal h)
 {
     DesignElement::setHeight(h);
-    
-    // Trigger layout on parent if it's a frame with flex and this element has relative position
-    if (parentElement() && m_position == Relative) {
-        Frame* parentFrame = qobject_cast<Frame*>(parentElement());
-        if (parentFrame && parentFrame->flex()) {
-            parentFrame->triggerLayout();
-        }
-    }
+    triggerParentLayout();
 }
 
 void Text::setRect(const QRectF &rect)
 {
     DesignElement::setRect(rect);
-    
-    // Trigger layout on parent if it's a frame with flex and this element has relative position
-    if (parentElement() && m_position == Relative) {
-        Frame* parentFrame = qobject_cast<Frame*>(parentElement());
-        if (parentFrame && parentFrame->flex()) {
-            parentFrame->triggerLayout();
-        }
-    }
+    triggerParentLayout();
 }
 
 void Text::exitEditMode()
@@ -130,6 +170,7 @@ void Text::registerProperties() {
     m_properties->registerProperty("color", QColor(Qt::black));
     m_properties->registerProperty("isEditing", false);
     m_properties->registerProperty("position", static_cast<int>(Absolute));
+    m_properties->registerProperty("autoSize", static_cast<int>(AutoSizeNone));
 }
 
 QVariant Text::getProperty(const QString& name) const {
@@ -139,6 +180,7 @@ QVariant Text::getProperty(const QString& name) const {
     if (name == "color") return color();
     if (name == "isEditing") return isEditing();
     if (name == "position") return static_cast<int>(position());
+    if (name == "autoSize") return static_cast<int>(autoSize());
     
     // Fall back to parent implementation
     return DesignElement::getProperty(name);
@@ -166,6 +208,10 @@ void Text::setProperty(const QString& name, const QVariant& value) {
         setPosition(static_cast<PositionType>(value.toInt()));
         return;
     }
+    if (name == "autoSize") {
+        setAutoSize(static_cast<AutoSize>(value.toInt()));
+        return;
+    }
     
     // Fall back to parent implementation
     DesignElement::setProperty(name, value);
@@ -181,6 +227,7 @@ QList<PropertyDefinition> Text::staticPropertyDefinitions() {
     
     // Position properties
     props.append(PropertyDefinition("position", QMetaType::Int, static_cast<int>(Text::Absolute), PropertyDefinition::Layout));
+    props.append(PropertyDefinition("autoSize", QMetaType::Int, static_cast<int>(Text::AutoSizeNone), PropertyDefinition::Layout));
     
     // Behavior properties
     props.append(PropertyDefinition("isEditing", QMetaType::Bool, false, PropertyDefinition::Behavior, false)); // Not editable
@@ -4,6 +4,9 @@
 #include <QFont>
 #include <QColor>
 #include <QList>
+#include <QSizeF>
+
+class Frame;
 
 class Text : public DesignElement {
     Q_OBJECT
@@ -12,6 +15,7 @@ class Text : public DesignElement {
     Q_PROPERTY(QColor color READ color WRITE setColor NOTIFY colorChanged)
     Q_PROPERTY(bool isEditing READ isEditing WRITE setIsEditing NOTIFY isEditingChanged)
     Q_PROPERTY(PositionType position READ position WRITE setPosition NOTIFY positionChanged)
+    Q_PROPERTY(AutoSize autoSize READ autoSize WRITE setAutoSize NOTIFY autoSizeChanged)
     
 public:
     enum PositionType {
@@ -20,6 +24,13 @@ public:
         Fixed
     };
     Q_ENUM(PositionType)
+    
+    enum AutoSize {
+        AutoSizeNone,    // Fixed width and height
+        AutoSizeWidth,   // Width and height hug the content, no wrapping
+        AutoSizeHeight   // Fixed width, height hugs the wrapped content
+    };
+    Q_ENUM(AutoSize)
     explicit Text(const QString &id, QObject *parent = nullptr);
     
     // Static factory support methods
@@ -31,12 +42,18 @@ public:
     QColor color() const { return m_color; }
     bool isEditing() const { return m_isEditing; }
     PositionType position() const { return m_position; }
+    AutoSize autoSize() const { return m_autoSize; }
     
     void setContent(const QString &content);
     void setFont(const QFont &font);
     void setColor(const QColor &color);
     void setIsEditing(bool editing);
     void setPosition(PositionType position);
+    void setAutoSize(AutoSize autoSize);
+    
+    // Size of the rendered content including padding. A negative widthConstraint
+    // measures without wrapping; otherwise the text wraps at that element width.
+    Q_INVOKABLE QSizeF intrinsicSize(qreal widthConstraint = -1) const;
     
     // Override geometry setters to trigger parent layout
     void setWidth(qreal w) override;
@@ -61,11 +78,19 @@ signals:
     void colorChanged();
     void isEditingChanged();
     void positionChanged();
+    void autoSizeChanged();
     
 private:
+    // Parent frame when it lays this element out with flex, otherwise nullptr
+    Frame* flexParentFrame() const;
+    void triggerParentLayout();
+    // Resize to the intrinsic size, or hand that to the parent's flex layout
+    void updateAutoSize();
+    
     QString m_content;
     QFont m_font;
     QColor m_color;
     bool m_isEditing = false;
     PositionType m_position = Absolute;
+    AutoSize m_autoSize = AutoSizeNone;
 };
\ No newline at end of file
@@ -0,0 +1,130 @@
+#include "TextMeasurementService.h"
+#include "Config.h"
+#include <QCoreApplication>
+#include <QTextLayout>
+#include <QTextOption>
+#include <QTimer>
+#include <cmath>
+
+TextMeasurementService* TextMeasurementService::s_instance = nullptr;
+
+// Line width used when the text is not wrapped. QTextLayout stores widths as
+// 26.6 fixed point, so this stays well inside its range.
+static constexpr qreal UNCONSTRAINED_LINE_WIDTH = 1000000.0;
+
+TextMeasurementService* TextMeasurementService::instance()
+{
+    if (!s_instance) {
+        s_instance = new TextMeasurementService(QCoreApplication::instance());
+    }
+    return s_instance;
+}
+
+TextMeasurementService::TextMeasurementService(QObject *parent)
+    : QObject(parent)
+    , m_cache(Config::TEXT_MEASURE_CACHE_SIZE)
+{
+    // Statistics change on every measurement; only tell QML about it occasionally
+    m_statisticsTimer = new QTimer(this);
+    m_statisticsTimer->setSingleShot(true);
+    m_statisticsTimer->setInterval(500);
+    connect(m_statisticsTimer, &QTimer::timeout, this, &TextMeasurementService::statisticsChanged);
+}
+
+QSizeF TextMeasurementService::measure(const QFont& font, const QString& content,
+                                       qreal widthConstraint, qreal lineHeight)
+{
+    CacheKey key;
+    key.fontKey = font.key();
+    key.content = content;
+    key.widthConstraint = widthConstraint < 0 ? -1 : qRound(widthConstraint * 64);
+    key.lineHeight = qRound(lineHeight * 1000);
+
+    if (const QSizeF* cached = m_cache.object(key)) {
+        ++m_hits;
+        scheduleStatisticsUpdate();
+        return *cached;
+    }
+
+    ++m_misses;
+    QSizeF size = layoutText(font, content, widthConstraint, lineHeight);
+    m_cache.insert(key, new QSizeF(size));
+    scheduleStatisticsUpdate();
+    return size;
+}
+
+QSizeF TextMeasurementService::layoutText(const QFont& font, const QString& content,
+                                          qreal widthConstraint, qreal lineHeight) const
+{
+    // QTextLayout only breaks on Unicode line separators
+    QString text = content;
+    text.replace(QLatin1Char('\n'), QChar::LineSeparator);
+
+    const bool wrap = widthConstraint >= 0;
+    QTextOption option;
+    option.setWrapMode(wrap ? QTextOption::WrapAtWordBoundaryOrAnywhere : QTextOption::ManualWrap);
+
+    QTextLayout layout(text, font);
+    layout.setTextOption(option);
+    layout.setCacheEnabled(false);
+
+    qreal width = 0;
+    qreal height = 0;
+    layout.beginLayout();
+    for (QTextLine line = layout.createLine(); line.isValid(); line = layout.createLine()) {
+        line.setLineWidth(wrap ? qMax<qreal>(0, widthConstraint) : UNCONSTRAINED_LINE_WIDTH);
+        line.setPosition(QPointF(0, height));
+        width = qMax(width, line.naturalTextWidth());
+        height += line.height() * lineHeight;
+    }
+    layout.endLayout();
+
+    // Round up so the rendered text never clips against the measured box
+    return QSizeF(std::ceil(width), std::ceil(height));
+}
+
+void TextMeasurementService::setCapacity(int capacity)
+{
+    if (capacity != this->capacity()) {
+        m_cache.setMaxCost(qMax(0, capacity));
+        emit statisticsChanged();
+    }
+}
+
+qreal TextMeasurementService::hitRate() const
+{
+    const qint64 total = m_hits + m_misses;
+    return total > 0 ? static_cast<qreal>(m_hits) / total : 0.0;
+}
+
+MemoryUsage TextMeasurementService::memoryUsage() const
+{
+    MemoryUsage usage;
+    const QList<CacheKey> keys = m_cache.keys();
+    for (const CacheKey& key : keys) {
+        usage.bytes += sizeof(CacheKey) + sizeof(QSizeF) + MemoryEstimate::HASH_NODE_OVERHEAD
+                       + MemoryEstimate::of(key.fontKey) + MemoryEstimate::of(key.content);
+    }
+    usage.objects = keys.size();
+    return usage;
+}
+
+void TextMeasurementService::clearCache()
+{
+    m_cache.clear();
+    emit statisticsChanged();
+}
+
+void TextMeasurementService::resetStatistics()
+{
+    m_hits = 0;
+    m_misses = 0;
+    emit statisticsChanged();
+}
+
+void TextMeasurementService::scheduleStatisticsUpdate()
+{
+    if (!m_statisticsTimer->isActive()) {
+        m_statisticsTimer->start();
+    }
+}
@@ -0,0 +1,87 @@
+#pragma once
+#include <QObject>
+#include <QCache>
+#include <QFont>
+#include <QSizeF>
+#include <QString>
+#include "MemoryUsage.h"
+
+class QTimer;
+
+/**
+ * TextMeasurementService lays text out with QTextLayout so elements can report
+ * their intrinsic size to the flex layout engine without waiting for QML to
+ * render them first.
+ *
+ * Measurements are cached (least recently used first out) keyed by the font,
+ * the content and the width constraint. Hit/miss counters are exposed as
+ * properties so the cache can be inspected from QML, and MemoryDiagnostics
+ * reports the cache's size and hit rate.
+ */
+class TextMeasurementService : public QObject {
+    Q_OBJECT
+    Q_PROPERTY(int cachedEntries READ cachedEntries NOTIFY statisticsChanged)
+    Q_PROPERTY(int capacity READ capacity WRITE setCapacity NOTIFY statisticsChanged)
+    Q_PROPERTY(qint64 hits READ hits NOTIFY statisticsChanged)
+    Q_PROPERTY(qint64 misses READ misses NOTIFY statisticsChanged)
+    Q_PROPERTY(qreal hitRate READ hitRate NOTIFY statisticsChanged)
+
+public:
+    static TextMeasurementService* instance();
+
+    // Measure content laid out with font. A negative widthConstraint means the
+    // text is not wrapped; otherwise lines are word-wrapped at that width.
+    // lineHeight is a proportional multiplier, like QML Text.lineHeight.
+    QSizeF measure(const QFont& font, const QString& content,
+                   qreal widthConstraint = -1, qreal lineHeight = 1.0);
+
+    Q_INVOKABLE QSizeF measureText(const QFont& font, const QString& content,
+                                   qreal widthConstraint = -1, qreal lineHeight = 1.0) {
+        return measure(font, content, widthConstraint, lineHeight);
+    }
+
+    int cachedEntries() const { return m_cache.count(); }
+    int capacity() const { return static_cast<int>(m_cache.maxCost()); }
+    void setCapacity(int capacity);
+    qint64 hits() const { return m_hits; }
+    qint64 misses() const { return m_misses; }
+    qreal hitRate() const;
+    // Estimated footprint of the cached keys and sizes; objects counts entries
+    MemoryUsage memoryUsage() const;
+
+    Q_INVOKABLE void clearCache();
+    Q_INVOKABLE void resetStatistics();
+
+signals:
+    void statisticsChanged();
+
+private:
+    explicit TextMeasurementService(QObject *parent = nullptr);
+
+    struct CacheKey {
+        QString fontKey;
+        QString content;           // Shares the caller's string data
+        int widthConstraint = -1;  // In 1/64 px, -1 when unconstrained
+        int lineHeight = 1000;     // Multiplier in 1/1000
+
+        bool operator==(const CacheKey& other) const {
+            return widthConstraint == other.widthConstraint
+                && lineHeight == other.lineHeight
+                && content == other.content
+                && fontKey == other.fontKey;
+        }
+    };
+    friend size_t qHash(const CacheKey& key, size_t seed) {
+        return qHashMulti(seed, key.fontKey, key.content, key.widthConstraint, key.lineHeight);
+    }
+
+    QSizeF layoutText(const QFont& font, const QString& content,
+                      qreal widthConstraint, qreal lineHeight) const;
+    void scheduleStatisticsUpdate();
+
+    static TextMeasurementService* s_instance;
+    QCache<CacheKey, QSizeF> m_cache;
+    qint64 m_hits = 0;
+    qint64 m_misses = 0;
+    QTimer* m_statisticsTimer = nullptr;
+};
@@ -0,0 +1,326 @@
+#include "VisibleElementsModel.h"
+#include "CanvasElement.h"
+#include "Config.h"
+#include "Element.h"
+#include "ElementFilterProxy.h"
+#include "ElementModel.h"
+#include "HitTestService.h"
+#include <QTimer>
+#include <algorithm>
+
+VisibleElementsModel::VisibleElementsModel(QObject *parent)
+    : QAbstractListModel(parent)
+{
+    // Coalesce viewport and geometry changes into one refresh per event loop pass
+    m_refreshTimer = new QTimer(this);
+    m_refreshTimer->setSingleShot(true);
+    m_refreshTimer->setInterval(0);
+    connect(m_refreshTimer, &QTimer::timeout, this, &VisibleElementsModel::refresh);
+}
+
+int VisibleElementsModel::rowCount(const QModelIndex &parent) const
+{
+    if (parent.isValid())
+        return 0;
+    return m_visible.size();
+}
+
+QVariant VisibleElementsModel::data(const QModelIndex &index, int role) const
+{
+    if (!m_elementModel || !index.isValid() || index.row() >= m_visible.size())
+        return QVariant();
+
+    return m_elementModel->elementData(m_visible.at(index.row()), role);
+}
+
+QHash<int, QByteArray> VisibleElementsModel::roleNames() const
+{
+    if (m_elementModel) {
+        return m_elementModel->roleNames();
+    }
+    return QAbstractListModel::roleNames();
+}
+
+void VisibleElementsModel::setElementModel(ElementModel *model)
+{
+    if (m_elementModel == model) return;
+
+    if (m_elementModel) {
+        disconnect(m_elementModel, nullptr, this, nullptr);
+    }
+
+    m_elementModel = model;
+
+    if (m_elementModel) {
+        connect(m_elementModel, &ElementModel::elementUpdated, this, &VisibleElementsModel::scheduleRefresh);
+        connect(m_elementModel, &ElementModel::elementRemoved, this, &VisibleElementsModel::onElementRemoved);
+        connect(m_elementModel, &ElementModel::childInserted, this, &VisibleElementsModel::onRootsChanged);
+        connect(m_elementModel, &ElementModel::childRemoved, this, &VisibleElementsModel::onRootsChanged);
+        connect(m_elementModel, &ElementModel::childMoved, this, &VisibleElementsModel::onRootsChanged);
+        connect(m_elementModel, &ElementModel::childIndexReset, this, &VisibleElementsModel::reset);
+    }
+
+    reset();
+    emit elementModelChanged();
+}
+
+void VisibleElementsModel::setHitTestService(HitTestService *service)
+{
+    if (m_hitTestService == service) return;
+
+    if (m_hitTestService) {
+        disconnect(m_hitTestService, nullptr, this, nullptr);
+    }
+
+    m_hitTestService = service;
+
+    if (m_hitTestService) {
+        connect(m_hitTestService, &HitTestService::spatialIndexRebuilt, this, &VisibleElementsModel::onIndexRebuilt);
+    }
+
+    m_unindexedValid = false;
+    scheduleRefresh();
+    emit hitTestServiceChanged();
+}
+
+void VisibleElementsModel::setFilterProxy(ElementFilterProxy *proxy)
+{
+    if (m_filterProxy == proxy) return;
+
+    if (m_filterProxy) {
+        disconnect(m_filterProxy, nullptr, this, nullptr);
+    }
+
+    m_filterProxy = proxy;
+
+    if (m_filterProxy) {
+        connect(m_filterProxy, &ElementFilterProxy::filterChanged, this, &VisibleElementsModel::onIndexRebuilt);
+    }
+
+    m_unindexedValid = false;
+    scheduleRefresh();
+    emit filterProxyChanged();
+}
+
+void VisibleElementsModel::setViewport(const QRectF &viewport)
+{
+    if (m_viewport == viewport) return;
+
+    m_viewport = viewport;
+    scheduleRefresh();
+    emit viewportChanged();
+}
+
+Element* VisibleElementsModel::elementAt(int row) const
+{
+    if (row >= 0 && row < m_visible.size()) {
+        return m_visible.at(row);
+    }
+    return nullptr;
+}
+
+void VisibleElementsModel::scheduleRefresh()
+{
+    if (!m_refreshTimer->isActive()) {
+        m_refreshTimer->start();
+    }
+}
+
+void VisibleElementsModel::reset()
+{
+    const int oldCount = m_visible.size();
+
+    beginResetModel();
+    m_visible.clear();
+    m_ranks.clear();
+    m_unindexedRoots.clear();
+    m_ranksValid = false;
+    m_unindexedValid = false;
+    endResetModel();
+
+    if (oldCount != 0) {
+        emit countChanged();
+    }
+    scheduleRefresh();
+}
+
+void VisibleElementsModel::onElementRemoved(const QString &elementId)
+{
+    // Drop the row right away; the element is deleted later in this event loop pass
+    for (int row = 0; row < m_visible.size(); ++row) {
+        Element *element = m_visible.at(row);
+        if (element->getId() == elementId) {
+            beginRemoveRows(QModelIndex(), row, row);
+            m_visible.removeAt(row);
+            endRemoveRows();
+            m_ranks.remove(element);
+            m_unindexedRoots.remove(element);
+            emit countChanged();
+            break;
+        }
+    }
+    m_ranksValid = false;
+    m_unindexedValid = false;
+}
+
+void VisibleElementsModel::onRootsChanged(const QString &parentId)
+{
+    if (parentId.isEmpty()) {
+        m_ranksValid = false;
+        m_unindexedValid = false;
+        scheduleRefresh();
+    }
+}
+
+void VisibleElementsModel::onIndexRebuilt()
+{
+    m_unindexedValid = false;
+    scheduleRefresh();
+}
+
+void VisibleElementsModel::rebuildRanks()
+{
+    m_ranks.clear();
+    if (m_elementModel) {
+        const QList<Element*> roots = m_elementModel->getDirectChildren(QString());
+        m_ranks.reserve(roots.size());
+        for (int i = 0; i < roots.size(); ++i) {
+            m_ranks.insert(roots.at(i), i);
+        }
+    }
+    m_ranksValid = true;
+}
+
+void VisibleElementsModel::rebuildUnindexedRoots()
+{
+    m_unindexedRoots.clear();
+    for (auto it = m_ranks.cbegin(); it != m_ranks.cend(); ++it) {
+        Element *root = it.key();
+        if (isRenderedRoot(root) && (!m_hitTestService || !m_hitTestService->isIndexed(root))) {
+            m_unindexedRoots.insert(root);
+        }
+    }
+    m_unindexedValid = true;
+}
+
+bool VisibleElementsModel::isRenderedRoot(Element *element) const
+{
+    if (!element || !element->getParentElementId().isEmpty()) {
+        return false;
+    }
+    if (!qobject_cast<CanvasElement*>(element)) {
+        return false;
+    }
+    return !m_filterProxy || m_filterProxy->shouldShowElement(element);
+}
+
+QSet<Element*> VisibleElementsModel::queryRoots(const QRectF &rect) const
+{
+    QSet<Element*> roots;
+    m_hitTestService->visitElementsInRect(rect, [&](Element *element) {
+        // A nested hit keeps its whole root alive; the root renders its descendants
+        CanvasElement *root = qobject_cast<CanvasElement*>(element);
+        while (root && root->parentElement()) {
+            root = root->parentElement();
+        }
+        if (root && isRenderedRoot(root)) {
+            roots.insert(root);
+        }
+        return true;
+    });
+    return roots;
+}
+
+void VisibleElementsModel::refresh()
+{
+    if (!m_elementModel) {
+        return;
+    }
+    if (!m_ranksValid) {
+        rebuildRanks();
+    }
+    if (!m_unindexedValid) {
+        rebuildUnindexedRoots();
+    }
+
+    QSet<Element*> target;
+    if (!m_hitTestService || m_viewport.width() <= 0 || m_viewport.height() <= 0) {
+        // No viewport yet: render every root like the unvirtualized layer did
+        for (auto it = m_ranks.cbegin(); it != m_ranks.cend(); ++it) {
+            if (isRenderedRoot(it.key())) {
+                target.insert(it.key());
+            }
+        }
+    } else {
+        const qreal preloadX = m_viewport.width() * Config::VIEWPORT_PRELOAD_FACTOR;
+        const qreal preloadY = m_viewport.height() * Config::VIEWPORT_PRELOAD_FACTOR;
+        const qreal retainX = m_viewport.width() * Config::VIEWPORT_RETAIN_FACTOR;
+        const qreal retainY = m_viewport.height() * Config::VIEWPORT_RETAIN_FACTOR;
+
+        target = queryRoots(m_viewport.adjusted(-preloadX, -preloadY, preloadX, preloadY));
+
+        // Hysteresis: live elements stay until they are past the retain margin
+        if (!m_visible.isEmpty()) {
+            const QSet<Element*> retained = queryRoots(m_viewport.adjusted(-retainX, -retainY, retainX, retainY));
+            for (Element *element : std::as_const(m_visible)) {
+                if (retained.contains(element)) {
+                    target.insert(element);
+                }
+            }
+        }
+        target.unite(m_unindexedRoots);
+    }
+
+    // Order the target set back to front
+    QList<Element*> ordered;
+    ordered.reserve(target.size());
+    for (Element *element : std::as_const(target)) {
+        if (m_ranks.contains(element)) {
+            ordered.append(element);
+        }
+    }
+    std::sort(ordered.begin(), ordered.end(), [this](Element *a, Element *b) {
+        return m_ranks.value(a) < m_ranks.value(b);
+    });
+
+    const int oldCount = m_visible.size();
+
+    // Remove rows that left the viewport, back to front so rows stay valid
+    for (int row = m_visible.size() - 1; row >= 0; --row) {
+        if (!target.contains(m_visible.at(row))) {
+            beginRemoveRows(QModelIndex(), row, row);
+            m_visible.removeAt(row);
+            endRemoveRows();
+        }
+    }
+
+    // A reorder among the survivors can't be expressed as inserts; reset instead
+    for (int row = 1; row < m_visible.size(); ++row) {
+        if (m_ranks.value(m_visible.at(row - 1), -1) > m_ranks.value(m_visible.at(row), -1)) {
+            beginResetModel();
+            m_visible = ordered;
+            endResetModel();
+            if (m_visible.size() != oldCount) {
+                emit countChanged();
+            }
+            return;
+        }
+    }
+
+    // Survivors are a subsequence of the ordered target; insert the newcomers around them
+    int row = 0;
+    for (Element *element : std::as_const(ordered)) {
+        if (row < m_visible.size() && m_visible.at(row) == element) {
+            ++row;
+            continue;
+        }
+        beginInsertRows(QModelIndex(), row, row);
+        m_visible.insert(row, element);
+        endInsertRows();
+        ++row;
+    }
+
+    if (m_visible.size() != oldCount) {
+        emit countChanged();
+    }
+}
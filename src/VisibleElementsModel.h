@@ -0,0 +1,88 @@
+#pragma once
+#include <QAbstractListModel>
+#include <QHash>
+#include <QList>
+#include <QPointer>
+#include <QRectF>
+#include <QSet>
+
+class Element;
+class ElementModel;
+class ElementFilterProxy;
+class HitTestService;
+class QTimer;
+
+/**
+ * VisibleElementsModel lists the root elements that intersect the viewport,
+ * in z-order, so the design canvas only instantiates delegates for what is
+ * on screen.
+ *
+ * Candidates come from HitTestService's spatial index and are mapped to their
+ * root ancestor, so a frame stays live while any of its children is visible.
+ * Root elements the index does not hold (for example with mouse events
+ * disabled) are always kept. Elements enter when they come within the preload
+ * margin and only leave once they are past the larger retain margin, so panning
+ * back and forth near an edge does not churn delegates.
+ */
+class VisibleElementsModel : public QAbstractListModel {
+    Q_OBJECT
+    Q_PROPERTY(ElementModel* elementModel READ elementModel WRITE setElementModel NOTIFY elementModelChanged)
+    Q_PROPERTY(HitTestService* hitTestService READ hitTestService WRITE setHitTestService NOTIFY hitTestServiceChanged)
+    Q_PROPERTY(ElementFilterProxy* filterProxy READ filterProxy WRITE setFilterProxy NOTIFY filterProxyChanged)
+    Q_PROPERTY(QRectF viewport READ viewport WRITE setViewport NOTIFY viewportChanged)
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+
+public:
+    explicit VisibleElementsModel(QObject *parent = nullptr);
+
+    // QAbstractListModel interface
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    ElementModel* elementModel() const { return m_elementModel; }
+    void setElementModel(ElementModel *model);
+    HitTestService* hitTestService() const { return m_hitTestService; }
+    void setHitTestService(HitTestService *service);
+    ElementFilterProxy* filterProxy() const { return m_filterProxy; }
+    void setFilterProxy(ElementFilterProxy *proxy);
+    QRectF viewport() const { return m_viewport; }
+    void setViewport(const QRectF &viewport);  // Canvas coordinates
+    int count() const { return m_visible.size(); }
+
+    Q_INVOKABLE Element* elementAt(int row) const;
+
+signals:
+    void elementModelChanged();
+    void hitTestServiceChanged();
+    void filterProxyChanged();
+    void viewportChanged();
+    void countChanged();
+
+private slots:
+    void scheduleRefresh();
+    void refresh();
+    void onElementRemoved(const QString &elementId);
+    void onRootsChanged(const QString &parentId);
+    void onIndexRebuilt();
+
+private:
+    void reset();
+    void rebuildRanks();
+    void rebuildUnindexedRoots();
+    QSet<Element*> queryRoots(const QRectF &rect) const;
+    bool isRenderedRoot(Element *element) const;
+
+    QPointer<ElementModel> m_elementModel;
+    QPointer<HitTestService> m_hitTestService;
+    QPointer<ElementFilterProxy> m_filterProxy;
+    QRectF m_viewport;
+
+    QList<Element*> m_visible;          // Live root elements in z-order
+    QHash<Element*, int> m_ranks;       // Root element -> z-order position
+    QSet<Element*> m_unindexedRoots;    // Rendered roots missing from the spatial index
+    bool m_ranksValid = false;
+    bool m_unindexedValid = false;
+
+    QTimer *m_refreshTimer = nullptr;
+};
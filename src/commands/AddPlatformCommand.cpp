@@ -1,7 +1,6 @@
 #include "AddPlatformCommand.h"
 #include "Project.h"
-#include "Application.h"
-#include "ProjectApiClient.h"
+#include "ProjectSyncQueue.h"
 #include <QDebug>
 
 AddPlatformCommand::AddPlatformCommand(Project* project, const QString& platformName, QObject *parent)
@@ -39,28 +38,15 @@ void AddPlatformCommand::undo()
 
     // Remove the platform from the project
     m_project->removePlatform(m_platformName);
+
+    syncWithAPI();
 }
 
 void AddPlatformCommand::syncWithAPI()
 {
-    if (!m_project) {
-        return;
-    }
-
-    // Get the Application instance and its API client
-    Application* app = Application::instance();
-    if (!app) {
+    if (!m_project || !m_project->syncQueue()) {
         return;
     }
 
-    ProjectApiClient* apiClient = app->projectApiClient();
-    if (!apiClient) {
-        return;
-    }
-
-    // Get the project's API ID
-    QString apiProjectId = m_project->id();
-    
-    // Sync with API
-    apiClient->syncAddPlatform(apiProjectId, m_platformName);
+    m_project->syncQueue()->markProjectDirty();
 }
\ No newline at end of file
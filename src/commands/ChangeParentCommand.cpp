@@ -3,9 +3,8 @@
 #include "../CanvasElement.h"
 #include "../DesignElement.h"
 #include "../Frame.h"
-#include "../Application.h"
 #include "../Project.h"
-#include "../ProjectApiClient.h"
+#include "../ProjectSyncQueue.h"
 #include "../ElementModel.h"
 #include "../PlatformConfig.h"
 #include <QDebug>
@@ -345,41 +344,7 @@ void ChangeParentCommand::syncWithAPI()
         return;
     }
 
-    // Navigate up to find the project (through ElementModel)
-    ElementModel* model = nullptr;
-    QObject* parent = m_element->parent();
-    while (parent) {
-        model = qobject_cast<ElementModel*>(parent);
-        if (model) break;
-        parent = parent->parent();
+    if (ProjectSyncQueue* syncQueue = ProjectSyncQueue::forObject(m_element)) {
+        syncQueue->markDirty(m_element->getId());
     }
-
-    if (!model) {
-        return;
-    }
-
-    Project* project = qobject_cast<Project*>(model->parent());
-    if (!project) {
-        return;
-    }
-
-    // Get the Application instance and its API client
-    Application* app = Application::instance();
-    if (!app) {
-        return;
-    }
-
-    ProjectApiClient* apiClient = app->projectApiClient();
-    if (!apiClient) {
-        return;
-    }
-
-    // Get the project's API ID
-    QString apiProjectId = project->id();
-    
-    // Sync with API
-    apiClient->syncUpdateElement(apiProjectId, m_element->getId());
-    
-    qDebug() << "ChangeParentCommand: Syncing parent change with API for project" << apiProjectId 
-             << "element:" << m_element->getId() << "new parent:" << m_newParentId;
 }
\ No newline at end of file
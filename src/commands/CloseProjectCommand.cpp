@@ -157,4 +157,12 @@ void CloseProjectCommand::performClose()
     
     // Emit signal to indicate close is complete
     emit closeComplete();
-}
\ No newline at end of file
+}
+
+MemoryUsage CloseProjectCommand::memoryUsage() const
+{
+    MemoryUsage usage = Command::memoryUsage();
+    usage.bytes += sizeof(CloseProjectCommand) - sizeof(Command) + MemoryEstimate::of(m_projectId)
+                   + MemoryEstimate::of(m_savedProjectData);
+    return usage;
+}
@@ -21,6 +21,8 @@ public:
     void execute() override;
     void undo() override;
 
+    MemoryUsage memoryUsage() const override;
+
 signals:
     void closeComplete();
 
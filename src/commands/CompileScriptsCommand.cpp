@@ -3,10 +3,7 @@
 #include "../ElementModel.h"
 #include "../Project.h"
 #include "../ConsoleMessageRepository.h"
-#include "../Application.h"
-#include "../ProjectApiClient.h"
-#include <QJsonObject>
-#include <QDateTime>
+#include "../ProjectSyncQueue.h"
 #include <QDebug>
 
 CompileScriptsCommand::CompileScriptsCommand(Scripts* scripts, ElementModel* elementModel,
@@ -71,35 +68,23 @@ void CompileScriptsCommand::undo()
     if (m_console) {
         m_console->addInfo("Script compilation undone");
     }
-    
-    // Note: We don't undo the API sync as that would require storing
-    // the previous server state, which could be complex
+
+    syncWithApi();
 }
 
 void CompileScriptsCommand::syncWithApi()
 {
-    if (!m_project || !m_wasSuccessful) return;
-    
-    // Get the Application instance
-    Application* app = qobject_cast<Application*>(m_project->parent());
-    if (!app) return;
-    
-    // Get the ProjectApiClient
-    ProjectApiClient* apiClient = app->projectApiClient();
-    if (!apiClient) return;
-    
-    // Use the project's ID as the API project ID
-    QString apiProjectId = m_project->id();
-    
-    // The compilation has changed the state of the scripts
-    // We need to sync the entire project to ensure consistency
-    QJsonObject compilationData;
-    compilationData["action"] = "scripts_compiled";
-    compilationData["timestamp"] = QDateTime::currentDateTime().toString(Qt::ISODate);
-    
-    // Call syncCreateElement which internally updates the entire project
-    // This ensures all nodes, edges, and the compiled script are synced
-    apiClient->syncCreateElement(apiProjectId, compilationData);
-    
-    // qDebug() << "CompileScriptsCommand: Syncing compiled scripts with API for project:" << apiProjectId;
-}
\ No newline at end of file
+    if (!m_project || !m_wasSuccessful || !m_project->syncQueue()) return;
+
+    // The compilation changed the scripts' state; the next flush carries the
+    // nodes, edges and compiled script together
+    m_project->syncQueue()->markProjectDirty();
+}
+
+MemoryUsage CompileScriptsCommand::memoryUsage() const
+{
+    MemoryUsage usage = Command::memoryUsage();
+    usage.bytes += sizeof(CompileScriptsCommand) - sizeof(Command) + MemoryEstimate::of(m_compiledScript)
+                   + MemoryEstimate::of(m_previousCompiledScript);
+    return usage;
+}
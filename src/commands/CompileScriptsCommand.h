@@ -22,6 +22,8 @@ public:
 
     void execute() override;
     void undo() override;
+
+    MemoryUsage memoryUsage() const override;
     
     // Get the compilation result
     QString compiledScript() const { return m_compiledScript; }
@@ -0,0 +1,62 @@
+#include "CompoundCommand.h"
+
+CompoundCommand::CompoundCommand(const QString& description, const QString& mergeKey, QObject *parent)
+    : Command(parent)
+    , m_mergeKey(mergeKey)
+{
+    setDescription(description);
+}
+
+CompoundCommand::~CompoundCommand()
+{
+    // Destroy in reverse so later commands release what they own first
+    while (!m_children.empty()) {
+        m_children.pop_back();
+    }
+}
+
+void CompoundCommand::execute()
+{
+    // Children ran when they were recorded; this only replays them on redo
+    for (auto& command : m_children) {
+        command->redo();
+    }
+}
+
+void CompoundCommand::undo()
+{
+    for (auto it = m_children.rbegin(); it != m_children.rend(); ++it) {
+        (*it)->undo();
+    }
+}
+
+void CompoundCommand::append(std::unique_ptr<Command> command)
+{
+    if (command) {
+        m_children.push_back(std::move(command));
+    }
+}
+
+bool CompoundCommand::mergeWith(CompoundCommand* other)
+{
+    if (!other || m_mergeKey.isEmpty() || other->m_mergeKey != m_mergeKey) {
+        return false;
+    }
+
+    for (auto& command : other->m_children) {
+        m_children.push_back(std::move(command));
+    }
+    other->m_children.clear();
+    return true;
+}
+
+MemoryUsage CompoundCommand::memoryUsage() const
+{
+    MemoryUsage usage = Command::memoryUsage();
+    usage.bytes += sizeof(CompoundCommand) - sizeof(Command) + MemoryEstimate::of(m_mergeKey)
+                   + m_children.capacity() * sizeof(std::unique_ptr<Command>);
+    for (const auto& child : m_children) {
+        usage += child->memoryUsage();
+    }
+    return usage;
+}
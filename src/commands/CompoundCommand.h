@@ -0,0 +1,37 @@
+#ifndef COMPOUNDCOMMAND_H
+#define COMPOUNDCOMMAND_H
+
+#include "../Command.h"
+#include <memory>
+#include <vector>
+
+// Groups already-executed commands into one undo step. Built by
+// CommandHistory::beginMacro()/endMacro().
+class CompoundCommand : public Command
+{
+    Q_OBJECT
+
+public:
+    explicit CompoundCommand(const QString& description, const QString& mergeKey = QString(),
+                             QObject *parent = nullptr);
+    ~CompoundCommand();
+
+    void execute() override;
+    void undo() override;
+
+    void append(std::unique_ptr<Command> command);
+    bool isEmpty() const { return m_children.empty(); }
+    int count() const { return static_cast<int>(m_children.size()); }
+
+    // Macros with the same non-empty key may be folded into one undo step
+    QString mergeKey() const { return m_mergeKey; }
+    bool mergeWith(CompoundCommand* other);
+
+    MemoryUsage memoryUsage() const override;
+
+private:
+    std::vector<std::unique_ptr<Command>> m_children;
+    QString m_mergeKey;
+};
+
+#endif // COMPOUNDCOMMAND_H
@@ -4,11 +4,10 @@
 #include "Shape.h"
 #include "ElementModel.h"
 #include "SelectionManager.h"
-#include "Application.h"
 #include "Project.h"
 #include "Component.h"
 #include "ElementTypeRegistry.h"
-#include "ProjectApiClient.h"
+#include "ProjectSyncQueue.h"
 #include "PlatformConfig.h"
 #include "Variable.h"
 #include "UniqueIdGenerator.h"
@@ -67,6 +66,7 @@ void CreateDesignElementCommand::execute()
 
 
     // Create element on first execution
+    const bool isRedo = m_element;
     if (!m_element) {
         m_elementId = m_elementModel->generateId();
         
@@ -158,7 +158,10 @@ void CreateDesignElementCommand::execute()
         }
     }
     
-    // Don't sync with API here - it will be synced after resize is complete
+    // The first execution syncs once the resize is complete; a redo already has its final size
+    if (isRedo) {
+        syncWithAPI();
+    }
 }
 
 void CreateDesignElementCommand::undo()
@@ -204,6 +207,10 @@ void CreateDesignElementCommand::undo()
         }
         
         m_elementModel->removeElement(m_element->getId());
+
+        if (ProjectSyncQueue* syncQueue = ProjectSyncQueue::forObject(m_elementModel)) {
+            syncQueue->markDirty(m_element->getId(), ProjectSyncQueue::Deleted);
+        }
     }
 }
 
@@ -215,41 +222,11 @@ void CreateDesignElementCommand::creationCompleted()
 
 void CreateDesignElementCommand::syncWithAPI()
 {
-    
     if (!m_elementModel || !m_element) {
         return;
     }
 
-    // Get the Project from the ElementModel's parent
-    Project* project = qobject_cast<Project*>(m_elementModel->parent());
-    if (!project) {
-        return;
-    }
-
-    // Get the Application instance and its API client
-    Application* app = Application::instance();
-    if (!app) {
-        return;
-    }
-
-    ProjectApiClient* apiClient = app->projectApiClient();
-    if (!apiClient) {
-        return;
+    if (ProjectSyncQueue* syncQueue = ProjectSyncQueue::forObject(m_elementModel)) {
+        syncQueue->markDirty(m_element->getId(), ProjectSyncQueue::Created);
     }
-
-    // Get the project's API ID (assuming it's the same as the project ID for now)
-    QString apiProjectId = project->id();
-    
-    // Serialize the element data
-    QJsonObject elementData = app->serializeElement(m_element);
-    
-    
-    if (m_elementType == "shape") {
-        if (Shape* shape = qobject_cast<Shape*>(m_element)) {
-        }
-    }
-    
-    // Sync with API
-    apiClient->syncCreateElement(apiProjectId, elementData);
-    
 }
\ No newline at end of file
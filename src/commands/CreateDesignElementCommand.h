@@ -29,6 +29,10 @@ public:
     // Call this after the element has been resized to its final dimensions
     void creationCompleted();
 
+    // The created element, once execute() has run
+    DesignElement* element() const { return m_element; }
+    QString elementId() const { return m_elementId; }
+
 private:
     void syncWithAPI();
     QPointer<ElementModel> m_elementModel;
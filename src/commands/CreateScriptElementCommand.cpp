@@ -6,10 +6,7 @@
 #include "SelectionManager.h"
 #include "Scripts.h"
 #include "HandleType.h"
-#include "../Application.h"
-#include "../Project.h"
-#include "../ProjectApiClient.h"
-#include <QJsonObject>
+#include "../ProjectSyncQueue.h"
 #include <QDebug>
 
 CreateScriptElementCommand::CreateScriptElementCommand(ElementModel* model, SelectionManager* selectionManager,
@@ -165,47 +162,10 @@ void CreateScriptElementCommand::execute()
 void CreateScriptElementCommand::syncWithApi()
 {
     if (!m_element || !m_elementModel) return;
-    
-    // Get the project from the element model
-    Project* project = qobject_cast<Project*>(m_elementModel->parent());
-    if (!project) return;
-    
-    // Get the Application instance
-    Application* app = qobject_cast<Application*>(project->parent());
-    if (!app) return;
-    
-    // Get the ProjectApiClient
-    ProjectApiClient* apiClient = app->projectApiClient();
-    if (!apiClient) return;
-    
-    // Create element data for API sync
-    QJsonObject elementData;
-    elementData["elementId"] = m_element->getId();
-    elementData["elementType"] = m_elementType;
-    
-    if (m_elementType == "node") {
-        if (Node* node = qobject_cast<Node*>(m_element)) {
-            elementData["nodeTitle"] = node->nodeTitle();
-            elementData["nodeType"] = node->nodeType();
-            elementData["x"] = node->x();
-            elementData["y"] = node->y();
-            elementData["width"] = node->width();
-            elementData["height"] = node->height();
-        }
-    } else if (m_elementType == "edge") {
-        if (Edge* edge = qobject_cast<Edge*>(m_element)) {
-            elementData["sourceNodeId"] = edge->sourceNodeId();
-            elementData["targetNodeId"] = edge->targetNodeId();
-            elementData["sourcePortIndex"] = edge->sourcePortIndex();
-            elementData["targetPortIndex"] = edge->targetPortIndex();
-        }
+
+    if (ProjectSyncQueue* syncQueue = ProjectSyncQueue::forObject(m_elementModel)) {
+        syncQueue->markDirty(m_element->getId(), ProjectSyncQueue::Created);
     }
-    
-    // Use the project's ID as the API project ID
-    QString apiProjectId = project->id();
-    
-    // Sync the element creation with the API
-    apiClient->syncCreateElement(apiProjectId, elementData);
 }
 
 void CreateScriptElementCommand::undo()
@@ -234,6 +194,10 @@ void CreateScriptElementCommand::undo()
     // Remove element from model
     if (m_element) {
         m_elementModel->removeElement(m_element->getId());
+
+        if (ProjectSyncQueue* syncQueue = ProjectSyncQueue::forObject(m_elementModel)) {
+            syncQueue->markDirty(m_element->getId(), ProjectSyncQueue::Deleted);
+        }
     }
 }
 
@@ -5,10 +5,8 @@
 #include "../UniqueIdGenerator.h"
 #include "../Project.h"
 #include "../PlatformConfig.h"
-#include "../Application.h"
-#include "../ProjectApiClient.h"
+#include "../ProjectSyncQueue.h"
 #include <QDebug>
-#include <QJsonObject>
 
 CreateVariableCommand::CreateVariableCommand(ElementModel* model, SelectionManager* selectionManager,
                                            QObject *parent)
@@ -82,6 +80,10 @@ void CreateVariableCommand::undo()
     
     // Remove from model
     m_elementModel->removeElement(m_variable);
+
+    if (ProjectSyncQueue* syncQueue = ProjectSyncQueue::forObject(m_elementModel)) {
+        syncQueue->markDirty(m_variable->getId(), ProjectSyncQueue::Deleted);
+    }
 }
 
 void CreateVariableCommand::syncWithAPI()
@@ -90,29 +92,7 @@ void CreateVariableCommand::syncWithAPI()
         return;
     }
 
-    // Get the Project from the ElementModel's parent
-    Project* project = qobject_cast<Project*>(m_elementModel->parent());
-    if (!project) {
-        return;
-    }
-
-    // Get the Application instance and its API client
-    Application* app = Application::instance();
-    if (!app) {
-        return;
-    }
-
-    ProjectApiClient* apiClient = app->projectApiClient();
-    if (!apiClient) {
-        return;
+    if (ProjectSyncQueue* syncQueue = ProjectSyncQueue::forObject(m_elementModel)) {
+        syncQueue->markDirty(m_variable->getId(), ProjectSyncQueue::Created);
     }
-
-    // Get the project's API ID
-    QString apiProjectId = project->id();
-    
-    // Serialize the variable data
-    QJsonObject variableData = app->serializeElement(m_variable);
-    
-    // Sync with API
-    apiClient->syncCreateElement(apiProjectId, variableData);
 }
\ No newline at end of file
@@ -11,11 +11,10 @@
 #include "../DesignElement.h"
 #include "../Component.h"
 #include "../Variable.h"
-#include "../Application.h"
-#include "../ProjectApiClient.h"
+#include "../ProjectSyncQueue.h"
+#include "../PropertyRegistry.h"
 #include <QDebug>
 #include <QCoreApplication>
-#include <QJsonArray>
 #include <vector>
 
 DeleteElementsCommand::DeleteElementsCommand(ElementModel* model, SelectionManager* selectionManager,
@@ -193,6 +192,7 @@ void DeleteElementsCommand::execute()
         m_elementModel->removeElement(info.element->getId());
         
     }
+    m_removed = true;
 
     // Clear the flag after all removals are done
     if (isScriptMode) {
@@ -224,6 +224,7 @@ void DeleteElementsCommand::undo()
         m_elementModel->addElement(info.element);
         
     }
+    m_removed = false;
 
     // Restore selection
     if (m_selectionManager && !m_deletedElements.isEmpty()) {
@@ -235,40 +236,20 @@ void DeleteElementsCommand::undo()
         m_selectionManager->selectAll(elementsToSelect);
     }
 
+    // The restored elements have to be recreated on the server
+    if (ProjectSyncQueue* syncQueue = ProjectSyncQueue::forObject(m_elementModel)) {
+        syncQueue->markDirty(m_deletedElementIds, ProjectSyncQueue::Created);
+    }
 }
 
 void DeleteElementsCommand::syncWithAPI()
 {
-    // Get the project from the element model
     if (!m_elementModel) return;
-    
-    Project* project = qobject_cast<Project*>(m_elementModel->parent());
-    if (!project) {
-        return;
-    }
-    
-    // Get the Application and API client
-    Application* app = Application::instance();
-    if (!app) {
-        return;
-    }
-    
-    ProjectApiClient* apiClient = app->projectApiClient();
-    if (!apiClient) {
-        return;
-    }
-    
-    // Get the project's API ID
-    QString apiProjectId = project->id();
-    
+
     // Use pre-stored element IDs (elements might already be deleted)
-    QJsonArray elementIds;
-    for (const QString& elementId : m_deletedElementIds) {
-        elementIds.append(elementId);
+    if (ProjectSyncQueue* syncQueue = ProjectSyncQueue::forObject(m_elementModel)) {
+        syncQueue->markDirty(m_deletedElementIds, ProjectSyncQueue::Deleted);
     }
-    
-    // Sync with API
-    apiClient->syncDeleteElements(apiProjectId, elementIds);
 }
 
 void DeleteElementsCommand::findChildElements(const QString& parentId, const QList<Element*>& allElements)
@@ -304,4 +285,26 @@ void DeleteElementsCommand::findChildElements(const QString& parentId, const QLi
             }
         }
     }
-}
\ No newline at end of file
+}
+
+MemoryUsage DeleteElementsCommand::memoryUsage() const
+{
+    MemoryUsage usage = Command::memoryUsage();
+    usage.bytes += sizeof(DeleteElementsCommand) - sizeof(Command) + MemoryEstimate::of(m_deletedElementIds)
+                   + (m_deletedElements.size() + m_deletedChildren.size()) * qint64(sizeof(ElementInfo));
+    if (!m_removed) {
+        return usage;
+    }
+    
+    // Removed from the model but not destroyed, so undo can put them back
+    for (const QList<ElementInfo>* list : {&m_deletedElements, &m_deletedChildren}) {
+        for (const ElementInfo& info : *list) {
+            usage.objects++;
+            usage.bytes += MemoryEstimate::QOBJECT_OVERHEAD;
+            if (const PropertyRegistry* registry = info.element->propertyRegistry()) {
+                usage += registry->memoryUsage();
+            }
+        }
+    }
+    return usage;
+}
@@ -22,6 +22,9 @@ public:
     void execute() override;
     void undo() override;
 
+    // Deleted elements are kept alive by this command while out of the model
+    MemoryUsage memoryUsage() const override;
+
 private:
     void syncWithAPI();
     void findChildElements(const QString& parentId, const QList<Element*>& allElements);
@@ -37,6 +40,7 @@ private:
     QList<ElementInfo> m_deletedElements;
     QList<ElementInfo> m_deletedChildren;
     QStringList m_deletedElementIds;  // Store IDs before deletion for API sync
+    bool m_removed = false;           // Elements are out of the model (executed, not undone)
 };
 
 #endif // DELETEELEMENTSCOMMAND_H
\ No newline at end of file
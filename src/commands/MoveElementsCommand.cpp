@@ -3,7 +3,7 @@
 #include "../CanvasElement.h"
 #include "../Application.h"
 #include "../Project.h"
-#include "../ProjectApiClient.h"
+#include "../ProjectSyncQueue.h"
 #include "../ElementModel.h"
 #include "../PlatformConfig.h"
 #include <QDebug>
@@ -93,6 +93,7 @@ void MoveElementsCommand::undo()
         move.element->setY(move.originalPosition.y());
     }
     
+    syncWithAPI();
 }
 
 bool MoveElementsCommand::mergeWith(MoveElementsCommand* other)
@@ -126,57 +127,20 @@ bool MoveElementsCommand::mergeWith(MoveElementsCommand* other)
 
 void MoveElementsCommand::syncWithAPI()
 {
-    if (m_moves.isEmpty()) {
-        return;
-    }
-
-    // Get project from any element's model
-    CanvasElement* firstElement = m_moves.first().element;
-    if (!firstElement) {
-        return;
-    }
-
-    // Navigate up to find the project (through ElementModel)
-    ElementModel* model = nullptr;
-    QObject* parent = firstElement->parent();
-    while (parent) {
-        model = qobject_cast<ElementModel*>(parent);
-        if (model) break;
-        parent = parent->parent();
-    }
-
-    if (!model) {
+    if (m_moves.isEmpty() || !m_moves.first().element) {
         return;
     }
 
-    Project* project = qobject_cast<Project*>(model->parent());
-    if (!project) {
+    ProjectSyncQueue* syncQueue = ProjectSyncQueue::forObject(m_moves.first().element);
+    if (!syncQueue) {
         return;
     }
 
-    // Get the Application instance and its API client
-    Application* app = Application::instance();
-    if (!app) {
-        return;
-    }
-
-    ProjectApiClient* apiClient = app->projectApiClient();
-    if (!apiClient) {
-        return;
-    }
-
-    // Get the project's API ID
-    QString apiProjectId = project->id();
-    
-    // Create array of element IDs
-    QJsonArray elementIds;
+    QStringList elementIds;
     for (const ElementMove& move : m_moves) {
         elementIds.append(move.element->getId());
     }
-    
-    // Sync with API
-    apiClient->syncMoveElements(apiProjectId, elementIds);
-    
+    syncQueue->markDirty(elementIds);
 }
 
 void MoveElementsCommand::syncGlobalElements()
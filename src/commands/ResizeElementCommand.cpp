@@ -1,9 +1,6 @@
 #include "ResizeElementCommand.h"
 #include "../CanvasElement.h"
-#include "../Application.h"
-#include "../Project.h"
-#include "../ProjectApiClient.h"
-#include "../ElementModel.h"
+#include "../ProjectSyncQueue.h"
 #include <QDebug>
 
 ResizeElementCommand::ResizeElementCommand(CanvasElement* element, const QRectF& oldRect, const QRectF& newRect, QObject *parent)
@@ -46,6 +43,7 @@ void ResizeElementCommand::undo()
     // Resize element back to original rect
     m_element->setRect(m_oldRect);
 
+    syncWithAPI();
 }
 
 bool ResizeElementCommand::mergeWith(ResizeElementCommand* other)
@@ -72,38 +70,7 @@ void ResizeElementCommand::syncWithAPI()
         return;
     }
 
-    // Navigate up to find the project (through ElementModel)
-    ElementModel* model = nullptr;
-    QObject* parent = m_element->parent();
-    while (parent) {
-        model = qobject_cast<ElementModel*>(parent);
-        if (model) break;
-        parent = parent->parent();
-    }
-
-    if (!model) {
-        return;
-    }
-
-    Project* project = qobject_cast<Project*>(model->parent());
-    if (!project) {
-        return;
+    if (ProjectSyncQueue* syncQueue = ProjectSyncQueue::forObject(m_element)) {
+        syncQueue->markDirty(m_element->getId());
     }
-
-    // Get the Application instance and its API client
-    Application* app = Application::instance();
-    if (!app) {
-        return;
-    }
-
-    ProjectApiClient* apiClient = app->projectApiClient();
-    if (!apiClient) {
-        return;
-    }
-
-    // Get the project's API ID
-    QString apiProjectId = project->id();
-    
-    // Sync with API
-    apiClient->syncUpdateElement(apiProjectId, m_element->getId());
 }
\ No newline at end of file
@@ -1,9 +1,6 @@
 #include "SetPropertyCommand.h"
 #include "../Element.h"
-#include "../Application.h"
-#include "../Project.h"
-#include "../ProjectApiClient.h"
-#include "../ElementModel.h"
+#include "../ProjectSyncQueue.h"
 #include <QObject>
 #include <QMetaProperty>
 #include <QDebug>
@@ -63,6 +60,7 @@ void SetPropertyCommand::undo()
     // Set property back to old value
     m_target->setProperty(m_propertyName.toUtf8().constData(), m_oldValue);
 
+    syncWithAPI();
 }
 
 bool SetPropertyCommand::mergeWith(SetPropertyCommand* other)
@@ -82,51 +80,13 @@ bool SetPropertyCommand::mergeWith(SetPropertyCommand* other)
 
 void SetPropertyCommand::syncWithAPI()
 {
-    if (!m_target) {
-        return;
-    }
-
     // Only sync if the target is an Element
     Element* element = qobject_cast<Element*>(m_target);
     if (!element) {
         return;
     }
 
-    // Navigate up to find the project (through ElementModel)
-    ElementModel* model = nullptr;
-    QObject* parent = element->parent();
-    while (parent) {
-        model = qobject_cast<ElementModel*>(parent);
-        if (model) break;
-        parent = parent->parent();
-    }
-
-    if (!model) {
-        return;
-    }
-
-    Project* project = qobject_cast<Project*>(model->parent());
-    if (!project) {
-        return;
+    if (ProjectSyncQueue* syncQueue = ProjectSyncQueue::forObject(element)) {
+        syncQueue->markDirty(element->getId());
     }
-
-    // Get the Application instance and its API client
-    Application* app = Application::instance();
-    if (!app) {
-        return;
-    }
-
-    ProjectApiClient* apiClient = app->projectApiClient();
-    if (!apiClient) {
-        return;
-    }
-
-    // Get the project's API ID
-    QString apiProjectId = project->id();
-    
-    // Sync with API
-    apiClient->syncUpdateElement(apiProjectId, element->getId());
-    
-    qDebug() << "SetPropertyCommand: Syncing property change with API for project" << apiProjectId 
-             << "element:" << element->getId() << "property:" << m_propertyName << "new value:" << m_newValue;
 }
\ No newline at end of file
@@ -28,7 +28,14 @@
 #include "Panels.h"
 #include "Scripts.h"
 #include "ScriptCompiler.h"
+#include "ScriptRuntime.h"
+#include "ProjectSyncQueue.h"
 #include "ElementFilterProxy.h"
+#include "ChildrenProxyModel.h"
+#include "VisibleElementsModel.h"
+#include "NodesModel.h"
+#include "EdgesModel.h"
+#include "HitTestService.h"
 #include "PrototypeController.h"
 #include "DesignControlsController.h"
 #include "ShapeControlsController.h"
@@ -43,6 +50,10 @@
 #include "ConfigObject.h"
 #include "VariableBinding.h"
 #include "GoogleFonts.h"
+#include "TextMeasurementService.h"
+#include "NetworkTransport.h"
+#include "PerformanceTrace.h"
+#include "MemoryDiagnostics.h"
 
 int main(int argc, char *argv[])
 {
@@ -74,6 +85,22 @@ int main(int argc, char *argv[])
     // Load property type mappings
     PropertyTypeMapper::instance()->loadMappings(":/data/src/property-types.json");
 
+    // CUBIT_TRACE_FILE=<path> records a performance trace for the whole session
+    // and writes it on exit
+    const QString traceFile = qEnvironmentVariable("CUBIT_TRACE_FILE");
+    if (!traceFile.isEmpty()) {
+        PerformanceTrace::setEnabled(true);
+    }
+
+    // CUBIT_CONSOLE_LOG=1 echoes console panel messages to the log
+    ConsoleMessageRepository::setEchoToLog(qEnvironmentVariableIntValue("CUBIT_CONSOLE_LOG") > 0);
+
+    // CUBIT_MEMORY_LOG_INTERVAL=<ms> logs a per-subsystem memory sample periodically
+    const int memoryLogInterval = qEnvironmentVariableIntValue("CUBIT_MEMORY_LOG_INTERVAL");
+    if (memoryLogInterval > 0) {
+        MemoryDiagnostics::instance()->setLogInterval(memoryLogInterval);
+    }
+
     // Create authentication manager
     AuthenticationManager *authManager = new AuthenticationManager(&app);
 
@@ -133,6 +160,13 @@ int main(int argc, char *argv[])
     qmlRegisterType<ScriptCompiler>("Cubit", 1, 0, "ScriptCompiler");
     qmlRegisterType<PlatformConfig>("Cubit", 1, 0, "PlatformConfig");
     qmlRegisterType<ElementFilterProxy>("Cubit", 1, 0, "ElementFilterProxy");
+    qmlRegisterType<ChildrenProxyModel>("Cubit", 1, 0, "ChildrenProxyModel");
+    qmlRegisterType<VisibleElementsModel>("Cubit", 1, 0, "VisibleElementsModel");
+    qmlRegisterType<NodesModel>("Cubit", 1, 0, "NodesModel");
+    qmlRegisterType<EdgesModel>("Cubit", 1, 0, "EdgesModel");
+    qmlRegisterUncreatableType<HitTestService>("Cubit", 1, 0, "HitTestService", "HitTestService is owned by CanvasController");
+    qmlRegisterUncreatableType<ScriptRuntime>("Cubit", 1, 0, "ScriptRuntime", "ScriptRuntime is owned by Project");
+    qmlRegisterUncreatableType<ProjectSyncQueue>("Cubit", 1, 0, "ProjectSyncQueue", "ProjectSyncQueue is owned by Project");
     qmlRegisterType<PrototypeController>("Cubit", 1, 0, "PrototypeController");
     qmlRegisterType<DesignControlsController>("Cubit", 1, 0, "DesignControlsController");
     qmlRegisterType<ShapeControlsController>("Cubit", 1, 0, "ShapeControlsController");
@@ -162,6 +196,33 @@ int main(int argc, char *argv[])
                                              return GoogleFonts::instance();
                                          });
     
+    // Register TextMeasurement singleton (exposes measurement cache statistics)
+    qmlRegisterSingletonType<TextMeasurementService>("Cubit", 1, 0, "TextMeasurement",
+                                                    [](QQmlEngine *engine, QJSEngine *scriptEngine) -> QObject *
+                                                    {
+                                                        Q_UNUSED(engine)
+                                                        Q_UNUSED(scriptEngine)
+                                                        return TextMeasurementService::instance();
+                                                    });
+    
+    // Register NetworkTransport singleton (exposes queue depth and per-endpoint latency)
+    qmlRegisterSingletonType<NetworkTransport>("Cubit", 1, 0, "NetworkTransport",
+                                              [](QQmlEngine *engine, QJSEngine *scriptEngine) -> QObject *
+                                              {
+                                                  Q_UNUSED(engine)
+                                                  Q_UNUSED(scriptEngine)
+                                                  return NetworkTransport::instance();
+                                              });
+    
+    // Register MemoryDiagnostics singleton (per-subsystem memory estimates)
+    qmlRegisterSingletonType<MemoryDiagnostics>("Cubit", 1, 0, "MemoryDiagnostics",
+                                               [](QQmlEngine *engine, QJSEngine *scriptEngine) -> QObject *
+                                               {
+                                                   Q_UNUSED(engine)
+                                                   Q_UNUSED(scriptEngine)
+                                                   return MemoryDiagnostics::instance();
+                                               });
+    
     // Register PropertyRegistry
     qmlRegisterType<PropertyRegistry>("Cubit", 1, 0, "PropertyRegistry");
     qmlRegisterType<PropertyMetadata>("Cubit", 1, 0, "PropertyMetadata");
@@ -249,6 +310,10 @@ int main(int argc, char *argv[])
 
     int result = app.exec();
     
+    if (!traceFile.isEmpty()) {
+        PerformanceTrace::writeChromeTrace(traceFile);
+    }
+    
     // IMPORTANT: Clear all QML connections before Application is destroyed
     // This prevents QML from trying to access destroyed C++ objects during shutdown
     
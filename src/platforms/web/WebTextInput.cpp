@@ -4,6 +4,8 @@
 #include "UniqueIdGenerator.h"
 #include "Frame.h"
 #include "PropertyRegistry.h"
+#include "TextMeasurementService.h"
+#include <QFont>
 
 WebTextInput::WebTextInput(const QString &id, QObject *parent)
     : DesignElement(id, parent)
@@ -89,6 +91,7 @@ void WebTextInput::setPlaceholder(const QString &placeholder)
 void WebTextInput::setValue(const QString &value)
 {
     if (m_value != value) {
+        notifyAboutToChange();
         m_value = value;
         emit valueChanged();
     }
@@ -149,7 +152,7 @@ void WebTextInput::setWidth(qreal w)
     // Trigger layout on parent if it's a frame with flex and this element has relative position
     if (parentElement() && m_position == Relative) {
         Frame* parentFrame = qobject_cast<Frame*>(parentElement());
-        if (parentFrame && parentFrame->flex()) {
+        if (parentFrame && parentFrame->flex() && !parentFrame->isLayouting()) {
             parentFrame->triggerLayout();
         }
     }
@@ -162,7 +165,7 @@ void WebTextInput::setHeight(qreal h)
     // Trigger layout on parent if it's a frame with flex and this element has relative position
     if (parentElement() && m_position == Relative) {
         Frame* parentFrame = qobject_cast<Frame*>(parentElement());
-        if (parentFrame && parentFrame->flex()) {
+        if (parentFrame && parentFrame->flex() && !parentFrame->isLayouting()) {
             parentFrame->triggerLayout();
         }
     }
@@ -175,12 +178,31 @@ void WebTextInput::setRect(const QRectF &rect)
     // Trigger layout on parent if it's a frame with flex and this element has relative position
     if (parentElement() && m_position == Relative) {
         Frame* parentFrame = qobject_cast<Frame*>(parentElement());
-        if (parentFrame && parentFrame->flex()) {
+        if (parentFrame && parentFrame->flex() && !parentFrame->isLayouting()) {
             parentFrame->triggerLayout();
         }
     }
 }
 
+QSizeF WebTextInput::intrinsicSize(qreal widthConstraint) const
+{
+    // Mirrors WebTextInputElement.qml: a single 14px line inset 8px inside the border
+    static const qreal inset = 8.0;
+    QFont font;
+    font.setPixelSize(14);
+    
+    TextMeasurementService* measurement = TextMeasurementService::instance();
+    QSizeF valueSize = measurement->measure(font, m_value);
+    QSizeF placeholderSize = measurement->measure(font, m_placeholder);
+    
+    const qreal chrome = 2 * (inset + m_borderWidth);
+    qreal intrinsicWidth = qMax(valueSize.width(), placeholderSize.width()) + chrome;
+    if (widthConstraint >= 0) {
+        intrinsicWidth = qMin(intrinsicWidth, widthConstraint);
+    }
+    return QSizeF(intrinsicWidth, qMax(valueSize.height(), placeholderSize.height()) + chrome);
+}
+
 void WebTextInput::executeScriptEvent(const QString& eventName, const QVariantMap& eventData)
 {
     // Create event data containing the current value, merging with any provided data
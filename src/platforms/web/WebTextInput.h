@@ -1,6 +1,7 @@
 #pragma once
 #include "DesignElement.h"
 #include <QColor>
+#include <QSizeF>
 
 class WebTextInput : public DesignElement {
     Q_OBJECT
@@ -42,6 +43,10 @@ public:
     void setHeight(qreal h) override;
     void setRect(const QRectF &rect) override;
     
+    // Size needed to show the value or placeholder on one line without clipping.
+    // The flex layout engine uses the height as the input's minimum height.
+    Q_INVOKABLE QSizeF intrinsicSize(qreal widthConstraint = -1) const;
+    
     // Override to pass current value to script events
     Q_INVOKABLE void executeScriptEvent(const QString& eventName, const QVariantMap& eventData = QVariantMap()) override;
     
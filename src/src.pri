@@ -0,0 +1,220 @@
+# Application sources shared by the app and the benchmarks (benchmarks/benchmarks.pro)
+
+SOURCES += \
+    $$PWD/Element.cpp \
+    $$PWD/CanvasElement.cpp \
+    $$PWD/Component.cpp \
+    $$PWD/DesignElement.cpp \
+    $$PWD/ScriptElement.cpp \
+    $$PWD/Frame.cpp \
+    $$PWD/Text.cpp \
+    $$PWD/platforms/web/WebTextInput.cpp \
+    $$PWD/Shape.cpp \
+    $$PWD/Variable.cpp \
+    $$PWD/Node.cpp \
+    $$PWD/Edge.cpp \
+    $$PWD/CanvasController.cpp \
+    $$PWD/DesignCanvas.cpp \
+    $$PWD/ElementModel.cpp \
+    $$PWD/SelectionManager.cpp \
+    $$PWD/ViewportCache.cpp \
+    $$PWD/ConsoleMessageRepository.cpp \
+    $$PWD/Application.cpp \
+    $$PWD/Project.cpp \
+    $$PWD/Panels.cpp \
+    $$PWD/Scripts.cpp \
+    $$PWD/CreationManager.cpp \
+    $$PWD/HitTestService.cpp \
+    $$PWD/JsonImporter.cpp \
+    $$PWD/ElementTypeRegistry.cpp \
+    $$PWD/QuadTree.cpp \
+    $$PWD/Command.cpp \
+    $$PWD/CommandHistory.cpp \
+    $$PWD/commands/CreateDesignElementCommand.cpp \
+    $$PWD/commands/CreateScriptElementCommand.cpp \
+    $$PWD/commands/CreateVariableCommand.cpp \
+    $$PWD/commands/CompileScriptsCommand.cpp \
+    $$PWD/commands/CreateProjectCommand.cpp \
+    $$PWD/commands/OpenProjectCommand.cpp \
+    $$PWD/commands/DeleteElementsCommand.cpp \
+    $$PWD/commands/DeleteProjectCommand.cpp \
+    $$PWD/commands/MoveElementsCommand.cpp \
+    $$PWD/commands/ResizeElementCommand.cpp \
+    $$PWD/commands/SetPropertyCommand.cpp \
+    $$PWD/commands/ChangeParentCommand.cpp \
+    $$PWD/commands/CloseProjectCommand.cpp \
+    $$PWD/commands/CreateComponentCommand.cpp \
+    $$PWD/commands/CreateInstanceCommand.cpp \
+    $$PWD/commands/DetachComponentCommand.cpp \
+    $$PWD/commands/AssignVariableCommand.cpp \
+    $$PWD/commands/AddPlatformCommand.cpp \
+    $$PWD/commands/CompoundCommand.cpp \
+    $$PWD/ScriptCompiler.cpp \
+    $$PWD/ScriptExecutor.cpp \
+    $$PWD/ScriptRuntime.cpp \
+    $$PWD/ScriptGraphValidator.cpp \
+    $$PWD/ScriptInvokeBuilder.cpp \
+    $$PWD/ScriptFunctionRegistry.cpp \
+    $$PWD/ScriptIntrinsics.cpp \
+    $$PWD/ScriptSerializer.cpp \
+    $$PWD/SelectModeHandler.cpp \
+    $$PWD/CreationModeHandler.cpp \
+    $$PWD/PenModeHandler.cpp \
+    $$PWD/ElementFilterProxy.cpp \
+    $$PWD/ChildrenProxyModel.cpp \
+    $$PWD/VisibleElementsModel.cpp \
+    $$PWD/NodesModel.cpp \
+    $$PWD/EdgesModel.cpp \
+    $$PWD/FlexLayoutEngine.cpp \
+    $$PWD/PrototypeController.cpp \
+    $$PWD/GoogleFonts.cpp \
+    $$PWD/TextMeasurementService.cpp \
+    $$PWD/NetworkTransport.cpp \
+    $$PWD/ProjectSyncQueue.cpp \
+    $$PWD/PerformanceTrace.cpp \
+    $$PWD/InputRecording.cpp \
+    $$PWD/InputReplayer.cpp \
+    $$PWD/MemoryUsage.cpp \
+    $$PWD/MemoryDiagnostics.cpp \
+    $$PWD/SnappingService.cpp \
+    $$PWD/DesignControlsController.cpp \
+    $$PWD/ShapeControlsController.cpp \
+    $$PWD/AuthenticationManager.cpp \
+    $$PWD/UrlSchemeHandler.cpp \
+    $$PWD/StreamingAIClient.cpp \
+    $$PWD/AICommandDispatcher.cpp \
+    $$PWD/AICommandStreamParser.cpp \
+    $$PWD/ProjectApiClient.cpp \
+    $$PWD/FileManager.cpp \
+    $$PWD/Serializer.cpp \
+    $$PWD/PlatformConfig.cpp \
+    $$PWD/CanvasContext.cpp \
+    $$PWD/contexts/MainCanvasContext.cpp \
+    $$PWD/contexts/ScriptCanvasContext.cpp \
+    $$PWD/PropertyRegistry.cpp \
+    $$PWD/PropertyTypeMapper.cpp \
+    $$PWD/ThrottledUpdate.cpp \
+    $$PWD/AdaptiveThrottler.cpp \
+    $$PWD/AIService.cpp \
+    $$PWD/VariableBinding.cpp
+
+HEADERS += \
+    $$PWD/Element.h \
+    $$PWD/FlexLayoutEngine.h \
+    $$PWD/CanvasElement.h \
+    $$PWD/Component.h \
+    $$PWD/DesignElement.h \
+    $$PWD/ScriptElement.h \
+    $$PWD/Frame.h \
+    $$PWD/Text.h \
+    $$PWD/platforms/web/WebTextInput.h \
+    $$PWD/Shape.h \
+    $$PWD/Variable.h \
+    $$PWD/BoxShadow.h \
+    $$PWD/ComponentTemplates.h \
+    $$PWD/ConnectionManager.h \
+    $$PWD/PropertySyncer.h \
+    $$PWD/PropertyCopier.h \
+    $$PWD/Node.h \
+    $$PWD/Edge.h \
+    $$PWD/CanvasController.h \
+    $$PWD/DesignCanvas.h \
+    $$PWD/ElementModel.h \
+    $$PWD/SelectionManager.h \
+    $$PWD/Config.h \
+    $$PWD/UniqueIdGenerator.h \
+    $$PWD/HandleType.h \
+    $$PWD/ViewportCache.h \
+    $$PWD/ConsoleMessageRepository.h \
+    $$PWD/Application.h \
+    $$PWD/Project.h \
+    $$PWD/Panels.h \
+    $$PWD/Scripts.h \
+    $$PWD/CreationManager.h \
+    $$PWD/HitTestService.h \
+    $$PWD/JsonImporter.h \
+    $$PWD/PropertyDefinition.h \
+    $$PWD/ElementTypeRegistry.h \
+    $$PWD/ElementTemplates.h \
+    $$PWD/QuadTree.h \
+    $$PWD/Command.h \
+    $$PWD/CommandHistory.h \
+    $$PWD/commands/CreateDesignElementCommand.h \
+    $$PWD/commands/CreateScriptElementCommand.h \
+    $$PWD/commands/CreateVariableCommand.h \
+    $$PWD/commands/CompileScriptsCommand.h \
+    $$PWD/commands/CreateProjectCommand.h \
+    $$PWD/commands/OpenProjectCommand.h \
+    $$PWD/commands/DeleteElementsCommand.h \
+    $$PWD/commands/DeleteProjectCommand.h \
+    $$PWD/commands/MoveElementsCommand.h \
+    $$PWD/commands/ResizeElementCommand.h \
+    $$PWD/commands/SetPropertyCommand.h \
+    $$PWD/commands/ChangeParentCommand.h \
+    $$PWD/commands/CloseProjectCommand.h \
+    $$PWD/commands/CreateComponentCommand.h \
+    $$PWD/commands/CreateInstanceCommand.h \
+    $$PWD/commands/DetachComponentCommand.h \
+    $$PWD/commands/AssignVariableCommand.h \
+    $$PWD/commands/AddPlatformCommand.h \
+    $$PWD/commands/CompoundCommand.h \
+    $$PWD/ScriptCompiler.h \
+    $$PWD/ScriptExecutor.h \
+    $$PWD/ScriptRuntime.h \
+    $$PWD/ScriptGraphValidator.h \
+    $$PWD/ScriptInvokeBuilder.h \
+    $$PWD/ScriptFunctionRegistry.h \
+    $$PWD/ScriptIntrinsics.h \
+    $$PWD/ScriptSerializer.h \
+    $$PWD/IModeHandler.h \
+    $$PWD/SelectModeHandler.h \
+    $$PWD/CreationModeHandler.h \
+    $$PWD/PenModeHandler.h \
+    $$PWD/ElementFilterProxy.h \
+    $$PWD/ChildrenProxyModel.h \
+    $$PWD/VisibleElementsModel.h \
+    $$PWD/NodesModel.h \
+    $$PWD/EdgesModel.h \
+    $$PWD/PrototypeController.h \
+    $$PWD/GoogleFonts.h \
+    $$PWD/TextMeasurementService.h \
+    $$PWD/NetworkTransport.h \
+    $$PWD/ProjectSyncQueue.h \
+    $$PWD/PerformanceTrace.h \
+    $$PWD/InputRecording.h \
+    $$PWD/InputReplayer.h \
+    $$PWD/MemoryUsage.h \
+    $$PWD/MemoryDiagnostics.h \
+    $$PWD/ParallelFor.h \
+    $$PWD/SnappingService.h \
+    $$PWD/DesignControlsController.h \
+    $$PWD/ShapeControlsController.h \
+    $$PWD/AuthenticationManager.h \
+    $$PWD/UrlSchemeHandler.h \
+    $$PWD/StreamingAIClient.h \
+    $$PWD/AICommandDispatcher.h \
+    $$PWD/AICommandStreamParser.h \
+    $$PWD/ProjectApiClient.h \
+    $$PWD/FileManager.h \
+    $$PWD/Serializer.h \
+    $$PWD/PlatformConfig.h \
+    $$PWD/CanvasContext.h \
+    $$PWD/contexts/MainCanvasContext.h \
+    $$PWD/contexts/ScriptCanvasContext.h \
+    $$PWD/PropertyRegistry.h \
+    $$PWD/PropertyTypeMapper.h \
+    $$PWD/PropertyMetadata.h \
+    $$PWD/ThrottledUpdate.h \
+    $$PWD/AdaptiveThrottler.h \
+    $$PWD/ConfigObject.h \
+    $$PWD/AIService.h \
+    $$PWD/VariableBinding.h
+
+# Add include paths for better organization
+INCLUDEPATH += $$PWD
+INCLUDEPATH += $$PWD/platforms/web
+INCLUDEPATH += $$PWD/contexts
+
+# Performance trace points are compiled in and stay off until enabled at
+# runtime; CONFIG += no_tracing compiles them out
+no_tracing: DEFINES += CUBIT_NO_TRACING